@@ -0,0 +1,116 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Collects per-frame CPU and GPU timings and writes percentile statistics to a JSON or CSV report.
+class FrameBenchmark
+{
+public:
+    enum TIMING : Uint32
+    {
+        TIMING_UPDATE = 0,
+        TIMING_RENDER,
+        TIMING_PRESENT,
+        TIMING_FRAME,
+        TIMING_GPU,
+        TIMING_COUNT
+    };
+
+    struct Statistics
+    {
+        size_t NumSamples = 0;
+        double Mean       = 0;
+        double Min        = 0;
+        double P50        = 0;
+        double P95        = 0;
+        double P99        = 0;
+        double Max        = 0;
+    };
+
+    struct ReportInfo
+    {
+        const char* SampleName  = nullptr;
+        const char* DeviceType  = nullptr;
+        const char* AdapterName = nullptr;
+        Uint32      Width       = 0;
+        Uint32      Height      = 0;
+    };
+
+    FrameBenchmark(Uint32 NumWarmupFrames, Uint32 NumFrames, double TimeStep);
+
+    /// Returns the fixed simulated time of the current frame.
+    double GetCurrentTime() const { return m_FrameIndex * m_TimeStep; }
+    double GetTimeStep() const { return m_TimeStep; }
+
+    /// Returns true while the warmup frames are being rendered; samples recorded during
+    /// this period are discarded.
+    bool IsWarmingUp() const { return m_FrameIndex < m_NumWarmupFrames; }
+
+    /// Returns true when all warmup and measured frames have been rendered.
+    bool IsComplete() const { return m_FrameIndex >= m_NumWarmupFrames + m_NumFrames; }
+
+    /// Records the CPU time, in seconds, spent in the given phase of the current frame.
+    void RecordCPUTime(TIMING Timing, double Seconds);
+
+    /// Records a GPU frame duration, in seconds. GPU timings become available
+    /// several frames after the frame was submitted, so they are stored independently
+    /// of the CPU timings of the current frame.
+    void RecordGPUTime(double Seconds);
+
+    void EndFrame();
+
+    Statistics ComputeStatistics(TIMING Timing) const;
+
+    /// Writes the report to the file. The format is selected by the file extension:
+    /// '.csv' produces a CSV table, everything else produces JSON.
+    bool WriteReport(const std::string& FilePath, const ReportInfo& Info) const;
+
+    static const char* GetTimingName(TIMING Timing);
+
+private:
+    std::string FormatJSON(const ReportInfo& Info) const;
+    std::string FormatCSV(const ReportInfo& Info) const;
+
+    const Uint32 m_NumWarmupFrames;
+    const Uint32 m_NumFrames;
+    const double m_TimeStep;
+
+    Uint32 m_FrameIndex = 0;
+
+    std::array<std::vector<double>, TIMING_COUNT> m_Samples;
+};
+
+} // namespace Diligent
@@ -0,0 +1,225 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "RenderDevice.h"
+#include "DeviceContext.h"
+#include "Query.h"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Records named, nested CPU and GPU scopes and keeps the results of the last frames.
+///
+/// \remarks    GPU scopes are timestamp query pairs recorded in any context on any queue. CPU scopes are
+///             recorded by every thread into its own ring buffer without locks; the buffers are drained
+///             by EndFrame(). Query results of a frame are read when its history slot is reused, so the
+///             resolved frames lag HistoryDepth - 1 frames behind the current one.
+///             Every thread that records CPU scopes gets its own track for the lifetime of the profiler,
+///             so scopes should be recorded by long-lived threads such as the workers of a thread pool.
+///             Scope names are not copied and must have static storage duration.
+class FrameProfiler
+{
+public:
+    struct CreateInfo
+    {
+        /// The number of frames in the history. This is also the number of frames
+        /// the GPU may lag behind the CPU before query results are read.
+        Uint32 HistoryDepth = 8;
+
+        /// The maximum number of GPU scopes recorded by all contexts in one frame.
+        Uint32 MaxGpuScopesPerFrame = 32;
+
+        /// The number of CPU scopes every thread can record between two EndFrame() calls.
+        /// Rounded up to a power of two.
+        Uint32 CpuScopeBufferSize = 4096;
+
+        /// The file that the "Save trace" button writes.
+        const char* TraceFilePath = "frame_profile.json";
+    };
+
+    struct ScopeRecord
+    {
+        const char* Name = nullptr;
+
+        /// Begin and end times, in seconds. CPU times are measured from the profiler initialization,
+        /// GPU times use the GPU clock.
+        double Begin = 0;
+        double End   = 0;
+
+        /// The thread index for CPU scopes and the context id for GPU scopes.
+        Uint32 Track = 0;
+
+        /// The nesting level within the track.
+        Uint32 Depth = 0;
+    };
+
+    struct FrameRecord
+    {
+        Uint64 FrameNumber = 0;
+
+        /// CPU times of the EndFrame() calls that enclose the frame.
+        double CpuBegin = 0;
+        double CpuEnd   = 0;
+
+        std::vector<ScopeRecord> CpuScopes;
+        std::vector<ScopeRecord> GpuScopes;
+
+        /// The offset that converts GPU times of the frame to the CPU clock. It is the smallest offset
+        /// for which no GPU scope begins before the CPU recorded it.
+        double GpuToCpuTimeOffset = 0;
+    };
+
+    /// Records a CPU scope and, if the context is not null, a GPU scope with the same name.
+    class Scope
+    {
+    public:
+        Scope(FrameProfiler& Profiler, IDeviceContext* pContext, const char* Name);
+        ~Scope();
+
+        // clang-format off
+        Scope           (const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        // clang-format on
+
+    private:
+        FrameProfiler&        m_Profiler;
+        IDeviceContext* const m_pContext;
+        Uint32                m_GpuScopeId = InvalidScopeId;
+    };
+
+    FrameProfiler();
+    ~FrameProfiler();
+
+    // clang-format off
+    FrameProfiler           (const FrameProfiler&) = delete;
+    FrameProfiler& operator=(const FrameProfiler&) = delete;
+    // clang-format on
+
+    /// If pDevice is null or does not support timestamp queries, only CPU scopes are recorded.
+    void Initialize(IRenderDevice* pDevice, const CreateInfo& CI);
+
+    /// Begins a GPU scope in the context and returns its id, or InvalidScopeId if the scope is not recorded.
+    /// Different threads may record GPU scopes in different immediate contexts simultaneously.
+    /// Deferred contexts and transfer queues that do not support timestamp queries are skipped.
+    Uint32 BeginGpuScope(IDeviceContext* pContext, const char* Name);
+    void   EndGpuScope(IDeviceContext* pContext, Uint32 ScopeId);
+
+    /// Begins and ends a CPU scope on the calling thread. Scopes of one thread must be properly nested.
+    void BeginCpuScope(const char* Name);
+    void EndCpuScope();
+
+    /// Sets the name of the calling thread's track.
+    void SetThreadName(const char* Name);
+
+    /// Closes the current frame. All scopes of the frame must be ended by this time.
+    void EndFrame();
+
+    /// Returns the most recent frame with resolved GPU results, or null if there is none yet.
+    const FrameRecord* GetLastResolvedFrame() const;
+
+    /// Writes all resolved frames in the Chrome trace event format (chrome://tracing, Perfetto).
+    /// GPU times are shifted into the CPU clock domain.
+    bool WriteChromeTrace(const char* FilePath) const;
+
+    void UpdateUI();
+
+    static constexpr Uint32 InvalidScopeId = ~0u;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    double GetCpuTime() const;
+
+    struct ThreadRecorder;
+    ThreadRecorder* GetThreadRecorder();
+
+    struct FrameSlot;
+
+    void CollectCpuScopes(FrameRecord& Frame);
+    void ResolveGpuScopes(FrameSlot& Slot);
+
+    std::string GetTrackName(bool IsGpu, Uint32 Track) const;
+
+    struct GpuScope
+    {
+        RefCntAutoPtr<IQuery> pBeginQuery;
+        RefCntAutoPtr<IQuery> pEndQuery;
+
+        const char* Name      = nullptr;
+        const char* TrackName = nullptr;
+        Uint32      ContextId = 0;
+        double      CpuBegin  = 0;
+        bool        Ended     = false;
+    };
+
+    struct FrameSlot
+    {
+        std::vector<GpuScope> GpuScopes;
+        std::atomic<Uint32>   NumGpuScopes{0};
+        FrameRecord           Frame;
+        bool                  IsRecorded = false;
+    };
+
+    const Uint32 m_Id;
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    CreateInfo  m_CI;
+    std::string m_TraceFilePath;
+
+    Clock::time_point m_StartTime = Clock::now();
+
+    bool m_SupportsTransferQueueTimestamps = false;
+
+    std::vector<std::unique_ptr<FrameSlot>> m_Slots;
+    Uint32                                  m_CurrSlot    = 0;
+    Uint64                                  m_FrameNumber = 0;
+    double                                  m_FrameBegin  = 0;
+
+    mutable std::mutex                           m_RecordersMtx;
+    std::vector<std::unique_ptr<ThreadRecorder>> m_Recorders;
+
+    // Names of GPU tracks indexed by context id
+    std::vector<std::string> m_GpuTrackNames;
+
+    std::deque<FrameRecord> m_Resolved;
+
+    bool        m_ShowCpuTracks = true;
+    std::string m_StatusStr;
+};
+
+} // namespace Diligent
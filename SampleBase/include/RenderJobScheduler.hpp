@@ -0,0 +1,146 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "DeviceContext.h"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Records draw commands in parallel using deferred contexts.
+///
+/// \remarks    The items of a job are split into chunks, and every chunk is recorded into its own
+///             command list. Every worker thread owns one deferred context and initially owns a contiguous
+///             range of chunks; when a worker runs out of chunks, it steals chunks from the other workers.
+///             The first chunk is recorded by the calling thread directly into the immediate context.
+///             Command lists are executed in the chunk order, so the draw order does not depend on
+///             which thread recorded which chunk. Idle workers sleep on a condition variable.
+class RenderJobScheduler
+{
+public:
+    struct JobInfo
+    {
+        /// The number of items, e.g. instances or batches, to render.
+        Uint32 NumItems = 0;
+
+        /// The minimum number of items in one chunk.
+        Uint32 MinChunkSize = 1;
+
+        /// The number of chunks per worker thread. More chunks give better load balancing
+        /// at the cost of more command lists.
+        Uint32 ChunksPerWorker = 4;
+
+        /// Records items [FirstItem, EndItem) into the device context.
+        /// CtxIndex is 0 for the immediate context and 1 + the worker index for deferred contexts.
+        /// The function is called from multiple threads simultaneously, but never with the same
+        /// context index. Every chunk starts a new command list, so the function must bind all states.
+        std::function<void(IDeviceContext* pCtx, Uint32 CtxIndex, Uint32 FirstItem, Uint32 EndItem)> RecordChunk;
+    };
+
+    /// CPU-only work that is distributed between the same threads, e.g. simulation update.
+    struct TaskInfo
+    {
+        /// The number of items to process.
+        Uint32 NumItems = 0;
+
+        /// The minimum number of items in one chunk. Chunk boundaries are multiples of this value,
+        /// which allows processing the items in SIMD-width groups.
+        Uint32 MinChunkSize = 1;
+
+        /// The number of chunks per worker thread.
+        Uint32 ChunksPerWorker = 4;
+
+        /// Processes items [FirstItem, EndItem). The function is called from multiple threads simultaneously.
+        std::function<void(Uint32 FirstItem, Uint32 EndItem)> Process;
+    };
+
+    /// Starts NumWorkers threads. Worker i uses ppDeferredContexts[i].
+    /// ppDeferredContexts may be null if the scheduler is only used for ParallelFor().
+    RenderJobScheduler(IDeviceContext* pImmediateContext, IDeviceContext* const* ppDeferredContexts, Uint32 NumWorkers);
+
+    /// Stops the worker threads. When the scheduler is recreated with a different number of workers,
+    /// the old one must be destroyed first, as its threads still use the deferred contexts.
+    ~RenderJobScheduler();
+
+    // clang-format off
+    RenderJobScheduler(const RenderJobScheduler&)            = delete;
+    RenderJobScheduler& operator=(const RenderJobScheduler&) = delete;
+    // clang-format on
+
+    /// Records all items of the job and submits the command lists to the immediate context.
+    /// Render targets must be set and transitioned to the required states before the call.
+    void Execute(const JobInfo& Job);
+
+    /// Processes all items of the task on the worker threads and the calling thread and waits for completion.
+    void ParallelFor(const TaskInfo& Task);
+
+    Uint32 GetNumWorkers() const { return static_cast<Uint32>(m_Workers.size()); }
+
+private:
+    void   WorkerThreadFunc(Uint32 WorkerId);
+    bool   RecordNextChunk(Uint32 WorkerId);
+    Uint32 StartJob(Uint32 NumItems, Uint32 MinChunkSize, Uint32 ChunksPerWorker, const JobInfo* pJob, const TaskInfo* pTask);
+    void   WaitForWorkers();
+
+    IDeviceContext* const m_pImmediateContext;
+
+    struct WorkerInfo
+    {
+        IDeviceContext* pCtx = nullptr;
+        std::thread     Thread;
+
+        // Range of chunks owned by the worker. Other workers steal from the same end.
+        std::atomic<Uint32> NextChunk{0};
+        Uint32              EndChunk = 0;
+    };
+    std::vector<std::unique_ptr<WorkerInfo>> m_Workers;
+
+    std::mutex              m_Mtx;
+    std::condition_variable m_WorkerCV;
+    std::condition_variable m_JobCompleteCV;
+    Uint64                  m_JobId          = 0;
+    Uint32                  m_NumBusyWorkers = 0;
+    bool                    m_Stop           = false;
+
+    // Current job state
+    const JobInfo*                           m_pJob      = nullptr;
+    const TaskInfo*                          m_pTask     = nullptr;
+    Uint32                                   m_ChunkSize = 0;
+    std::vector<RefCntAutoPtr<ICommandList>> m_CmdLists;
+    std::vector<ICommandList*>               m_CmdListPtrs;
+};
+
+} // namespace Diligent
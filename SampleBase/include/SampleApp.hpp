@@ -39,18 +39,44 @@
 #include "SwapChain.h"
 #include "SampleBase.hpp"
 #include "ScreenCapture.hpp"
+#include "ScreenCaptureWriter.hpp"
 #include "Image.h"
+#include "Timer.hpp"
+#include "DurationQueryHelper.hpp"
+#include "FrameBenchmark.hpp"
 
 namespace Diligent
 {
 
 class ImGuiImplDiligent;
 
+/// Describes a sample that is run by an application that processes golden images
+/// of several samples in one process, see SampleApp::SetSampleBatch().
+struct SampleBatchItem
+{
+    /// Sample path relative to the samples root directory, e.g. "Tutorials/Tutorial01_HelloTriangle".
+    /// The sample runs in the <samples root>/<Path>/assets directory, and its golden image
+    /// is <capture path>/<Path>/<sample folder name>_<mode>.png, same as in ProcessGoldenImages scripts.
+    const char* Path = nullptr;
+
+    /// Additional command line arguments of the sample, e.g. "--show_ui 0".
+    const char* Args = nullptr;
+
+    /// Sample factory function.
+    SampleBase* (*CreateSample)() = nullptr;
+};
+
 class SampleApp : public NativeAppBase
 {
 public:
     SampleApp();
     ~SampleApp();
+
+    /// Sets the list of samples that the application runs one after another on the same
+    /// device and swap chain in golden image mode. Must be called from CreateSample(),
+    /// which should return the first sample of the batch.
+    static void SetSampleBatch(std::vector<SampleBatchItem> Items);
+
     virtual CommandLineStatus ProcessCommandLine(int argc, const char* const* argv) override final;
 
     virtual const char* GetAppTitle() const override final { return m_AppTitle.c_str(); }
@@ -76,6 +102,13 @@ public:
         return m_ExitCode;
     }
 
+    /// Returns true when the application has finished its work (e.g. the benchmark is complete).
+    /// Update, Render and Present do nothing after that, and the platform loop should exit with GetExitCode().
+    bool IsQuitRequested() const
+    {
+        return m_bQuitRequested;
+    }
+
     virtual bool IsReady() const override final
     {
         return m_pDevice && m_pSwapChain && m_NumImmediateContexts > 0;
@@ -89,9 +122,11 @@ public:
 
 protected:
     void InitializeDiligentEngine(const NativeWindow* pWindow);
+    void ModifyEngineInitInfo(const SampleBase::ModifyEngineInitInfoAttribs& Attribs);
     void InitializeSample();
     void UpdateAdaptersDialog();
     void UpdateAppSettings(bool IsInitialization);
+    void UpdateFrame(double CurrTime, double ElapsedTime);
 
     virtual void SetFullscreenMode(const DisplayModeAttribs& DisplayMode)
     {
@@ -108,6 +143,20 @@ protected:
 
     void CompareGoldenImage(const std::string& FileName, ScreenCapture::CaptureInfo& Capture);
     void SaveScreenCapture(const std::string& FileName, ScreenCapture::CaptureInfo& Capture);
+    void FinishBenchmark();
+
+    // Stops rendering and asks the platform main loop to exit. Platform implementations
+    // override this to post the native quit message.
+    virtual void RequestQuit()
+    {
+        m_bQuitRequested = true;
+    }
+
+    CommandLineStatus ProcessBatchSampleCommandLine(size_t SampleIdx, int argc, const char* const* argv);
+    void              SetBatchSampleCaptureInfo(size_t SampleIdx);
+    bool              SwitchToBatchSample(size_t SampleIdx);
+    bool              CheckBatchSampleTeardown(size_t SampleIdx);
+    void              RunSampleBatch(double CurrTime);
 
     RENDER_DEVICE_TYPE                         m_DeviceType = RENDER_DEVICE_TYPE_UNDEFINED;
     RefCntAutoPtr<IEngineFactory>              m_pEngineFactory;
@@ -120,6 +169,25 @@ protected:
 
     std::unique_ptr<SampleBase> m_TheSample;
 
+    std::vector<SampleBatchItem> m_SampleBatch;
+    struct SampleBatchInfo
+    {
+        // Samples that have not run yet. The sample that is currently running is owned by m_TheSample.
+        std::vector<std::unique_ptr<SampleBase>> Samples;
+        std::vector<int>                         ExitCodes;
+
+        std::string SamplesRoot;
+        std::string GoldenImgRoot;
+        std::string ModeName;
+        std::string AppTitleSuffix;
+        size_t      CurrentSample = 0;
+        bool        IsRunning     = false;
+
+        // Reference counts of the engine objects before the first sample is initialized.
+        // Every sample must release all its references when it is destroyed.
+        std::vector<ReferenceCounterValueType> BaselineRefCounts;
+    } m_BatchInfo;
+
     int          m_InitialWindowWidth  = 0;
     int          m_InitialWindowHeight = 0;
     int          m_ValidationLevel     = -1;
@@ -143,25 +211,43 @@ protected:
 
     struct ScreenCaptureInfo
     {
-        bool              AllowCapture = false;
+        bool              AllowCapture     = false;
         std::string       Directory;
-        std::string       FileName        = "frame";
-        double            CaptureFPS      = 30;
-        double            LastCaptureTime = -1e+10;
-        Uint32            FramesToCapture = 0;
-        Uint32            CurrentFrame    = 0;
-        IMAGE_FILE_FORMAT FileFormat      = IMAGE_FILE_FORMAT_PNG;
-        int               JpegQuality     = 95;
-        bool              KeepAlpha       = false;
+        std::string       FileName         = "frame";
+        double            CaptureFPS       = 30;
+        double            LastCaptureTime  = -1e+10;
+        Uint32            FramesToCapture  = 0;
+        Uint32            CurrentFrame     = 0;
+        IMAGE_FILE_FORMAT FileFormat       = IMAGE_FILE_FORMAT_PNG;
+        int               JpegQuality      = 95;
+        bool              KeepAlpha        = false;
+        Uint32            NumWriterThreads = 0;
+        Uint32            MaxPendingImages = 0;
 
     } m_ScreenCaptureInfo;
-    std::unique_ptr<ScreenCapture> m_pScreenCapture;
+    std::unique_ptr<ScreenCapture>       m_pScreenCapture;
+    std::unique_ptr<ScreenCaptureWriter> m_pScreenCaptureWriter;
 
     std::unique_ptr<ImGuiImplDiligent> m_pImGui;
 
+    struct BenchmarkInfo
+    {
+        Uint32      NumFrames       = 0;
+        Uint32      NumWarmupFrames = 30;
+        double      FPS             = 60;
+        std::string ReportPath      = "benchmark.json";
+        double      FrameStartTime  = 0;
+        double      PhaseStartTime  = 0;
+    } m_BenchmarkInfo;
+    std::unique_ptr<FrameBenchmark>      m_pBenchmark;
+    std::unique_ptr<DurationQueryHelper> m_pBenchmarkGPUTimer;
+    Timer                                m_BenchmarkTimer;
+
     GoldenImageMode m_GoldenImgMode           = GoldenImageMode::None;
     int             m_GoldenImgPixelTolerance = 0;
+    std::string     m_GoldenImgDiffDirectory;
     int             m_ExitCode                = 0;
+    bool            m_bQuitRequested          = false;
 };
 
 } // namespace Diligent
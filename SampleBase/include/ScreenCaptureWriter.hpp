@@ -0,0 +1,93 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+#include "RefCntAutoPtr.hpp"
+#include "ThreadPool.hpp"
+#include "Image.h"
+
+namespace Diligent
+{
+
+/// Encodes screen captures and writes them to disk on a pool of worker threads.
+///
+/// \remarks    The writer owns a copy of the pixel data, so the staging texture the image
+///             was read from can be recycled as soon as Enqueue() returns. The number of images
+///             that are being processed is limited; when the limit is reached, Enqueue() blocks
+///             until one of the workers finishes.
+class ScreenCaptureWriter
+{
+public:
+    struct ImageInfo
+    {
+        std::string       FileName;
+        Uint32            Width       = 0;
+        Uint32            Height      = 0;
+        TEXTURE_FORMAT    TexFormat   = TEX_FORMAT_UNKNOWN;
+        bool              KeepAlpha   = false;
+        bool              FlipY       = false;
+        IMAGE_FILE_FORMAT FileFormat  = IMAGE_FILE_FORMAT_PNG;
+        int               JpegQuality = 95;
+    };
+
+    ScreenCaptureWriter(Uint32 NumThreads, Uint32 MaxPendingImages);
+    ~ScreenCaptureWriter();
+
+    // clang-format off
+    ScreenCaptureWriter(const ScreenCaptureWriter&)            = delete;
+    ScreenCaptureWriter& operator=(const ScreenCaptureWriter&) = delete;
+    // clang-format on
+
+    /// Copies the image data and schedules it for encoding. Blocks if the queue is full.
+    void Enqueue(const ImageInfo& Info, const void* pData, Uint32 Stride);
+
+    /// Waits until all scheduled images are written.
+    void WaitForIdle();
+
+    /// Returns the first error code reported by the workers, or 0 if all files were written successfully.
+    /// The codes match the ones used by SampleApp::SaveScreenCapture.
+    int GetErrorCode() const { return m_ErrorCode.load(); }
+
+private:
+    void WriteImage(const ImageInfo& Info, const std::vector<Uint8>& Pixels, Uint32 Stride);
+
+    RefCntAutoPtr<IThreadPool> m_pThreadPool;
+
+    const Uint32            m_MaxPendingImages;
+    Uint32                  m_NumPendingImages = 0;
+    std::mutex              m_PendingImagesMtx;
+    std::condition_variable m_PendingImagesCV;
+
+    std::atomic<int> m_ErrorCode{0};
+};
+
+} // namespace Diligent
@@ -0,0 +1,228 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Minimal portable 4-wide float vector that maps to SSE2 on x86/x64, NEON on ARM,
+/// and falls back to scalar code on other platforms (e.g. WebAssembly).
+
+#include <cmath>
+
+#include "BasicTypes.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define DILIGENT_SIMD_SSE2 1
+#    include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#    define DILIGENT_SIMD_NEON 1
+#    include <arm_neon.h>
+#endif
+
+namespace Diligent
+{
+
+/// Per-lane mask produced by SimdFloat4 comparisons.
+struct SimdMask4
+{
+#if DILIGENT_SIMD_SSE2
+    __m128 m;
+#elif DILIGENT_SIMD_NEON
+    uint32x4_t m;
+#else
+    bool m[4];
+#endif
+
+    /// Returns a 4-bit mask where bit i is set if lane i is true.
+    Uint32 GetBits() const
+    {
+#if DILIGENT_SIMD_SSE2
+        return static_cast<Uint32>(_mm_movemask_ps(m));
+#elif DILIGENT_SIMD_NEON
+        return (vgetq_lane_u32(m, 0) & 1u) |
+            (vgetq_lane_u32(m, 1) & 2u) |
+            (vgetq_lane_u32(m, 2) & 4u) |
+            (vgetq_lane_u32(m, 3) & 8u);
+#else
+        return (m[0] ? 1u : 0u) | (m[1] ? 2u : 0u) | (m[2] ? 4u : 0u) | (m[3] ? 8u : 0u);
+#endif
+    }
+
+    friend SimdMask4 operator|(const SimdMask4& a, const SimdMask4& b)
+    {
+#if DILIGENT_SIMD_SSE2
+        return {_mm_or_ps(a.m, b.m)};
+#elif DILIGENT_SIMD_NEON
+        return {vorrq_u32(a.m, b.m)};
+#else
+        return {{a.m[0] || b.m[0], a.m[1] || b.m[1], a.m[2] || b.m[2], a.m[3] || b.m[3]}};
+#endif
+    }
+};
+
+/// Four floats processed in one SIMD register.
+struct SimdFloat4
+{
+    static constexpr Uint32 Width = 4;
+
+#if DILIGENT_SIMD_SSE2
+    __m128 m;
+#elif DILIGENT_SIMD_NEON
+    float32x4_t m;
+#else
+    float m[4];
+#endif
+
+    /// Loads four floats. The pointer does not need to be aligned.
+    static SimdFloat4 Load(const float* p)
+    {
+#if DILIGENT_SIMD_SSE2
+        return {_mm_loadu_ps(p)};
+#elif DILIGENT_SIMD_NEON
+        return {vld1q_f32(p)};
+#else
+        return {{p[0], p[1], p[2], p[3]}};
+#endif
+    }
+
+    /// Sets all lanes to the same value.
+    static SimdFloat4 Set(float f)
+    {
+#if DILIGENT_SIMD_SSE2
+        return {_mm_set1_ps(f)};
+#elif DILIGENT_SIMD_NEON
+        return {vdupq_n_f32(f)};
+#else
+        return {{f, f, f, f}};
+#endif
+    }
+
+    /// Stores four floats. The pointer does not need to be aligned.
+    void Store(float* p) const
+    {
+#if DILIGENT_SIMD_SSE2
+        _mm_storeu_ps(p, m);
+#elif DILIGENT_SIMD_NEON
+        vst1q_f32(p, m);
+#else
+        p[0] = m[0];
+        p[1] = m[1];
+        p[2] = m[2];
+        p[3] = m[3];
+#endif
+    }
+
+    friend SimdFloat4 operator+(const SimdFloat4& a, const SimdFloat4& b)
+    {
+#if DILIGENT_SIMD_SSE2
+        return {_mm_add_ps(a.m, b.m)};
+#elif DILIGENT_SIMD_NEON
+        return {vaddq_f32(a.m, b.m)};
+#else
+        return {{a.m[0] + b.m[0], a.m[1] + b.m[1], a.m[2] + b.m[2], a.m[3] + b.m[3]}};
+#endif
+    }
+
+    friend SimdFloat4 operator-(const SimdFloat4& a, const SimdFloat4& b)
+    {
+#if DILIGENT_SIMD_SSE2
+        return {_mm_sub_ps(a.m, b.m)};
+#elif DILIGENT_SIMD_NEON
+        return {vsubq_f32(a.m, b.m)};
+#else
+        return {{a.m[0] - b.m[0], a.m[1] - b.m[1], a.m[2] - b.m[2], a.m[3] - b.m[3]}};
+#endif
+    }
+
+    friend SimdFloat4 operator*(const SimdFloat4& a, const SimdFloat4& b)
+    {
+#if DILIGENT_SIMD_SSE2
+        return {_mm_mul_ps(a.m, b.m)};
+#elif DILIGENT_SIMD_NEON
+        return {vmulq_f32(a.m, b.m)};
+#else
+        return {{a.m[0] * b.m[0], a.m[1] * b.m[1], a.m[2] * b.m[2], a.m[3] * b.m[3]}};
+#endif
+    }
+
+    friend SimdFloat4 Min(const SimdFloat4& a, const SimdFloat4& b)
+    {
+#if DILIGENT_SIMD_SSE2
+        return {_mm_min_ps(a.m, b.m)};
+#elif DILIGENT_SIMD_NEON
+        return {vminq_f32(a.m, b.m)};
+#else
+        return {{std::fmin(a.m[0], b.m[0]), std::fmin(a.m[1], b.m[1]), std::fmin(a.m[2], b.m[2]), std::fmin(a.m[3], b.m[3])}};
+#endif
+    }
+
+    friend SimdFloat4 Max(const SimdFloat4& a, const SimdFloat4& b)
+    {
+#if DILIGENT_SIMD_SSE2
+        return {_mm_max_ps(a.m, b.m)};
+#elif DILIGENT_SIMD_NEON
+        return {vmaxq_f32(a.m, b.m)};
+#else
+        return {{std::fmax(a.m[0], b.m[0]), std::fmax(a.m[1], b.m[1]), std::fmax(a.m[2], b.m[2]), std::fmax(a.m[3], b.m[3])}};
+#endif
+    }
+
+    friend SimdFloat4 Abs(const SimdFloat4& a)
+    {
+#if DILIGENT_SIMD_SSE2
+        return {_mm_andnot_ps(_mm_set1_ps(-0.f), a.m)};
+#elif DILIGENT_SIMD_NEON
+        return {vabsq_f32(a.m)};
+#else
+        return {{std::fabs(a.m[0]), std::fabs(a.m[1]), std::fabs(a.m[2]), std::fabs(a.m[3])}};
+#endif
+    }
+
+    friend SimdMask4 operator>(const SimdFloat4& a, const SimdFloat4& b)
+    {
+#if DILIGENT_SIMD_SSE2
+        return {_mm_cmpgt_ps(a.m, b.m)};
+#elif DILIGENT_SIMD_NEON
+        return {vcgtq_f32(a.m, b.m)};
+#else
+        return {{a.m[0] > b.m[0], a.m[1] > b.m[1], a.m[2] > b.m[2], a.m[3] > b.m[3]}};
+#endif
+    }
+
+    /// Returns a where the mask is set and b otherwise.
+    friend SimdFloat4 Select(const SimdMask4& Mask, const SimdFloat4& a, const SimdFloat4& b)
+    {
+#if DILIGENT_SIMD_SSE2
+        return {_mm_or_ps(_mm_and_ps(Mask.m, a.m), _mm_andnot_ps(Mask.m, b.m))};
+#elif DILIGENT_SIMD_NEON
+        return {vbslq_f32(Mask.m, a.m, b.m)};
+#else
+        return {{Mask.m[0] ? a.m[0] : b.m[0], Mask.m[1] ? a.m[1] : b.m[1], Mask.m[2] ? a.m[2] : b.m[2], Mask.m[3] ? a.m[3] : b.m[3]}};
+#endif
+    }
+};
+
+} // namespace Diligent
@@ -0,0 +1,95 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "BasicMath.hpp"
+#include "SimdFloat4.hpp"
+
+namespace Diligent
+{
+
+/// Position, velocity and rotation of 2D sprites that move inside the [-Bound, +Bound] square,
+/// stored as structure of arrays.
+///
+/// \remarks    Every array is padded to a multiple of SimdFloat4::Width so that the update kernel
+///             never needs a scalar tail. Different threads may update disjoint ranges simultaneously.
+class SpriteMotionSoA
+{
+public:
+    static constexpr Uint32 SimdWidth = SimdFloat4::Width;
+
+    struct UpdateAttribs
+    {
+        /// Elapsed time, in seconds.
+        float ElapsedTime = 0;
+
+        /// Sprites bounce off the lines x = +-Bound and y = +-Bound.
+        float Bound = 0.95f;
+
+        /// When a sprite bounces, it gets a new random rotation speed in this range.
+        float MinRotSpeed = -PI_F * 0.5f;
+        float MaxRotSpeed = +PI_F * 0.5f;
+
+        /// Seed that makes random rotation speeds differ between frames. The result for
+        /// a given seed does not depend on how the sprites are split between threads.
+        Uint32 Seed = 0;
+    };
+
+    void Resize(Uint32 NumSprites);
+
+    Uint32 GetNumSprites() const { return m_NumSprites; }
+
+    void SetSprite(Uint32 Idx, const float2& Pos, const float2& MoveDir, float Angle, float RotSpeed)
+    {
+        m_PosX[Idx]     = Pos.x;
+        m_PosY[Idx]     = Pos.y;
+        m_MoveX[Idx]    = MoveDir.x;
+        m_MoveY[Idx]    = MoveDir.y;
+        m_Angle[Idx]    = Angle;
+        m_RotSpeed[Idx] = RotSpeed;
+    }
+
+    float2 GetPos(Uint32 Idx) const { return float2{m_PosX[Idx], m_PosY[Idx]}; }
+    float  GetAngle(Uint32 Idx) const { return m_Angle[Idx]; }
+
+    /// Updates sprites [FirstSprite, EndSprite). FirstSprite must be a multiple of SimdWidth.
+    void Update(Uint32 FirstSprite, Uint32 EndSprite, const UpdateAttribs& Attribs);
+
+private:
+    Uint32 m_NumSprites = 0;
+
+    std::vector<float> m_PosX;
+    std::vector<float> m_PosY;
+    std::vector<float> m_MoveX;
+    std::vector<float> m_MoveY;
+    std::vector<float> m_Angle;
+    std::vector<float> m_RotSpeed;
+};
+
+} // namespace Diligent
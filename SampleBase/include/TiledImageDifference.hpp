@@ -0,0 +1,140 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+struct IThreadPool;
+
+/// Tiled image difference attributes.
+struct TiledImageDifferenceAttribs
+{
+    /// Image width.
+    Uint32 Width = 0;
+
+    /// Image height.
+    Uint32 Height = 0;
+
+    /// A pointer to the first 8-bit image data.
+    const void* pImage1 = nullptr;
+
+    /// Number of channels in the first image.
+    Uint32 NumChannels1 = 0;
+
+    /// Row stride of the first image data, in bytes.
+    Uint32 Stride1 = 0;
+
+    /// A pointer to the second 8-bit image data.
+    const void* pImage2 = nullptr;
+
+    /// Number of channels in the second image.
+    Uint32 NumChannels2 = 0;
+
+    /// Row stride of the second image data, in bytes.
+    Uint32 Stride2 = 0;
+
+    /// Difference threshold.
+    Uint32 Threshold = 0;
+
+    /// Tile size, in pixels. Tiles are processed in parallel.
+    Uint32 TileSize = 64;
+
+    /// Thread pool to process the tiles. If null, the tiles are processed on the calling thread.
+    IThreadPool* pThreadPool = nullptr;
+
+    /// The number of tasks to enqueue into the thread pool, typically the number of pool threads.
+    Uint32 NumWorkers = 0;
+
+    /// An optional pointer to the RGBA8 heat-map image that receives the per-pixel difference.
+    /// Identical pixels are black, pixels that differ within the threshold are shaded
+    /// from blue to yellow, and pixels above the threshold are red.
+    void* pDiffImage = nullptr;
+
+    /// Row stride of the heat-map image, in bytes.
+    Uint32 DiffStride = 0;
+};
+
+/// Difference statistics of a single image tile.
+struct ImageTileDiffInfo
+{
+    Uint32 X      = 0;
+    Uint32 Y      = 0;
+    Uint32 Width  = 0;
+    Uint32 Height = 0;
+
+    /// The number of pixels that differ.
+    Uint32 NumDiffPixels = 0;
+
+    /// The number of pixels that differ above the threshold.
+    Uint32 NumDiffPixelsAboveThreshold = 0;
+
+    /// The maximum difference between any two pixels in the tile.
+    Uint32 MaxDiff = 0;
+
+    /// Sum of squared channel differences.
+    double SquaredError = 0;
+
+    /// Mean structural similarity index of the tile luminance, computed over 8x8 blocks.
+    double SSIM = 1;
+};
+
+/// Tiled image difference information.
+struct TiledImageDiffInfo
+{
+    /// The number of pixels that differ.
+    Uint32 NumDiffPixels = 0;
+
+    /// The number of pixels that differ above the threshold.
+    Uint32 NumDiffPixelsAboveThreshold = 0;
+
+    /// The maximum difference between any two pixels.
+    Uint32 MaxDiff = 0;
+
+    /// Peak signal-to-noise ratio, in dB. Identical images have infinite PSNR.
+    double PSNR = 0;
+
+    /// Mean structural similarity index over all tiles.
+    double SSIM = 1;
+
+    /// Per-tile statistics, in row-major order.
+    std::vector<ImageTileDiffInfo> Tiles;
+};
+
+/// Computes the difference between two images by splitting them into tiles
+/// and processing the tiles in parallel.
+///
+/// \remarks    The difference between two pixels is computed as the maximum absolute difference
+///             between the channels present in both images, which matches ComputeImageDifference.
+///             The calling thread processes tiles along with the thread pool workers.
+void ComputeTiledImageDifference(const TiledImageDifferenceAttribs& Attribs, TiledImageDiffInfo& DiffInfo);
+
+} // namespace Diligent
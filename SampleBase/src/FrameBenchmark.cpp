@@ -0,0 +1,207 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "FrameBenchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <sstream>
+#include <iomanip>
+
+#include "Errors.hpp"
+#include "FileWrapper.hpp"
+
+namespace Diligent
+{
+
+FrameBenchmark::FrameBenchmark(Uint32 NumWarmupFrames, Uint32 NumFrames, double TimeStep) :
+    m_NumWarmupFrames{NumWarmupFrames},
+    m_NumFrames{NumFrames},
+    m_TimeStep{TimeStep}
+{
+    for (std::vector<double>& Samples : m_Samples)
+        Samples.reserve(NumFrames);
+}
+
+const char* FrameBenchmark::GetTimingName(TIMING Timing)
+{
+    switch (Timing)
+    {
+        // clang-format off
+        case TIMING_UPDATE:  return "update_cpu";
+        case TIMING_RENDER:  return "render_cpu";
+        case TIMING_PRESENT: return "present_cpu";
+        case TIMING_FRAME:   return "frame_cpu";
+        case TIMING_GPU:     return "frame_gpu";
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected timing");
+            return "unknown";
+    }
+}
+
+void FrameBenchmark::RecordCPUTime(TIMING Timing, double Seconds)
+{
+    VERIFY_EXPR(Timing < TIMING_COUNT && Timing != TIMING_GPU);
+    if (IsWarmingUp() || IsComplete())
+        return;
+
+    m_Samples[Timing].push_back(Seconds);
+}
+
+void FrameBenchmark::RecordGPUTime(double Seconds)
+{
+    if (IsWarmingUp() || IsComplete())
+        return;
+
+    m_Samples[TIMING_GPU].push_back(Seconds);
+}
+
+void FrameBenchmark::EndFrame()
+{
+    ++m_FrameIndex;
+}
+
+FrameBenchmark::Statistics FrameBenchmark::ComputeStatistics(TIMING Timing) const
+{
+    Statistics Stats;
+
+    std::vector<double> Sorted = m_Samples[Timing];
+    if (Sorted.empty())
+        return Stats;
+
+    std::sort(Sorted.begin(), Sorted.end());
+
+    // Nearest-rank percentile
+    auto Percentile = [&Sorted](double P) {
+        size_t Rank = static_cast<size_t>(std::ceil(P / 100.0 * static_cast<double>(Sorted.size())));
+        return Sorted[std::min(std::max(Rank, size_t{1}), Sorted.size()) - 1];
+    };
+
+    Stats.NumSamples = Sorted.size();
+    Stats.Mean       = std::accumulate(Sorted.begin(), Sorted.end(), 0.0) / static_cast<double>(Sorted.size());
+    Stats.Min        = Sorted.front();
+    Stats.P50        = Percentile(50);
+    Stats.P95        = Percentile(95);
+    Stats.P99        = Percentile(99);
+    Stats.Max        = Sorted.back();
+
+    return Stats;
+}
+
+std::string FrameBenchmark::FormatJSON(const ReportInfo& Info) const
+{
+    auto Quote = [](const char* Str) {
+        std::string Res{"\""};
+        for (const char* c = Str != nullptr ? Str : ""; *c != '\0'; ++c)
+        {
+            if (*c == '"' || *c == '\\')
+                Res.push_back('\\');
+            Res.push_back(*c);
+        }
+        Res.push_back('"');
+        return Res;
+    };
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(4);
+    ss << "{\n"
+       << "  \"sample\": " << Quote(Info.SampleName) << ",\n"
+       << "  \"device\": " << Quote(Info.DeviceType) << ",\n"
+       << "  \"adapter\": " << Quote(Info.AdapterName) << ",\n"
+       << "  \"width\": " << Info.Width << ",\n"
+       << "  \"height\": " << Info.Height << ",\n"
+       << "  \"warmup_frames\": " << m_NumWarmupFrames << ",\n"
+       << "  \"frames\": " << m_NumFrames << ",\n"
+       << "  \"time_step_ms\": " << m_TimeStep * 1000.0 << ",\n"
+       << "  \"timings_ms\": {\n";
+
+    for (Uint32 t = 0; t < TIMING_COUNT; ++t)
+    {
+        const TIMING     Timing = static_cast<TIMING>(t);
+        const Statistics Stats  = ComputeStatistics(Timing);
+        ss << "    \"" << GetTimingName(Timing) << "\": {"
+           << "\"samples\": " << Stats.NumSamples
+           << ", \"mean\": " << Stats.Mean * 1000.0
+           << ", \"min\": " << Stats.Min * 1000.0
+           << ", \"p50\": " << Stats.P50 * 1000.0
+           << ", \"p95\": " << Stats.P95 * 1000.0
+           << ", \"p99\": " << Stats.P99 * 1000.0
+           << ", \"max\": " << Stats.Max * 1000.0
+           << '}' << (t + 1 < TIMING_COUNT ? "," : "") << '\n';
+    }
+    ss << "  }\n"
+       << "}\n";
+
+    return ss.str();
+}
+
+std::string FrameBenchmark::FormatCSV(const ReportInfo& Info) const
+{
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(4);
+    ss << "sample,device,timing,samples,mean_ms,min_ms,p50_ms,p95_ms,p99_ms,max_ms\n";
+    for (Uint32 t = 0; t < TIMING_COUNT; ++t)
+    {
+        const TIMING     Timing = static_cast<TIMING>(t);
+        const Statistics Stats  = ComputeStatistics(Timing);
+        ss << (Info.SampleName != nullptr ? Info.SampleName : "") << ','
+           << (Info.DeviceType != nullptr ? Info.DeviceType : "") << ','
+           << GetTimingName(Timing) << ','
+           << Stats.NumSamples << ','
+           << Stats.Mean * 1000.0 << ','
+           << Stats.Min * 1000.0 << ','
+           << Stats.P50 * 1000.0 << ','
+           << Stats.P95 * 1000.0 << ','
+           << Stats.P99 * 1000.0 << ','
+           << Stats.Max * 1000.0 << '\n';
+    }
+    return ss.str();
+}
+
+bool FrameBenchmark::WriteReport(const std::string& FilePath, const ReportInfo& Info) const
+{
+    const bool IsCSV = FilePath.size() >= 4 && FilePath.compare(FilePath.size() - 4, 4, ".csv") == 0;
+
+    const std::string Report = IsCSV ? FormatCSV(Info) : FormatJSON(Info);
+
+    FileWrapper pFile{FilePath.c_str(), EFileAccessMode::Overwrite};
+    if (!pFile)
+    {
+        LOG_ERROR_MESSAGE("Failed to create benchmark report file '", FilePath, "'.");
+        return false;
+    }
+
+    const bool Res = pFile->Write(Report.data(), Report.size());
+    pFile.Close();
+    if (!Res)
+        LOG_ERROR_MESSAGE("Failed to write benchmark report file '", FilePath, "'.");
+
+    return Res;
+}
+
+} // namespace Diligent
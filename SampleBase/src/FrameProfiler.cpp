@@ -0,0 +1,739 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "FrameProfiler.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <set>
+#include <sstream>
+
+#include "Errors.hpp"
+#include "FileWrapper.hpp"
+#include "imgui.h"
+
+namespace Diligent
+{
+
+namespace
+{
+
+std::atomic<Uint32> g_NextProfilerId{0};
+
+Uint32 RoundUpToPowerOfTwo(Uint32 Value)
+{
+    Uint32 Res = 1;
+    while (Res < Value)
+        Res <<= 1;
+    return Res;
+}
+
+// Assigns nesting levels to the scopes of every track from the containment of their intervals.
+void ComputeScopeDepths(std::vector<FrameProfiler::ScopeRecord>& Scopes)
+{
+    std::sort(Scopes.begin(), Scopes.end(),
+              [](const FrameProfiler::ScopeRecord& lhs, const FrameProfiler::ScopeRecord& rhs) {
+                  if (lhs.Track != rhs.Track)
+                      return lhs.Track < rhs.Track;
+                  if (lhs.Begin != rhs.Begin)
+                      return lhs.Begin < rhs.Begin;
+                  // The enclosing scope goes first
+                  return lhs.End > rhs.End;
+              });
+
+    std::vector<double> OpenScopeEnds;
+    for (size_t i = 0; i < Scopes.size(); ++i)
+    {
+        FrameProfiler::ScopeRecord& Scope = Scopes[i];
+        if (i == 0 || Scopes[i - 1].Track != Scope.Track)
+            OpenScopeEnds.clear();
+
+        while (!OpenScopeEnds.empty() && OpenScopeEnds.back() <= Scope.Begin)
+            OpenScopeEnds.pop_back();
+
+        Scope.Depth = static_cast<Uint32>(OpenScopeEnds.size());
+        OpenScopeEnds.push_back(Scope.End);
+    }
+}
+
+std::string TimeToStr(double dt)
+{
+    std::stringstream ss;
+    ss.precision(2);
+    ss.flags(std::ios_base::fixed);
+    if (dt <= 0.0)
+        ss << "-";
+    else if (dt > 1.0e-1)
+        ss << dt << " s";
+    else if (dt > 1.0e-4)
+        ss << (dt * 1.0e+3) << " ms"; // milliseconds
+    else
+        ss << (dt * 1.0e+6) << " mus"; // microseconds
+    return ss.str();
+}
+
+} // namespace
+
+// Records the CPU scopes of a single thread.
+// The owning thread is the only producer and EndFrame() is the only consumer of the event ring,
+// so the two sides only synchronize through the published and consumed event counters.
+struct FrameProfiler::ThreadRecorder
+{
+    struct Event
+    {
+        const char* Name  = nullptr;
+        double      Begin = 0;
+        double      End   = 0;
+        Uint32      Depth = 0;
+    };
+
+    struct OpenScope
+    {
+        const char* Name;
+        double      Begin;
+    };
+
+    ThreadRecorder(Uint32 _Index, Uint32 BufferSize) :
+        Index{_Index},
+        Events(BufferSize),
+        Mask{BufferSize - 1}
+    {
+        VERIFY_EXPR((BufferSize & Mask) == 0);
+        OpenScopes.reserve(32);
+    }
+
+    void Push(const Event& Evt)
+    {
+        const Uint64 Published = NumPublished.load(std::memory_order_relaxed);
+        if (Published - NumConsumed.load(std::memory_order_acquire) >= Events.size())
+        {
+            // The ring is full: drop the event rather than wait for the consumer
+            NumDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        Events[Published & Mask] = Evt;
+        NumPublished.store(Published + 1, std::memory_order_release);
+    }
+
+    const Uint32 Index;
+
+    // Protected by FrameProfiler::m_RecordersMtx
+    std::string Name;
+
+    std::vector<Event> Events;
+    const Uint64       Mask;
+
+    std::atomic<Uint64> NumPublished{0};
+    std::atomic<Uint64> NumConsumed{0};
+    std::atomic<Uint32> NumDropped{0};
+
+    // Only accessed by the owning thread
+    std::vector<OpenScope> OpenScopes;
+};
+
+FrameProfiler::Scope::Scope(FrameProfiler& Profiler, IDeviceContext* pContext, const char* Name) :
+    m_Profiler{Profiler},
+    m_pContext{pContext}
+{
+    m_Profiler.BeginCpuScope(Name);
+    if (m_pContext != nullptr)
+        m_GpuScopeId = m_Profiler.BeginGpuScope(m_pContext, Name);
+}
+
+FrameProfiler::Scope::~Scope()
+{
+    if (m_pContext != nullptr)
+        m_Profiler.EndGpuScope(m_pContext, m_GpuScopeId);
+    m_Profiler.EndCpuScope();
+}
+
+FrameProfiler::FrameProfiler() :
+    m_Id{g_NextProfilerId.fetch_add(1)}
+{
+}
+
+FrameProfiler::~FrameProfiler()
+{
+}
+
+void FrameProfiler::Initialize(IRenderDevice* pDevice, const CreateInfo& CI)
+{
+    VERIFY(CI.HistoryDepth >= 2, "History depth must be at least 2");
+
+    m_CI                    = CI;
+    m_CI.HistoryDepth       = std::max(CI.HistoryDepth, 2u);
+    m_CI.CpuScopeBufferSize = RoundUpToPowerOfTwo(std::max(CI.CpuScopeBufferSize, 16u));
+    m_TraceFilePath         = CI.TraceFilePath != nullptr ? CI.TraceFilePath : "";
+    m_CI.TraceFilePath      = m_TraceFilePath.c_str();
+
+    m_pDevice = pDevice != nullptr && pDevice->GetDeviceInfo().Features.TimestampQueries ? pDevice : nullptr;
+
+    m_SupportsTransferQueueTimestamps = m_pDevice && m_pDevice->GetDeviceInfo().Features.TransferQueueTimestampQueries;
+
+    QueryDesc queryDesc;
+    queryDesc.Name = "Profiler timestamp query";
+    queryDesc.Type = QUERY_TYPE_TIMESTAMP;
+
+    m_Slots.clear();
+    m_Resolved.clear();
+    m_CurrSlot    = 0;
+    m_FrameNumber = 0;
+    m_FrameBegin  = GetCpuTime();
+    for (Uint32 i = 0; i < m_CI.HistoryDepth; ++i)
+    {
+        std::unique_ptr<FrameSlot> pSlot = std::make_unique<FrameSlot>();
+        if (m_pDevice)
+        {
+            pSlot->GpuScopes.resize(m_CI.MaxGpuScopesPerFrame);
+            for (GpuScope& Scope : pSlot->GpuScopes)
+            {
+                m_pDevice->CreateQuery(queryDesc, &Scope.pBeginQuery);
+                m_pDevice->CreateQuery(queryDesc, &Scope.pEndQuery);
+                VERIFY_EXPR(Scope.pBeginQuery && Scope.pEndQuery);
+            }
+        }
+        m_Slots.emplace_back(std::move(pSlot));
+    }
+}
+
+double FrameProfiler::GetCpuTime() const
+{
+    return std::chrono::duration_cast<std::chrono::duration<double>>(Clock::now() - m_StartTime).count();
+}
+
+Uint32 FrameProfiler::BeginGpuScope(IDeviceContext* pContext, const char* Name)
+{
+    if (!m_pDevice || pContext == nullptr)
+        return InvalidScopeId;
+
+    const DeviceContextDesc& CtxDesc = pContext->GetDesc();
+    if (CtxDesc.IsDeferred)
+        return InvalidScopeId;
+    if ((CtxDesc.QueueType & COMMAND_QUEUE_TYPE_PRIMARY_MASK) <= COMMAND_QUEUE_TYPE_TRANSFER && !m_SupportsTransferQueueTimestamps)
+        return InvalidScopeId;
+
+    FrameSlot&   Slot    = *m_Slots[m_CurrSlot];
+    const Uint32 ScopeId = Slot.NumGpuScopes.fetch_add(1);
+    if (ScopeId >= Slot.GpuScopes.size())
+        return InvalidScopeId;
+
+    GpuScope& Scope = Slot.GpuScopes[ScopeId];
+    Scope.Name      = Name;
+    Scope.TrackName = CtxDesc.Name;
+    Scope.ContextId = CtxDesc.ContextId;
+    Scope.Ended     = false;
+    Scope.CpuBegin  = GetCpuTime();
+    pContext->EndQuery(Scope.pBeginQuery);
+
+    return ScopeId;
+}
+
+void FrameProfiler::EndGpuScope(IDeviceContext* pContext, Uint32 ScopeId)
+{
+    if (ScopeId == InvalidScopeId)
+        return;
+
+    GpuScope& Scope = m_Slots[m_CurrSlot]->GpuScopes[ScopeId];
+    VERIFY(pContext->GetDesc().ContextId == Scope.ContextId, "GPU scope '", Scope.Name, "' must be ended in the context it was begun in");
+    pContext->EndQuery(Scope.pEndQuery);
+    Scope.Ended = true;
+}
+
+FrameProfiler::ThreadRecorder* FrameProfiler::GetThreadRecorder()
+{
+    struct CachedRecorder
+    {
+        Uint32          ProfilerId;
+        ThreadRecorder* pRecorder;
+    };
+    // Profiler ids are never reused, so entries of destroyed profilers are never matched
+    thread_local std::vector<CachedRecorder> CachedRecorders;
+    for (const CachedRecorder& Cached : CachedRecorders)
+    {
+        if (Cached.ProfilerId == m_Id)
+            return Cached.pRecorder;
+    }
+
+    ThreadRecorder* pRecorder = nullptr;
+    {
+        std::lock_guard<std::mutex> Lock{m_RecordersMtx};
+        m_Recorders.emplace_back(std::make_unique<ThreadRecorder>(static_cast<Uint32>(m_Recorders.size()), m_CI.CpuScopeBufferSize));
+        pRecorder = m_Recorders.back().get();
+    }
+    CachedRecorders.push_back({m_Id, pRecorder});
+    return pRecorder;
+}
+
+void FrameProfiler::BeginCpuScope(const char* Name)
+{
+    ThreadRecorder* pRecorder = GetThreadRecorder();
+    pRecorder->OpenScopes.push_back({Name, GetCpuTime()});
+}
+
+void FrameProfiler::EndCpuScope()
+{
+    ThreadRecorder* pRecorder = GetThreadRecorder();
+    if (pRecorder->OpenScopes.empty())
+    {
+        UNEXPECTED("There is no open CPU scope on this thread");
+        return;
+    }
+
+    const ThreadRecorder::OpenScope& Open = pRecorder->OpenScopes.back();
+
+    ThreadRecorder::Event Evt;
+    Evt.Name  = Open.Name;
+    Evt.Begin = Open.Begin;
+    Evt.End   = GetCpuTime();
+    Evt.Depth = static_cast<Uint32>(pRecorder->OpenScopes.size() - 1);
+    pRecorder->OpenScopes.pop_back();
+
+    pRecorder->Push(Evt);
+}
+
+void FrameProfiler::SetThreadName(const char* Name)
+{
+    ThreadRecorder* pRecorder = GetThreadRecorder();
+
+    std::lock_guard<std::mutex> Lock{m_RecordersMtx};
+    pRecorder->Name = Name != nullptr ? Name : "";
+}
+
+void FrameProfiler::CollectCpuScopes(FrameRecord& Frame)
+{
+    std::lock_guard<std::mutex> Lock{m_RecordersMtx};
+    for (const std::unique_ptr<ThreadRecorder>& pRecorder : m_Recorders)
+    {
+        const Uint64 Published = pRecorder->NumPublished.load(std::memory_order_acquire);
+        const Uint64 Consumed  = pRecorder->NumConsumed.load(std::memory_order_relaxed);
+        for (Uint64 i = Consumed; i < Published; ++i)
+        {
+            const ThreadRecorder::Event& Evt = pRecorder->Events[i & pRecorder->Mask];
+
+            ScopeRecord Scope;
+            Scope.Name  = Evt.Name;
+            Scope.Begin = Evt.Begin;
+            Scope.End   = Evt.End;
+            Scope.Track = pRecorder->Index;
+            Scope.Depth = Evt.Depth;
+            Frame.CpuScopes.push_back(Scope);
+        }
+        pRecorder->NumConsumed.store(Published, std::memory_order_release);
+
+        if (const Uint32 NumDropped = pRecorder->NumDropped.exchange(0, std::memory_order_relaxed))
+        {
+            LOG_WARNING_MESSAGE("Profiler dropped ", NumDropped, " CPU scope(s) of thread ", pRecorder->Index,
+                                ". Increase CpuScopeBufferSize (currently ", pRecorder->Events.size(), ").");
+        }
+    }
+}
+
+void FrameProfiler::ResolveGpuScopes(FrameSlot& Slot)
+{
+    FrameRecord& Frame = Slot.Frame;
+
+    const auto ReadTime = [](IQuery* pQuery, double& Time) //
+    {
+        QueryDataTimestamp TimeData;
+        if (!pQuery->GetData(&TimeData, sizeof(TimeData), true))
+            return false;
+        Time = static_cast<double>(TimeData.Counter) / static_cast<double>(TimeData.Frequency);
+        return true;
+    };
+
+    bool HasOffset = false;
+
+    const Uint32 NumScopes = std::min(Slot.NumGpuScopes.load(), static_cast<Uint32>(Slot.GpuScopes.size()));
+    for (Uint32 i = 0; i < NumScopes; ++i)
+    {
+        const GpuScope& Src = Slot.GpuScopes[i];
+        if (!Src.Ended)
+            continue;
+
+        ScopeRecord Scope;
+        Scope.Name  = Src.Name;
+        Scope.Track = Src.ContextId;
+        if (!ReadTime(Src.pBeginQuery, Scope.Begin) || !ReadTime(Src.pEndQuery, Scope.End))
+            continue;
+        VERIFY_EXPR(Scope.End >= Scope.Begin);
+        Frame.GpuScopes.push_back(Scope);
+
+        // The GPU can't start executing commands before the CPU has recorded them
+        const double Offset      = Src.CpuBegin - Scope.Begin;
+        Frame.GpuToCpuTimeOffset = HasOffset ? std::max(Frame.GpuToCpuTimeOffset, Offset) : Offset;
+        HasOffset                = true;
+
+        if (Src.ContextId >= m_GpuTrackNames.size())
+            m_GpuTrackNames.resize(Src.ContextId + size_t{1});
+        if (Src.TrackName != nullptr && m_GpuTrackNames[Src.ContextId].empty())
+            m_GpuTrackNames[Src.ContextId] = Src.TrackName;
+    }
+
+    ComputeScopeDepths(Frame.GpuScopes);
+}
+
+void FrameProfiler::EndFrame()
+{
+    if (m_Slots.empty())
+        return;
+
+    const double Time = GetCpuTime();
+
+    {
+        FrameSlot& Curr = *m_Slots[m_CurrSlot];
+        Curr.Frame             = {};
+        Curr.Frame.FrameNumber = m_FrameNumber;
+        Curr.Frame.CpuBegin    = m_FrameBegin;
+        Curr.Frame.CpuEnd      = Time;
+        CollectCpuScopes(Curr.Frame);
+        Curr.IsRecorded = true;
+    }
+
+    ++m_FrameNumber;
+    m_FrameBegin = Time;
+    m_CurrSlot   = (m_CurrSlot + 1) % static_cast<Uint32>(m_Slots.size());
+
+    // The oldest frame in the history is reused, so its queries must be read now
+    FrameSlot& Next = *m_Slots[m_CurrSlot];
+    if (Next.IsRecorded)
+    {
+        ResolveGpuScopes(Next);
+        m_Resolved.emplace_back(std::move(Next.Frame));
+        while (m_Resolved.size() > m_CI.HistoryDepth)
+            m_Resolved.pop_front();
+    }
+    Next.Frame        = {};
+    Next.IsRecorded   = false;
+    Next.NumGpuScopes = 0;
+}
+
+const FrameProfiler::FrameRecord* FrameProfiler::GetLastResolvedFrame() const
+{
+    return !m_Resolved.empty() ? &m_Resolved.back() : nullptr;
+}
+
+std::string FrameProfiler::GetTrackName(bool IsGpu, Uint32 Track) const
+{
+    if (IsGpu)
+    {
+        if (Track < m_GpuTrackNames.size() && !m_GpuTrackNames[Track].empty())
+            return m_GpuTrackNames[Track];
+        return "Context " + std::to_string(Track);
+    }
+    else
+    {
+        std::lock_guard<std::mutex> Lock{m_RecordersMtx};
+        if (Track < m_Recorders.size() && !m_Recorders[Track]->Name.empty())
+            return m_Recorders[Track]->Name;
+        return "Thread " + std::to_string(Track);
+    }
+}
+
+bool FrameProfiler::WriteChromeTrace(const char* FilePath) const
+{
+    auto Quote = [](const char* Str) {
+        std::string Res{"\""};
+        for (const char* c = Str != nullptr ? Str : ""; *c != '\0'; ++c)
+        {
+            if (*c == '"' || *c == '\\')
+                Res.push_back('\\');
+            Res.push_back(*c);
+        }
+        Res.push_back('"');
+        return Res;
+    };
+
+    static constexpr int CpuPid = 1;
+    static constexpr int GpuPid = 2;
+
+    // A single offset for all frames keeps the GPU timeline monotonic
+    double GpuToCpuTimeOffset = 0;
+    bool   HasGpuScopes       = false;
+    for (const FrameRecord& Frame : m_Resolved)
+    {
+        if (Frame.GpuScopes.empty())
+            continue;
+        GpuToCpuTimeOffset = HasGpuScopes ? std::max(GpuToCpuTimeOffset, Frame.GpuToCpuTimeOffset) : Frame.GpuToCpuTimeOffset;
+        HasGpuScopes       = true;
+    }
+
+    std::set<Uint32> CpuTracks;
+    std::set<Uint32> GpuTracks;
+
+    std::stringstream Events;
+    Events << std::fixed << std::setprecision(3);
+
+    const auto WriteScope = [&](const ScopeRecord& Scope, int Pid, double Offset) {
+        Events << ",\n{\"name\":" << Quote(Scope.Name) << ",\"cat\":\"" << (Pid == CpuPid ? "cpu" : "gpu")
+               << "\",\"ph\":\"X\",\"pid\":" << Pid << ",\"tid\":" << Scope.Track
+               << ",\"ts\":" << (Scope.Begin + Offset) * 1.0e+6
+               << ",\"dur\":" << (Scope.End - Scope.Begin) * 1.0e+6 << '}';
+    };
+    for (const FrameRecord& Frame : m_Resolved)
+    {
+        Events << ",\n{\"name\":\"Frame " << Frame.FrameNumber << "\",\"ph\":\"i\",\"s\":\"g\",\"pid\":" << CpuPid
+               << ",\"tid\":0,\"ts\":" << Frame.CpuBegin * 1.0e+6 << '}';
+
+        for (const ScopeRecord& Scope : Frame.CpuScopes)
+        {
+            WriteScope(Scope, CpuPid, 0);
+            CpuTracks.insert(Scope.Track);
+        }
+        for (const ScopeRecord& Scope : Frame.GpuScopes)
+        {
+            WriteScope(Scope, GpuPid, GpuToCpuTimeOffset);
+            GpuTracks.insert(Scope.Track);
+        }
+    }
+
+    std::stringstream ss;
+    ss << "{\"traceEvents\":[\n"
+       << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << CpuPid << ",\"args\":{\"name\":\"CPU\"}},\n"
+       << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << GpuPid << ",\"args\":{\"name\":\"GPU\"}}";
+    for (Uint32 Track : CpuTracks)
+    {
+        ss << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << CpuPid << ",\"tid\":" << Track
+           << ",\"args\":{\"name\":" << Quote(GetTrackName(false, Track).c_str()) << "}}";
+    }
+    for (Uint32 Track : GpuTracks)
+    {
+        ss << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << GpuPid << ",\"tid\":" << Track
+           << ",\"args\":{\"name\":" << Quote(GetTrackName(true, Track).c_str()) << "}}";
+    }
+    ss << Events.str() << "\n],\n"
+       << "\"displayTimeUnit\":\"ms\"\n"
+       << "}\n";
+
+    const std::string Trace = ss.str();
+
+    FileWrapper pFile{FilePath, EFileAccessMode::Overwrite};
+    if (!pFile)
+    {
+        LOG_ERROR_MESSAGE("Failed to create profiler trace file '", FilePath, "'.");
+        return false;
+    }
+
+    const bool Res = pFile->Write(Trace.data(), Trace.size());
+    pFile.Close();
+    if (!Res)
+        LOG_ERROR_MESSAGE("Failed to write profiler trace file '", FilePath, "'.");
+
+    return Res;
+}
+
+void FrameProfiler::UpdateUI()
+{
+    static constexpr float GraphWidth = 500.f;
+    static constexpr float RowHeight  = 16.f;
+
+    ImGui::SetNextWindowPos(ImVec2(240, 10), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Profiler", nullptr, ImGuiWindowFlags_AlwaysAutoResize))
+    {
+        ImGui::End();
+        return;
+    }
+
+    const FrameRecord* pFrame = GetLastResolvedFrame();
+    if (pFrame == nullptr)
+    {
+        ImGui::TextDisabled("Waiting for the first resolved frame");
+        ImGui::End();
+        return;
+    }
+    const FrameRecord& Frame = *pFrame;
+
+    ImGui::Checkbox("CPU tracks", &m_ShowCpuTracks);
+
+    // Timeline of the frame in the CPU clock
+    double StartTime = Frame.CpuBegin;
+    double EndTime   = Frame.CpuEnd;
+    for (const ScopeRecord& Scope : Frame.GpuScopes)
+    {
+        StartTime = std::min(StartTime, Scope.Begin + Frame.GpuToCpuTimeOffset);
+        EndTime   = std::max(EndTime, Scope.End + Frame.GpuToCpuTimeOffset);
+    }
+    const float Scale = GraphWidth / static_cast<float>(std::max(EndTime - StartTime, 1.0e-6));
+
+    const auto DrawTrack = [&](const std::vector<ScopeRecord>& Scopes, bool IsGpu, Uint32 Track, double Offset) {
+        Uint32 NumRows = 0;
+        for (const ScopeRecord& Scope : Scopes)
+        {
+            if (Scope.Track == Track)
+                NumRows = std::max(NumRows, Scope.Depth + 1);
+        }
+        if (NumRows == 0)
+            return;
+
+        ImGui::TextDisabled("%s %s", IsGpu ? "GPU:" : "CPU:", GetTrackName(IsGpu, Track).c_str());
+
+        const ImVec2 Origin   = ImGui::GetCursorScreenPos();
+        ImDrawList*  pDrawList = ImGui::GetWindowDrawList();
+        ImGui::Dummy(ImVec2{GraphWidth, RowHeight * static_cast<float>(NumRows)});
+
+        for (const ScopeRecord& Scope : Scopes)
+        {
+            if (Scope.Track != Track)
+                continue;
+
+            const float  X0 = static_cast<float>(Scope.Begin + Offset - StartTime) * Scale;
+            const float  X1 = std::max(X0 + 2.f, static_cast<float>(Scope.End + Offset - StartTime) * Scale);
+            const float  Y0 = static_cast<float>(Scope.Depth) * RowHeight;
+            const ImVec2 Min{Origin.x + X0, Origin.y + Y0};
+            const ImVec2 Max{Origin.x + X1, Origin.y + Y0 + RowHeight - 1.f};
+
+            // Color every scope name consistently
+            Uint32 Hash = 2166136261u;
+            for (const char* c = Scope.Name; c != nullptr && *c != '\0'; ++c)
+                Hash = (Hash ^ static_cast<Uint8>(*c)) * 16777619u;
+            const ImU32 Color = IM_COL32(64 + (Hash & 0x7F), 64 + ((Hash >> 8) & 0x7F), 64 + ((Hash >> 16) & 0x7F), 255);
+
+            pDrawList->AddRectFilled(Min, Max, Color, 2.f);
+            if (Scope.Name != nullptr && ImGui::CalcTextSize(Scope.Name).x < X1 - X0 - 4.f)
+                pDrawList->AddText(ImVec2{Min.x + 2.f, Min.y + 1.f}, IM_COL32_WHITE, Scope.Name);
+
+            if (ImGui::IsMouseHoveringRect(Min, Max))
+                ImGui::SetTooltip("%s: %s", Scope.Name != nullptr ? Scope.Name : "", TimeToStr(Scope.End - Scope.Begin).c_str());
+        }
+    };
+
+    std::set<Uint32> GpuTracks;
+    for (const ScopeRecord& Scope : Frame.GpuScopes)
+        GpuTracks.insert(Scope.Track);
+    for (Uint32 Track : GpuTracks)
+        DrawTrack(Frame.GpuScopes, true, Track, Frame.GpuToCpuTimeOffset);
+
+    if (m_ShowCpuTracks)
+    {
+        std::set<Uint32> CpuTracks;
+        for (const ScopeRecord& Scope : Frame.CpuScopes)
+            CpuTracks.insert(Scope.Track);
+        for (Uint32 Track : CpuTracks)
+            DrawTrack(Frame.CpuScopes, false, Track, 0);
+    }
+
+    // Total time of every named scope
+    {
+        std::vector<const char*> Names;
+        const auto               AddNames = [&Names](const std::vector<ScopeRecord>& Scopes) {
+            for (const ScopeRecord& Scope : Scopes)
+            {
+                if (Scope.Name == nullptr)
+                    continue;
+                if (std::find_if(Names.begin(), Names.end(), [&Scope](const char* Name) { return strcmp(Name, Scope.Name) == 0; }) == Names.end())
+                    Names.push_back(Scope.Name);
+            }
+        };
+        AddNames(Frame.GpuScopes);
+        AddNames(Frame.CpuScopes);
+
+        const auto TotalTime = [](const std::vector<ScopeRecord>& Scopes, const char* Name) {
+            double Total = 0;
+            for (const ScopeRecord& Scope : Scopes)
+            {
+                if (Scope.Name != nullptr && strcmp(Scope.Name, Name) == 0)
+                    Total += Scope.End - Scope.Begin;
+            }
+            return Total;
+        };
+
+        // The interval between the same scope in two consecutive frames. For scopes that never overlap
+        // with the previous frame, such as graphics passes, this is the true GPU frame period.
+        const FrameRecord* pPrevFrame = m_Resolved.size() >= 2 ? &m_Resolved[m_Resolved.size() - 2] : nullptr;
+        const auto         FirstBegin = [](const std::vector<ScopeRecord>& Scopes, const char* Name, double& Begin) {
+            bool Found = false;
+            for (const ScopeRecord& Scope : Scopes)
+            {
+                if (Scope.Name != nullptr && strcmp(Scope.Name, Name) == 0 && (!Found || Scope.Begin < Begin))
+                {
+                    Begin = Scope.Begin;
+                    Found = true;
+                }
+            }
+            return Found;
+        };
+        const auto Period = [&](const char* Name) {
+            double CurrBegin = 0;
+            double PrevBegin = 0;
+            if (pPrevFrame == nullptr)
+                return 0.0;
+            if (FirstBegin(Frame.GpuScopes, Name, CurrBegin) && FirstBegin(pPrevFrame->GpuScopes, Name, PrevBegin))
+                return CurrBegin - PrevBegin;
+            if (FirstBegin(Frame.CpuScopes, Name, CurrBegin) && FirstBegin(pPrevFrame->CpuScopes, Name, PrevBegin))
+                return CurrBegin - PrevBegin;
+            return 0.0;
+        };
+
+        double GpuFrameBegin = 0;
+        double GpuFrameEnd   = 0;
+        for (size_t i = 0; i < Frame.GpuScopes.size(); ++i)
+        {
+            GpuFrameBegin = i == 0 ? Frame.GpuScopes[i].Begin : std::min(GpuFrameBegin, Frame.GpuScopes[i].Begin);
+            GpuFrameEnd   = i == 0 ? Frame.GpuScopes[i].End : std::max(GpuFrameEnd, Frame.GpuScopes[i].End);
+        }
+
+        std::stringstream params_ss, gpu_ss, cpu_ss, period_ss;
+        params_ss << std::endl
+                  << "Frame:" << std::endl;
+        gpu_ss << "GPU" << std::endl
+               << TimeToStr(GpuFrameEnd - GpuFrameBegin) << std::endl;
+        cpu_ss << "CPU" << std::endl
+               << TimeToStr(Frame.CpuEnd - Frame.CpuBegin) << std::endl;
+        period_ss << "Period" << std::endl
+                  << (pPrevFrame != nullptr ? TimeToStr(Frame.CpuBegin - pPrevFrame->CpuBegin) : "-") << std::endl;
+        for (const char* Name : Names)
+        {
+            params_ss << Name << ':' << std::endl;
+            gpu_ss << TimeToStr(TotalTime(Frame.GpuScopes, Name)) << std::endl;
+            cpu_ss << TimeToStr(TotalTime(Frame.CpuScopes, Name)) << std::endl;
+            period_ss << TimeToStr(Period(Name)) << std::endl;
+        }
+
+        ImGui::TextDisabled("%s", params_ss.str().c_str());
+        ImGui::SameLine(0.f, 20.f);
+        ImGui::TextDisabled("%s", gpu_ss.str().c_str());
+        ImGui::SameLine(0.f, 20.f);
+        ImGui::TextDisabled("%s", cpu_ss.str().c_str());
+        ImGui::SameLine(0.f, 20.f);
+        ImGui::TextDisabled("%s", period_ss.str().c_str());
+    }
+
+    if (ImGui::Button("Save trace"))
+    {
+        m_StatusStr = WriteChromeTrace(m_TraceFilePath.c_str()) ?
+            "Saved " + std::to_string(m_Resolved.size()) + " frames to " + m_TraceFilePath :
+            "Failed to save the trace";
+    }
+    if (!m_StatusStr.empty())
+    {
+        ImGui::SameLine();
+        ImGui::TextDisabled("%s", m_StatusStr.c_str());
+    }
+
+    ImGui::End();
+}
+
+} // namespace Diligent
@@ -23,6 +23,9 @@
 *  of the possibility of such damages.
 */
 
+#include <cstdlib>
+#include <cstring>
+
 #include "SampleApp.hpp"
 #if VULKAN_SUPPORTED
 #    include "ImGuiImplLinuxXCB.hpp"
@@ -50,6 +53,8 @@ public:
             LinuxNativeWindow LinuxWindow;
             LinuxWindow.pDisplay = display;
             LinuxWindow.WindowId = window;
+            m_Display            = display;
+            m_Window             = window;
             InitializeDiligentEngine(&LinuxWindow);
             const auto& SCDesc = m_pSwapChain->GetDesc();
             m_pImGui           = ImGuiImplLinuxX11::Create(ImGuiDiligentCreateInfo{m_pDevice, SCDesc}, SCDesc.Width, SCDesc.Height);
@@ -82,6 +87,8 @@ public:
             LinuxNativeWindow LinuxWindow;
             LinuxWindow.WindowId       = window;
             LinuxWindow.pXCBConnection = connection;
+            m_XCBConnection            = connection;
+            m_XCBWindow                = window;
             InitializeDiligentEngine(&LinuxWindow);
             const auto& SCDesc = m_pSwapChain->GetDesc();
             m_pImGui           = ImGuiImplLinuxXCB::Create(ImGuiDiligentCreateInfo{m_pDevice, SCDesc}, connection, SCDesc.Width, SCDesc.Height);
@@ -105,6 +112,56 @@ public:
         }
     }
 #endif
+
+protected:
+    // The main loop exits when the window manager asks to close the window,
+    // so send the same message to our own window.
+    virtual void RequestQuit() override final
+    {
+        SampleApp::RequestQuit();
+
+#if VULKAN_SUPPORTED
+        if (m_XCBConnection != nullptr)
+        {
+            const auto InternAtom = [this](const char* Name) {
+                xcb_intern_atom_reply_t* Reply = xcb_intern_atom_reply(m_XCBConnection, xcb_intern_atom(m_XCBConnection, 0, static_cast<uint16_t>(strlen(Name)), Name), nullptr);
+                const xcb_atom_t         Atom  = Reply != nullptr ? Reply->atom : XCB_ATOM_NONE;
+                free(Reply);
+                return Atom;
+            };
+
+            xcb_client_message_event_t Event = {};
+            Event.response_type              = XCB_CLIENT_MESSAGE;
+            Event.format                     = 32;
+            Event.window                     = m_XCBWindow;
+            Event.type                       = InternAtom("WM_PROTOCOLS");
+            Event.data.data32[0]             = InternAtom("WM_DELETE_WINDOW");
+            xcb_send_event(m_XCBConnection, 0, m_XCBWindow, XCB_EVENT_MASK_NO_EVENT, reinterpret_cast<const char*>(&Event));
+            xcb_flush(m_XCBConnection);
+            return;
+        }
+#endif
+
+        if (m_Display != nullptr)
+        {
+            XEvent Event               = {};
+            Event.xclient.type         = ClientMessage;
+            Event.xclient.window       = m_Window;
+            Event.xclient.message_type = XInternAtom(m_Display, "WM_PROTOCOLS", False);
+            Event.xclient.format       = 32;
+            Event.xclient.data.l[0]    = static_cast<long>(XInternAtom(m_Display, "WM_DELETE_WINDOW", False));
+            XSendEvent(m_Display, m_Window, False, NoEventMask, &Event);
+            XFlush(m_Display);
+        }
+    }
+
+private:
+    Display* m_Display = nullptr;
+    Window   m_Window  = 0;
+#if VULKAN_SUPPORTED
+    xcb_connection_t* m_XCBConnection = nullptr;
+    uint32_t          m_XCBWindow     = 0;
+#endif
 };
 
 NativeAppBase* CreateApplication()
@@ -0,0 +1,243 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "RenderJobScheduler.hpp"
+
+#include <algorithm>
+
+#include "Errors.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+RenderJobScheduler::RenderJobScheduler(IDeviceContext* pImmediateContext, IDeviceContext* const* ppDeferredContexts, Uint32 NumWorkers) :
+    m_pImmediateContext{pImmediateContext}
+{
+    VERIFY_EXPR(m_pImmediateContext != nullptr);
+
+    m_Workers.resize(NumWorkers);
+    for (Uint32 i = 0; i < NumWorkers; ++i)
+    {
+        m_Workers[i].reset(new WorkerInfo{});
+        m_Workers[i]->pCtx = ppDeferredContexts != nullptr ? ppDeferredContexts[i] : nullptr;
+    }
+    // Start the threads after all workers are created as they may steal from each other
+    for (Uint32 i = 0; i < NumWorkers; ++i)
+        m_Workers[i]->Thread = std::thread{&RenderJobScheduler::WorkerThreadFunc, this, i};
+}
+
+RenderJobScheduler::~RenderJobScheduler()
+{
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_Stop = true;
+    }
+    m_WorkerCV.notify_all();
+
+    for (std::unique_ptr<WorkerInfo>& Worker : m_Workers)
+        Worker->Thread.join();
+}
+
+void RenderJobScheduler::Execute(const JobInfo& Job)
+{
+    VERIFY_EXPR(Job.RecordChunk);
+    if (Job.NumItems == 0)
+        return;
+
+    const Uint32 NumWorkers = GetNumWorkers();
+    VERIFY(NumWorkers == 0 || m_Workers[0]->pCtx != nullptr, "Recording jobs requires deferred contexts");
+    if (NumWorkers == 0)
+    {
+        Job.RecordChunk(m_pImmediateContext, 0, 0, Job.NumItems);
+        return;
+    }
+
+    const Uint32 ChunkSize = StartJob(Job.NumItems, Job.MinChunkSize, Job.ChunksPerWorker, &Job, nullptr);
+    const Uint32 NumChunks = static_cast<Uint32>(m_CmdLists.size());
+
+    Job.RecordChunk(m_pImmediateContext, 0, 0, std::min(ChunkSize, Job.NumItems));
+
+    WaitForWorkers();
+
+    m_CmdListPtrs.clear();
+    for (Uint32 i = 1; i < NumChunks; ++i)
+    {
+        VERIFY_EXPR(m_CmdLists[i]);
+        m_CmdListPtrs.push_back(m_CmdLists[i]);
+    }
+    m_pImmediateContext->ExecuteCommandLists(static_cast<Uint32>(m_CmdListPtrs.size()), m_CmdListPtrs.data());
+
+    for (RefCntAutoPtr<ICommandList>& pCmdList : m_CmdLists)
+    {
+        // Release command lists now to release all outstanding references.
+        // In d3d11 mode, command lists hold references to the swap chain's back buffer
+        // that cause swap chain resize to fail.
+        pCmdList.Release();
+    }
+    m_CmdListPtrs.clear();
+}
+
+void RenderJobScheduler::ParallelFor(const TaskInfo& Task)
+{
+    VERIFY_EXPR(Task.Process);
+    if (Task.NumItems == 0)
+        return;
+
+    if (GetNumWorkers() == 0)
+    {
+        Task.Process(0, Task.NumItems);
+        return;
+    }
+
+    const Uint32 ChunkSize = StartJob(Task.NumItems, Task.MinChunkSize, Task.ChunksPerWorker, nullptr, &Task);
+
+    Task.Process(0, std::min(ChunkSize, Task.NumItems));
+
+    WaitForWorkers();
+}
+
+Uint32 RenderJobScheduler::StartJob(Uint32 NumItems, Uint32 MinChunkSize, Uint32 ChunksPerWorker, const JobInfo* pJob, const TaskInfo* pTask)
+{
+    const Uint32 NumWorkers = GetNumWorkers();
+    MinChunkSize            = std::max(MinChunkSize, 1u);
+
+    // Chunk size adapts to the number of items so that every worker gets several chunks to balance the load
+    const Uint32 TargetNumChunks = 1 + NumWorkers * std::max(ChunksPerWorker, 1u);
+    const Uint32 ChunkSize       = std::max((NumItems + TargetNumChunks - 1) / TargetNumChunks / MinChunkSize, 1u) * MinChunkSize;
+    const Uint32 NumChunks       = (NumItems + ChunkSize - 1) / ChunkSize;
+
+    if (pJob != nullptr)
+        m_CmdLists.resize(NumChunks);
+
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        // The first chunk is processed by the calling thread. Distribute the remaining chunks between the workers.
+        const Uint32 NumWorkerChunks = NumChunks - 1;
+        for (Uint32 i = 0; i < NumWorkers; ++i)
+        {
+            WorkerInfo& Worker = *m_Workers[i];
+            Worker.NextChunk.store(1 + NumWorkerChunks * i / NumWorkers);
+            Worker.EndChunk = 1 + NumWorkerChunks * (i + 1) / NumWorkers;
+        }
+
+        m_pJob           = pJob;
+        m_pTask          = pTask;
+        m_ChunkSize      = ChunkSize;
+        m_NumBusyWorkers = NumWorkers;
+        ++m_JobId;
+    }
+    m_WorkerCV.notify_all();
+
+    return ChunkSize;
+}
+
+void RenderJobScheduler::WaitForWorkers()
+{
+    std::unique_lock<std::mutex> Lock{m_Mtx};
+    m_JobCompleteCV.wait(Lock, [this]() { return m_NumBusyWorkers == 0; });
+    m_pJob  = nullptr;
+    m_pTask = nullptr;
+}
+
+bool RenderJobScheduler::RecordNextChunk(Uint32 WorkerId)
+{
+    const Uint32 NumWorkers = GetNumWorkers();
+    // Take chunks from the own range first, then steal from the other workers
+    for (Uint32 i = 0; i < NumWorkers; ++i)
+    {
+        WorkerInfo& Victim = *m_Workers[(WorkerId + i) % NumWorkers];
+        if (Victim.NextChunk.load(std::memory_order_relaxed) >= Victim.EndChunk)
+            continue;
+
+        const Uint32 Chunk = Victim.NextChunk.fetch_add(1);
+        if (Chunk >= Victim.EndChunk)
+            continue;
+
+        if (m_pTask != nullptr)
+        {
+            const Uint32 FirstItem = Chunk * m_ChunkSize;
+            m_pTask->Process(FirstItem, std::min(FirstItem + m_ChunkSize, m_pTask->NumItems));
+            return true;
+        }
+
+        IDeviceContext* pCtx      = m_Workers[WorkerId]->pCtx;
+        const Uint32    FirstItem = Chunk * m_ChunkSize;
+        const Uint32    EndItem   = std::min(FirstItem + m_ChunkSize, m_pJob->NumItems);
+
+        pCtx->Begin(0);
+        m_pJob->RecordChunk(pCtx, 1 + WorkerId, FirstItem, EndItem);
+        pCtx->FinishCommandList(&m_CmdLists[Chunk]);
+        return true;
+    }
+
+    return false;
+}
+
+void RenderJobScheduler::WorkerThreadFunc(Uint32 WorkerId)
+{
+    IDeviceContext* pCtx = m_Workers[WorkerId]->pCtx;
+
+    Uint64 LastJobId       = 0;
+    bool   NeedFinishFrame = false;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> Lock{m_Mtx};
+            m_WorkerCV.wait(Lock, [&]() { return m_Stop || m_JobId != LastJobId; });
+            if (m_Stop)
+                break;
+            LastJobId = m_JobId;
+        }
+
+        // Call FinishFrame() to release dynamic resources allocated by the deferred context
+        // for the previous job. The command lists of that job have been submitted by now.
+        // IMPORTANT: In Metal backend FinishFrame must be called from the same
+        //            thread that issued rendering commands.
+        if (NeedFinishFrame)
+        {
+            pCtx->FinishFrame();
+            NeedFinishFrame = false;
+        }
+
+        const bool IsRenderJob = m_pJob != nullptr;
+        while (RecordNextChunk(WorkerId))
+            NeedFinishFrame = NeedFinishFrame || IsRenderJob;
+
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            VERIFY_EXPR(m_NumBusyWorkers > 0);
+            if (--m_NumBusyWorkers == 0)
+                m_JobCompleteCV.notify_one();
+        }
+    }
+
+    if (NeedFinishFrame)
+        pCtx->FinishFrame();
+}
+
+} // namespace Diligent
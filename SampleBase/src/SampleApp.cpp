@@ -27,8 +27,11 @@
 
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
 #include <cstdlib>
 #include <cmath>
+#include <thread>
+#include <cstring>
 
 #include "PlatformDefinitions.h"
 #include "SampleApp.hpp"
@@ -40,6 +43,9 @@
 #include "CommandLineParser.hpp"
 #include "GraphicsAccessories.hpp"
 #include "ImageTools.h"
+#include "TiledImageDifference.hpp"
+#include "ThreadPool.hpp"
+#include "FileSystem.hpp"
 
 #if D3D11_SUPPORTED
 #    include "EngineFactoryD3D11.h"
@@ -73,18 +79,85 @@
 #    include <emscripten/html5_webgpu.h>
 #endif
 
+#if PLATFORM_WIN32
+#    include <direct.h>
+#elif PLATFORM_LINUX || PLATFORM_MACOS
+#    include <unistd.h>
+#endif
+
 namespace Diligent
 {
 
+namespace
+{
+
+std::vector<SampleBatchItem>& GetSampleBatchStorage()
+{
+    static std::vector<SampleBatchItem> SampleBatch;
+    return SampleBatch;
+}
+
+// Merges the features requested by two samples so that the device satisfies both
+void MergeDeviceFeatures(DeviceFeatures& Features, const DeviceFeatures& OtherFeatures)
+{
+    static_assert(sizeof(DeviceFeatures) % sizeof(DEVICE_FEATURE_STATE) == 0, "DeviceFeatures is expected to only contain DEVICE_FEATURE_STATE members");
+
+    DEVICE_FEATURE_STATE*       pStates      = reinterpret_cast<DEVICE_FEATURE_STATE*>(&Features);
+    const DEVICE_FEATURE_STATE* pOtherStates = reinterpret_cast<const DEVICE_FEATURE_STATE*>(&OtherFeatures);
+    for (size_t i = 0; i < sizeof(DeviceFeatures) / sizeof(DEVICE_FEATURE_STATE); ++i)
+    {
+        if (pStates[i] == DEVICE_FEATURE_STATE_ENABLED || pOtherStates[i] == DEVICE_FEATURE_STATE_ENABLED)
+            pStates[i] = DEVICE_FEATURE_STATE_ENABLED;
+        else if (pStates[i] == DEVICE_FEATURE_STATE_OPTIONAL || pOtherStates[i] == DEVICE_FEATURE_STATE_OPTIONAL)
+            pStates[i] = DEVICE_FEATURE_STATE_OPTIONAL;
+        else
+            pStates[i] = DEVICE_FEATURE_STATE_DISABLED;
+    }
+}
+
+bool SetWorkingDirectory(const std::string& Dir)
+{
+#if PLATFORM_WIN32
+    return _chdir(Dir.c_str()) == 0;
+#elif PLATFORM_LINUX || PLATFORM_MACOS
+    return chdir(Dir.c_str()) == 0;
+#else
+    LOG_ERROR_MESSAGE("Changing the working directory is not supported on this platform");
+    return false;
+#endif
+}
+
+} // namespace
+
+void SampleApp::SetSampleBatch(std::vector<SampleBatchItem> Items)
+{
+    GetSampleBatchStorage() = std::move(Items);
+}
+
 SampleApp::SampleApp() :
     m_TheSample{CreateSample()},
     m_AppTitle{m_TheSample->GetSampleName()}
 {
+    // The batch, if any, is set by CreateSample()
+    m_SampleBatch = std::move(GetSampleBatchStorage());
+    if (!m_SampleBatch.empty())
+    {
+        // Create all samples up front so that the device can be initialized with
+        // the union of their requirements. The first sample is owned by m_TheSample.
+        m_BatchInfo.Samples.resize(m_SampleBatch.size());
+        for (size_t i = 1; i < m_SampleBatch.size(); ++i)
+            m_BatchInfo.Samples[i].reset(m_SampleBatch[i].CreateSample());
+        m_BatchInfo.ExitCodes.resize(m_SampleBatch.size(), 0);
+    }
+
     UpdateAppSettings(true);
 }
 
 SampleApp::~SampleApp()
 {
+    // Wait until all pending screen captures are written
+    m_pScreenCaptureWriter.reset();
+
     m_pImGui.reset();
     m_TheSample.reset();
 
@@ -131,6 +204,48 @@ void SampleApp::UpdateAppSettings(bool IsInitialization)
         m_bShowAdaptersDialog = DesiredSettings.ShowAdaptersDialog;
 }
 
+void SampleApp::ModifyEngineInitInfo(const SampleBase::ModifyEngineInitInfoAttribs& Attribs)
+{
+    m_TheSample->ModifyEngineInitInfo(Attribs);
+
+    // All samples in the batch share the device, so it must satisfy the requirements of every sample
+    const SwapChainDesc SCDesc = Attribs.SCDesc;
+    for (size_t i = 0; i < m_BatchInfo.Samples.size(); ++i)
+    {
+        if (!m_BatchInfo.Samples[i])
+            continue;
+
+        EngineCreateInfo&                 EngineCI             = Attribs.EngineCI;
+        const DeviceFeatures              Features             = EngineCI.Features;
+        const Uint32                      NumDeferredContexts  = EngineCI.NumDeferredContexts;
+        const Uint32                      NumImmediateContexts = EngineCI.NumImmediateContexts;
+        const ImmediateContextCreateInfo* pContextInfo         = EngineCI.pImmediateContextInfo;
+
+        m_BatchInfo.Samples[i]->ModifyEngineInitInfo(Attribs);
+
+        MergeDeviceFeatures(EngineCI.Features, Features);
+        EngineCI.NumDeferredContexts = std::max(EngineCI.NumDeferredContexts, NumDeferredContexts);
+        if (EngineCI.NumImmediateContexts < NumImmediateContexts)
+        {
+            EngineCI.NumImmediateContexts  = NumImmediateContexts;
+            EngineCI.pImmediateContextInfo = pContextInfo;
+        }
+
+        if (Attribs.SCDesc.ColorBufferFormat != SCDesc.ColorBufferFormat || Attribs.SCDesc.DepthBufferFormat != SCDesc.DepthBufferFormat)
+        {
+            LOG_WARNING_MESSAGE("Sample '", m_SampleBatch[i].Path, "' requests different swap chain formats. The formats of the first sample will be used.");
+            Attribs.SCDesc.ColorBufferFormat = SCDesc.ColorBufferFormat;
+            Attribs.SCDesc.DepthBufferFormat = SCDesc.DepthBufferFormat;
+        }
+    }
+
+    if (m_pBenchmark && Attribs.EngineCI.Features.TimestampQueries == DEVICE_FEATURE_STATE_DISABLED)
+    {
+        // GPU frame times are measured with timestamp queries
+        Attribs.EngineCI.Features.TimestampQueries = DEVICE_FEATURE_STATE_OPTIONAL;
+    }
+}
+
 void SampleApp::InitializeDiligentEngine(const NativeWindow* pWindow)
 {
     if (m_ScreenCaptureInfo.AllowCapture)
@@ -245,7 +360,7 @@ void SampleApp::InitializeDiligentEngine(const NativeWindow* pWindow)
                 EngineCI.SetValidationLevel(static_cast<VALIDATION_LEVEL>(m_ValidationLevel));
 
             EngineCI.AdapterId = FindAdapter(pFactoryD3D11, EngineCI.GraphicsAPIVersion, m_AdapterAttribs);
-            m_TheSample->ModifyEngineInitInfo({pFactoryD3D11, m_DeviceType, EngineCI, m_SwapChainInitDesc});
+            ModifyEngineInitInfo({pFactoryD3D11, m_DeviceType, EngineCI, m_SwapChainInitDesc});
 
             if (m_AdapterType != ADAPTER_TYPE_SOFTWARE && EngineCI.AdapterId != DEFAULT_ADAPTER_ID)
             {
@@ -303,7 +418,7 @@ void SampleApp::InitializeDiligentEngine(const NativeWindow* pWindow)
 #    endif
             }
 
-            m_TheSample->ModifyEngineInitInfo({pFactoryD3D12, m_DeviceType, EngineCI, m_SwapChainInitDesc});
+            ModifyEngineInitInfo({pFactoryD3D12, m_DeviceType, EngineCI, m_SwapChainInitDesc});
 
             if (m_AdapterType != ADAPTER_TYPE_SOFTWARE && EngineCI.AdapterId != DEFAULT_ADAPTER_ID)
             {
@@ -350,7 +465,7 @@ void SampleApp::InitializeDiligentEngine(const NativeWindow* pWindow)
             if (m_ValidationLevel >= 0)
                 EngineCI.SetValidationLevel(static_cast<VALIDATION_LEVEL>(m_ValidationLevel));
 
-            m_TheSample->ModifyEngineInitInfo({pFactoryOpenGL, m_DeviceType, EngineCI, m_SwapChainInitDesc});
+            ModifyEngineInitInfo({pFactoryOpenGL, m_DeviceType, EngineCI, m_SwapChainInitDesc});
 
             if (m_bForceNonSeprblProgs)
                 EngineCI.Features.SeparablePrograms = DEVICE_FEATURE_STATE_DISABLED;
@@ -396,7 +511,7 @@ void SampleApp::InitializeDiligentEngine(const NativeWindow* pWindow)
             m_pEngineFactory             = pFactoryVk;
 
             EngineCI.AdapterId = FindAdapter(pFactoryVk, EngineCI.GraphicsAPIVersion, m_AdapterAttribs);
-            m_TheSample->ModifyEngineInitInfo({pFactoryVk, m_DeviceType, EngineCI, m_SwapChainInitDesc});
+            ModifyEngineInitInfo({pFactoryVk, m_DeviceType, EngineCI, m_SwapChainInitDesc});
 
             if (m_bVulkanCompatibilityMode)
             {
@@ -429,7 +544,7 @@ void SampleApp::InitializeDiligentEngine(const NativeWindow* pWindow)
             IEngineFactoryMtl* pFactoryMtl = GetEngineFactoryMtl();
             m_pEngineFactory               = pFactoryMtl;
 
-            m_TheSample->ModifyEngineInitInfo({pFactoryMtl, m_DeviceType, EngineCI, m_SwapChainInitDesc});
+            ModifyEngineInitInfo({pFactoryMtl, m_DeviceType, EngineCI, m_SwapChainInitDesc});
 
             NumImmediateContexts = std::max(1u, EngineCI.NumImmediateContexts);
             ppContexts.resize(NumImmediateContexts + EngineCI.NumDeferredContexts);
@@ -459,7 +574,7 @@ void SampleApp::InitializeDiligentEngine(const NativeWindow* pWindow)
 
             NumImmediateContexts = std::max(1u, EngineCI.NumImmediateContexts);
             ppContexts.resize(NumImmediateContexts + EngineCI.NumDeferredContexts);
-            m_TheSample->ModifyEngineInitInfo({pFactoryWebGPU, m_DeviceType, EngineCI, m_SwapChainInitDesc});
+            ModifyEngineInitInfo({pFactoryWebGPU, m_DeviceType, EngineCI, m_SwapChainInitDesc});
 
             if (EngineCI.NumDeferredContexts != 0)
             {
@@ -498,6 +613,7 @@ void SampleApp::InitializeDiligentEngine(const NativeWindow* pWindow)
     m_AppTitle.append(", API ");
     m_AppTitle.append(std::to_string(DILIGENT_API_VERSION));
     m_AppTitle.push_back(')');
+    m_BatchInfo.AppTitleSuffix = m_AppTitle.substr(std::strlen(m_TheSample->GetSampleName()));
 
     m_NumImmediateContexts = NumImmediateContexts;
     m_pDeviceContexts.resize(ppContexts.size());
@@ -513,6 +629,27 @@ void SampleApp::InitializeDiligentEngine(const NativeWindow* pWindow)
         }
 
         m_pScreenCapture.reset(new ScreenCapture(m_pDevice));
+
+        if (m_GoldenImgMode == GoldenImageMode::None)
+        {
+            // Encode and write captured frames on worker threads. Golden image modes capture a single
+            // frame and must report the result through the exit code, so they keep the synchronous path.
+            Uint32 NumThreads = m_ScreenCaptureInfo.NumWriterThreads;
+            if (NumThreads == 0)
+                NumThreads = std::min(std::max(std::thread::hardware_concurrency(), 2u) - 1u, 4u);
+            Uint32 MaxPendingImages = m_ScreenCaptureInfo.MaxPendingImages;
+            if (MaxPendingImages == 0)
+                MaxPendingImages = NumThreads * 2;
+            m_pScreenCaptureWriter.reset(new ScreenCaptureWriter{NumThreads, MaxPendingImages});
+        }
+    }
+
+    if (m_pBenchmark)
+    {
+        if (m_pDevice->GetDeviceInfo().Features.TimestampQueries)
+            m_pBenchmarkGPUTimer.reset(new DurationQueryHelper{m_pDevice, 4});
+        else
+            LOG_WARNING_MESSAGE("Timestamp queries are not supported by this device. GPU frame times will not be reported.");
     }
 }
 
@@ -546,6 +683,14 @@ void SampleApp::InitializeSample()
     for (size_t ctx = 0; ctx < m_pDeviceContexts.size(); ++ctx)
         ppContexts[ctx] = m_pDeviceContexts[ctx];
 
+    if (!m_SampleBatch.empty() && m_BatchInfo.BaselineRefCounts.empty())
+    {
+        m_BatchInfo.BaselineRefCounts.push_back(m_pDevice->GetReferenceCounters()->GetNumStrongRefs());
+        m_BatchInfo.BaselineRefCounts.push_back(m_pSwapChain->GetReferenceCounters()->GetNumStrongRefs());
+        for (const RefCntAutoPtr<IDeviceContext>& pCtx : m_pDeviceContexts)
+            m_BatchInfo.BaselineRefCounts.push_back(pCtx->GetReferenceCounters()->GetNumStrongRefs());
+    }
+
     SampleInitInfo InitInfo;
     InitInfo.pEngineFactory  = m_pEngineFactory;
     InitInfo.pDevice         = m_pDevice;
@@ -670,6 +815,11 @@ void SampleApp::UpdateAdaptersDialog()
 //
 //     magick convert  -delay 6  -loop 0 -layers Optimize -compress LZW -strip -resize 240x180   frame*.png   Animation.gif
 //
+// Command line example to run the sample headlessly for 500 frames at a fixed 60 FPS time step
+// and write frame time percentiles to a JSON report (use .csv extension to get CSV):
+//
+//     --mode vk --adapter sw --adapters_dialog 0 --show_ui 0 --benchmark_frames 500 --benchmark_warmup 30 --benchmark_fps 60 --benchmark_report bench.json
+//
 SampleApp::CommandLineStatus SampleApp::ProcessCommandLine(int argc, const char* const* argv)
 {
     if (argc == 0)
@@ -685,6 +835,7 @@ SampleApp::CommandLineStatus SampleApp::ProcessCommandLine(int argc, const char*
 
     ArgsParser.Parse("mode", 'm',
                      [&](const char* ArgVal) {
+                         m_BatchInfo.ModeName = ArgVal;
                          if (StrCmpNoCase(ArgVal, "d3d11_sw") == 0)
                          {
                              m_DeviceType  = RENDER_DEVICE_TYPE_D3D11;
@@ -788,6 +939,8 @@ SampleApp::CommandLineStatus SampleApp::ProcessCommandLine(int argc, const char*
 
     ArgsParser.Parse("capture_quality", m_ScreenCaptureInfo.JpegQuality);
     ArgsParser.Parse("capture_alpha", m_ScreenCaptureInfo.KeepAlpha);
+    ArgsParser.Parse("capture_threads", m_ScreenCaptureInfo.NumWriterThreads);
+    ArgsParser.Parse("capture_queue_size", m_ScreenCaptureInfo.MaxPendingImages);
     ArgsParser.Parse("width", 'w', m_InitialWindowWidth);
     ArgsParser.Parse("height", 'h', m_InitialWindowHeight);
     ArgsParser.Parse("validation", m_ValidationLevel);
@@ -822,11 +975,30 @@ SampleApp::CommandLineStatus SampleApp::ProcessCommandLine(int argc, const char*
     }
 
     ArgsParser.Parse("golden_image_tolerance", m_GoldenImgPixelTolerance);
+    ArgsParser.Parse("golden_image_diff_path", m_GoldenImgDiffDirectory);
     ArgsParser.Parse("vsync", m_bVSync);
     ArgsParser.Parse("non_separable_progs", m_bForceNonSeprblProgs);
     ArgsParser.Parse("vk_compatibility", m_bVulkanCompatibilityMode);
     ArgsParser.Parse("break_on_error", m_bBreakOnError);
 
+    ArgsParser.Parse("benchmark_frames", m_BenchmarkInfo.NumFrames);
+    ArgsParser.Parse("benchmark_warmup", m_BenchmarkInfo.NumWarmupFrames);
+    ArgsParser.Parse("benchmark_fps", m_BenchmarkInfo.FPS);
+    ArgsParser.Parse("benchmark_report", m_BenchmarkInfo.ReportPath);
+    if (m_BenchmarkInfo.NumFrames > 0)
+    {
+        if (m_GoldenImgMode != GoldenImageMode::None)
+        {
+            LOG_ERROR_MESSAGE("Benchmark mode can't be used together with golden image mode");
+            return CommandLineStatus::Error;
+        }
+        if (m_BenchmarkInfo.FPS <= 0)
+        {
+            LOG_ERROR_MESSAGE("Benchmark FPS (", m_BenchmarkInfo.FPS, ") must be positive");
+            return CommandLineStatus::Error;
+        }
+        m_pBenchmark = std::make_unique<FrameBenchmark>(m_BenchmarkInfo.NumWarmupFrames, m_BenchmarkInfo.NumFrames, 1.0 / m_BenchmarkInfo.FPS);
+    }
 
     if (m_DeviceType == RENDER_DEVICE_TYPE_UNDEFINED)
     {
@@ -849,9 +1021,227 @@ SampleApp::CommandLineStatus SampleApp::ProcessCommandLine(int argc, const char*
         }
     }
 
+    if (!m_SampleBatch.empty())
+    {
+        ArgsParser.Parse("batch_samples_root", m_BatchInfo.SamplesRoot);
+        if (m_GoldenImgMode == GoldenImageMode::None)
+        {
+            LOG_ERROR_MESSAGE("Sample batch can only be run in golden image mode");
+            return CommandLineStatus::Error;
+        }
+        if (m_BatchInfo.SamplesRoot.empty())
+        {
+            LOG_ERROR_MESSAGE("Samples root directory must be specified by --batch_samples_root");
+            return CommandLineStatus::Error;
+        }
+        if (m_ScreenCaptureInfo.Directory.empty())
+        {
+            LOG_ERROR_MESSAGE("Golden images directory must be specified by --capture_path");
+            return CommandLineStatus::Error;
+        }
+        m_BatchInfo.GoldenImgRoot = m_ScreenCaptureInfo.Directory;
+
+        if (m_BatchInfo.ModeName.empty())
+        {
+            switch (m_DeviceType)
+            {
+                // clang-format off
+                case RENDER_DEVICE_TYPE_D3D11:  m_BatchInfo.ModeName = "d3d11"; break;
+                case RENDER_DEVICE_TYPE_D3D12:  m_BatchInfo.ModeName = "d3d12"; break;
+                case RENDER_DEVICE_TYPE_GL:     m_BatchInfo.ModeName = "gl";    break;
+                case RENDER_DEVICE_TYPE_GLES:   m_BatchInfo.ModeName = "gles";  break;
+                case RENDER_DEVICE_TYPE_VULKAN: m_BatchInfo.ModeName = "vk";    break;
+                case RENDER_DEVICE_TYPE_METAL:  m_BatchInfo.ModeName = "mtl";   break;
+                case RENDER_DEVICE_TYPE_WEBGPU: m_BatchInfo.ModeName = "wgpu";  break;
+                // clang-format on
+                default: m_BatchInfo.ModeName = "unknown";
+            }
+        }
+
+        for (size_t i = 0; i < m_SampleBatch.size(); ++i)
+        {
+            CommandLineStatus Status = ProcessBatchSampleCommandLine(i, ArgsParser.ArgC(), ArgsParser.ArgV());
+            if (Status != CommandLineStatus::OK)
+                return Status;
+        }
+
+        SetBatchSampleCaptureInfo(0);
+        if (!SetWorkingDirectory(m_BatchInfo.SamplesRoot + "/" + m_SampleBatch[0].Path + "/assets"))
+        {
+            LOG_ERROR_MESSAGE("Failed to set working directory for sample '", m_SampleBatch[0].Path, "'");
+            return CommandLineStatus::Error;
+        }
+
+        return CommandLineStatus::OK;
+    }
+
     return m_TheSample->ProcessCommandLine(ArgsParser.ArgC(), ArgsParser.ArgV());
 }
 
+SampleApp::CommandLineStatus SampleApp::ProcessBatchSampleCommandLine(size_t SampleIdx, int argc, const char* const* argv)
+{
+    const SampleBatchItem& Item = m_SampleBatch[SampleIdx];
+
+    // Sample arguments go after the remaining application arguments (argv[0] is the executable name)
+    std::vector<std::string> SampleArgs;
+    if (Item.Args != nullptr)
+    {
+        const std::string Args{Item.Args};
+        SampleArgs = SplitString(Args.begin(), Args.end());
+    }
+
+    std::vector<const char*> Argv{argv, argv + argc};
+    for (const std::string& Arg : SampleArgs)
+        Argv.push_back(Arg.c_str());
+
+    SampleBase* pSample = SampleIdx == 0 ? m_TheSample.get() : m_BatchInfo.Samples[SampleIdx].get();
+    return pSample->ProcessCommandLine(static_cast<int>(Argv.size()), Argv.data());
+}
+
+void SampleApp::SetBatchSampleCaptureInfo(size_t SampleIdx)
+{
+    const std::string Path{m_SampleBatch[SampleIdx].Path};
+    const size_t      NameStart = Path.find_last_of('/');
+
+    m_ScreenCaptureInfo.Directory = m_BatchInfo.GoldenImgRoot + "/" + Path;
+    m_ScreenCaptureInfo.FileName  = Path.substr(NameStart != std::string::npos ? NameStart + 1 : 0) + "_" + m_BatchInfo.ModeName;
+
+    if (m_GoldenImgMode == GoldenImageMode::Capture && !FileSystem::PathExists(m_ScreenCaptureInfo.Directory.c_str()))
+        FileSystem::CreateDirectory(m_ScreenCaptureInfo.Directory.c_str());
+}
+
+bool SampleApp::CheckBatchSampleTeardown(size_t SampleIdx)
+{
+    std::vector<IObject*> Objects;
+    Objects.push_back(m_pDevice);
+    Objects.push_back(m_pSwapChain);
+    for (const RefCntAutoPtr<IDeviceContext>& pCtx : m_pDeviceContexts)
+        Objects.push_back(pCtx);
+    VERIFY_EXPR(Objects.size() == m_BatchInfo.BaselineRefCounts.size());
+
+    static constexpr const char* ObjectNames[] = {"render device", "swap chain"};
+
+    bool Res = true;
+    for (size_t i = 0; i < Objects.size(); ++i)
+    {
+        const ReferenceCounterValueType NumRefs = Objects[i]->GetReferenceCounters()->GetNumStrongRefs();
+        if (NumRefs != m_BatchInfo.BaselineRefCounts[i])
+        {
+            const std::string ObjName = i < _countof(ObjectNames) ? ObjectNames[i] : "device context " + std::to_string(i - _countof(ObjectNames));
+            LOG_ERROR_MESSAGE("Sample '", m_SampleBatch[SampleIdx].Path, "' did not release ", NumRefs - m_BatchInfo.BaselineRefCounts[i],
+                              " reference(s) to the ", ObjName);
+            Res = false;
+        }
+    }
+    return Res;
+}
+
+bool SampleApp::SwitchToBatchSample(size_t SampleIdx)
+{
+    const size_t PrevSampleIdx = m_BatchInfo.CurrentSample;
+
+    // Full teardown of the previous sample
+    m_TheSample->ReleaseSwapChainBuffers();
+    m_TheSample.reset();
+    for (Uint32 q = 0; q < m_NumImmediateContexts; ++q)
+    {
+        IDeviceContext* pCtx = m_pDeviceContexts[q];
+        pCtx->Flush();
+        pCtx->WaitForIdle();
+        pCtx->InvalidateState();
+    }
+    m_pDevice->IdleGPU();
+    m_pDevice->ReleaseStaleResources(true);
+
+    if (!CheckBatchSampleTeardown(PrevSampleIdx))
+        m_BatchInfo.ExitCodes[PrevSampleIdx] = std::max(m_BatchInfo.ExitCodes[PrevSampleIdx], 20);
+
+    m_BatchInfo.CurrentSample = SampleIdx;
+    m_TheSample               = std::move(m_BatchInfo.Samples[SampleIdx]);
+    m_AppTitle                = std::string{m_TheSample->GetSampleName()} + m_BatchInfo.AppTitleSuffix;
+
+    if (!SetWorkingDirectory(m_BatchInfo.SamplesRoot + "/" + m_SampleBatch[SampleIdx].Path + "/assets"))
+    {
+        LOG_ERROR_MESSAGE("Failed to set working directory for sample '", m_SampleBatch[SampleIdx].Path, "'");
+        return false;
+    }
+
+    SetBatchSampleCaptureInfo(SampleIdx);
+    m_ScreenCaptureInfo.FramesToCapture = 1;
+    m_ScreenCaptureInfo.LastCaptureTime = -1e+10;
+
+    InitializeSample();
+
+    return true;
+}
+
+void SampleApp::RunSampleBatch(double CurrTime)
+{
+    VERIFY_EXPR(!m_SampleBatch.empty() && !m_BatchInfo.IsRunning);
+    m_BatchInfo.IsRunning = true;
+
+    // Every sample renders and captures one frame. Platform overrides of Render() and Present()
+    // are bypassed, as they may lock the same mutex as Update(), which runs the batch.
+    for (size_t i = 0; i < m_SampleBatch.size(); ++i)
+    {
+        // The first sample has been initialized by InitializeSample()
+        if (i > 0)
+            m_ExitCode = 0;
+        try
+        {
+            if (i == 0 || SwitchToBatchSample(i))
+            {
+                UpdateFrame(CurrTime, 0);
+                SampleApp::Render();
+                SampleApp::Present();
+            }
+            else
+            {
+                m_ExitCode = 1;
+            }
+        }
+        catch (...)
+        {
+            LOG_ERROR_MESSAGE("Failed to run sample '", m_SampleBatch[i].Path, "'");
+            m_ExitCode = 1;
+        }
+        m_BatchInfo.ExitCodes[i] = std::max(m_BatchInfo.ExitCodes[i], m_ExitCode);
+    }
+
+    // Destroy the last sample and check that it released all references as well
+    if (m_TheSample)
+    {
+        m_TheSample->ReleaseSwapChainBuffers();
+        m_TheSample.reset();
+        for (Uint32 q = 0; q < m_NumImmediateContexts; ++q)
+            m_pDeviceContexts[q]->WaitForIdle();
+        m_pDevice->ReleaseStaleResources(true);
+        if (!CheckBatchSampleTeardown(m_BatchInfo.CurrentSample))
+            m_BatchInfo.ExitCodes[m_BatchInfo.CurrentSample] = std::max(m_BatchInfo.ExitCodes[m_BatchInfo.CurrentSample], 20);
+    }
+
+    int NumFailed = 0;
+    for (size_t i = 0; i < m_SampleBatch.size(); ++i)
+    {
+        if (m_BatchInfo.ExitCodes[i] == 0)
+        {
+            LOG_INFO_MESSAGE(TextColorCode::Green, m_SampleBatch[i].Path, ": PASSED", TextColorCode::Default);
+        }
+        else
+        {
+            LOG_ERROR_MESSAGE(m_SampleBatch[i].Path, ": FAILED. Error code: ", m_BatchInfo.ExitCodes[i]);
+            ++NumFailed;
+        }
+    }
+    LOG_INFO_MESSAGE(m_SampleBatch.size() - NumFailed, " of ", m_SampleBatch.size(), " samples passed");
+
+    // Same as in ProcessGoldenImages scripts, the exit code is the number of failed samples
+    m_ExitCode = NumFailed;
+
+    // All samples have been destroyed, so the frame that runs the batch must not render anything
+    RequestQuit();
+}
+
 void SampleApp::WindowResize(int width, int height)
 {
     if (m_pSwapChain)
@@ -866,6 +1256,30 @@ void SampleApp::WindowResize(int width, int height)
 
 void SampleApp::Update(double CurrTime, double ElapsedTime)
 {
+    if (m_bQuitRequested)
+        return;
+
+    if (!m_SampleBatch.empty())
+    {
+        // The batch runs all samples within the first frame of the platform main loop
+        RunSampleBatch(CurrTime);
+        return;
+    }
+
+    UpdateFrame(CurrTime, ElapsedTime);
+}
+
+void SampleApp::UpdateFrame(double CurrTime, double ElapsedTime)
+{
+    if (m_pBenchmark)
+    {
+        // Drive the sample with a fixed time step so that every run renders identical frames
+        CurrTime    = m_pBenchmark->GetCurrentTime();
+        ElapsedTime = m_pBenchmark->GetTimeStep();
+
+        m_BenchmarkInfo.FrameStartTime = m_BenchmarkTimer.GetElapsedTime();
+    }
+
     m_CurrentTime = CurrTime;
 
     UpdateAppSettings(false);
@@ -884,16 +1298,24 @@ void SampleApp::Update(double CurrTime, double ElapsedTime)
         m_TheSample->Update(CurrTime, ElapsedTime, m_bShowUI);
         m_TheSample->GetInputController().ClearState();
     }
+
+    if (m_pBenchmark)
+        m_pBenchmark->RecordCPUTime(FrameBenchmark::TIMING_UPDATE, m_BenchmarkTimer.GetElapsedTime() - m_BenchmarkInfo.FrameStartTime);
 }
 
 void SampleApp::Render()
 {
-    if (m_NumImmediateContexts == 0 || !m_pSwapChain)
+    if (m_NumImmediateContexts == 0 || !m_pSwapChain || m_bQuitRequested)
         return;
 
     IDeviceContext* pCtx = GetImmediateContext();
     pCtx->ClearStats();
 
+    if (m_pBenchmark)
+        m_BenchmarkInfo.PhaseStartTime = m_BenchmarkTimer.GetElapsedTime();
+    if (m_pBenchmarkGPUTimer)
+        m_pBenchmarkGPUTimer->Begin(pCtx);
+
     ITextureView* pRTV = m_pSwapChain->GetCurrentBackBufferRTV();
     ITextureView* pDSV = m_pSwapChain->GetDepthBufferDSV();
     pCtx->SetRenderTargets(1, &pRTV, pDSV, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
@@ -914,6 +1336,16 @@ void SampleApp::Render()
             m_pImGui->EndFrame();
         }
     }
+
+    if (m_pBenchmarkGPUTimer)
+    {
+        // The query helper returns the duration of one of the previous frames, if available
+        double GPUFrameTime = 0;
+        if (m_pBenchmarkGPUTimer->End(pCtx, GPUFrameTime))
+            m_pBenchmark->RecordGPUTime(GPUFrameTime);
+    }
+    if (m_pBenchmark)
+        m_pBenchmark->RecordCPUTime(FrameBenchmark::TIMING_RENDER, m_BenchmarkTimer.GetElapsedTime() - m_BenchmarkInfo.PhaseStartTime);
 }
 
 void SampleApp::CompareGoldenImage(const std::string& FileName, ScreenCapture::CaptureInfo& Capture)
@@ -954,7 +1386,16 @@ void SampleApp::CompareGoldenImage(const std::string& FileName, ScreenCapture::C
         /*FlipY = */ m_pDevice->GetDeviceInfo().IsGLDevice());
     pCtx->UnmapTextureSubresource(Capture.pTexture, 0, 0);
 
-    ComputeImageDifferenceAttribs DiffAttribs;
+    ThreadPoolCreateInfo ThreadPoolCI;
+    ThreadPoolCI.NumThreads = std::max(std::thread::hardware_concurrency(), 2u) - 1u;
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCI);
+
+    // RGBA8 heat map that is saved to the diff directory if the validation fails
+    std::vector<Uint8> DiffImage;
+    if (!m_GoldenImgDiffDirectory.empty())
+        DiffImage.resize(size_t{TexDesc.Width} * size_t{TexDesc.Height} * 4);
+
+    TiledImageDifferenceAttribs DiffAttribs;
     DiffAttribs.Width        = TexDesc.Width;
     DiffAttribs.Height       = TexDesc.Height;
     DiffAttribs.pImage1      = CapturedPixels.data();
@@ -964,9 +1405,14 @@ void SampleApp::CompareGoldenImage(const std::string& FileName, ScreenCapture::C
     DiffAttribs.NumChannels2 = GoldenImgDesc.NumComponents;
     DiffAttribs.Stride2      = GoldenImgDesc.RowStride;
     DiffAttribs.Threshold    = static_cast<Uint32>(m_GoldenImgPixelTolerance);
+    DiffAttribs.pThreadPool  = pThreadPool;
+    DiffAttribs.NumWorkers   = ThreadPoolCI.NumThreads;
+    DiffAttribs.pDiffImage   = !DiffImage.empty() ? DiffImage.data() : nullptr;
+    DiffAttribs.DiffStride   = TexDesc.Width * 4;
 
-    ImageDiffInfo ImgDiff;
-    ComputeImageDifference(DiffAttribs, ImgDiff);
+    TiledImageDiffInfo ImgDiff;
+    ComputeTiledImageDifference(DiffAttribs, ImgDiff);
+    pThreadPool.Release();
 
     const Uint32 NumBadPixels  = ImgDiff.NumDiffPixelsAboveThreshold;
     const Uint32 NumDiffPixels = ImgDiff.NumDiffPixels - ImgDiff.NumDiffPixelsAboveThreshold;
@@ -980,20 +1426,72 @@ void SampleApp::CompareGoldenImage(const std::string& FileName, ScreenCapture::C
         else
         {
             LOG_WARNING_MESSAGE(GetAppTitle(), ": golden image validation PASSED with ", NumDiffPixels,
-                                " differing pixels within the threshold (", m_GoldenImgPixelTolerance, "). Maximum difference: ", MaxDiff, '.');
+                                " differing pixels within the threshold (", m_GoldenImgPixelTolerance, "). Maximum difference: ", MaxDiff,
+                                ". PSNR: ", ImgDiff.PSNR, " dB, SSIM: ", ImgDiff.SSIM, '.');
         }
     }
     else
     {
         if (NumDiffPixels == 0)
         {
-            LOG_ERROR_MESSAGE(GetAppTitle(), ": golden image validation FAILED: ", NumBadPixels, " inconsistent pixels are found. Maximum difference: ", MaxDiff, '.');
+            LOG_ERROR_MESSAGE(GetAppTitle(), ": golden image validation FAILED: ", NumBadPixels, " inconsistent pixels are found. Maximum difference: ", MaxDiff,
+                              ". PSNR: ", ImgDiff.PSNR, " dB, SSIM: ", ImgDiff.SSIM, '.');
         }
         else
         {
             LOG_ERROR_MESSAGE(GetAppTitle(), ": golden image validation FAILED: ", NumBadPixels, " inconsistent pixels and ", NumDiffPixels,
-                              " differing pixels within the threshold (", m_GoldenImgPixelTolerance, ") are found. Maximum difference: ", MaxDiff, '.');
+                              " differing pixels within the threshold (", m_GoldenImgPixelTolerance, ") are found. Maximum difference: ", MaxDiff,
+                              ". PSNR: ", ImgDiff.PSNR, " dB, SSIM: ", ImgDiff.SSIM, '.');
         }
+
+        // Report the tiles with the most inconsistent pixels
+        std::vector<const ImageTileDiffInfo*> BadTiles;
+        for (const ImageTileDiffInfo& Tile : ImgDiff.Tiles)
+        {
+            if (Tile.NumDiffPixelsAboveThreshold > 0)
+                BadTiles.push_back(&Tile);
+        }
+        std::sort(BadTiles.begin(), BadTiles.end(), [](const ImageTileDiffInfo* pTile1, const ImageTileDiffInfo* pTile2) {
+            return pTile1->NumDiffPixelsAboveThreshold > pTile2->NumDiffPixelsAboveThreshold;
+        });
+
+        std::stringstream TilesSS;
+        TilesSS << BadTiles.size() << " of " << ImgDiff.Tiles.size() << " tiles contain inconsistent pixels. Worst tiles:";
+        for (size_t i = 0; i < std::min(BadTiles.size(), size_t{8}); ++i)
+        {
+            const ImageTileDiffInfo& Tile = *BadTiles[i];
+            TilesSS << "\n    [" << Tile.X << ", " << Tile.Y << ", " << Tile.Width << "x" << Tile.Height << "]: "
+                    << Tile.NumDiffPixelsAboveThreshold << " inconsistent pixels, max diff " << Tile.MaxDiff
+                    << ", SSIM " << std::fixed << std::setprecision(4) << Tile.SSIM << std::defaultfloat;
+        }
+        LOG_INFO_MESSAGE(TilesSS.str());
+    }
+
+    if (NumBadPixels > 0 && !DiffImage.empty())
+    {
+        // Save the heat map as <diff directory>/<capture name>_diff.png
+        std::string DiffFileName = m_GoldenImgDiffDirectory;
+        if (DiffFileName.back() != '/')
+            DiffFileName.push_back('/');
+        DiffFileName += m_ScreenCaptureInfo.FileName + "_diff.png";
+
+        Image::EncodeInfo Info;
+        Info.Width      = TexDesc.Width;
+        Info.Height     = TexDesc.Height;
+        Info.TexFormat  = TEX_FORMAT_RGBA8_UNORM;
+        Info.KeepAlpha  = false;
+        Info.pData      = DiffImage.data();
+        Info.Stride     = TexDesc.Width * 4;
+        Info.FileFormat = IMAGE_FILE_FORMAT_PNG;
+
+        RefCntAutoPtr<IDataBlob> pEncodedImage;
+        Image::Encode(Info, &pEncodedImage);
+
+        FileWrapper pFile(DiffFileName.c_str(), EFileAccessMode::Overwrite);
+        if (pEncodedImage && pFile && pFile->Write(pEncodedImage->GetDataPtr(), pEncodedImage->GetSize()))
+            LOG_INFO_MESSAGE("Golden image difference is saved to '", DiffFileName, "'.");
+        else
+            LOG_WARNING_MESSAGE("Failed to save golden image difference to '", DiffFileName, "'.");
     }
 
     m_ExitCode = NumBadPixels > 0 ? 10 : 0;
@@ -1007,6 +1505,24 @@ void SampleApp::SaveScreenCapture(const std::string& FileName, ScreenCapture::Ca
     pCtx->MapTextureSubresource(Capture.pTexture, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, TexData);
     const TextureDesc& TexDesc = Capture.pTexture->GetDesc();
 
+    if (m_pScreenCaptureWriter)
+    {
+        ScreenCaptureWriter::ImageInfo ImgInfo;
+        ImgInfo.FileName    = FileName;
+        ImgInfo.Width       = TexDesc.Width;
+        ImgInfo.Height      = TexDesc.Height;
+        ImgInfo.TexFormat   = TexDesc.Format;
+        ImgInfo.KeepAlpha   = m_ScreenCaptureInfo.KeepAlpha;
+        ImgInfo.FlipY       = m_pDevice->GetDeviceInfo().IsGLDevice();
+        ImgInfo.FileFormat  = m_ScreenCaptureInfo.FileFormat;
+        ImgInfo.JpegQuality = m_ScreenCaptureInfo.JpegQuality;
+
+        // The writer copies the data, so the texture can be unmapped and recycled right away
+        m_pScreenCaptureWriter->Enqueue(ImgInfo, TexData.pData, static_cast<Uint32>(TexData.Stride));
+        pCtx->UnmapTextureSubresource(Capture.pTexture, 0, 0);
+        return;
+    }
+
     Image::EncodeInfo Info;
     Info.Width       = TexDesc.Width;
     Info.Height      = TexDesc.Height;
@@ -1044,11 +1560,14 @@ void SampleApp::SaveScreenCapture(const std::string& FileName, ScreenCapture::Ca
 
 void SampleApp::Present()
 {
-    if (!m_pSwapChain)
+    if (!m_pSwapChain || m_bQuitRequested)
         return;
 
     IDeviceContext* const pCtx = GetImmediateContext();
 
+    if (m_pBenchmark)
+        m_BenchmarkInfo.PhaseStartTime = m_BenchmarkTimer.GetElapsedTime();
+
     if (m_pScreenCapture && m_ScreenCaptureInfo.FramesToCapture > 0)
     {
         if (m_CurrentTime - m_ScreenCaptureInfo.LastCaptureTime >= 1.0 / m_ScreenCaptureInfo.CaptureFPS)
@@ -1075,7 +1594,8 @@ void SampleApp::Present()
         }
     }
 
-    m_pSwapChain->Present(m_bVSync ? 1 : 0);
+    // VSync is always disabled in benchmark mode as it would clamp the frame time
+    m_pSwapChain->Present(m_bVSync && !m_pBenchmark ? 1 : 0);
 
     if (m_pScreenCapture)
     {
@@ -1114,6 +1634,65 @@ void SampleApp::Present()
             m_pScreenCapture->RecycleStagingTexture(std::move(Capture.pTexture));
         }
     }
+
+    if (m_pScreenCaptureWriter && m_ExitCode == 0)
+    {
+        // Do NOT reset the exit code to 0 if an error was reported earlier
+        m_ExitCode = m_pScreenCaptureWriter->GetErrorCode();
+    }
+
+    if (m_pBenchmark)
+    {
+        const double FrameEndTime = m_BenchmarkTimer.GetElapsedTime();
+        m_pBenchmark->RecordCPUTime(FrameBenchmark::TIMING_PRESENT, FrameEndTime - m_BenchmarkInfo.PhaseStartTime);
+        m_pBenchmark->RecordCPUTime(FrameBenchmark::TIMING_FRAME, FrameEndTime - m_BenchmarkInfo.FrameStartTime);
+        m_pBenchmark->EndFrame();
+        if (m_pBenchmark->IsComplete())
+            FinishBenchmark();
+    }
+}
+
+void SampleApp::FinishBenchmark()
+{
+    VERIFY_EXPR(m_pBenchmark && m_pBenchmark->IsComplete());
+
+    for (Uint32 q = 0; q < m_NumImmediateContexts; ++q)
+        m_pDeviceContexts[q]->WaitForIdle();
+
+    if (m_pScreenCaptureWriter)
+    {
+        m_pScreenCaptureWriter->WaitForIdle();
+        if (m_ExitCode == 0)
+            m_ExitCode = m_pScreenCaptureWriter->GetErrorCode();
+    }
+
+    const SwapChainDesc& SCDesc = m_pSwapChain->GetDesc();
+
+    FrameBenchmark::ReportInfo Info;
+    Info.SampleName  = m_TheSample->GetSampleName();
+    Info.DeviceType  = GetRenderDeviceTypeString(m_DeviceType);
+    Info.AdapterName = m_AdapterAttribs.Description;
+    Info.Width       = SCDesc.Width;
+    Info.Height      = SCDesc.Height;
+
+    for (Uint32 t = 0; t < FrameBenchmark::TIMING_COUNT; ++t)
+    {
+        const FrameBenchmark::TIMING     Timing = static_cast<FrameBenchmark::TIMING>(t);
+        const FrameBenchmark::Statistics Stats  = m_pBenchmark->ComputeStatistics(Timing);
+        if (Stats.NumSamples == 0)
+            continue;
+
+        std::stringstream ss;
+        ss << std::setw(12) << std::left << FrameBenchmark::GetTimingName(Timing) << std::fixed << std::setprecision(3)
+           << " p50: " << Stats.P50 * 1000.0 << " ms, p95: " << Stats.P95 * 1000.0 << " ms, p99: " << Stats.P99 * 1000.0 << " ms";
+        LOG_INFO_MESSAGE(ss.str());
+    }
+
+    if (!m_pBenchmark->WriteReport(m_BenchmarkInfo.ReportPath, Info))
+        m_ExitCode = 7;
+
+    // The platform main loop exits after this frame, and the app is destroyed normally
+    RequestQuit();
 }
 
 } // namespace Diligent
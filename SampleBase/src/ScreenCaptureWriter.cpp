@@ -0,0 +1,137 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ScreenCaptureWriter.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "Errors.hpp"
+#include "FileWrapper.hpp"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+ScreenCaptureWriter::ScreenCaptureWriter(Uint32 NumThreads, Uint32 MaxPendingImages) :
+    m_MaxPendingImages{std::max(MaxPendingImages, 1u)}
+{
+    ThreadPoolCreateInfo ThreadPoolCI;
+    ThreadPoolCI.NumThreads = std::max(NumThreads, 1u);
+    m_pThreadPool           = CreateThreadPool(ThreadPoolCI);
+}
+
+ScreenCaptureWriter::~ScreenCaptureWriter()
+{
+    // Stop the worker threads before the synchronization objects are destroyed
+    m_pThreadPool->WaitForAllTasks();
+    m_pThreadPool.Release();
+}
+
+void ScreenCaptureWriter::Enqueue(const ImageInfo& Info, const void* pData, Uint32 Stride)
+{
+    {
+        // Apply back-pressure: do not let the render thread get ahead of the encoders
+        std::unique_lock<std::mutex> Lock{m_PendingImagesMtx};
+        m_PendingImagesCV.wait(Lock, [this]() { return m_NumPendingImages < m_MaxPendingImages; });
+        ++m_NumPendingImages;
+    }
+
+    // Copy the rows into a tightly packed buffer so that the staging texture can be unmapped and recycled
+    const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(Info.TexFormat);
+
+    const Uint32 RowSize = Info.Width * Uint32{FmtAttribs.ComponentSize} * Uint32{FmtAttribs.NumComponents};
+    VERIFY_EXPR(RowSize <= Stride);
+
+    std::vector<Uint8> Pixels(size_t{RowSize} * size_t{Info.Height});
+    for (Uint32 row = 0; row < Info.Height; ++row)
+    {
+        std::memcpy(&Pixels[size_t{row} * RowSize], static_cast<const Uint8*>(pData) + size_t{row} * size_t{Stride}, RowSize);
+    }
+
+    EnqueueAsyncWork(m_pThreadPool,
+                     [this, Info, Pixels = std::move(Pixels), RowSize](Uint32 ThreadId) {
+                         WriteImage(Info, Pixels, RowSize);
+
+                         std::lock_guard<std::mutex> Lock{m_PendingImagesMtx};
+                         --m_NumPendingImages;
+                         m_PendingImagesCV.notify_all();
+
+                         return ASYNC_TASK_STATUS_COMPLETE;
+                     });
+}
+
+void ScreenCaptureWriter::WaitForIdle()
+{
+    std::unique_lock<std::mutex> Lock{m_PendingImagesMtx};
+    m_PendingImagesCV.wait(Lock, [this]() { return m_NumPendingImages == 0; });
+}
+
+void ScreenCaptureWriter::WriteImage(const ImageInfo& Info, const std::vector<Uint8>& Pixels, Uint32 Stride)
+{
+    Image::EncodeInfo EncodeInfo;
+    EncodeInfo.Width       = Info.Width;
+    EncodeInfo.Height      = Info.Height;
+    EncodeInfo.TexFormat   = Info.TexFormat;
+    EncodeInfo.KeepAlpha   = Info.KeepAlpha;
+    EncodeInfo.FlipY       = Info.FlipY;
+    EncodeInfo.pData       = Pixels.data();
+    EncodeInfo.Stride      = Stride;
+    EncodeInfo.FileFormat  = Info.FileFormat;
+    EncodeInfo.JpegQuality = Info.JpegQuality;
+
+    RefCntAutoPtr<IDataBlob> pEncodedImage;
+    Image::Encode(EncodeInfo, &pEncodedImage);
+    if (!pEncodedImage)
+    {
+        LOG_ERROR_MESSAGE("Failed to encode screen capture '", Info.FileName, "'.");
+        int Expected = 0;
+        m_ErrorCode.compare_exchange_strong(Expected, 5);
+        return;
+    }
+
+    FileWrapper pFile(Info.FileName.c_str(), EFileAccessMode::Overwrite);
+    if (pFile)
+    {
+        bool res = pFile->Write(pEncodedImage->GetDataPtr(), pEncodedImage->GetSize());
+        if (!res)
+        {
+            LOG_ERROR_MESSAGE("Failed to write screen capture file '", Info.FileName, "'.");
+            int Expected = 0;
+            m_ErrorCode.compare_exchange_strong(Expected, 5);
+        }
+        pFile.Close();
+    }
+    else
+    {
+        LOG_ERROR_MESSAGE("Failed to create screen capture file '", Info.FileName, "'. Verify that the directory exists and the app has sufficient rights to write to this directory.");
+        int Expected = 0;
+        m_ErrorCode.compare_exchange_strong(Expected, 6);
+    }
+}
+
+} // namespace Diligent
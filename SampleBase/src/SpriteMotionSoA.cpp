@@ -0,0 +1,116 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "SpriteMotionSoA.hpp"
+
+#include "Align.hpp"
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Maps the sprite index and the seed to a uniformly distributed number in [0, 1)
+float HashToUnitFloat(Uint32 Idx, Uint32 Seed)
+{
+    Uint32 h = Idx * 0x9E3779B9u ^ (Seed + 0x7F4A7C15u);
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return static_cast<float>(h >> 8) * (1.f / 16777216.f);
+}
+
+} // namespace
+
+void SpriteMotionSoA::Resize(Uint32 NumSprites)
+{
+    m_NumSprites = NumSprites;
+
+    // Padding lanes stay zero and never bounce
+    const size_t PaddedSize = AlignUp(NumSprites, SimdWidth);
+    for (std::vector<float>* pArray : {&m_PosX, &m_PosY, &m_MoveX, &m_MoveY, &m_Angle, &m_RotSpeed})
+        pArray->assign(PaddedSize, 0.f);
+}
+
+void SpriteMotionSoA::Update(Uint32 FirstSprite, Uint32 EndSprite, const UpdateAttribs& Attribs)
+{
+    VERIFY((FirstSprite % SimdWidth) == 0, "First sprite must be a multiple of the SIMD width");
+    VERIFY_EXPR(EndSprite <= m_NumSprites);
+    // The arrays are padded, so the last group may run past the end
+    EndSprite = AlignUp(EndSprite, SimdWidth);
+
+    const SimdFloat4 Zero  = SimdFloat4::Set(0.f);
+    const SimdFloat4 dt    = SimdFloat4::Set(Attribs.ElapsedTime);
+    const SimdFloat4 Bound = SimdFloat4::Set(Attribs.Bound);
+
+    float* const PosX     = m_PosX.data();
+    float* const PosY     = m_PosY.data();
+    float* const MoveX    = m_MoveX.data();
+    float* const MoveY    = m_MoveY.data();
+    float* const Angle    = m_Angle.data();
+    float* const RotSpeed = m_RotSpeed.data();
+
+    for (Uint32 i = FirstSprite; i < EndSprite; i += SimdWidth)
+    {
+        SimdFloat4 Px = SimdFloat4::Load(PosX + i);
+        SimdFloat4 Py = SimdFloat4::Load(PosY + i);
+        SimdFloat4 Mx = SimdFloat4::Load(MoveX + i);
+        SimdFloat4 My = SimdFloat4::Load(MoveY + i);
+
+        const SimdFloat4 Rot = SimdFloat4::Load(RotSpeed + i);
+        (SimdFloat4::Load(Angle + i) + Rot * dt).Store(Angle + i);
+
+        // Reverse the direction if the sprite would cross the boundary
+        const SimdMask4 BounceX = Abs(Px + Mx * dt) > Bound;
+        const SimdMask4 BounceY = Abs(Py + My * dt) > Bound;
+        Mx                      = Select(BounceX, Zero - Mx, Mx);
+        My                      = Select(BounceY, Zero - My, My);
+
+        (Px + Mx * dt).Store(PosX + i);
+        (Py + My * dt).Store(PosY + i);
+        Mx.Store(MoveX + i);
+        My.Store(MoveY + i);
+
+        // Bounces are rare, so new rotation speeds are generated one lane at a time
+        if (const Uint32 BounceBits = (BounceX | BounceY).GetBits())
+        {
+            for (Uint32 lane = 0; lane < SimdWidth; ++lane)
+            {
+                if (BounceBits & (1u << lane))
+                {
+                    const float t      = HashToUnitFloat(i + lane, Attribs.Seed);
+                    RotSpeed[i + lane] = Attribs.MinRotSpeed + (Attribs.MaxRotSpeed - Attribs.MinRotSpeed) * t;
+                }
+            }
+        }
+    }
+}
+
+} // namespace Diligent
@@ -0,0 +1,466 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "TiledImageDifference.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+
+#include "Errors.hpp"
+#include "ThreadPool.hpp"
+#include "SimdFloat4.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+constexpr Uint32 SSIMBlockSize = 8;
+
+inline Uint32 GetLuminance(const Uint8* pPixel, Uint32 NumChannels)
+{
+    if (NumChannels < 3)
+        return pPixel[0];
+
+    // Rec. 601 luma weights in 8-bit fixed point
+    return (Uint32{pPixel[0]} * 77u + Uint32{pPixel[1]} * 150u + Uint32{pPixel[2]} * 29u) >> 8u;
+}
+
+// Computes SSIM of the luminance of two blocks
+double ComputeBlockSSIM(const Uint8* pBlock1, Uint32 Stride1, Uint32 NumChannels1,
+                        const Uint8* pBlock2, Uint32 Stride2, Uint32 NumChannels2,
+                        Uint32 Width, Uint32 Height)
+{
+    constexpr double C1 = (0.01 * 255.0) * (0.01 * 255.0);
+    constexpr double C2 = (0.03 * 255.0) * (0.03 * 255.0);
+
+    Uint32 Sum1 = 0, Sum2 = 0;
+    Uint32 SqSum1 = 0, SqSum2 = 0, CrossSum = 0;
+    for (Uint32 y = 0; y < Height; ++y)
+    {
+        const Uint8* pRow1 = pBlock1 + size_t{y} * Stride1;
+        const Uint8* pRow2 = pBlock2 + size_t{y} * Stride2;
+        for (Uint32 x = 0; x < Width; ++x)
+        {
+            const Uint32 L1 = GetLuminance(pRow1 + size_t{x} * NumChannels1, NumChannels1);
+            const Uint32 L2 = GetLuminance(pRow2 + size_t{x} * NumChannels2, NumChannels2);
+            Sum1 += L1;
+            Sum2 += L2;
+            SqSum1 += L1 * L1;
+            SqSum2 += L2 * L2;
+            CrossSum += L1 * L2;
+        }
+    }
+
+    const double N     = static_cast<double>(Width * Height);
+    const double Mean1 = Sum1 / N;
+    const double Mean2 = Sum2 / N;
+    const double Var1  = SqSum1 / N - Mean1 * Mean1;
+    const double Var2  = SqSum2 / N - Mean2 * Mean2;
+    const double Covar = CrossSum / N - Mean1 * Mean2;
+    const double Numer = (2.0 * Mean1 * Mean2 + C1) * (2.0 * Covar + C2);
+    const double Denom = (Mean1 * Mean1 + Mean2 * Mean2 + C1) * (Var1 + Var2 + C2);
+    return Numer / Denom;
+}
+
+inline void WriteHeatMapPixel(Uint8* pDst, Uint32 Diff, Uint32 Threshold)
+{
+    if (Diff == 0)
+    {
+        pDst[0] = pDst[1] = pDst[2] = 0;
+    }
+    else if (Diff > Threshold)
+    {
+        pDst[0] = 255;
+        pDst[1] = 0;
+        pDst[2] = 0;
+    }
+    else
+    {
+        // Blue for the smallest difference, yellow for the difference at the threshold
+        const Uint32 t = Threshold > 0 ? (Diff * 255u) / Threshold : 255u;
+        pDst[0]        = static_cast<Uint8>(t);
+        pDst[1]        = static_cast<Uint8>(t);
+        pDst[2]        = static_cast<Uint8>(255u - t);
+    }
+    pDst[3] = 255;
+}
+
+#if DILIGENT_SIMD_SSE2 || DILIGENT_SIMD_NEON
+// Returns the number of leading pixels of a row that can be loaded four at a time with 16-byte loads
+// without reading past the end of the row
+template <Uint32 NumChannels>
+constexpr Uint32 GetNumVecPixels(Uint32 Width)
+{
+    // Four RGB8 pixels take 12 bytes, so the load reads 4 bytes of the next two pixels
+    return NumChannels == 4 ? (Width & ~3u) : (Width >= 2 ? ((Width - 2) & ~3u) : 0u);
+}
+
+#    if DILIGENT_SIMD_SSE2
+// Loads four RGB8 or RGBA8 pixels into the 32-bit lanes. The fourth byte of an RGB8 pixel is undefined.
+template <Uint32 NumChannels>
+inline __m128i LoadPixels4(const Uint8* pPixels)
+{
+    const __m128i Pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pPixels));
+    if (NumChannels == 4)
+        return Pixels;
+
+    // Pixel i starts at byte 3 * i
+    const __m128i Pixels01 = _mm_unpacklo_epi32(Pixels, _mm_srli_si128(Pixels, 3));
+    const __m128i Pixels23 = _mm_unpacklo_epi32(_mm_srli_si128(Pixels, 6), _mm_srli_si128(Pixels, 9));
+    return _mm_unpacklo_epi64(Pixels01, Pixels23);
+}
+#    elif DILIGENT_SIMD_NEON
+// Loads four RGB8 or RGBA8 pixels into the 32-bit lanes. The fourth byte of an RGB8 pixel is undefined.
+template <Uint32 NumChannels>
+inline uint8x16_t LoadPixels4(const Uint8* pPixels)
+{
+    const uint8x16_t Pixels = vld1q_u8(pPixels);
+    if (NumChannels == 4)
+        return Pixels;
+
+    // Pixel i starts at byte 3 * i
+    const uint32x2_t Pixels01 = vzip_u32(vget_low_u32(vreinterpretq_u32_u8(Pixels)), vget_low_u32(vreinterpretq_u32_u8(vextq_u8(Pixels, Pixels, 3)))).val[0];
+    const uint32x2_t Pixels23 = vzip_u32(vget_low_u32(vreinterpretq_u32_u8(vextq_u8(Pixels, Pixels, 6))), vget_low_u32(vreinterpretq_u32_u8(vextq_u8(Pixels, Pixels, 9)))).val[0];
+    return vreinterpretq_u8_u32(vcombine_u32(Pixels01, Pixels23));
+}
+#    endif
+
+// Compares the pixels of two RGB8 or RGBA8 rows four at a time and returns the number of processed pixels.
+// The remaining pixels are left to the scalar loop. Alpha is only compared if both images have it.
+template <Uint32 NumChannels1, Uint32 NumChannels2>
+Uint32 ProcessRow8(const Uint8*       pRow1,
+                   const Uint8*       pRow2,
+                   Uint32             Width,
+                   Uint32             Threshold,
+                   Uint8*             pDiffRow,
+                   ImageTileDiffInfo& Tile,
+                   Uint64&            SquaredError)
+{
+    // Every iteration adds up to 4 * 255^2 to a 32-bit lane of the squared error,
+    // so the accumulators are flushed before they can overflow.
+    constexpr Uint32 MaxPixelsPerChunk = 16384;
+    constexpr Uint32 ChannelMask       = NumChannels1 == 4 && NumChannels2 == 4 ? 0xFFFFFFFFu : 0x00FFFFFFu;
+
+    const Uint32 NumVecPixels = std::min(GetNumVecPixels<NumChannels1>(Width), GetNumVecPixels<NumChannels2>(Width));
+    for (Uint32 ChunkStart = 0; ChunkStart < NumVecPixels; ChunkStart += MaxPixelsPerChunk)
+    {
+        const Uint32 ChunkEnd = std::min(ChunkStart + MaxPixelsPerChunk, NumVecPixels);
+
+        alignas(16) Uint32 PixelDiffs[4];
+        alignas(16) Uint32 SqErrSums[4];
+        alignas(16) Uint32 NumDiffSums[4];
+        alignas(16) Uint32 NumAboveSums[4];
+        alignas(16) Uint32 MaxDiffs[4];
+
+#    if DILIGENT_SIMD_SSE2
+        const __m128i Zero     = _mm_setzero_si128();
+        const __m128i ByteMask = _mm_set1_epi32(0xFF);
+        const __m128i ChMask   = _mm_set1_epi32(static_cast<int>(ChannelMask));
+        const __m128i ThrVec   = _mm_set1_epi32(static_cast<int>(std::min(Threshold, 255u)));
+
+        __m128i SqErr    = Zero;
+        __m128i NumDiff  = Zero;
+        __m128i NumAbove = Zero;
+        __m128i MaxDiff  = Zero;
+        for (Uint32 x = ChunkStart; x < ChunkEnd; x += 4)
+        {
+            const __m128i Pixels1 = LoadPixels4<NumChannels1>(pRow1 + size_t{x} * NumChannels1);
+            const __m128i Pixels2 = LoadPixels4<NumChannels2>(pRow2 + size_t{x} * NumChannels2);
+            const __m128i AbsDiff = _mm_and_si128(_mm_or_si128(_mm_subs_epu8(Pixels1, Pixels2), _mm_subs_epu8(Pixels2, Pixels1)), ChMask);
+
+            const __m128i AbsDiffLo = _mm_unpacklo_epi8(AbsDiff, Zero);
+            const __m128i AbsDiffHi = _mm_unpackhi_epi8(AbsDiff, Zero);
+            SqErr                   = _mm_add_epi32(SqErr, _mm_add_epi32(_mm_madd_epi16(AbsDiffLo, AbsDiffLo), _mm_madd_epi16(AbsDiffHi, AbsDiffHi)));
+
+            // Maximum channel difference of every pixel in its 32-bit lane
+            __m128i PixelDiff = _mm_max_epu8(AbsDiff, _mm_srli_epi32(AbsDiff, 16));
+            PixelDiff         = _mm_max_epu8(PixelDiff, _mm_srli_epi32(PixelDiff, 8));
+            PixelDiff         = _mm_and_si128(PixelDiff, ByteMask);
+
+            // Comparison results are all ones, so subtracting them counts the pixels
+            NumDiff  = _mm_sub_epi32(NumDiff, _mm_cmpgt_epi32(PixelDiff, Zero));
+            NumAbove = _mm_sub_epi32(NumAbove, _mm_cmpgt_epi32(PixelDiff, ThrVec));
+            MaxDiff  = _mm_max_epu8(MaxDiff, PixelDiff);
+
+            if (pDiffRow != nullptr)
+            {
+                _mm_store_si128(reinterpret_cast<__m128i*>(PixelDiffs), PixelDiff);
+                for (Uint32 i = 0; i < 4; ++i)
+                    WriteHeatMapPixel(pDiffRow + size_t{x + i} * 4, PixelDiffs[i], Threshold);
+            }
+        }
+        _mm_store_si128(reinterpret_cast<__m128i*>(SqErrSums), SqErr);
+        _mm_store_si128(reinterpret_cast<__m128i*>(NumDiffSums), NumDiff);
+        _mm_store_si128(reinterpret_cast<__m128i*>(NumAboveSums), NumAbove);
+        _mm_store_si128(reinterpret_cast<__m128i*>(MaxDiffs), MaxDiff);
+#    elif DILIGENT_SIMD_NEON
+        const uint32x4_t Zero     = vdupq_n_u32(0);
+        const uint32x4_t ByteMask = vdupq_n_u32(0xFF);
+        const uint8x16_t ChMask   = vreinterpretq_u8_u32(vdupq_n_u32(ChannelMask));
+        const uint32x4_t ThrVec   = vdupq_n_u32(std::min(Threshold, 255u));
+
+        uint32x4_t SqErr    = Zero;
+        uint32x4_t NumDiff  = Zero;
+        uint32x4_t NumAbove = Zero;
+        uint32x4_t MaxDiff  = Zero;
+        for (Uint32 x = ChunkStart; x < ChunkEnd; x += 4)
+        {
+            const uint8x16_t Pixels1 = LoadPixels4<NumChannels1>(pRow1 + size_t{x} * NumChannels1);
+            const uint8x16_t Pixels2 = LoadPixels4<NumChannels2>(pRow2 + size_t{x} * NumChannels2);
+            const uint8x16_t AbsDiff = vandq_u8(vabdq_u8(Pixels1, Pixels2), ChMask);
+
+            SqErr = vpadalq_u16(SqErr, vmull_u8(vget_low_u8(AbsDiff), vget_low_u8(AbsDiff)));
+            SqErr = vpadalq_u16(SqErr, vmull_u8(vget_high_u8(AbsDiff), vget_high_u8(AbsDiff)));
+
+            // Maximum channel difference of every pixel in its 32-bit lane
+            uint8x16_t MaxBytes = vmaxq_u8(AbsDiff, vreinterpretq_u8_u32(vshrq_n_u32(vreinterpretq_u32_u8(AbsDiff), 16)));
+            MaxBytes            = vmaxq_u8(MaxBytes, vreinterpretq_u8_u32(vshrq_n_u32(vreinterpretq_u32_u8(MaxBytes), 8)));
+
+            const uint32x4_t PixelDiff = vandq_u32(vreinterpretq_u32_u8(MaxBytes), ByteMask);
+
+            // Comparison results are all ones, so subtracting them counts the pixels
+            NumDiff  = vsubq_u32(NumDiff, vcgtq_u32(PixelDiff, Zero));
+            NumAbove = vsubq_u32(NumAbove, vcgtq_u32(PixelDiff, ThrVec));
+            MaxDiff  = vmaxq_u32(MaxDiff, PixelDiff);
+
+            if (pDiffRow != nullptr)
+            {
+                vst1q_u32(PixelDiffs, PixelDiff);
+                for (Uint32 i = 0; i < 4; ++i)
+                    WriteHeatMapPixel(pDiffRow + size_t{x + i} * 4, PixelDiffs[i], Threshold);
+            }
+        }
+        vst1q_u32(SqErrSums, SqErr);
+        vst1q_u32(NumDiffSums, NumDiff);
+        vst1q_u32(NumAboveSums, NumAbove);
+        vst1q_u32(MaxDiffs, MaxDiff);
+#    endif
+
+        for (Uint32 i = 0; i < 4; ++i)
+        {
+            SquaredError += SqErrSums[i];
+            Tile.NumDiffPixels += NumDiffSums[i];
+            Tile.NumDiffPixelsAboveThreshold += NumAboveSums[i];
+            Tile.MaxDiff = std::max(Tile.MaxDiff, MaxDiffs[i]);
+        }
+    }
+
+    return NumVecPixels;
+}
+
+using ProcessRowFuncType = Uint32 (*)(const Uint8*, const Uint8*, Uint32, Uint32, Uint8*, ImageTileDiffInfo&, Uint64&);
+
+// Returns the vectorized row function for the channel counts, or null if there is none
+ProcessRowFuncType GetProcessRowFunc(Uint32 NumChannels1, Uint32 NumChannels2)
+{
+    if (NumChannels1 == 4 && NumChannels2 == 4)
+        return ProcessRow8<4, 4>;
+    if (NumChannels1 == 3 && NumChannels2 == 3)
+        return ProcessRow8<3, 3>;
+    if (NumChannels1 == 3 && NumChannels2 == 4)
+        return ProcessRow8<3, 4>;
+    if (NumChannels1 == 4 && NumChannels2 == 3)
+        return ProcessRow8<4, 3>;
+    return nullptr;
+}
+#endif
+
+void ProcessTile(const TiledImageDifferenceAttribs& Attribs, ImageTileDiffInfo& Tile)
+{
+    const Uint32 NumChannels = std::min(Attribs.NumChannels1, Attribs.NumChannels2);
+
+    const Uint8* const pImage1 = static_cast<const Uint8*>(Attribs.pImage1);
+    const Uint8* const pImage2 = static_cast<const Uint8*>(Attribs.pImage2);
+
+#if DILIGENT_SIMD_SSE2 || DILIGENT_SIMD_NEON
+    const ProcessRowFuncType ProcessRow = GetProcessRowFunc(Attribs.NumChannels1, Attribs.NumChannels2);
+#endif
+
+    Uint64 SquaredError = 0;
+    for (Uint32 y = Tile.Y; y < Tile.Y + Tile.Height; ++y)
+    {
+        const Uint8* pRow1    = pImage1 + size_t{y} * Attribs.Stride1 + size_t{Tile.X} * Attribs.NumChannels1;
+        const Uint8* pRow2    = pImage2 + size_t{y} * Attribs.Stride2 + size_t{Tile.X} * Attribs.NumChannels2;
+        Uint8*       pDiffRow = nullptr;
+        if (Attribs.pDiffImage != nullptr)
+            pDiffRow = static_cast<Uint8*>(Attribs.pDiffImage) + size_t{y} * Attribs.DiffStride + size_t{Tile.X} * 4;
+
+        Uint32 x = 0;
+#if DILIGENT_SIMD_SSE2 || DILIGENT_SIMD_NEON
+        // Fast path for RGB8 and RGBA8 images, e.g. the golden image and the capture converted to RGB8
+        if (ProcessRow != nullptr)
+            x = ProcessRow(pRow1, pRow2, Tile.Width, Attribs.Threshold, pDiffRow, Tile, SquaredError);
+#endif
+        for (; x < Tile.Width; ++x)
+        {
+            const Uint8* pPixel1 = pRow1 + size_t{x} * Attribs.NumChannels1;
+            const Uint8* pPixel2 = pRow2 + size_t{x} * Attribs.NumChannels2;
+
+            Uint32 PixelDiff = 0;
+            for (Uint32 c = 0; c < NumChannels; ++c)
+            {
+                const int    d       = static_cast<int>(pPixel1[c]) - static_cast<int>(pPixel2[c]);
+                const Uint32 AbsDiff = static_cast<Uint32>(d >= 0 ? d : -d);
+                PixelDiff            = std::max(PixelDiff, AbsDiff);
+                SquaredError += AbsDiff * AbsDiff;
+            }
+
+            Tile.NumDiffPixels += PixelDiff > 0 ? 1 : 0;
+            Tile.NumDiffPixelsAboveThreshold += PixelDiff > Attribs.Threshold ? 1 : 0;
+            Tile.MaxDiff = std::max(Tile.MaxDiff, PixelDiff);
+
+            if (pDiffRow != nullptr)
+                WriteHeatMapPixel(pDiffRow + size_t{x} * 4, PixelDiff, Attribs.Threshold);
+        }
+    }
+    Tile.SquaredError = static_cast<double>(SquaredError);
+
+    if (Tile.NumDiffPixels == 0)
+    {
+        Tile.SSIM = 1;
+        return;
+    }
+
+    double SSIMSum   = 0;
+    Uint32 NumBlocks = 0;
+    for (Uint32 by = Tile.Y; by < Tile.Y + Tile.Height; by += SSIMBlockSize)
+    {
+        for (Uint32 bx = Tile.X; bx < Tile.X + Tile.Width; bx += SSIMBlockSize)
+        {
+            const Uint32 BlockW = std::min(SSIMBlockSize, Tile.X + Tile.Width - bx);
+            const Uint32 BlockH = std::min(SSIMBlockSize, Tile.Y + Tile.Height - by);
+            SSIMSum += ComputeBlockSSIM(pImage1 + size_t{by} * Attribs.Stride1 + size_t{bx} * Attribs.NumChannels1, Attribs.Stride1, Attribs.NumChannels1,
+                                        pImage2 + size_t{by} * Attribs.Stride2 + size_t{bx} * Attribs.NumChannels2, Attribs.Stride2, Attribs.NumChannels2,
+                                        BlockW, BlockH);
+            ++NumBlocks;
+        }
+    }
+    Tile.SSIM = NumBlocks > 0 ? SSIMSum / NumBlocks : 1.0;
+}
+
+} // namespace
+
+void ComputeTiledImageDifference(const TiledImageDifferenceAttribs& Attribs, TiledImageDiffInfo& DiffInfo)
+{
+    DiffInfo = {};
+
+    if (Attribs.pImage1 == nullptr || Attribs.pImage2 == nullptr)
+    {
+        UNEXPECTED("Image pointers must not be null");
+        return;
+    }
+    if (Attribs.pDiffImage != nullptr && Attribs.DiffStride < Attribs.Width * 4)
+    {
+        UNEXPECTED("Heat-map image stride (", Attribs.DiffStride, ") is too small");
+        return;
+    }
+
+    const Uint32 TileSize  = std::max(Attribs.TileSize, SSIMBlockSize);
+    const Uint32 NumTilesX = (Attribs.Width + TileSize - 1) / TileSize;
+    const Uint32 NumTilesY = (Attribs.Height + TileSize - 1) / TileSize;
+
+    DiffInfo.Tiles.resize(size_t{NumTilesX} * size_t{NumTilesY});
+    for (Uint32 ty = 0; ty < NumTilesY; ++ty)
+    {
+        for (Uint32 tx = 0; tx < NumTilesX; ++tx)
+        {
+            ImageTileDiffInfo& Tile = DiffInfo.Tiles[size_t{ty} * NumTilesX + tx];
+
+            Tile.X      = tx * TileSize;
+            Tile.Y      = ty * TileSize;
+            Tile.Width  = std::min(TileSize, Attribs.Width - Tile.X);
+            Tile.Height = std::min(TileSize, Attribs.Height - Tile.Y);
+        }
+    }
+
+    // Workers pull tiles from the shared counter, so the load is balanced even when some tiles are more expensive
+    std::atomic<size_t> NextTile{0};
+
+    auto ProcessTiles = [&]() {
+        for (size_t t = NextTile.fetch_add(1); t < DiffInfo.Tiles.size(); t = NextTile.fetch_add(1))
+            ProcessTile(Attribs, DiffInfo.Tiles[t]);
+    };
+
+    if (Attribs.pThreadPool != nullptr && Attribs.NumWorkers > 0 && DiffInfo.Tiles.size() > 1)
+    {
+        const Uint32 NumWorkers = std::min(Attribs.NumWorkers, static_cast<Uint32>(DiffInfo.Tiles.size()) - 1);
+
+        std::mutex              WorkersMtx;
+        std::condition_variable WorkersCV;
+        Uint32                  NumRunningWorkers = NumWorkers;
+        for (Uint32 i = 0; i < NumWorkers; ++i)
+        {
+            EnqueueAsyncWork(Attribs.pThreadPool,
+                             [&](Uint32 ThreadId) {
+                                 ProcessTiles();
+
+                                 std::lock_guard<std::mutex> Lock{WorkersMtx};
+                                 --NumRunningWorkers;
+                                 WorkersCV.notify_one();
+
+                                 return ASYNC_TASK_STATUS_COMPLETE;
+                             });
+        }
+
+        ProcessTiles();
+
+        std::unique_lock<std::mutex> Lock{WorkersMtx};
+        WorkersCV.wait(Lock, [&]() { return NumRunningWorkers == 0; });
+    }
+    else
+    {
+        ProcessTiles();
+    }
+
+    double SquaredError = 0;
+    double SSIMSum      = 0;
+    for (const ImageTileDiffInfo& Tile : DiffInfo.Tiles)
+    {
+        DiffInfo.NumDiffPixels += Tile.NumDiffPixels;
+        DiffInfo.NumDiffPixelsAboveThreshold += Tile.NumDiffPixelsAboveThreshold;
+        DiffInfo.MaxDiff = std::max(DiffInfo.MaxDiff, Tile.MaxDiff);
+        SquaredError += Tile.SquaredError;
+        // Weigh the tile SSIM by its area so that partial edge tiles do not skew the result
+        SSIMSum += Tile.SSIM * Tile.Width * Tile.Height;
+    }
+
+    const double NumPixels   = static_cast<double>(Attribs.Width) * static_cast<double>(Attribs.Height);
+    const Uint32 NumChannels = std::min(Attribs.NumChannels1, Attribs.NumChannels2);
+    if (NumPixels > 0)
+    {
+        const double MSE = SquaredError / (NumPixels * NumChannels);
+        DiffInfo.PSNR    = MSE > 0 ? 10.0 * std::log10(255.0 * 255.0 / MSE) : std::numeric_limits<double>::infinity();
+        DiffInfo.SSIM    = SSIMSum / NumPixels;
+    }
+}
+
+} // namespace Diligent
@@ -217,6 +217,12 @@ public:
 
 
 protected:
+    virtual void RequestQuit() override final
+    {
+        SampleApp::RequestQuit();
+        PostQuitMessage(m_ExitCode);
+    }
+
     void ToggleFullscreenWindow()
     {
         // Ignore if we are in exclusive fullscreen mode
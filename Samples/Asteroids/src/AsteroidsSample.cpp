@@ -0,0 +1,353 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "AsteroidsSample.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "CommandLineParser.hpp"
+#include "GraphicsAccessories.hpp"
+#include "imgui.h"
+#include "ImGuiUtils.hpp"
+
+namespace Diligent
+{
+
+SampleBase* CreateSample()
+{
+    return new AsteroidsSample();
+}
+
+AsteroidsSample::~AsteroidsSample()
+{
+    // Stop the worker threads before the simulation is destroyed
+    m_pRenderer.reset();
+}
+
+const char* AsteroidsSample::GetBindingModeName(int Mode)
+{
+    switch (Mode)
+    {
+        case BINDING_MODE_DYNAMIC: return "dynamic";
+        case BINDING_MODE_MUTABLE: return "mutable";
+        case BINDING_MODE_TEXTURE_MUTABLE: return "texture_mutable";
+        case BINDING_MODE_BINDLESS: return "bindless";
+        case BINDING_MODE_GPU_DRIVEN: return "gpu_driven";
+        default:
+            UNEXPECTED("Unexpected binding mode");
+            return "unknown";
+    }
+}
+
+AsteroidsSample::CommandLineStatus AsteroidsSample::ProcessCommandLine(int argc, const char* const* argv)
+{
+    CommandLineParser ArgsParser{argc, argv};
+    ArgsParser.Parse("threads", 't', m_NumThreads);
+    if (ArgsParser.Parse("binding_mode", 'b', m_Settings.resourceBindingMode))
+    {
+        m_Settings.resourceBindingMode = clamp(m_Settings.resourceBindingMode, 0, BINDING_MODE_COUNT - 1);
+    }
+    bool SingleThreaded = false;
+    if (ArgsParser.Parse("single_threaded", 's', SingleThreaded))
+    {
+        m_Settings.multithreadedRendering = !SingleThreaded;
+    }
+    ArgsParser.Parse("binding_mode_frames", m_BenchmarkModeFrames);
+    ArgsParser.Parse("binding_mode_warmup", m_BenchmarkModeWarmupFrames);
+    ArgsParser.Parse("binding_mode_report", m_BenchmarkReportPath);
+    ArgsParser.Parse("texture_cache", m_TextureCacheDir);
+
+    return CommandLineStatus::OK;
+}
+
+void AsteroidsSample::ModifyEngineInitInfo(const ModifyEngineInitInfoAttribs& Attribs)
+{
+    SampleBase::ModifyEngineInitInfo(Attribs);
+
+    if (m_NumThreads <= 0)
+        m_NumThreads = std::max(static_cast<int>(std::thread::hardware_concurrency()) - 1, 2);
+    m_NumThreads = std::min(m_NumThreads, 32);
+
+    // Every subset except for the first one is recorded into its own deferred context
+    Attribs.EngineCI.NumDeferredContexts = static_cast<Uint32>(m_NumThreads - 1);
+
+    // Asteroid shaders output linear color and use reversed depth
+    Attribs.SCDesc.ColorBufferFormat = TEX_FORMAT_RGBA8_UNORM_SRGB;
+    Attribs.SCDesc.DepthBufferFormat = TEX_FORMAT_D32_FLOAT;
+    Attribs.SCDesc.DefaultDepthValue = 0.f;
+
+#if D3D12_SUPPORTED
+    if (Attribs.DeviceType == RENDER_DEVICE_TYPE_D3D12)
+    {
+        EngineD3D12CreateInfo& EngineD3D12CI          = static_cast<EngineD3D12CreateInfo&>(Attribs.EngineCI);
+        EngineD3D12CI.GPUDescriptorHeapDynamicSize[0] = 65536 * 4;
+        EngineD3D12CI.GPUDescriptorHeapSize[0]        = 65536; // For mutable mode
+    }
+#endif
+#if VULKAN_SUPPORTED
+    if (Attribs.DeviceType == RENDER_DEVICE_TYPE_VULKAN)
+    {
+        EngineVkCreateInfo& EngineVkCI = static_cast<EngineVkCreateInfo&>(Attribs.EngineCI);
+        EngineVkCI.DynamicHeapSize     = 64 << 20;
+    }
+#endif
+}
+
+bool AsteroidsSample::IsBindingModeSupported(int Mode) const
+{
+    switch (Mode)
+    {
+        case BINDING_MODE_BINDLESS: return m_pDevice->GetDeviceInfo().Features.BindlessResources;
+        case BINDING_MODE_GPU_DRIVEN: return AsteroidsDE::Asteroids::IsGPUDrivenModeSupported(m_pDevice);
+        default: return true;
+    }
+}
+
+void AsteroidsSample::Initialize(const SampleInitInfo& InitInfo)
+{
+    SampleBase::Initialize(InitInfo);
+
+    m_Settings.numThreads = m_NumThreads;
+    if (m_pDeferredContexts.empty())
+    {
+        // All subsets are rendered by the immediate context
+        m_Settings.multithreadedRendering = false;
+    }
+
+    m_pSimulation = std::make_unique<::AsteroidsSimulation>(1337, NUM_ASTEROIDS, NUM_UNIQUE_MESHES, MESH_MAX_SUBDIV_LEVELS, NUM_UNIQUE_TEXTURES,
+                                                            m_TextureCacheDir.empty() ? nullptr : m_TextureCacheDir.c_str());
+
+    {
+        auto center    = DirectX::XMVectorSet(0.0f, -0.4f * SIM_DISC_RADIUS, 0.0f, 0.0f);
+        auto radius    = SIM_ORBIT_RADIUS + SIM_DISC_RADIUS + 10.f;
+        auto minRadius = SIM_ORBIT_RADIUS - 3.0f * SIM_DISC_RADIUS;
+        auto maxRadius = SIM_ORBIT_RADIUS + 3.0f * SIM_DISC_RADIUS;
+        auto longAngle = 4.50f;
+        auto latAngle  = 1.45f;
+        m_Camera.View(center, radius, minRadius, maxRadius, longAngle, latAngle);
+    }
+    const SwapChainDesc& SCDesc = m_pSwapChain->GetDesc();
+    WindowResize(SCDesc.Width, SCDesc.Height);
+
+    if (m_BenchmarkModeFrames > 0)
+    {
+        StartNextBenchmarkMode();
+    }
+    else
+    {
+        if (!IsBindingModeSupported(m_Settings.resourceBindingMode))
+        {
+            LOG_WARNING_MESSAGE("Binding mode '", GetBindingModeName(m_Settings.resourceBindingMode), "' is not supported by this device. Using texture-mutable mode.");
+            m_Settings.resourceBindingMode = BINDING_MODE_TEXTURE_MUTABLE;
+        }
+        CreateRenderer();
+    }
+}
+
+void AsteroidsSample::CreateRenderer()
+{
+    // Release the old renderer first to stop its worker threads
+    m_pRenderer.reset();
+
+    std::vector<IDeviceContext*> pDeferredCtxs(m_pDeferredContexts.size());
+    for (size_t ctx = 0; ctx < m_pDeferredContexts.size(); ++ctx)
+        pDeferredCtxs[ctx] = m_pDeferredContexts[ctx];
+
+    m_pRenderer = std::make_unique<AsteroidsDE::Asteroids>(m_Settings, m_pSimulation.get(), &m_GUI,
+                                                           m_pDevice, m_pImmediateContext,
+                                                           pDeferredCtxs.data(), static_cast<Uint32>(pDeferredCtxs.size()),
+                                                           m_pSwapChain);
+    m_Settings.resourceBindingMode = m_pRenderer->GetResourceBindingMode();
+
+    m_FilteredUpdateTime = 0;
+    m_FilteredRenderTime = 0;
+}
+
+void AsteroidsSample::StartNextBenchmarkMode()
+{
+    do
+    {
+        ++m_BenchmarkMode;
+    } while (m_BenchmarkMode < BINDING_MODE_COUNT && !IsBindingModeSupported(m_BenchmarkMode));
+
+    if (m_BenchmarkMode >= BINDING_MODE_COUNT)
+    {
+        // All modes have been measured; keep rendering with the last one
+        m_pModeBenchmark.reset();
+        return;
+    }
+
+    m_Settings.resourceBindingMode = m_BenchmarkMode;
+    CreateRenderer();
+    m_pModeBenchmark = std::make_unique<FrameBenchmark>(m_BenchmarkModeWarmupFrames, m_BenchmarkModeFrames, 0.0);
+}
+
+void AsteroidsSample::FinishBenchmarkMode()
+{
+    VERIFY_EXPR(m_pModeBenchmark && m_pModeBenchmark->IsComplete());
+
+    const FrameBenchmark::Statistics UpdateStats = m_pModeBenchmark->ComputeStatistics(FrameBenchmark::TIMING_UPDATE);
+    const FrameBenchmark::Statistics RenderStats = m_pModeBenchmark->ComputeStatistics(FrameBenchmark::TIMING_RENDER);
+
+    std::stringstream ss;
+    ss << "Asteroids " << std::setw(16) << std::left << GetBindingModeName(m_BenchmarkMode) << std::fixed << std::setprecision(3)
+       << " (" << (m_Settings.multithreadedRendering ? m_NumThreads : 1) << "t)"
+       << " update p50: " << UpdateStats.P50 * 1000.0 << " ms, p95: " << UpdateStats.P95 * 1000.0 << " ms;"
+       << " render p50: " << RenderStats.P50 * 1000.0 << " ms, p95: " << RenderStats.P95 * 1000.0 << " ms";
+    LOG_INFO_MESSAGE(ss.str());
+
+    if (!m_BenchmarkReportPath.empty())
+    {
+        // bench.json -> bench_bindless.json
+        std::string  ReportPath = m_BenchmarkReportPath;
+        const size_t DotPos     = ReportPath.find_last_of('.');
+        const size_t SlashPos   = ReportPath.find_last_of("/\\");
+        const size_t InsertPos  = (DotPos != std::string::npos && (SlashPos == std::string::npos || DotPos > SlashPos)) ? DotPos : ReportPath.length();
+        ReportPath.insert(InsertPos, std::string{"_"} + GetBindingModeName(m_BenchmarkMode));
+
+        const std::string SampleName = std::string{"Asteroids "} + GetBindingModeName(m_BenchmarkMode);
+
+        const SwapChainDesc& SCDesc = m_pSwapChain->GetDesc();
+
+        FrameBenchmark::ReportInfo Info;
+        Info.SampleName  = SampleName.c_str();
+        Info.DeviceType  = GetRenderDeviceTypeString(m_pDevice->GetDeviceInfo().Type);
+        Info.AdapterName = m_pDevice->GetAdapterInfo().Description;
+        Info.Width       = SCDesc.Width;
+        Info.Height      = SCDesc.Height;
+        m_pModeBenchmark->WriteReport(ReportPath, Info);
+    }
+}
+
+void AsteroidsSample::UpdateCamera()
+{
+    const MouseState& Mouse = m_InputController.GetMouseState();
+    if (!ImGui::GetIO().WantCaptureMouse)
+    {
+        if ((Mouse.ButtonFlags & MouseState::BUTTON_FLAG_LEFT) != 0 &&
+            (m_PrevMouse.ButtonFlags & MouseState::BUTTON_FLAG_LEFT) != 0)
+        {
+            m_Camera.OrbitX((Mouse.PosX - m_PrevMouse.PosX) * 0.005f);
+            m_Camera.OrbitY(-(Mouse.PosY - m_PrevMouse.PosY) * 0.005f);
+        }
+        if (Mouse.WheelDelta != 0)
+        {
+            m_Camera.ZoomRadius(-10.f * Mouse.WheelDelta);
+        }
+    }
+    m_PrevMouse = Mouse;
+}
+
+void AsteroidsSample::Update(double CurrTime, double ElapsedTime, bool DoUpdateUI)
+{
+    SampleBase::Update(CurrTime, ElapsedTime, DoUpdateUI);
+
+    UpdateCamera();
+
+    // Maintaining absolute time sync is not important in this demo so we can err on the "smoother" side
+    const float Alpha = 0.2f;
+    m_FrameTime       = Alpha * static_cast<float>(ElapsedTime) + (1.0f - Alpha) * m_FrameTime;
+
+    if (m_pModeBenchmark && m_pModeBenchmark->IsComplete())
+    {
+        FinishBenchmarkMode();
+        StartNextBenchmarkMode();
+    }
+    else if (m_pRenderer && m_pRenderer->GetResourceBindingMode() != m_Settings.resourceBindingMode)
+    {
+        // Binding mode was changed in the UI
+        CreateRenderer();
+    }
+}
+
+void AsteroidsSample::Render()
+{
+    m_pRenderer->Render(m_FrameTime, m_Camera, m_Settings);
+
+    float UpdateTime = 0;
+    float RenderTime = 0;
+    m_pRenderer->GetPerfCounters(UpdateTime, RenderTime);
+
+    const float FilterScale = 0.02f;
+    m_FilteredUpdateTime    = m_FilteredUpdateTime * (1.f - FilterScale) + FilterScale * UpdateTime;
+    m_FilteredRenderTime    = m_FilteredRenderTime * (1.f - FilterScale) + FilterScale * RenderTime;
+
+    if (m_pModeBenchmark)
+    {
+        m_pModeBenchmark->RecordCPUTime(FrameBenchmark::TIMING_UPDATE, UpdateTime);
+        m_pModeBenchmark->RecordCPUTime(FrameBenchmark::TIMING_RENDER, RenderTime);
+        m_pModeBenchmark->EndFrame();
+    }
+}
+
+void AsteroidsSample::WindowResize(Uint32 Width, Uint32 Height)
+{
+    if (Width != 0 && Height != 0)
+    {
+        const float Aspect = static_cast<float>(Width) / static_cast<float>(Height);
+        m_Camera.Projection(DirectX::XM_PIDIV2 * 0.8f * 3 / 2, Aspect);
+    }
+}
+
+void AsteroidsSample::UpdateUI()
+{
+    ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_FirstUseEver);
+    if (ImGui::Begin("Settings", nullptr, ImGuiWindowFlags_AlwaysAutoResize))
+    {
+        {
+            // Binding mode is controlled by the benchmark
+            ImGui::ScopedDisabler Disable(m_pModeBenchmark != nullptr);
+
+            const char* ModeNames[BINDING_MODE_COUNT] = {"Dynamic", "Mutable", "Texture mutable", "Bindless", "GPU-driven"};
+            // GPU-driven mode requires bindless resources, so unsupported modes are always at the end of the list
+            int NumModes = BINDING_MODE_BINDLESS;
+            if (IsBindingModeSupported(BINDING_MODE_BINDLESS))
+                NumModes = IsBindingModeSupported(BINDING_MODE_GPU_DRIVEN) ? BINDING_MODE_COUNT : BINDING_MODE_GPU_DRIVEN;
+            ImGui::Combo("Binding mode", &m_Settings.resourceBindingMode, ModeNames, NumModes);
+        }
+        {
+            ImGui::ScopedDisabler Disable(m_pDeferredContexts.empty());
+            ImGui::Checkbox("Multithreaded", &m_Settings.multithreadedRendering);
+        }
+        ImGui::Checkbox("Animate", &m_Settings.animate);
+
+        ImGui::Text("Threads: %d", m_Settings.multithreadedRendering ? m_NumThreads : 1);
+        ImGui::Text("Update: %4.2f ms", m_FilteredUpdateTime * 1000.f);
+        ImGui::Text("Render: %4.2f ms", m_FilteredRenderTime * 1000.f);
+
+        if (m_pModeBenchmark)
+        {
+            ImGui::Text("Benchmarking %s mode", GetBindingModeName(m_BenchmarkMode));
+        }
+    }
+    ImGui::End();
+}
+
+} // namespace Diligent
@@ -0,0 +1,116 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "SampleBase.hpp"
+#include "FrameBenchmark.hpp"
+
+#include "asteroids_DE.h"
+
+namespace Diligent
+{
+
+/// Platform-neutral driver for the Diligent Engine Asteroids renderer.
+///
+/// \remarks    The renderer uses the device, contexts and swap chain created by the sample
+///             application. When the binding mode benchmark is enabled, the sample
+///             cycles through all binding modes supported by the device and reports the
+///             update and render times measured by the renderer for each mode.
+class AsteroidsSample final : public SampleBase
+{
+public:
+    ~AsteroidsSample() override;
+
+    virtual CommandLineStatus ProcessCommandLine(int argc, const char* const* argv) override final;
+
+    virtual void ModifyEngineInitInfo(const ModifyEngineInitInfoAttribs& Attribs) override final;
+
+    virtual void Initialize(const SampleInitInfo& InitInfo) override final;
+
+    virtual void Render() override final;
+    virtual void Update(double CurrTime, double ElapsedTime, bool DoUpdateUI) override final;
+
+    virtual void WindowResize(Uint32 Width, Uint32 Height) override final;
+
+    virtual const Char* GetSampleName() const override final { return "Asteroids"; }
+
+protected:
+    virtual void UpdateUI() override final;
+
+private:
+    // Matches AsteroidsDE::Asteroids::BindingMode
+    enum BINDING_MODE : int
+    {
+        BINDING_MODE_DYNAMIC = 0,
+        BINDING_MODE_MUTABLE,
+        BINDING_MODE_TEXTURE_MUTABLE,
+        BINDING_MODE_BINDLESS,
+        BINDING_MODE_GPU_DRIVEN,
+        BINDING_MODE_COUNT
+    };
+    static const char* GetBindingModeName(int Mode);
+
+    bool IsBindingModeSupported(int Mode) const;
+    void CreateRenderer();
+    void UpdateCamera();
+    void StartNextBenchmarkMode();
+    void FinishBenchmarkMode();
+
+    ::Settings                              m_Settings;
+    ::OrbitCamera                           m_Camera;
+    ::GUI                                   m_GUI;
+    std::unique_ptr<::AsteroidsSimulation>  m_pSimulation;
+    std::unique_ptr<AsteroidsDE::Asteroids> m_pRenderer;
+
+    // The number of threads requested from the command line. Zero means #cpu-1.
+    int m_NumThreads = 0;
+    // Directory where the generated textures are cached between runs. Empty disables the cache.
+    std::string m_TextureCacheDir;
+
+    float m_FrameTime = 0;
+
+    // Exponentially filtered renderer timings, in seconds
+    float m_FilteredUpdateTime = 0;
+    float m_FilteredRenderTime = 0;
+
+    MouseState m_PrevMouse;
+
+    // The number of frames measured for every binding mode. Zero disables the benchmark.
+    Uint32 m_BenchmarkModeFrames = 0;
+    // The number of frames rendered after switching the binding mode that are not measured
+    Uint32 m_BenchmarkModeWarmupFrames = 10;
+    // Optional report path. The binding mode name is appended to the file name.
+    std::string m_BenchmarkReportPath;
+
+    int                             m_BenchmarkMode = -1;
+    std::unique_ptr<FrameBenchmark> m_pModeBenchmark;
+};
+
+} // namespace Diligent
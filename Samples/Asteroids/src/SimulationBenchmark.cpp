@@ -0,0 +1,161 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+// Micro-benchmark that compares the cost of the original scalar asteroid update
+// (AsteroidsSimulation::UpdateReference) with the vectorized AoSoA update
+// (AsteroidsSimulation::Update) for different asteroid counts.
+//
+// Usage: AsteroidsSimulationBenchmark [--frames N] [--threads N] [count ...]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "simulation.h"
+
+using namespace DirectX;
+
+namespace
+{
+
+using Clock = std::chrono::high_resolution_clock;
+
+// Fixed simulation step so that both updates advance the same state
+constexpr float FrameTime = 1.0f / 60.0f;
+
+template <typename UpdateFuncType>
+double MeasureUpdate(AsteroidsSimulation& Sim, unsigned int NumFrames, unsigned int NumThreads, UpdateFuncType&& UpdateFunc)
+{
+    // Match the partitioning of the renderers: one range per thread that does not respect block boundaries
+    const size_t AsteroidCount = Sim.GetAsteroidCount();
+    const size_t RangeSize     = (AsteroidCount + NumThreads - 1) / NumThreads;
+
+    const auto StartTime = Clock::now();
+    for (unsigned int frame = 0; frame < NumFrames; ++frame)
+    {
+        if (NumThreads == 1)
+        {
+            UpdateFunc(size_t{0}, AsteroidCount);
+            continue;
+        }
+
+        std::vector<std::thread> Threads;
+        Threads.reserve(NumThreads);
+        for (unsigned int t = 0; t < NumThreads; ++t)
+        {
+            const size_t Start = std::min(AsteroidCount, RangeSize * t);
+            const size_t Count = std::min(AsteroidCount - Start, RangeSize);
+            if (Count == 0)
+                break;
+            Threads.emplace_back([&UpdateFunc, Start, Count]() { UpdateFunc(Start, Count); });
+        }
+        for (auto& Thread : Threads)
+            Thread.join();
+    }
+    const double TotalTime = std::chrono::duration<double>(Clock::now() - StartTime).count();
+
+    return TotalTime / NumFrames;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    unsigned int        NumFrames  = 100;
+    unsigned int        NumThreads = 1;
+    std::vector<size_t> Counts;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+            NumFrames = std::max(atoi(argv[++i]), 1);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            NumThreads = std::max(atoi(argv[++i]), 1);
+        else if (atoi(argv[i]) > 0)
+            Counts.push_back(static_cast<size_t>(atoi(argv[i])));
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--frames N] [--threads N] [count ...]" << std::endl;
+            return 1;
+        }
+    }
+    if (Counts.empty())
+        Counts = {50000, 200000, 500000, 1000000};
+
+    Settings settings;
+    settings.animate = true;
+
+    const auto CameraEye = XMVectorSet(0.0f, 0.5f * SIM_ORBIT_RADIUS, -(SIM_ORBIT_RADIUS + SIM_DISC_RADIUS), 0.0f);
+
+    std::cout << std::fixed << std::setprecision(3);
+    for (size_t Count : Counts)
+    {
+        // Mesh and texture counts only affect the static data, keep them small to speed up the setup
+        AsteroidsSimulation Sim{1337, static_cast<unsigned int>(Count), 16, MESH_MAX_SUBDIV_LEVELS, 1};
+
+        // The reference update only modifies the world matrices, while the vectorized update
+        // only reads its own state, so both can run on the same instance starting from the same state.
+        const double ReferenceTime = MeasureUpdate(Sim, NumFrames, NumThreads, [&](size_t Start, size_t Num) {
+            Sim.UpdateReference(FrameTime, CameraEye, settings, Start, Num);
+        });
+        std::vector<AsteroidDynamic> Reference{Sim.DynamicData(), Sim.DynamicData() + Count};
+
+        const double VectorizedTime = MeasureUpdate(Sim, NumFrames, NumThreads, [&](size_t Start, size_t Num) {
+            Sim.Update(FrameTime, CameraEye, settings, Start, Num);
+        });
+
+        // Both updates must produce the same transforms; LOD selection may only differ
+        // for asteroids right at a subdivision boundary due to the estimated reciprocal.
+        float  MaxError       = 0;
+        size_t NumLODMismatch = 0;
+        for (size_t i = 0; i < Count; ++i)
+        {
+            const AsteroidDynamic& Ref = Reference[i];
+            const AsteroidDynamic& Vec = Sim.DynamicData()[i];
+            for (int r = 0; r < 4; ++r)
+            {
+                const float Error = XMVectorGetX(XMVector4LengthEst(XMVectorSubtract(Ref.world.r[r], Vec.world.r[r])));
+                MaxError          = std::max(MaxError, Error);
+            }
+            if (Ref.indexStart != Vec.indexStart)
+                ++NumLODMismatch;
+        }
+
+        std::cout << std::setw(8) << Count << " asteroids, " << NumFrames << " frames, " << NumThreads << " thread(s): "
+                  << "reference " << ReferenceTime * 1000.0 << " ms, "
+                  << "vectorized " << VectorizedTime * 1000.0 << " ms, "
+                  << "speedup " << std::setprecision(2) << ReferenceTime / VectorizedTime << "x, "
+                  << std::setprecision(5) << "max error " << MaxError << ", "
+                  << "LOD mismatches " << NumLODMismatch << std::setprecision(3) << std::endl;
+    }
+
+    return 0;
+}
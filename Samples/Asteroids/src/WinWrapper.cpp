@@ -193,7 +193,7 @@ LRESULT CALLBACK WindowProc(
                 return 0;
             case 'B':
                 if (gSettings.mode == Settings::RenderMode::DiligentD3D12 || gSettings.mode == Settings::RenderMode::DiligentVulkan) {
-                    gSettings.resourceBindingMode = (gSettings.resourceBindingMode + 1) % 4;
+                    gSettings.resourceBindingMode = (gSettings.resourceBindingMode + 1) % 5;
                     gUpdateWorkload = true;
                 }
                 return 0;
@@ -580,6 +580,7 @@ int main(int argc, char** argv)
                         case 1: resBindModeStr = "-mut";break;
                         case 2: resBindModeStr = "-tex_mut";break;
                         case 3: resBindModeStr = "-bindless";break;
+                        case 4: resBindModeStr = "-gpu_driven";break;
                     }
                 break;
             }
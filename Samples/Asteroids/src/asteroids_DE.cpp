@@ -8,7 +8,7 @@
 // Intel does not assume any responsibility for any errors which may appear in this software
 // nor any responsibility to update it.
 
-#include <directxmath.h>
+#include <DirectXMath.h>
 #include <math.h>
 
 #include <iostream>
@@ -18,6 +18,7 @@
 #include <limits>
 #include <random>
 #include <locale>
+#include <chrono>
 
 #include "asteroids_DE.h"
 
@@ -77,7 +78,31 @@ struct SkyboxConstantBuffer
     DirectX::XMFLOAT4X4 mViewProjection;
 };
 
+// Must match CullConstants in asteroid_cull_cs.csh
+struct CullConstantBuffer
+{
+    DirectX::XMFLOAT4 mFrustumPlanes[6];
+    DirectX::XMFLOAT4 mCameraEye;
+    Uint32            mNumAsteroids;
+    Uint32            mSubdivCount;
+    float             mMinSubdivSizeLog2;
+    float             mMeshRadius;
+    Uint32            mIndexOffsets[8];
+};
+static_assert(MESH_MAX_SUBDIV_LEVELS + 2 <= sizeof(CullConstantBuffer::mIndexOffsets) / sizeof(Uint32), "Not enough space for the index offsets");
 
+// Layout of the indexed indirect draw arguments written by the culling shader
+struct DrawIndexedIndirectArgs
+{
+    Uint32 NumIndices;
+    Uint32 NumInstances;
+    Uint32 FirstIndexLocation;
+    Int32  BaseVertex;
+    Uint32 FirstInstanceLocation;
+};
+
+
+#ifdef _WIN32
 // Create Direct3D device and swap chain
 void Asteroids::InitDevice(HWND hWnd, RENDER_DEVICE_TYPE DevType)
 {
@@ -180,19 +205,52 @@ void Asteroids::InitDevice(HWND hWnd, RENDER_DEVICE_TYPE DevType)
 Asteroids::Asteroids(const Settings& settings, AsteroidsSimulation* asteroids, GUI* gui, HWND hWnd, RENDER_DEVICE_TYPE DevType) :
     mAsteroids(asteroids), mGUI(gui)
 {
-    QueryPerformanceFrequency((LARGE_INTEGER*)&mPerfCounterFreq);
-
     mNumSubsets = std::max(settings.numThreads, 1);
     mNumSubsets = std::min(settings.numThreads, 32);
 
     InitDevice(hWnd, DevType);
 
+    Initialize(settings);
+}
+#endif
+
+Asteroids::Asteroids(const Settings&        settings,
+                     AsteroidsSimulation*   asteroids,
+                     GUI*                   gui,
+                     IRenderDevice*         pDevice,
+                     IDeviceContext*        pImmediateCtx,
+                     IDeviceContext* const* ppDeferredCtxs,
+                     Uint32                 NumDeferredCtxs,
+                     ISwapChain*            pSwapChain) :
+    mAsteroids(asteroids), mGUI(gui), mSwapChain(pSwapChain), mDevice(pDevice), mDeviceCtxt(pImmediateCtx), mPresent(false)
+{
+    mNumSubsets = std::min(std::max(settings.numThreads, 1), 32);
+    if (NumDeferredCtxs > 0)
+    {
+        // One subset is rendered by the immediate context
+        mNumSubsets = std::min(mNumSubsets, NumDeferredCtxs + 1);
+        mDeferredCtxt.assign(ppDeferredCtxs, ppDeferredCtxs + (mNumSubsets - 1));
+    }
+
+    Initialize(settings);
+}
+
+void Asteroids::Initialize(const Settings& settings)
+{
+    const auto DevType = mDevice->GetDeviceInfo().Type;
+
     m_BindingMode = static_cast<BindingMode>(settings.resourceBindingMode);
+    if (m_BindingMode == BindingMode::GPUDriven && !IsGPUDrivenModeSupported(mDevice))
+        m_BindingMode = BindingMode::Bindless;
     if (m_BindingMode == BindingMode::Bindless && !mDevice->GetDeviceInfo().Features.BindlessResources)
         m_BindingMode = BindingMode::TextureMutable;
 
+    // GPU-driven mode draws the asteroids with the bindless shaders
+    const bool UseBindlessShaders = m_BindingMode == BindingMode::Bindless || m_BindingMode == BindingMode::GPUDriven;
+
     mCmdLists.resize(mDeferredCtxt.size());
-    mWorkerThreads.resize(mNumSubsets - 1);
+    // Every worker thread records one subset into its deferred context
+    mWorkerThreads.resize(mDeferredCtxt.size());
     for (auto& thread : mWorkerThreads)
     {
         thread = std::thread(WorkerThreadFunc, this, (Uint32)(&thread - mWorkerThreads.data()));
@@ -203,7 +261,8 @@ Asteroids::Asteroids(const Settings& settings, AsteroidsSimulation* asteroids, G
     {
         case RENDER_DEVICE_TYPE_D3D11: spriteFile = "media/DiligentD3D11.dds"; break;
         case RENDER_DEVICE_TYPE_D3D12: spriteFile = "media/DiligentD3D12.dds"; break;
-        case RENDER_DEVICE_TYPE_GL: spriteFile = "media/DiligentGL.dds"; break;
+        case RENDER_DEVICE_TYPE_GL:
+        case RENDER_DEVICE_TYPE_GLES: spriteFile = "media/DiligentGL.dds"; break;
         case RENDER_DEVICE_TYPE_VULKAN: spriteFile = "media/DiligentVk.dds"; break;
         default: UNEXPECTED("Unexpected device type");
     }
@@ -215,23 +274,24 @@ Asteroids::Asteroids(const Settings& settings, AsteroidsSimulation* asteroids, G
     std::vector<StateTransitionDesc> Barriers;
     mBackBufferWidth                = mSwapChain->GetDesc().Width;
     mBackBufferHeight               = mSwapChain->GetDesc().Height;
-    const auto MaxAsteroidsInSubset = (NUM_ASTEROIDS + mNumSubsets - 1) / mNumSubsets;
+    // In GPU-driven mode, all asteroids are drawn from the immediate context
+    const auto MaxAsteroidsInSubset = m_BindingMode == BindingMode::GPUDriven ? Uint32{NUM_ASTEROIDS} : (NUM_ASTEROIDS + mNumSubsets - 1) / mNumSubsets;
 
     {
         BufferDesc desc;
         desc.Name = "Asteroids constant buffer";
         // In bindless mode we will be updating the buffer with UpdateBuffer method
-        desc.Usage          = (m_BindingMode == BindingMode::Bindless) ? USAGE_DEFAULT : USAGE_DYNAMIC;
+        desc.Usage          = UseBindlessShaders ? USAGE_DEFAULT : USAGE_DYNAMIC;
         desc.CPUAccessFlags = desc.Usage == USAGE_DYNAMIC ? CPU_ACCESS_WRITE : CPU_ACCESS_NONE;
         desc.BindFlags      = BIND_UNIFORM_BUFFER;
         // In bindless mode, we will only write view-projection matrix
-        desc.Size = static_cast<Uint32>((m_BindingMode == BindingMode::Bindless) ? sizeof(DirectX::XMFLOAT4X4) : sizeof(DrawConstantBuffer));
+        desc.Size = static_cast<Uint32>(UseBindlessShaders ? sizeof(DirectX::XMFLOAT4X4) : sizeof(DrawConstantBuffer));
         mDevice->CreateBuffer(desc, nullptr, &mDrawConstantBuffer);
-        if (m_BindingMode != BindingMode::Bindless)
+        if (!UseBindlessShaders)
             Barriers.emplace_back(mDrawConstantBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_CONSTANT_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE);
     }
 
-    if (m_BindingMode == BindingMode::Bindless)
+    if (UseBindlessShaders)
     {
         {
             // In Direct3D there is no easy way to pass draw call number into the shader,
@@ -262,9 +322,17 @@ Asteroids::Asteroids(const Settings& settings, AsteroidsSimulation* asteroids, G
             desc.ElementByteStride = static_cast<Uint32>(sizeof(AsteroidData));
             desc.Size              = desc.ElementByteStride * MaxAsteroidsInSubset;
             mAsteroidsDataBuffers.resize(mNumSubsets);
-            for (Uint32 i = 0; i < mNumSubsets; ++i)
+            if (m_BindingMode == BindingMode::GPUDriven)
+            {
+                // In GPU-driven mode, there is a single buffer for all asteroids that is updated
+                // once per frame and is read by both the culling shader and the vertex shader
+                desc.Usage          = USAGE_DEFAULT;
+                desc.CPUAccessFlags = CPU_ACCESS_NONE;
+                mAsteroidsDataBuffers.resize(1);
+            }
+            for (auto& buffer : mAsteroidsDataBuffers)
             {
-                mDevice->CreateBuffer(desc, nullptr, &mAsteroidsDataBuffers[i]);
+                mDevice->CreateBuffer(desc, nullptr, &buffer);
             }
         }
     }
@@ -286,7 +354,7 @@ Asteroids::Asteroids(const Settings& settings, AsteroidsSimulation* asteroids, G
 
         GraphicsPipeline.InputLayout.LayoutElements = inputDesc;
         // In bindless mode we will use instance ID buffer as the third input
-        GraphicsPipeline.InputLayout.NumElements = (m_BindingMode == BindingMode::Bindless) ? 3 : 2;
+        GraphicsPipeline.InputLayout.NumElements = UseBindlessShaders ? 3 : 2;
 
         GraphicsPipeline.DepthStencilDesc.DepthFunc = COMPARISON_FUNC_GREATER_EQUAL;
 
@@ -300,7 +368,7 @@ Asteroids::Asteroids(const Settings& settings, AsteroidsSimulation* asteroids, G
             attribs.pShaderSourceStreamFactory = pShaderSourceFactory;
 
             ShaderMacro Macros[] = {{"BINDLESS", "1"}};
-            if (m_BindingMode == BindingMode::Bindless)
+            if (UseBindlessShaders)
             {
                 attribs.Macros = {Macros, _countof(Macros)};
             }
@@ -317,7 +385,7 @@ Asteroids::Asteroids(const Settings& settings, AsteroidsSimulation* asteroids, G
             attribs.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
 
             ShaderMacro Macros[] = {{"BINDLESS", "1"}};
-            if (m_BindingMode == BindingMode::Bindless)
+            if (UseBindlessShaders)
             {
                 attribs.Macros = {Macros, _countof(Macros)};
             }
@@ -346,7 +414,7 @@ Asteroids::Asteroids(const Settings& settings, AsteroidsSimulation* asteroids, G
         std::vector<ShaderResourceVariableDesc> Variables =
             {
                 {SHADER_TYPE_PIXEL, "Tex", m_BindingMode == BindingMode::Dynamic ? SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC : SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE}};
-        if (m_BindingMode == BindingMode::Bindless)
+        if (UseBindlessShaders)
             Variables.emplace_back(SHADER_TYPE_VERTEX, "g_Data", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE);
 
         PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
@@ -388,6 +456,11 @@ Asteroids::Asteroids(const Settings& settings, AsteroidsSimulation* asteroids, G
             // Create one SRB per subset for bindless mode
             NumSRBs = mNumSubsets;
         }
+        else if (m_BindingMode == BindingMode::GPUDriven)
+        {
+            // All asteroids are drawn with a single SRB in GPU-driven mode
+            NumSRBs = 1;
+        }
         mAsteroidsSRBs.resize(NumSRBs);
         for (size_t srb = 0; srb < mAsteroidsSRBs.size(); ++srb)
         {
@@ -518,7 +591,7 @@ Asteroids::Asteroids(const Settings& settings, AsteroidsSimulation* asteroids, G
         {
             auto& BlendState = GraphicsPipeline.BlendDesc;
             // Premultiplied over blend
-            BlendState.RenderTargets[0].BlendEnable = TRUE;
+            BlendState.RenderTargets[0].BlendEnable = True;
             BlendState.RenderTargets[0].SrcBlend    = BLEND_FACTOR_ONE;
             BlendState.RenderTargets[0].BlendOp     = BLEND_OPERATION_ADD;
             BlendState.RenderTargets[0].DestBlend   = BLEND_FACTOR_INV_SRC_ALPHA;
@@ -597,21 +670,123 @@ Asteroids::Asteroids(const Settings& settings, AsteroidsSimulation* asteroids, G
             mAsteroidsSRBs[srb]->GetVariableByName(SHADER_TYPE_PIXEL, "Tex")->Set(mTextureSRVs[srb]);
         }
     }
-    else if (m_BindingMode == BindingMode::Bindless)
+    else if (UseBindlessShaders)
     {
         // Bind all textures to every subset's SRB. The textures will be dynamically indexed in the shader.
         IDeviceObject* SRVArray[NUM_UNIQUE_TEXTURES];
         for (Uint32 t = 0; t < NUM_UNIQUE_TEXTURES; ++t)
             SRVArray[t] = mTextureSRVs[t];
-        for (Uint32 i = 0; i < mNumSubsets; ++i)
+        for (size_t i = 0; i < mAsteroidsSRBs.size(); ++i)
         {
             mAsteroidsSRBs[i]->GetVariableByName(SHADER_TYPE_PIXEL, "Tex")->SetArray(SRVArray, 0, NUM_UNIQUE_TEXTURES);
             mAsteroidsSRBs[i]->GetVariableByName(SHADER_TYPE_VERTEX, "g_Data")->Set(mAsteroidsDataBuffers[i]->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
         }
     }
+    if (m_BindingMode == BindingMode::GPUDriven)
+    {
+        CreateGPUDrivenResources(pShaderSourceFactory, Barriers);
+    }
     mDeviceCtxt->TransitionResourceStates(static_cast<Uint32>(Barriers.size()), Barriers.data());
 }
 
+bool Asteroids::IsGPUDrivenModeSupported(IRenderDevice* pDevice)
+{
+    const auto& Features = pDevice->GetDeviceInfo().Features;
+    const auto  DrawCaps = pDevice->GetAdapterInfo().DrawCommand.CapFlags;
+    return Features.ComputeShaders && Features.BindlessResources &&
+        (DrawCaps & DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_FIRST_INSTANCE) != 0 &&
+        (DrawCaps & DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNTER_BUFFER) != 0;
+}
+
+void Asteroids::CreateGPUDrivenResources(IShaderSourceInputStreamFactory* pShaderSourceFactory, std::vector<StateTransitionDesc>& Barriers)
+{
+    const auto* staticAsteroidData = mAsteroids->StaticData();
+
+    // Only the world matrices are updated every frame
+    mAsteroidDataCPU.resize(NUM_ASTEROIDS);
+    for (Uint32 i = 0; i < NUM_ASTEROIDS; ++i)
+    {
+        mAsteroidDataCPU[i].mSurfaceColor = staticAsteroidData[i].surfaceColor;
+        mAsteroidDataCPU[i].mDeepColor    = staticAsteroidData[i].deepColor;
+        mAsteroidDataCPU[i].mTextureIndex = staticAsteroidData[i].textureIndex;
+    }
+
+    mMeshRadius = 0;
+    for (const auto& vertex : mAsteroids->Meshes()->vertices)
+        mMeshRadius = std::max(mMeshRadius, std::sqrt(vertex.x * vertex.x + vertex.y * vertex.y + vertex.z * vertex.z));
+
+    {
+        std::vector<Uint32> vertexStart(NUM_ASTEROIDS);
+        for (Uint32 i = 0; i < NUM_ASTEROIDS; ++i)
+            vertexStart[i] = staticAsteroidData[i].vertexStart;
+
+        BufferDesc desc;
+        desc.Name              = "Asteroid vertex start buffer";
+        desc.Usage             = USAGE_IMMUTABLE;
+        desc.BindFlags         = BIND_SHADER_RESOURCE;
+        desc.Mode              = BUFFER_MODE_STRUCTURED;
+        desc.ElementByteStride = sizeof(Uint32);
+        desc.Size              = Uint64{desc.ElementByteStride} * NUM_ASTEROIDS;
+        BufferData Data{vertexStart.data(), desc.Size};
+        mDevice->CreateBuffer(desc, &Data, &mVertexStartBuffer);
+        Barriers.emplace_back(mVertexStartBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE);
+    }
+
+    {
+        BufferDesc desc;
+        desc.Name           = "Asteroid culling constant buffer";
+        desc.Usage          = USAGE_DYNAMIC;
+        desc.BindFlags      = BIND_UNIFORM_BUFFER;
+        desc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        desc.Size           = sizeof(CullConstantBuffer);
+        mDevice->CreateBuffer(desc, nullptr, &mCullConstantBuffer);
+        Barriers.emplace_back(mCullConstantBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_CONSTANT_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE);
+    }
+
+    {
+        // Draw arguments of the visible asteroids, compacted by the culling shader
+        BufferDesc desc;
+        desc.Name              = "Asteroid draw args buffer";
+        desc.Usage             = USAGE_DEFAULT;
+        desc.BindFlags         = BIND_UNORDERED_ACCESS | BIND_INDIRECT_DRAW_ARGS;
+        desc.Mode              = BUFFER_MODE_STRUCTURED;
+        desc.ElementByteStride = sizeof(DrawIndexedIndirectArgs);
+        desc.Size              = Uint64{desc.ElementByteStride} * NUM_ASTEROIDS;
+        mDevice->CreateBuffer(desc, nullptr, &mDrawArgsBuffer);
+
+        // The number of visible asteroids
+        desc.Name              = "Asteroid draw count buffer";
+        desc.ElementByteStride = sizeof(Uint32);
+        desc.Size              = sizeof(Uint32);
+        mDevice->CreateBuffer(desc, nullptr, &mDrawCountBuffer);
+    }
+
+    {
+        ShaderCreateInfo attribs;
+        attribs.Desc                       = {"Asteroid culling CS", SHADER_TYPE_COMPUTE, true};
+        attribs.EntryPoint                 = "asteroid_cull_cs";
+        attribs.FilePath                   = "asteroid_cull_cs.csh";
+        attribs.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+        attribs.pShaderSourceStreamFactory = pShaderSourceFactory;
+        RefCntAutoPtr<IShader> cs;
+        mDevice->CreateShader(attribs, &cs);
+
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name                               = "Asteroid culling PSO";
+        PSOCreateInfo.PSODesc.PipelineType                       = PIPELINE_TYPE_COMPUTE;
+        PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+        PSOCreateInfo.pCS                                        = cs;
+        mDevice->CreateComputePipelineState(PSOCreateInfo, &mCullPSO);
+
+        mCullPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "CullConstants")->Set(mCullConstantBuffer);
+        mCullPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "g_Data")->Set(mAsteroidsDataBuffers[0]->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+        mCullPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "g_VertexStart")->Set(mVertexStartBuffer->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
+        mCullPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "g_DrawArgs")->Set(mDrawArgsBuffer->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+        mCullPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "g_DrawCount")->Set(mDrawCountBuffer->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+        mCullPSO->CreateShaderResourceBinding(&mCullSRB, true);
+    }
+}
+
 Asteroids::~Asteroids()
 {
     mDeviceCtxt->Flush();
@@ -626,12 +801,14 @@ Asteroids::~Asteroids()
 }
 
 
+#ifdef _WIN32
 void Asteroids::ResizeSwapChain(HWND outputWindow, unsigned int width, unsigned int height)
 {
     mSwapChain->Resize(width, height);
     mBackBufferWidth  = width;
     mBackBufferHeight = height;
 }
+#endif
 
 
 void Asteroids::CreateMeshes()
@@ -801,6 +978,8 @@ void Asteroids::WorkerThreadFunc(Asteroids* pThis, Uint32 ThreadNum)
         auto& FrameAttribs = pThis->mFrameAttribs;
 
         pThis->mAsteroids->Update(FrameAttribs.frameTime, FrameAttribs.camera->Eye(), *FrameAttribs.settings, SubsetStart, SubsetSize);
+        if (pThis->m_BindingMode == BindingMode::GPUDriven)
+            pThis->WriteAsteroidData(SubsetStart, SubsetSize);
 
         // Increment number of completed threads
         ++pThis->m_NumThreadsCompleted;
@@ -809,11 +988,14 @@ void Asteroids::WorkerThreadFunc(Asteroids* pThis, Uint32 ThreadNum)
         // Wait for RenderSubsets signal
         pThis->mRenderSubsetsSignal.Wait();
 
-        pThis->RenderSubset(1 + ThreadNum, pThis->mDeferredCtxt[ThreadNum], *FrameAttribs.camera, SubsetStart, SubsetSize);
+        // In GPU-driven mode, all asteroids are drawn by the immediate context
+        if (pThis->m_BindingMode != BindingMode::GPUDriven)
+        {
+            pThis->RenderSubset(1 + ThreadNum, pThis->mDeferredCtxt[ThreadNum], *FrameAttribs.camera, SubsetStart, SubsetSize);
 
-        RefCntAutoPtr<ICommandList> pCmdList;
-        pThis->mCmdLists[ThreadNum].Release();
-        pThis->mDeferredCtxt[ThreadNum]->FinishCommandList(&pThis->mCmdLists[ThreadNum]);
+            pThis->mCmdLists[ThreadNum].Release();
+            pThis->mDeferredCtxt[ThreadNum]->FinishCommandList(&pThis->mCmdLists[ThreadNum]);
+        }
 
         // Increment number of completed threads
         ++pThis->m_NumThreadsCompleted;
@@ -918,12 +1100,95 @@ void Asteroids::RenderSubset(Uint32             SubsetNum,
     }
 }
 
+void Asteroids::WriteAsteroidData(Uint32 startIdx, Uint32 numAsteroids)
+{
+    auto dynamicAsteroidData = mAsteroids->DynamicData();
+    for (UINT i = startIdx; i < startIdx + numAsteroids; ++i)
+    {
+        XMStoreFloat4x4(&mAsteroidDataCPU[i].mWorld, dynamicAsteroidData[i].world);
+    }
+}
+
+void Asteroids::RenderGPUDriven(const OrbitCamera& camera, Uint32 numAsteroids)
+{
+    auto* pCtx = mDeviceCtxt.RawPtr();
+
+    pCtx->UpdateBuffer(mAsteroidsDataBuffers[0], 0, sizeof(AsteroidData) * numAsteroids, mAsteroidDataCPU.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    const Uint32 zero = 0;
+    pCtx->UpdateBuffer(mDrawCountBuffer, 0, sizeof(zero), &zero, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    {
+        MapHelper<CullConstantBuffer> cullConstants(pCtx, mCullConstantBuffer, MAP_WRITE, MAP_FLAG_DISCARD);
+
+        // Frustum planes of the row-vector view-projection matrix are sums and differences
+        // of its columns. Depth is reversed, but testing 0 <= z <= w covers both conventions.
+        const auto columns = XMMatrixTranspose(camera.ViewProjection());
+        const XMVECTOR planes[] = {
+            XMVectorAdd(columns.r[3], columns.r[0]),      // left
+            XMVectorSubtract(columns.r[3], columns.r[0]), // right
+            XMVectorAdd(columns.r[3], columns.r[1]),      // bottom
+            XMVectorSubtract(columns.r[3], columns.r[1]), // top
+            columns.r[2],                                 // z >= 0
+            XMVectorSubtract(columns.r[3], columns.r[2]), // z <= w
+        };
+        for (size_t p = 0; p < _countof(planes); ++p)
+            XMStoreFloat4(&cullConstants->mFrustumPlanes[p], XMPlaneNormalize(planes[p]));
+        XMStoreFloat4(&cullConstants->mCameraEye, camera.Eye());
+
+        cullConstants->mNumAsteroids      = numAsteroids;
+        cullConstants->mSubdivCount       = mAsteroids->SubdivCount();
+        cullConstants->mMinSubdivSizeLog2 = std::log2(SIM_MIN_SUBDIV_SIZE);
+        cullConstants->mMeshRadius        = mMeshRadius;
+        for (Uint32 i = 0; i < mAsteroids->SubdivCount() + 2; ++i)
+            cullConstants->mIndexOffsets[i] = mAsteroids->IndexOffsets()[i];
+    }
+
+    // Cull the asteroids, select their LOD and write the draw arguments of the visible ones
+    pCtx->SetPipelineState(mCullPSO);
+    pCtx->CommitShaderResources(mCullSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    DispatchComputeAttribs dispatchAttribs{(numAsteroids + 63) / 64};
+    pCtx->DispatchCompute(dispatchAttribs);
+
+    auto* pRTV = mSwapChain->GetCurrentBackBufferRTV();
+    auto* pDSV = mSwapChain->GetDepthBufferDSV();
+    pCtx->SetRenderTargets(1, &pRTV, pDSV, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    pCtx->SetPipelineState(mAsteroidsPSO);
+    {
+        IBuffer* ia_buffers[] = {mVertexBuffer, mInstanceIDBuffer};
+        pCtx->SetVertexBuffers(0, _countof(ia_buffers), ia_buffers, nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY, SET_VERTEX_BUFFERS_FLAG_NONE);
+        pCtx->SetIndexBuffer(mIndexBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+    }
+    // The asteroid data buffer was written by UpdateBuffer and needs to be transitioned
+    pCtx->CommitShaderResources(mAsteroidsSRBs[0], RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    // One draw per visible asteroid; the number of draws is read from the counter buffer
+    DrawIndexedIndirectAttribs attribs;
+    attribs.pAttribsBuffer                   = mDrawArgsBuffer;
+    attribs.IndexType                        = VT_UINT16;
+    attribs.DrawCount                        = numAsteroids;
+    attribs.DrawArgsStride                   = sizeof(DrawIndexedIndirectArgs);
+    attribs.AttribsBufferStateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    attribs.pCounterBuffer                   = mDrawCountBuffer;
+    attribs.CounterBufferStateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+    attribs.Flags                            = DRAW_FLAG_VERIFY_ALL;
+    pCtx->DrawIndexedIndirect(attribs);
+}
+
 void Asteroids::Render(float frameTime, const OrbitCamera& camera, const Settings& settings)
 {
     mFrameAttribs.frameTime = frameTime;
     mFrameAttribs.camera    = &camera;
     mFrameAttribs.settings  = &settings;
 
+    // The swap chain may have been resized by the application
+    mBackBufferWidth  = mSwapChain->GetDesc().Width;
+    mBackBufferHeight = mSwapChain->GetDesc().Height;
+
+    // Worker threads are only available when there are deferred contexts
+    const bool multithreadedRendering = settings.multithreadedRendering && !mWorkerThreads.empty();
+
     // Clear the render target
     float clearcol[4] = {0.0f, 0.0f, 0.0f, 0.0f};
     auto* pRTV        = mSwapChain->GetCurrentBackBufferRTV();
@@ -932,13 +1197,12 @@ void Asteroids::Render(float frameTime, const OrbitCamera& camera, const Setting
     mDeviceCtxt->ClearRenderTarget(pRTV, clearcol, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
     mDeviceCtxt->ClearDepthStencil(pDSV, CLEAR_DEPTH_FLAG, 0.0f, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
 
-    LONG64 currCounter;
-    QueryPerformanceCounter((LARGE_INTEGER*)&currCounter);
-    mUpdateTicks = currCounter;
+    using Clock      = std::chrono::high_resolution_clock;
+    auto updateStart = Clock::now();
 
     auto SubsetSize = NUM_ASTEROIDS / mNumSubsets;
 
-    if (m_BindingMode == BindingMode::Bindless)
+    if (m_BindingMode == BindingMode::Bindless || m_BindingMode == BindingMode::GPUDriven)
     {
         // Write view-projection matrix into the buffer
         const auto& viewProjection = camera.ViewProjection();
@@ -948,17 +1212,21 @@ void Asteroids::Render(float frameTime, const OrbitCamera& camera, const Setting
         mDeviceCtxt->TransitionResourceState(Barrier);
     }
 
-    if (settings.multithreadedRendering)
+    if (multithreadedRendering)
     {
         m_NumThreadsCompleted = 0;
         mUpdateSubsetsSignal.Trigger(true);
     }
 
     // Update all subsets in this thread when multithreadedRendering is false
-    for (Uint32 i = 0; i < (!settings.multithreadedRendering ? mNumSubsets : 1); ++i)
+    for (Uint32 i = 0; i < (!multithreadedRendering ? mNumSubsets : 1); ++i)
+    {
         mAsteroids->Update(frameTime, camera.Eye(), settings, SubsetSize * i, SubsetSize);
+        if (m_BindingMode == BindingMode::GPUDriven)
+            WriteAsteroidData(SubsetSize * i, SubsetSize);
+    }
 
-    if (settings.multithreadedRendering)
+    if (multithreadedRendering)
     {
         // Wait for worker threads to finish
         while (m_NumThreadsCompleted < (int)mNumSubsets - 1)
@@ -967,30 +1235,39 @@ void Asteroids::Render(float frameTime, const OrbitCamera& camera, const Setting
         mUpdateSubsetsSignal.Reset();
     }
 
-    QueryPerformanceCounter((LARGE_INTEGER*)&currCounter);
-    mUpdateTicks = currCounter - mUpdateTicks;
+    auto renderStart = Clock::now();
+    mUpdateTime      = std::chrono::duration<float>(renderStart - updateStart).count();
 
-    mRenderTicks = currCounter;
-
-    if (settings.multithreadedRendering)
+    if (multithreadedRendering)
     {
         // Signal RenderSubsets
         m_NumThreadsCompleted = 0;
         mRenderSubsetsSignal.Trigger(true);
     }
 
-    // Render all subsets in this thread when multithreadedRendering is false
-    for (Uint32 i = 0; i < (!settings.multithreadedRendering ? mNumSubsets : 1); ++i)
-        RenderSubset(i, mDeviceCtxt, camera, SubsetSize * i, SubsetSize);
+    if (m_BindingMode == BindingMode::GPUDriven)
+    {
+        // All asteroids are culled and drawn by the immediate context
+        RenderGPUDriven(camera, SubsetSize * mNumSubsets);
+    }
+    else
+    {
+        // Render all subsets in this thread when multithreadedRendering is false
+        for (Uint32 i = 0; i < (!multithreadedRendering ? mNumSubsets : 1); ++i)
+            RenderSubset(i, mDeviceCtxt, camera, SubsetSize * i, SubsetSize);
+    }
 
-    if (settings.multithreadedRendering)
+    if (multithreadedRendering)
     {
         // Wait for worker threads to finish
         while (m_NumThreadsCompleted < (int)mNumSubsets - 1)
             std::this_thread::yield();
         // Reset mRenderSubsetsSignal while all threads are waiting for mUpdateSubsetsSignal
         mRenderSubsetsSignal.Reset();
+    }
 
+    if (multithreadedRendering && m_BindingMode != BindingMode::GPUDriven)
+    {
         mCmdListPtrs.resize(mCmdLists.size());
         for (size_t i = 0; i < mCmdLists.size(); ++i)
             mCmdListPtrs[i] = mCmdLists[i];
@@ -1008,11 +1285,13 @@ void Asteroids::Render(float frameTime, const OrbitCamera& camera, const Setting
     // Call FinishFrame() to release dynamic resources allocated by deferred contexts
     // IMPORTANT: we must wait until the command lists are submitted for execution
     // because FinishFrame() invalidates all dynamic resources
-    for (auto& ctx : mDeferredCtxt)
-        ctx->FinishFrame();
+    if (m_BindingMode != BindingMode::GPUDriven)
+    {
+        for (auto& ctx : mDeferredCtxt)
+            ctx->FinishFrame();
+    }
 
-    QueryPerformanceCounter((LARGE_INTEGER*)&currCounter);
-    mRenderTicks = currCounter - mRenderTicks;
+    mRenderTime = std::chrono::duration<float>(Clock::now() - renderStart).count();
 
     mDeviceCtxt->SetRenderTargets(1, &pRTV, pDSV, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
 
@@ -1081,13 +1360,14 @@ void Asteroids::Render(float frameTime, const OrbitCamera& camera, const Setting
         }
     }
 
-    mSwapChain->Present(settings.vsync ? 1 : 0);
+    if (mPresent)
+        mSwapChain->Present(settings.vsync ? 1 : 0);
 }
 
 void Asteroids::GetPerfCounters(float& UpdateTime, float& RenderTime)
 {
-    UpdateTime = (float)mUpdateTicks / (float)mPerfCounterFreq;
-    RenderTime = (float)mRenderTicks / (float)mPerfCounterFreq;
+    UpdateTime = mUpdateTime;
+    RenderTime = mRenderTime;
 }
 
 } // namespace AsteroidsDE
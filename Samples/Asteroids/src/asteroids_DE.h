@@ -18,6 +18,8 @@
 #include <map>
 #include <mutex>
 #include <atomic>
+#include <thread>
+#include <memory>
 
 #include "camera.h"
 #include "settings.h"
@@ -28,30 +30,61 @@
 
 namespace AsteroidsDE {
 
+struct AsteroidData;
+
 class Asteroids {
 public:
+#ifdef _WIN32
     Asteroids(const Settings &settings, AsteroidsSimulation* asteroids, GUI* gui, HWND hWnd, Diligent::RENDER_DEVICE_TYPE DevType);
+#endif
+
+    // Renders into the swap chain owned by the application, which is also responsible for presenting it.
+    // Every deferred context renders one subset on its own worker thread. If no deferred contexts
+    // are provided, all subsets are rendered on the immediate context.
+    Asteroids(const Settings &settings, AsteroidsSimulation* asteroids, GUI* gui,
+              Diligent::IRenderDevice* pDevice, Diligent::IDeviceContext* pImmediateCtx,
+              Diligent::IDeviceContext* const* ppDeferredCtxs, Diligent::Uint32 NumDeferredCtxs,
+              Diligent::ISwapChain* pSwapChain);
     ~Asteroids();
 
     void Render(float frameTime, const OrbitCamera& camera, const Settings& settings);
 
+#ifdef _WIN32
     void ResizeSwapChain(HWND outputWindow, unsigned int width, unsigned int height);
+#endif
 
     void GetPerfCounters(float &UpdateTime, float &RenderTime);
 
+    // Returns the binding mode actually used, which may differ from the one requested
+    // in the settings if the device does not support it.
+    int GetResourceBindingMode() const { return static_cast<int>(m_BindingMode); }
+
+    // GPU-driven mode requires compute shaders, bindless resources and indirect draws
+    // that take the first instance location and the draw count from GPU buffers.
+    static bool IsGPUDrivenModeSupported(Diligent::IRenderDevice* pDevice);
+
 private:
+    void Initialize(const Settings& settings);
     void CreateMeshes();
     void InitializeTextureData();
     void CreateGUIResources();
     void RenderSubset(Diligent::Uint32 SubsetNum, Diligent::IDeviceContext *pCtx, const OrbitCamera& camera, Diligent::Uint32 startIdx, Diligent::Uint32 numAsteroids);
+    void CreateGPUDrivenResources(Diligent::IShaderSourceInputStreamFactory* pShaderSourceFactory, std::vector<Diligent::StateTransitionDesc>& Barriers);
+    void WriteAsteroidData(Diligent::Uint32 startIdx, Diligent::Uint32 numAsteroids);
+    void RenderGPUDriven(const OrbitCamera& camera, Diligent::Uint32 numAsteroids);
+#ifdef _WIN32
     void InitDevice(HWND hWnd, Diligent::RENDER_DEVICE_TYPE DevType);
+#endif
 
     enum class BindingMode
     {
         Dynamic = 0,
         Mutable,
         TextureMutable,
-        Bindless
+        Bindless,
+        // Asteroids are culled and their LOD is selected by a compute shader that
+        // writes the arguments of a single indirect draw call
+        GPUDriven
     }m_BindingMode = BindingMode::TextureMutable;
 
     AsteroidsSimulation*        mAsteroids = nullptr;
@@ -100,6 +133,18 @@ private:
     Diligent::RefCntAutoPtr<Diligent::IShaderResourceBinding> mFontSRB;
     
 
+    // GPU-driven mode resources
+    Diligent::RefCntAutoPtr<Diligent::IPipelineState>  mCullPSO;
+    Diligent::RefCntAutoPtr<Diligent::IShaderResourceBinding> mCullSRB;
+    Diligent::RefCntAutoPtr<Diligent::IBuffer>  mCullConstantBuffer;
+    Diligent::RefCntAutoPtr<Diligent::IBuffer>  mVertexStartBuffer;
+    Diligent::RefCntAutoPtr<Diligent::IBuffer>  mDrawArgsBuffer;
+    Diligent::RefCntAutoPtr<Diligent::IBuffer>  mDrawCountBuffer;
+    // Asteroid data of all asteroids written by the update threads and uploaded once per frame
+    std::vector<AsteroidData> mAsteroidDataCPU;
+    // Bounding sphere radius of the unit-scale asteroid meshes
+    float mMeshRadius = 0;
+
     Diligent::RefCntAutoPtr<Diligent::IPipelineState>  mSkyboxPSO;
     Diligent::RefCntAutoPtr<Diligent::IShaderResourceBinding> mSkyboxSRB;
 
@@ -111,8 +156,12 @@ private:
     Diligent::RefCntAutoPtr<Diligent::ISampler> mSamplerState;
 
     std::unique_ptr<GUISprite> mSprite;
-    UINT64 mPerfCounterFreq = 0;
-    volatile LONG64 mUpdateTicks = 0, mRenderTicks = 0;
+
+    // Whether the swap chain is owned and presented by the renderer
+    bool mPresent = true;
+
+    // Update and render times of the last frame, in seconds
+    float mUpdateTime = 0, mRenderTime = 0;
 };
 
 } // namespace AsteroidsD3D11
@@ -28,6 +28,7 @@ OrbitCamera::OrbitCamera()
     mLongAngle = 0.0f;
     mLatAngle = 0.0f;
 
+#ifdef _WIN32
     // Set up interaction context (i.e. touch input processing, etc)
     ThrowIfFailed(CreateInteractionContext(&mInteractionContext));
     ThrowIfFailed(SetPropertyInteractionContext(mInteractionContext, INTERACTION_CONTEXT_PROPERTY_FILTER_POINTERS, TRUE));
@@ -50,12 +51,15 @@ OrbitCamera::OrbitCamera()
     }
 
     ThrowIfFailed(RegisterOutputCallbackInteractionContext(mInteractionContext, OrbitCamera::StaticInteractionOutputCallback, this));
+#endif
 }
 
 
 OrbitCamera::~OrbitCamera()
 {
+#ifdef _WIN32
     DestroyInteractionContext(mInteractionContext);
+#endif
 }
 
 
@@ -122,6 +126,7 @@ void OrbitCamera::ZoomRadiusScale(float delta)
 }
 
 
+#ifdef _WIN32
 void OrbitCamera::AddPointer(UINT pointerId)
 {
     AddPointerInteractionContext(mInteractionContext, pointerId);
@@ -170,3 +175,4 @@ void OrbitCamera::InteractionOutputCallback(const INTERACTION_CONTEXT_OUTPUT *ou
         break;
     }
 }
+#endif
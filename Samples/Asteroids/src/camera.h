@@ -11,7 +11,10 @@
 #pragma once
 
 #include <DirectXMath.h>
+
+#ifdef _WIN32
 #include <interactioncontext.h>
+#endif
 
 class OrbitCamera
 {
@@ -29,10 +32,13 @@ public:
     DirectX::XMVECTOR const& Eye() const { return mEye; }
     DirectX::XMMATRIX const& ViewProjection() const { return mViewProjection; }
 
+#ifdef _WIN32
+    // Touch and mouse input is only processed through the Win32 interaction context
     void AddPointer(UINT pointerId);
     void ProcessPointerFrames(UINT pointerId, const POINTER_INFO* pointerInfo);
     void ProcessInertia();
     void RemovePointer(UINT pointerId);
+#endif
 
     void OrbitX(float angle);
     void OrbitY(float angle);
@@ -41,8 +47,10 @@ public:
     
 private:
     void UpdateData();
+#ifdef _WIN32
     static VOID CALLBACK StaticInteractionOutputCallback(VOID *clientData, const INTERACTION_CONTEXT_OUTPUT *output);
     void InteractionOutputCallback(const INTERACTION_CONTEXT_OUTPUT *output);
+#endif
 
     DirectX::XMVECTOR mCenter;
     DirectX::XMVECTOR mUp;
@@ -58,5 +66,7 @@ private:
     DirectX::XMMATRIX mProjection;
     DirectX::XMMATRIX mViewProjection;
 
+#ifdef _WIN32
     HINTERACTIONCONTEXT mInteractionContext;
+#endif
 };
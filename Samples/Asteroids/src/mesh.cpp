@@ -10,8 +10,13 @@
 
 #include "mesh.h"
 #include "noise.h"
-#include <map>
+#include <assert.h>
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <random>
+#include <thread>
 
 using namespace DirectX;
 
@@ -68,49 +73,83 @@ void CreateIcosahedron(Mesh *outMesh)
 }
 
 
-// Maps edge (lower index first!) to
-struct Edge
+// Open-addressing hash table that maps an edge (lower index first!) to the index of its midpoint vertex.
+// Linear probing over flat arrays avoids the per-node allocations and pointer chasing of std::map.
+class MidpointTable
 {
-    Edge(IndexType i0, IndexType i1)
-        : v0(i0), v1(i1)
+public:
+    explicit MidpointTable(size_t maxEdgeCount)
     {
-        if (v0 > v1)
-            std::swap(v0, v1);
+        // Keep the load factor at or below 1/2 so that probe sequences stay short
+        size_t capacity = 16;
+        while (capacity < maxEdgeCount * 2)
+            capacity *= 2;
+        mKeys.assign(capacity, EmptyKey);
+        mValues.resize(capacity);
+        mMask = capacity - 1;
     }
-    IndexType v0;
-    IndexType v1;
 
-    bool operator<(const Edge &c) const
+    // Returns the midpoint index slot of the edge; *inserted is set if the edge was not in the table
+    IndexType* FindOrInsert(IndexType i0, IndexType i1, bool* inserted)
     {
-        return v0 < c.v0 || (v0 == c.v0 && v1 < c.v1);
+        if (i0 > i1)
+            std::swap(i0, i1);
+        auto key = (uint32_t(i0) << 16) | uint32_t(i1);
+
+        for (size_t slot = Hash(key) & mMask;; slot = (slot + 1) & mMask) {
+            if (mKeys[slot] == key) {
+                *inserted = false;
+                return &mValues[slot];
+            }
+            if (mKeys[slot] == EmptyKey) {
+                mKeys[slot] = key;
+                *inserted = true;
+                return &mValues[slot];
+            }
+        }
+    }
+
+private:
+    static_assert(sizeof(IndexType) == 2, "Edge keys pack two 16-bit indices");
+    // i0 < i1 for every edge, so no edge maps to this key
+    static constexpr uint32_t EmptyKey = 0xFFFFFFFFu;
+
+    static size_t Hash(uint32_t key)
+    {
+        key *= 0x9E3779B1u; // Fibonacci hashing
+        return key ^ (key >> 16);
     }
-};
 
-typedef std::map<Edge, IndexType> MidpointMap;
+    std::vector<uint32_t> mKeys;
+    std::vector<IndexType> mValues;
+    size_t mMask = 0;
+};
 
-inline IndexType EdgeMidpoint(Mesh *mesh, MidpointMap *midpoints, Edge e)
+inline IndexType EdgeMidpoint(Mesh *mesh, MidpointTable *midpoints, IndexType i0, IndexType i1)
 {
-    auto index = midpoints->find(e);
-    if (index == midpoints->end())
+    bool inserted = false;
+    auto index = midpoints->FindOrInsert(i0, i1, &inserted);
+    if (inserted)
     {
-        auto a = mesh->vertices[e.v0];
-        auto b = mesh->vertices[e.v1];
+        auto a = mesh->vertices[i0];
+        auto b = mesh->vertices[i1];
 
         Vertex m;
         m.x = (a.x + b.x) * 0.5f;
         m.y = (a.y + b.y) * 0.5f;
         m.z = (a.z + b.z) * 0.5f;
 
-        index = midpoints->insert(std::make_pair(e, static_cast<IndexType>(mesh->vertices.size()))).first;
+        *index = static_cast<IndexType>(mesh->vertices.size());
         mesh->vertices.push_back(m);
     }
-    return index->second;
+    return *index;
 }
 
 
 void SubdivideInPlace(Mesh *outMesh)
 {
-    MidpointMap midpoints;
+    // Every triangle contributes at most three new edges
+    MidpointTable midpoints(outMesh->indices.size());
 
     std::vector<IndexType> newIndices;
     newIndices.reserve(outMesh->indices.size() * 4);
@@ -124,9 +163,9 @@ void SubdivideInPlace(Mesh *outMesh)
         auto t1 = outMesh->indices[t*3+1];
         auto t2 = outMesh->indices[t*3+2];
 
-        auto m0 = EdgeMidpoint(outMesh, &midpoints, Edge(t0, t1));
-        auto m1 = EdgeMidpoint(outMesh, &midpoints, Edge(t1, t2));
-        auto m2 = EdgeMidpoint(outMesh, &midpoints, Edge(t2, t0));
+        auto m0 = EdgeMidpoint(outMesh, &midpoints, t0, t1);
+        auto m1 = EdgeMidpoint(outMesh, &midpoints, t1, t2);
+        auto m2 = EdgeMidpoint(outMesh, &midpoints, t2, t0);
 
         IndexType indices[] = {
             t0, m0, m2,
@@ -152,21 +191,22 @@ void SpherifyInPlace(Mesh *outMesh, float radius)
 }
 
 
-void ComputeAvgNormalsInPlace(Mesh *outMesh)
+// Works on a range of vertices, so that the meshes of different asteroids can be processed in place
+static void ComputeAvgNormals(Vertex *vertices, size_t vertexCount, const IndexType *indices, size_t indexCount)
 {
-    for (auto &v : outMesh->vertices) {
-        v.nx = 0.0f;
-        v.ny = 0.0f;
-        v.nz = 0.0f;
+    for (auto v = vertices; v != vertices + vertexCount; ++v) {
+        v->nx = 0.0f;
+        v->ny = 0.0f;
+        v->nz = 0.0f;
     }
 
-    assert(outMesh->indices.size() % 3 == 0); // trilist
-    size_t triangles = outMesh->indices.size() / 3;
+    assert(indexCount % 3 == 0); // trilist
+    size_t triangles = indexCount / 3;
     for (size_t t = 0; t < triangles; ++t)
     {
-        auto v1 = &outMesh->vertices[outMesh->indices[t*3+0]];
-        auto v2 = &outMesh->vertices[outMesh->indices[t*3+1]];
-        auto v3 = &outMesh->vertices[outMesh->indices[t*3+2]];
+        auto v1 = &vertices[indices[t*3+0]];
+        auto v2 = &vertices[indices[t*3+1]];
+        auto v3 = &vertices[indices[t*3+2]];
 
         // Two edge vectors u,v
         auto ux = v2->x - v1->x;
@@ -188,14 +228,19 @@ void ComputeAvgNormalsInPlace(Mesh *outMesh)
     }
 
     // Normalize
-    for (auto &v : outMesh->vertices) {
-        float n = 1.0f / std::sqrt(v.nx*v.nx + v.ny*v.ny + v.nz*v.nz);
-        v.nx *= n;
-        v.ny *= n;
-        v.nz *= n;
+    for (auto v = vertices; v != vertices + vertexCount; ++v) {
+        float n = 1.0f / std::sqrt(v->nx*v->nx + v->ny*v->ny + v->nz*v->nz);
+        v->nx *= n;
+        v->ny *= n;
+        v->nz *= n;
     }
 }
 
+void ComputeAvgNormalsInPlace(Mesh *outMesh)
+{
+    ComputeAvgNormals(outMesh->vertices.data(), outMesh->vertices.size(), outMesh->indices.data(), outMesh->indices.size());
+}
+
 
 void CreateGeospheres(Mesh *outMesh, unsigned int subdivLevelCount, unsigned int* outSubdivIndexOffsets)
 {
@@ -241,9 +286,9 @@ void CreateAsteroidsFromGeospheres(Mesh *outMesh,
     CreateGeospheres(&baseMesh, subdivLevelCount, outSubdivIndexOffsets);
 
     // Per unique mesh
-    *vertexCountPerMesh = (unsigned int)baseMesh.vertices.size();
-    std::vector<Vertex> vertices;
-    vertices.reserve(meshInstanceCount * baseMesh.vertices.size());
+    auto baseVertexCount = baseMesh.vertices.size();
+    *vertexCountPerMesh = (unsigned int)baseVertexCount;
+    std::vector<Vertex> vertices(meshInstanceCount * baseVertexCount);
     // Reuse indices for the different unique meshes
 
     auto randomNoise = std::uniform_real_distribution<float>(0.0f, 10000.0f);
@@ -252,22 +297,49 @@ void CreateAsteroidsFromGeospheres(Mesh *outMesh,
     float radiusScale = 0.9f;
     float radiusBias = 0.3f;
 
-    // Create and randomize unique vertices for each mesh instance
-    for (unsigned int m = 0; m < meshInstanceCount; ++m) {
-        Mesh newMesh(baseMesh);
-        NoiseOctaves<4> textureNoise(randomPersistence(rng));
-        float noise = randomNoise(rng);
+    // Draw the random parameters of all meshes up front in the original order,
+    // so that the meshes do not depend on the number of threads
+    struct MeshParams
+    {
+        float persistence;
+        float noise;
+    };
+    std::vector<MeshParams> meshParams(meshInstanceCount);
+    for (auto &params : meshParams) {
+        params.persistence = randomPersistence(rng);
+        params.noise = randomNoise(rng);
+    }
+
+    // Create and randomize unique vertices for each mesh instance directly in the output array
+    auto createMesh = [&](unsigned int m) {
+        auto meshVertices = vertices.data() + m * baseVertexCount;
+        std::copy(baseMesh.vertices.begin(), baseMesh.vertices.end(), meshVertices);
+
+        NoiseOctaves<4> textureNoise(meshParams[m].persistence);
+        float noise = meshParams[m].noise;
 
-        for (auto &v : newMesh.vertices) {
-            float radius = textureNoise(v.x*noiseScale, v.y*noiseScale, v.z*noiseScale, noise);
+        for (auto v = meshVertices; v != meshVertices + baseVertexCount; ++v) {
+            float radius = textureNoise(v->x*noiseScale, v->y*noiseScale, v->z*noiseScale, noise);
             radius = radius * radiusScale + radiusBias;
-            v.x *= radius;
-            v.y *= radius;
-            v.z *= radius;
+            v->x *= radius;
+            v->y *= radius;
+            v->z *= radius;
         }
-        ComputeAvgNormalsInPlace(&newMesh);
+        ComputeAvgNormals(meshVertices, baseVertexCount, baseMesh.indices.data(), baseMesh.indices.size());
+    };
 
-        vertices.insert(vertices.end(), newMesh.vertices.begin(), newMesh.vertices.end());
+    // Meshes are picked up one at a time by a pool of workers
+    std::atomic<unsigned int> nextMesh{0};
+    auto numWorkers = std::max(1U, std::min(std::thread::hardware_concurrency(), meshInstanceCount));
+    std::vector<std::thread> workers(numWorkers);
+    for (auto& worker : workers) {
+        worker = std::thread([&]() {
+            for (unsigned int m = nextMesh++; m < meshInstanceCount; m = nextMesh++)
+                createMesh(m);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
     }
 
     // Copy to output
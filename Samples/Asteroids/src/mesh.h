@@ -11,7 +11,7 @@
 #pragma once
 
 #include <vector>
-#include <directxmath.h>
+#include <DirectXMath.h>
 
 typedef unsigned short IndexType;
 
@@ -10,8 +10,116 @@
 
 #pragma once
 
+#include <stdint.h>
+#include <DirectXMath.h>
+
 #include "simplexnoise1234.h"
 
+// FASTFLOOR() of simplexnoise1234.c for four values: truncates and subtracts one from values <= 0
+inline DirectX::XMVECTOR XM_CALLCONV FastFloor4(DirectX::FXMVECTOR v)
+{
+    using namespace DirectX;
+    auto t = XMVectorTruncate(v);
+    return XMVectorSelect(t, XMVectorSubtract(t, XMVectorSplatOne()), XMVectorLessOrEqual(v, XMVectorZero()));
+}
+
+// Contribution of one simplex corner at four points: the falloff times grad3() of simplexnoise1234.c
+inline DirectX::XMVECTOR XM_CALLCONV SimplexCorner3x4(DirectX::FXMVECTOR hash, DirectX::FXMVECTOR x, DirectX::FXMVECTOR y, DirectX::GXMVECTOR z)
+{
+    using namespace DirectX;
+    auto zero = XMVectorZero();
+    auto h = XMVectorAndInt(hash, XMVectorReplicateInt(15));
+
+    // u = h<8 ? x : y; v = h<4 ? y : h==12||h==14 ? x : z
+    auto u = XMVectorSelect(y, x, XMVectorEqualInt(XMVectorAndInt(h, XMVectorReplicateInt(8)), zero));
+    auto v = XMVectorSelect(z, x, XMVectorEqualInt(XMVectorAndInt(h, XMVectorReplicateInt(13)), XMVectorReplicateInt(12)));
+    v = XMVectorSelect(v, y, XMVectorEqualInt(XMVectorAndInt(h, XMVectorReplicateInt(12)), zero));
+    u = XMVectorSelect(u, XMVectorNegate(u), XMVectorEqualInt(XMVectorAndInt(h, XMVectorReplicateInt(1)), XMVectorReplicateInt(1)));
+    v = XMVectorSelect(v, XMVectorNegate(v), XMVectorEqualInt(XMVectorAndInt(h, XMVectorReplicateInt(2)), XMVectorReplicateInt(2)));
+
+    // Corners farther than sqrt(0.6) do not contribute
+    auto t = XMVectorSubtract(XMVectorSubtract(XMVectorSubtract(XMVectorReplicate(0.6f), XMVectorMultiply(x, x)), XMVectorMultiply(y, y)), XMVectorMultiply(z, z));
+    t = XMVectorMax(t, zero);
+    t = XMVectorMultiply(t, t);
+    return XMVectorMultiply(XMVectorMultiply(t, t), XMVectorAdd(u, v));
+}
+
+// snoise3() at four points. The simplex order, the gradients and the falloff are selected with
+// masks instead of branches; only the permutation table lookups are scalar. The skew factors
+// are applied in float rather than double, so the result differs slightly from snoise3(),
+// most near integer coordinates where FASTFLOOR() may pick the neighboring cell.
+inline DirectX::XMVECTOR XM_CALLCONV SimplexNoise3x4(DirectX::FXMVECTOR x, DirectX::FXMVECTOR y, DirectX::FXMVECTOR z)
+{
+    using namespace DirectX;
+    const float G3 = 0.166666667f;
+
+    // Skew the input space to determine which simplex cell we're in
+    auto s = XMVectorScale(XMVectorAdd(XMVectorAdd(x, y), z), 0.333333333f);
+    auto i = FastFloor4(XMVectorAdd(x, s));
+    auto j = FastFloor4(XMVectorAdd(y, s));
+    auto k = FastFloor4(XMVectorAdd(z, s));
+
+    // Unskew the cell origin back to (x,y,z) space
+    auto t = XMVectorScale(XMVectorAdd(XMVectorAdd(i, j), k), G3);
+    auto x0 = XMVectorSubtract(x, XMVectorSubtract(i, t));
+    auto y0 = XMVectorSubtract(y, XMVectorSubtract(j, t));
+    auto z0 = XMVectorSubtract(z, XMVectorSubtract(k, t));
+
+    // Same traversal order as the if/else ladder in snoise3()
+    auto xy = XMVectorGreaterOrEqual(x0, y0);
+    auto yz = XMVectorGreaterOrEqual(y0, z0);
+    auto xz = XMVectorGreaterOrEqual(x0, z0);
+    auto i1 = XMVectorAndInt(xy, XMVectorOrInt(yz, xz));
+    auto j1 = XMVectorAndCInt(yz, xy);
+    auto k1 = XMVectorNotInt(XMVectorOrInt(yz, XMVectorAndInt(xy, xz)));
+    auto i2 = XMVectorOrInt(xy, XMVectorAndInt(yz, xz));
+    auto j2 = XMVectorNotInt(XMVectorAndCInt(xy, yz));
+    auto k2 = XMVectorNotInt(XMVectorAndInt(yz, XMVectorOrInt(xy, xz)));
+
+    // Offsets of the other corners in (x,y,z) coords
+    auto one = XMVectorSplatOne();
+    auto g1 = XMVectorReplicate(G3);
+    auto g2 = XMVectorReplicate(2.0f * G3);
+    auto g3 = XMVectorReplicate(-1.0f + 3.0f * G3);
+    auto x1 = XMVectorAdd(XMVectorSubtract(x0, XMVectorAndInt(i1, one)), g1);
+    auto y1 = XMVectorAdd(XMVectorSubtract(y0, XMVectorAndInt(j1, one)), g1);
+    auto z1 = XMVectorAdd(XMVectorSubtract(z0, XMVectorAndInt(k1, one)), g1);
+    auto x2 = XMVectorAdd(XMVectorSubtract(x0, XMVectorAndInt(i2, one)), g2);
+    auto y2 = XMVectorAdd(XMVectorSubtract(y0, XMVectorAndInt(j2, one)), g2);
+    auto z2 = XMVectorAdd(XMVectorSubtract(z0, XMVectorAndInt(k2, one)), g2);
+    auto x3 = XMVectorAdd(x0, g3);
+    auto y3 = XMVectorAdd(y0, g3);
+    auto z3 = XMVectorAdd(z0, g3);
+
+    // Hashes of the four corners; the offsets are all-ones masks, so bit 0 is the offset
+    uint32_t ii[4], jj[4], kk[4], o[6][4], h[4][4];
+    XMStoreInt4(ii, XMConvertVectorFloatToInt(i, 0));
+    XMStoreInt4(jj, XMConvertVectorFloatToInt(j, 0));
+    XMStoreInt4(kk, XMConvertVectorFloatToInt(k, 0));
+    XMStoreInt4(o[0], i1);
+    XMStoreInt4(o[1], j1);
+    XMStoreInt4(o[2], k1);
+    XMStoreInt4(o[3], i2);
+    XMStoreInt4(o[4], j2);
+    XMStoreInt4(o[5], k2);
+    for (int l = 0; l < 4; ++l) {
+        // Wrap the integer indices at 256, to avoid indexing perm[] out of bounds
+        auto il = ii[l] & 0xff;
+        auto jl = jj[l] & 0xff;
+        auto kl = kk[l] & 0xff;
+        h[0][l] = perm[il + perm[jl + perm[kl]]];
+        h[1][l] = perm[il + (o[0][l] & 1) + perm[jl + (o[1][l] & 1) + perm[kl + (o[2][l] & 1)]]];
+        h[2][l] = perm[il + (o[3][l] & 1) + perm[jl + (o[4][l] & 1) + perm[kl + (o[5][l] & 1)]]];
+        h[3][l] = perm[il + 1 + perm[jl + 1 + perm[kl + 1]]];
+    }
+
+    auto n = SimplexCorner3x4(XMLoadInt4(h[0]), x0, y0, z0);
+    n = XMVectorAdd(n, SimplexCorner3x4(XMLoadInt4(h[1]), x1, y1, z1));
+    n = XMVectorAdd(n, SimplexCorner3x4(XMLoadInt4(h[2]), x2, y2, z2));
+    n = XMVectorAdd(n, SimplexCorner3x4(XMLoadInt4(h[3]), x3, y3, z3));
+    return XMVectorScale(n, 32.0f);
+}
+
 // Very simple multi-octave simplex noise helper
 // Returns noise in the range [0, 1] vs. the usual [-1, 1]
 template <size_t N = 4>
@@ -44,6 +152,22 @@ public:
         return r * mWeightNorm + 0.5f;
     }
 
+    // Evaluates the 3D noise at four points with SimplexNoise3x4()
+    void Evaluate4(const float* x, const float* y, const float* z, float* result) const
+    {
+        using namespace DirectX;
+        auto px = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(x));
+        auto py = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(y));
+        auto pz = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(z));
+        auto r = XMVectorZero();
+        for (size_t i = 0; i < N; ++i) {
+            r = XMVectorAdd(r, XMVectorScale(SimplexNoise3x4(px, py, pz), mWeights[i]));
+            px = XMVectorScale(px, 2.0f); py = XMVectorScale(py, 2.0f); pz = XMVectorScale(pz, 2.0f);
+        }
+        r = XMVectorAdd(XMVectorScale(r, mWeightNorm), XMVectorReplicate(0.5f));
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(result), r);
+    }
+
     // Returns [0, 1]
     float operator()(float x, float y, float z, float w) const
     {
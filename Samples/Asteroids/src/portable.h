@@ -0,0 +1,44 @@
+// Copyright 2014 Intel Corporation All Rights Reserved
+//
+// Intel makes no representations about the suitability of this software for any purpose.  
+// THIS SOFTWARE IS PROVIDED ""AS IS."" INTEL SPECIFICALLY DISCLAIMS ALL WARRANTIES,
+// EXPRESS OR IMPLIED, AND ALL LIABILITY, INCLUDING CONSEQUENTIAL AND OTHER INDIRECT DAMAGES,
+// FOR THE USE OF THIS SOFTWARE, INCLUDING LIABILITY FOR INFRINGEMENT OF ANY PROPRIETARY
+// RIGHTS, AND INCLUDING THE WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+// Intel does not assume any responsibility for any errors which may appear in this software
+// nor any responsibility to update it.
+
+#pragma once
+
+// Win32 types and macros used by the platform-independent parts of the demo
+// (simulation, meshes, procedural textures and the Diligent renderer).
+// On other platforms, minimal equivalents are defined here.
+
+#ifdef _WIN32
+
+#include <d3d11.h> // For D3D11_SUBRESOURCE_DATA
+
+#else
+
+#include <cstdint>
+#include <cfloat>
+
+typedef uint8_t      BYTE;
+typedef uint32_t     DWORD;
+typedef unsigned int UINT;
+
+// Matches the layout of the D3D11 structure
+struct D3D11_SUBRESOURCE_DATA
+{
+    const void* pSysMem;
+    UINT        SysMemPitch;
+    UINT        SysMemSlicePitch;
+};
+
+#ifndef ARRAYSIZE
+#define ARRAYSIZE(a) (sizeof(a) / sizeof((a)[0]))
+#endif
+
+#define D3D11_FLOAT32_MAX FLT_MAX
+
+#endif
@@ -31,6 +31,8 @@ enum { MESH_MAX_SUBDIV_LEVELS = 3 }; // 4x polys for each step.
 #define SIM_ORBIT_RADIUS 450.f
 #define SIM_DISC_RADIUS  120.f
 #define SIM_MIN_SCALE    0.2f
+// Relative screen size of the lowest subdivision level
+#define SIM_MIN_SUBDIV_SIZE 0.0019f
 
 // In FLIP swap chains the compositor owns one of your buffers at any given point
 // Thus to run unconstrained (>vsync) frame rates, you need 3 buffers
@@ -65,6 +65,9 @@ extern "C" {
     float snoise3( float x, float y, float z );
     float snoise4( float x, float y, float z, float w );
 
+    // Permutation table of the noise functions, also used by the vectorized noise in noise.h
+    extern unsigned char perm[512];
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
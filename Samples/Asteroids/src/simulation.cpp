@@ -17,7 +17,15 @@
 #include <limits>
 #include <algorithm>
 #include <iostream>
-#include <ppl.h>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <string>
 
 using namespace DirectX;
 
@@ -58,23 +66,41 @@ static inline float VeryApproxLog2f(float x)
 
 AsteroidsSimulation::AsteroidsSimulation(unsigned int rngSeed, unsigned int asteroidCount,
                                          unsigned int meshInstanceCount, unsigned int subdivCount,
-                                         unsigned int textureCount)
+                                         unsigned int textureCount, const char* textureCacheDir)
     : mAsteroidStatic(asteroidCount)
     , mAsteroidDynamic(asteroidCount)
+    , mAsteroidBlocks((asteroidCount + SIM_BLOCK_SIZE - 1) / SIM_BLOCK_SIZE)
     , mIndexOffsets(size_t{subdivCount} + 2) // Mesh subdivs are inclusive on both ends and need forward differencing for count
     , mSubdivCount(subdivCount)
 {
     std::mt19937 rng(rngSeed);
 
+    using Clock = std::chrono::high_resolution_clock;
+    auto msSince = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+
     // Create meshes
     std::cout
         << "Creating " << meshInstanceCount << " meshes, each with "
         << subdivCount << " subdivision levels..." << std::endl;
 
+    auto meshesStart = Clock::now();
     CreateAsteroidsFromGeospheres(&mMeshes, mSubdivCount, meshInstanceCount,
                                   rng(), mIndexOffsets.data(), &mVertexCountPerMesh);
+    auto meshesTime = msSince(meshesStart);
+
+    auto texturesStart = Clock::now();
+    CreateTextures(textureCount, rng(), textureCacheDir);
+    auto texturesTime = msSince(texturesStart);
 
-    CreateTextures(textureCount, rng());
+    // Startup time report
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(1)
+           << "Created meshes in " << meshesTime << " ms and "
+           << textureCount << " textures in " << texturesTime << " ms using "
+           << std::max(1U, std::thread::hardware_concurrency()) << " threads";
+    std::cout << report.str() << std::endl;
 
     // Constants
     std::normal_distribution<float> orbitRadiusDist(SIM_ORBIT_RADIUS, 0.6f * SIM_DISC_RADIUS);
@@ -91,7 +117,7 @@ AsteroidsSimulation::AsteroidsSimulation(unsigned int rngSeed, unsigned int aste
     // Approximate SRGB->Linear for colors
     float linearColorSchemes[NUM_COLOR_SCHEMES * 6];
     for (int i = 0; i < ARRAYSIZE(linearColorSchemes); ++i) {
-        linearColorSchemes[i] = std::powf((float)COLOR_SCHEMES[i] / 255.0f, 2.2f);
+        linearColorSchemes[i] = std::pow((float)COLOR_SCHEMES[i] / 255.0f, 2.2f);
     }
 
     // Create a torus of asteroids that spin around the ring
@@ -129,11 +155,181 @@ AsteroidsSimulation::AsteroidsSimulation(unsigned int rngSeed, unsigned int aste
         // Initialize dynamic data
         mAsteroidDynamic[i].world = scaleMatrix * disc * orbit;
 
+        // Initialize the vectorized state with the same transform: the orbit rotation
+        // becomes the orientation and the translated disc position is rotated by it
+        auto& block = mAsteroidBlocks[i / SIM_BLOCK_SIZE];
+        auto lane = i % SIM_BLOCK_SIZE;
+
+        float sinHalfAngle, cosHalfAngle;
+        XMScalarSinCos(&sinHalfAngle, &cosHalfAngle, 0.5f * positionAngle);
+        block.qx[lane] = 0.0f;
+        block.qy[lane] = sinHalfAngle;
+        block.qz[lane] = 0.0f;
+        block.qw[lane] = cosHalfAngle;
+
+        XMFLOAT3 position;
+        XMStoreFloat3(&position, XMVector3Transform(XMVectorSet(orbitRadius, discPosY, 0.0f, 1.0f), orbit));
+        block.px[lane] = position.x;
+        block.py[lane] = position.y;
+        block.pz[lane] = position.z;
+
+        XMFLOAT3 spinAxis;
+        XMStoreFloat3(&spinAxis, mAsteroidStatic[i].spinAxis);
+        block.spinAxisX[lane] = spinAxis.x;
+        block.spinAxisY[lane] = spinAxis.y;
+        block.spinAxisZ[lane] = spinAxis.z;
+
+        block.scale[lane]         = scale;
+        block.spinVelocity[lane]  = mAsteroidStatic[i].spinVelocity;
+        block.orbitVelocity[lane] = mAsteroidStatic[i].orbitVelocity;
+
         assert(mAsteroidStatic[i].scale > 0.0f);
         assert(mAsteroidStatic[i].orbitVelocity > 0.0f);
     }
+
+    // Padding lanes of the last block are never output, but keep them well-formed
+    for (unsigned int i = asteroidCount; i < mAsteroidBlocks.size() * SIM_BLOCK_SIZE; ++i) {
+        auto& block = mAsteroidBlocks[i / SIM_BLOCK_SIZE];
+        auto lane = i % SIM_BLOCK_SIZE;
+        block.qw[lane] = 1.0f;
+        block.scale[lane] = 1.0f;
+    }
+}
+
+
+#define LOAD_LANES(Field) XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(Field))
+#define STORE_LANES(Field, Value) XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(Field), Value)
+
+static_assert(SIM_BLOCK_SIZE == 4, "The block update processes one XMVECTOR per field");
+
+// Advances one block of asteroids and writes the world matrices and the subdivision levels
+// of lanes [laneBegin, laneEnd) to dynamicData[laneBegin..laneEnd).
+static void UpdateAsteroidBlock(AsteroidBlock& block, float frameTime, bool animate, FXMVECTOR cameraEye,
+                                float minSubdivSizeLog2, unsigned int subdivCount,
+                                unsigned int laneBegin, unsigned int laneEnd,
+                                AsteroidDynamic* dynamicData, unsigned int* subdivs)
+{
+    auto qx = LOAD_LANES(block.qx);
+    auto qy = LOAD_LANES(block.qy);
+    auto qz = LOAD_LANES(block.qz);
+    auto qw = LOAD_LANES(block.qw);
+    auto px = LOAD_LANES(block.px);
+    auto py = LOAD_LANES(block.py);
+    auto pz = LOAD_LANES(block.pz);
+    auto scale = LOAD_LANES(block.scale);
+
+    if (animate) {
+        // world = spin * world * orbit becomes q = qOrbit * q * qSpin for the orientation
+        // while the position is only affected by the orbit rotation
+        XMVECTOR sinSpin, cosSpin;
+        XMVectorSinCos(&sinSpin, &cosSpin, XMVectorScale(LOAD_LANES(block.spinVelocity), 0.5f * frameTime));
+        auto sx = XMVectorMultiply(LOAD_LANES(block.spinAxisX), sinSpin);
+        auto sy = XMVectorMultiply(LOAD_LANES(block.spinAxisY), sinSpin);
+        auto sz = XMVectorMultiply(LOAD_LANES(block.spinAxisZ), sinSpin);
+        auto sw = cosSpin;
+
+        // q * qSpin
+        auto nx = XMVectorAdd(XMVectorMultiplyAdd(qw, sx, XMVectorMultiply(sw, qx)), XMVectorNegativeMultiplySubtract(qz, sy, XMVectorMultiply(qy, sz)));
+        auto ny = XMVectorAdd(XMVectorMultiplyAdd(qw, sy, XMVectorMultiply(sw, qy)), XMVectorNegativeMultiplySubtract(qx, sz, XMVectorMultiply(qz, sx)));
+        auto nz = XMVectorAdd(XMVectorMultiplyAdd(qw, sz, XMVectorMultiply(sw, qz)), XMVectorNegativeMultiplySubtract(qy, sx, XMVectorMultiply(qx, sy)));
+        auto nw = XMVectorSubtract(XMVectorMultiply(qw, sw), XMVectorMultiplyAdd(qx, sx, XMVectorMultiplyAdd(qy, sy, XMVectorMultiply(qz, sz))));
+
+        // qOrbit * q, where qOrbit = (0, sin, 0, cos) is a rotation about Y
+        XMVECTOR sinOrbit, cosOrbit;
+        XMVectorSinCos(&sinOrbit, &cosOrbit, XMVectorScale(LOAD_LANES(block.orbitVelocity), 0.5f * frameTime));
+        qx = XMVectorMultiplyAdd(cosOrbit, nx, XMVectorMultiply(sinOrbit, nz));
+        qy = XMVectorMultiplyAdd(cosOrbit, ny, XMVectorMultiply(sinOrbit, nw));
+        qz = XMVectorNegativeMultiplySubtract(sinOrbit, nx, XMVectorMultiply(cosOrbit, nz));
+        qw = XMVectorNegativeMultiplySubtract(sinOrbit, ny, XMVectorMultiply(cosOrbit, nw));
+
+        // Renormalize to keep rounding errors from accumulating over many frames
+        auto lengthSq = XMVectorMultiplyAdd(qx, qx, XMVectorMultiplyAdd(qy, qy, XMVectorMultiplyAdd(qz, qz, XMVectorMultiply(qw, qw))));
+        auto lengthRcp = XMVectorReciprocalSqrt(lengthSq);
+        qx = XMVectorMultiply(qx, lengthRcp);
+        qy = XMVectorMultiply(qy, lengthRcp);
+        qz = XMVectorMultiply(qz, lengthRcp);
+        qw = XMVectorMultiply(qw, lengthRcp);
+
+        // Full-angle orbit rotation from the half-angle sine and cosine
+        auto cosAngle = XMVectorNegativeMultiplySubtract(sinOrbit, sinOrbit, XMVectorMultiply(cosOrbit, cosOrbit));
+        auto sinAngle = XMVectorScale(XMVectorMultiply(sinOrbit, cosOrbit), 2.0f);
+        auto rx = XMVectorMultiplyAdd(px, cosAngle, XMVectorMultiply(pz, sinAngle));
+        pz = XMVectorNegativeMultiplySubtract(px, sinAngle, XMVectorMultiply(pz, cosAngle));
+        px = rx;
+
+        STORE_LANES(block.qx, qx);
+        STORE_LANES(block.qy, qy);
+        STORE_LANES(block.qz, qz);
+        STORE_LANES(block.qw, qw);
+        STORE_LANES(block.px, px);
+        STORE_LANES(block.pz, pz);
+    }
+
+    // Scaled rotation matrix of the quaternion in row-vector convention
+    auto two = XMVectorReplicate(2.0f);
+    auto one = XMVectorSplatOne();
+    auto xx = XMVectorMultiply(qx, qx);
+    auto yy = XMVectorMultiply(qy, qy);
+    auto zz = XMVectorMultiply(qz, qz);
+    auto xy = XMVectorMultiply(qx, qy);
+    auto xz = XMVectorMultiply(qx, qz);
+    auto yz = XMVectorMultiply(qy, qz);
+    auto xw = XMVectorMultiply(qx, qw);
+    auto yw = XMVectorMultiply(qy, qw);
+    auto zw = XMVectorMultiply(qz, qw);
+    auto scale2 = XMVectorMultiply(scale, two);
+
+    XMMATRIX row0(XMVectorMultiply(scale, XMVectorNegativeMultiplySubtract(two, XMVectorAdd(yy, zz), one)),
+                  XMVectorMultiply(scale2, XMVectorAdd(xy, zw)),
+                  XMVectorMultiply(scale2, XMVectorSubtract(xz, yw)),
+                  XMVectorZero());
+    XMMATRIX row1(XMVectorMultiply(scale2, XMVectorSubtract(xy, zw)),
+                  XMVectorMultiply(scale, XMVectorNegativeMultiplySubtract(two, XMVectorAdd(xx, zz), one)),
+                  XMVectorMultiply(scale2, XMVectorAdd(yz, xw)),
+                  XMVectorZero());
+    XMMATRIX row2(XMVectorMultiply(scale2, XMVectorAdd(xz, yw)),
+                  XMVectorMultiply(scale2, XMVectorSubtract(yz, xw)),
+                  XMVectorMultiply(scale, XMVectorNegativeMultiplySubtract(two, XMVectorAdd(xx, yy), one)),
+                  XMVectorZero());
+    XMMATRIX row3(px, py, pz, one);
+
+    // Transpose from one vector per component to one vector per asteroid
+    row0 = XMMatrixTranspose(row0);
+    row1 = XMMatrixTranspose(row1);
+    row2 = XMMatrixTranspose(row2);
+    row3 = XMMatrixTranspose(row3);
+
+    // Pick LOD based on approx screen area - same approximation as the reference update
+    auto dx = XMVectorSubtract(XMVectorSplatX(cameraEye), px);
+    auto dy = XMVectorSubtract(XMVectorSplatY(cameraEye), py);
+    auto dz = XMVectorSubtract(XMVectorSplatZ(cameraEye), pz);
+    auto distanceToEyeRcp = XMVectorReciprocalSqrtEst(XMVectorMultiplyAdd(dx, dx, XMVectorMultiplyAdd(dy, dy, XMVectorMultiply(dz, dz))));
+    // Reinterpreting the float bits as an integer gives a scaled and biased log2
+    auto relativeScreenSize = XMVectorMultiply(scale, distanceToEyeRcp);
+    auto relativeScreenSizeLog2 = XMVectorSubtract(XMConvertVectorUIntToFloat(relativeScreenSize, 23), XMVectorReplicate(126.94269504f));
+    auto subdivFloat = XMVectorClamp(XMVectorSubtract(relativeScreenSizeLog2, XMVectorReplicate(minSubdivSizeLog2)),
+                                     XMVectorZero(), XMVectorReplicate(static_cast<float>(subdivCount)));
+    XMStoreInt4(subdivs, XMConvertVectorFloatToUInt(subdivFloat, 0));
+
+    for (unsigned int lane = laneBegin; lane < laneEnd; ++lane) {
+        dynamicData[lane].world = XMMATRIX(row0.r[lane], row1.r[lane], row2.r[lane], row3.r[lane]);
+    }
 }
 
+// Copies lanes [laneBegin, laneEnd) of every field between two blocks
+static void CopyBlockLanes(const AsteroidBlock& src, AsteroidBlock& dst, unsigned int laneBegin, unsigned int laneEnd)
+{
+    static_assert(sizeof(AsteroidBlock) % (sizeof(float) * SIM_BLOCK_SIZE) == 0, "AsteroidBlock must only contain lane arrays");
+    const size_t fieldCount = sizeof(AsteroidBlock) / (sizeof(float) * SIM_BLOCK_SIZE);
+
+    auto srcFields = reinterpret_cast<const float(*)[SIM_BLOCK_SIZE]>(&src);
+    auto dstFields = reinterpret_cast<float(*)[SIM_BLOCK_SIZE]>(&dst);
+    for (size_t field = 0; field < fieldCount; ++field) {
+        for (unsigned int lane = laneBegin; lane < laneEnd; ++lane) {
+            dstFields[field][lane] = srcFields[field][lane];
+        }
+    }
+}
 
 void AsteroidsSimulation::Update(float frameTime, DirectX::XMVECTOR cameraEye, const Settings& settings,
                                  size_t startIndex, size_t count)
@@ -141,7 +337,49 @@ void AsteroidsSimulation::Update(float frameTime, DirectX::XMVECTOR cameraEye, c
     bool animate = settings.animate;
 
     // TODO: This constant should really depend on resolution and/or be configurable...
-    static const float minSubdivSizeLog2 = std::log2f(0.0019f);
+    static const float minSubdivSizeLog2 = std::log2f(SIM_MIN_SUBDIV_SIZE);
+
+    size_t last = count ? startIndex + count : mAsteroidDynamic.size();
+    size_t firstBlock = startIndex / SIM_BLOCK_SIZE;
+    size_t lastBlock = (last + SIM_BLOCK_SIZE - 1) / SIM_BLOCK_SIZE;
+    for (size_t b = firstBlock; b < lastBlock; ++b) {
+        size_t blockStart = b * SIM_BLOCK_SIZE;
+        auto laneBegin = (unsigned int)(std::max(startIndex, blockStart) - blockStart);
+        auto laneEnd = (unsigned int)(std::min(last, blockStart + SIM_BLOCK_SIZE) - blockStart);
+
+        unsigned int subdivs[SIM_BLOCK_SIZE];
+        if (laneBegin == 0 && laneEnd == SIM_BLOCK_SIZE) {
+            UpdateAsteroidBlock(mAsteroidBlocks[b], frameTime, animate, cameraEye, minSubdivSizeLog2, mSubdivCount,
+                                laneBegin, laneEnd, &mAsteroidDynamic[blockStart], subdivs);
+        } else {
+            // The block is either the padded last block or is shared with a range that may be
+            // updated on another thread: work on a copy and only write back the lanes of this range
+            AsteroidBlock block = {};
+            CopyBlockLanes(mAsteroidBlocks[b], block, laneBegin, laneEnd);
+            UpdateAsteroidBlock(block, frameTime, animate, cameraEye, minSubdivSizeLog2, mSubdivCount,
+                                laneBegin, laneEnd, &mAsteroidDynamic[blockStart], subdivs);
+            CopyBlockLanes(block, mAsteroidBlocks[b], laneBegin, laneEnd);
+        }
+
+        for (unsigned int lane = laneBegin; lane < laneEnd; ++lane) {
+            AsteroidDynamic& dynamicData = mAsteroidDynamic[blockStart + lane];
+            dynamicData.indexStart = mIndexOffsets[subdivs[lane]];
+            dynamicData.indexCount = mIndexOffsets[subdivs[lane] + 1] - dynamicData.indexStart;
+        }
+    }
+}
+
+#undef LOAD_LANES
+#undef STORE_LANES
+
+
+void AsteroidsSimulation::UpdateReference(float frameTime, DirectX::XMVECTOR cameraEye, const Settings& settings,
+                                          size_t startIndex, size_t count)
+{
+    bool animate = settings.animate;
+
+    // TODO: This constant should really depend on resolution and/or be configurable...
+    static const float minSubdivSizeLog2 = std::log2f(SIM_MIN_SUBDIV_SIZE);
 
     size_t last = count ? startIndex + count : mAsteroidDynamic.size();
     for (size_t i = startIndex; i < last; ++i) {
@@ -170,16 +408,68 @@ void AsteroidsSimulation::Update(float frameTime, DirectX::XMVECTOR cameraEye, c
 }
 
 
-void AsteroidsSimulation::CreateTextures(unsigned int textureCount, unsigned int rngSeed)
+// Texture cache file layout: TextureCacheHeader followed by the raw texture data buffer
+struct TextureCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint64_t dataSize;
+};
+
+static const uint32_t TEXTURE_CACHE_MAGIC   = 0x58544341; // 'ACTX'
+static const uint32_t TEXTURE_CACHE_VERSION = 2;          // Bump when the generator output changes
+
+// FNV-1a
+static uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+{
+    auto bytes = (const BYTE*)data;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static bool LoadTextureCache(const char* fileName, uint64_t key, std::vector<BYTE>* data)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file)
+        return false;
+
+    TextureCacheHeader header = {};
+    file.read((char*)&header, sizeof(header));
+    if (!file || header.magic != TEXTURE_CACHE_MAGIC || header.version != TEXTURE_CACHE_VERSION ||
+        header.key != key || header.dataSize != data->size())
+        return false;
+
+    file.read((char*)data->data(), (std::streamsize)data->size());
+    return (bool)file;
+}
+
+static void SaveTextureCache(const char* fileName, uint64_t key, const std::vector<BYTE>& data)
+{
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    TextureCacheHeader header = {TEXTURE_CACHE_MAGIC, TEXTURE_CACHE_VERSION, key, data.size()};
+    file.write((const char*)&header, sizeof(header));
+    file.write((const char*)data.data(), (std::streamsize)data.size());
+    if (!file) {
+        std::cout << "Failed to write texture cache " << fileName << std::endl;
+    }
+}
+
+
+void AsteroidsSimulation::CreateTextures(unsigned int textureCount, unsigned int rngSeed, const char* textureCacheDir)
 {
     mTextureDim = TEXTURE_DIM;
     mTextureCount = textureCount;
     mTextureArraySize = 3;
     {
-        DWORD msbIndex = 0;
-        auto result = _BitScanReverse(&msbIndex, mTextureDim);
-        assert(result); // Should only fail if mTextureDim = 0
-        mTextureMipLevels = msbIndex + 1;
+        assert(mTextureDim != 0);
+        // Index of the most significant bit + 1
+        mTextureMipLevels = 0;
+        for (auto dim = mTextureDim; dim != 0; dim >>= 1)
+            ++mTextureMipLevels;
     }
 
     assert((mTextureDim & (mTextureDim-1)) == 0); // Must be pow2 currently; we don't handle wacky mip chains
@@ -196,20 +486,8 @@ void AsteroidsSimulation::CreateTextures(unsigned int textureCount, unsigned int
 
     mTextureDataBuffer.resize(size_t{totalTextureSizeInBytes} * size_t{textureCount});
     mTextureSubresources.resize(size_t{mTextureArraySize} * size_t{mTextureMipLevels} * size_t{textureCount});
-    
-    // Parallel over textures
-    std::vector<unsigned int> rngSeeds(textureCount);
-    {
-        std::mt19937 seeds;
-        for (auto &i : rngSeeds) i = seeds();
-    }
-
-    concurrency::parallel_for(UINT(0), textureCount, [&](UINT t) {
-        std::mt19937 rng(rngSeeds[t]);
-        auto randomNoise = std::uniform_real_distribution<float>(0.0f, 10000.0f);
-        auto randomNoiseScale = std::uniform_real_distribution<float>(100, 150);
-        auto randomPersistence = std::normal_distribution<float>(0.9f, 0.2f);
 
+    for (UINT t = 0; t < textureCount; ++t) {
         BYTE* data = mTextureDataBuffer.data() + t * size_t{totalTextureSizeInBytes};
         for (UINT a = 0; a < mTextureArraySize; ++a) {
             for (UINT m = 0; m < mTextureMipLevels; ++m) {
@@ -224,6 +502,52 @@ void AsteroidsSimulation::CreateTextures(unsigned int textureCount, unsigned int
                 data += size_t{initialData.SysMemPitch} * size_t{height};
             }
         }
+    }
+
+    std::vector<unsigned int> rngSeeds(textureCount);
+    {
+        std::mt19937 seeds;
+        for (auto &i : rngSeeds) i = seeds();
+    }
+
+    // The textures are fully determined by the seeds and the layout
+    uint64_t cacheKey = 0xcbf29ce484222325ULL;
+    {
+        const UINT layout[] = {mTextureDim, mTextureArraySize, mTextureMipLevels, textureCount, totalTextureSizeInBytes};
+        cacheKey = HashBytes(cacheKey, layout, sizeof(layout));
+        cacheKey = HashBytes(cacheKey, rngSeeds.data(), rngSeeds.size() * sizeof(rngSeeds[0]));
+    }
+
+    // The key is part of the file name, so runs with different parameters do not overwrite each other's cache
+    std::string cacheFile;
+    if (textureCacheDir != nullptr && *textureCacheDir != '\0') {
+        std::ostringstream fileName;
+        fileName << textureCacheDir << "/asteroid_textures_" << std::hex << std::setw(16) << std::setfill('0') << cacheKey << ".cache";
+        cacheFile = fileName.str();
+
+        if (LoadTextureCache(cacheFile.c_str(), cacheKey, &mTextureDataBuffer)) {
+            std::cout << "Loaded textures from " << cacheFile << std::endl;
+            return;
+        }
+    }
+
+    // Draw the parameters up front so that they do not depend on the order the work is done in
+    struct NoiseParams
+    {
+        float seed;
+        float persistence;
+        float noiseScale;
+        float strength;
+        float redScale;
+        float greenScale;
+        float blueScale;
+    };
+    std::vector<NoiseParams> noiseParams(size_t{textureCount} * size_t{mTextureArraySize});
+    for (UINT t = 0; t < textureCount; ++t) {
+        std::mt19937 rng(rngSeeds[t]);
+        auto randomNoise = std::uniform_real_distribution<float>(0.0f, 10000.0f);
+        auto randomNoiseScale = std::uniform_real_distribution<float>(100, 150);
+        auto randomPersistence = std::normal_distribution<float>(0.9f, 0.2f);
 
         // Use same parameters for each of the tri-planar projection planes/cube map faces/etc.
         float noiseScale = randomNoiseScale(rng) / float(mTextureDim);
@@ -231,20 +555,68 @@ void AsteroidsSimulation::CreateTextures(unsigned int textureCount, unsigned int
         float strength = 1.5f;
 
         for (UINT a = 0; a < mTextureArraySize; ++a) {
-            float redScale   = 255.0f;
-            float greenScale = 255.0f;
-            float blueScale  = 255.0f;
+            auto& params = noiseParams[t * mTextureArraySize + a];
+            params.seed        = randomNoise(rng);
+            params.persistence = persistence;
+            params.noiseScale  = noiseScale;
+            params.strength    = strength;
+            params.redScale    = 255.0f;
+            params.greenScale  = 255.0f;
+            params.blueScale   = 255.0f;
 
             // DEBUG colors
 #if 0
-            redScale   = t & 1 ? 255.0f : 0.0f;
-            greenScale = t & 2 ? 255.0f : 0.0f;
-            blueScale  = t & 4 ? 255.0f : 0.0f;
+            params.redScale   = t & 1 ? 255.0f : 0.0f;
+            params.greenScale = t & 2 ? 255.0f : 0.0f;
+            params.blueScale  = t & 4 ? 255.0f : 0.0f;
 #endif
-
-            FillNoise2D_RGBA8(&mTextureSubresources[SubresourceIndex(t, a)], mTextureDim, mTextureDim, mTextureMipLevels,
-                              randomNoise(rng), persistence, noiseScale, strength,
-                              redScale, greenScale, blueScale);
         }
-    }); // parallel_for
+    }
+
+    // The top level of every array slice is split into bands of rows, so that all threads are busy
+    // even when there are fewer textures than threads. Whichever worker finishes the last band of
+    // a slice builds its mip chain.
+    const UINT rowsPerBand = std::min<UINT>(mTextureDim, 32);
+    const UINT bandsPerSlice = mTextureDim / rowsPerBand;
+    const UINT sliceCount = textureCount * mTextureArraySize;
+    const UINT bandCount = sliceCount * bandsPerSlice;
+
+    std::unique_ptr<std::atomic<UINT>[]> bandsLeft(new std::atomic<UINT>[sliceCount]);
+    for (UINT i = 0; i < sliceCount; ++i)
+        bandsLeft[i] = bandsPerSlice;
+
+    auto createBand = [&](UINT band) {
+        auto slice = band / bandsPerSlice;
+        auto rowBegin = (band % bandsPerSlice) * rowsPerBand;
+        auto t = slice / mTextureArraySize;
+        auto a = slice % mTextureArraySize;
+        const auto& params = noiseParams[slice];
+        auto subresources = &mTextureSubresources[SubresourceIndex(t, a)];
+
+        FillNoise2DRows_RGBA8(subresources, mTextureDim, rowBegin, rowBegin + rowsPerBand,
+                              params.seed, params.persistence, params.noiseScale, params.strength,
+                              params.redScale, params.greenScale, params.blueScale);
+
+        if (bandsLeft[slice].fetch_sub(1) == 1 && mTextureMipLevels > 1)
+            GenerateMips2D_XXXX8(subresources, mTextureDim, mTextureDim, mTextureMipLevels);
+    };
+
+    // Bands are picked up one at a time by a pool of workers, so the result
+    // does not depend on the number of threads
+    std::atomic<UINT> nextBand{0};
+    auto numWorkers = std::max(1U, std::min(std::thread::hardware_concurrency(), bandCount));
+    std::vector<std::thread> workers(numWorkers);
+    for (auto& worker : workers) {
+        worker = std::thread([&]() {
+            for (UINT b = nextBand++; b < bandCount; b = nextBand++)
+                createBand(b);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    if (!cacheFile.empty()) {
+        SaveTextureCache(cacheFile.c_str(), cacheKey, mTextureDataBuffer);
+    }
 }
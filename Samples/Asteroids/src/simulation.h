@@ -10,17 +10,16 @@
 
 #pragma once
 
-#include <d3d11.h> // For D3D11_SUBRESOURCE_DATA
 #include <DirectXMath.h>
 #include <vector>
 #include <algorithm>
 #include <random>
 
+#include "portable.h"
 #include "mesh.h"
 #include "settings.h"
 
-// We may want to ISPC-ify this down the road and just let it own the data structure in AoSoA format or similar
-// For now we'll just do the dumb thing and see if it's fast enough
+// Per-frame output of the simulation consumed by the renderers
 struct AsteroidDynamic
 {
     DirectX::XMMATRIX world;
@@ -41,12 +40,41 @@ struct AsteroidStatic
     unsigned int textureIndex;
 };
 
+// Number of asteroids processed together by the vectorized update (the XMVECTOR width)
+enum { SIM_BLOCK_SIZE = 4 };
+
+// Simulation state of SIM_BLOCK_SIZE asteroids in AoSoA format: every field holds one lane
+// per asteroid, so the update loads and stores whole vectors without any shuffling.
+// Orientation is kept as a quaternion rather than a matrix, which makes the spin and orbit
+// updates a pair of quaternion products instead of two 4x4 matrix multiplications.
+struct alignas(16) AsteroidBlock
+{
+    // Orientation quaternion
+    float qx[SIM_BLOCK_SIZE];
+    float qy[SIM_BLOCK_SIZE];
+    float qz[SIM_BLOCK_SIZE];
+    float qw[SIM_BLOCK_SIZE];
+    // Position
+    float px[SIM_BLOCK_SIZE];
+    float py[SIM_BLOCK_SIZE];
+    float pz[SIM_BLOCK_SIZE];
+    float scale[SIM_BLOCK_SIZE];
+    // Normalized spin axis
+    float spinAxisX[SIM_BLOCK_SIZE];
+    float spinAxisY[SIM_BLOCK_SIZE];
+    float spinAxisZ[SIM_BLOCK_SIZE];
+    float spinVelocity[SIM_BLOCK_SIZE];
+    float orbitVelocity[SIM_BLOCK_SIZE];
+};
+
 class AsteroidsSimulation
 {
 private:
-    // NOTE: Memory could be optimized further for efficient cache traversal, etc.
+    // Static data is only read by the renderers and the reference update;
+    // the hot per-frame state lives in mAsteroidBlocks.
     std::vector<AsteroidStatic> mAsteroidStatic;
     std::vector<AsteroidDynamic> mAsteroidDynamic;
+    std::vector<AsteroidBlock> mAsteroidBlocks;
 
     Mesh mMeshes;
     std::vector<unsigned int> mIndexOffsets;
@@ -65,12 +93,14 @@ private:
         return mip + mTextureMipLevels * (arrayElement + mTextureArraySize * texture);
     }
 
-    void CreateTextures(unsigned int textureCount, unsigned int rngSeed);
+    void CreateTextures(unsigned int textureCount, unsigned int rngSeed, const char* textureCacheDir);
     
 public:
+    // Generated textures are saved to textureCacheDir and reused by the next run with the same parameters.
+    // The cache is disabled if textureCacheDir is null.
     AsteroidsSimulation(unsigned int rngSeed, unsigned int asteroidCount,
                         unsigned int meshInstanceCount, unsigned int subdivCount,
-                        unsigned int textureCount);
+                        unsigned int textureCount, const char* textureCacheDir = nullptr);
 
     const Mesh* Meshes() { return &mMeshes; }
     const D3D11_SUBRESOURCE_DATA* TextureData(unsigned int textureIndex)
@@ -80,11 +110,24 @@ public:
 
     unsigned int GetTextureMipLevels()const{return mTextureMipLevels;}
 
+    // Index offsets of the subdivision levels, SubdivCount() + 2 values
+    const unsigned int* IndexOffsets() const { return mIndexOffsets.data(); }
+    unsigned int SubdivCount() const { return mSubdivCount; }
+
     const AsteroidStatic* StaticData() const { return mAsteroidStatic.data(); }
     const AsteroidDynamic* DynamicData() const { return mAsteroidDynamic.data(); }
 
     // Can optionally provide a range of asteroids to update; count = 0 => to the end
     // This is useful for multithreading
+    // Blocks shared by two ranges are updated lane by lane, so the ranges may be updated concurrently
     void Update(float frameTime, DirectX::XMVECTOR cameraEye, const Settings& settings,
                 size_t startIndex = 0, size_t count = 0);
+
+    // The original scalar update that accumulates the world matrices of AsteroidDynamic directly.
+    // It does not advance the vectorized state, so the two functions must not be mixed on the same
+    // instance; it is kept to validate and benchmark Update().
+    void UpdateReference(float frameTime, DirectX::XMVECTOR cameraEye, const Settings& settings,
+                         size_t startIndex = 0, size_t count = 0);
+
+    size_t GetAsteroidCount() const { return mAsteroidStatic.size(); }
 };
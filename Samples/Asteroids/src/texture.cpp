@@ -11,11 +11,12 @@
 #include "texture.h"
 #include "util.h"
 #include "noise.h"
-#include "DDSTextureLoader.h"
 
 #include <stdint.h>
 #include <sstream>
 
+#ifdef _WIN32
+#include "DDSTextureLoader.h"
 
 static void WaitForAll(ID3D12Device* device, ID3D12CommandQueue* queue)
 {
@@ -31,6 +32,19 @@ static void WaitForAll(ID3D12Device* device, ID3D12CommandQueue* queue)
     CloseHandle(eventHandle);
     fence->Release();
 }
+#endif
+
+
+// 2x2 box filter of four XXXX8 texels, all channels at once: even and odd bytes are
+// summed in separate 16-bit lanes so that the sums cannot overflow into the neighbors.
+// Truncates like the per-channel (c0 + c1 + c2 + c3) / 4.
+static inline uint32_t BoxFilter_XXXX8(uint32_t t00, uint32_t t01, uint32_t t10, uint32_t t11)
+{
+    const uint32_t mask = 0x00FF00FF;
+    uint32_t even = (t00 & mask) + (t01 & mask) + (t10 & mask) + (t11 & mask);
+    uint32_t odd  = ((t00 >> 8) & mask) + ((t01 >> 8) & mask) + ((t10 >> 8) & mask) + ((t11 >> 8) & mask);
+    return ((even >> 2) & mask) | (((odd >> 2) & mask) << 8);
+}
 
 
 void GenerateMips2D_XXXX8(D3D11_SUBRESOURCE_DATA* subresources, size_t widthLevel0, size_t heightLevel0, size_t mipLevels)
@@ -45,57 +59,82 @@ void GenerateMips2D_XXXX8(D3D11_SUBRESOURCE_DATA* subresources, size_t widthLeve
         auto width = widthLevel0 >> m;
         auto height = heightLevel0 >> m;
 
-        // Iterating byte-wise is simpler in this case (pulls apart color nicely)
-        // Not optimized at all, obviously...
         for (size_t y = 0; y < height; ++y) {
-            auto rowSrc0 = (dataSrc + (y*2+0)*rowPitchSrc);
-            auto rowSrc1 = (dataSrc + (y*2+1)*rowPitchSrc);
-            auto rowDst  = (dataDst + (y    )*rowPitchDst);
+            auto rowSrc0 = (const uint32_t*)(dataSrc + (y*2+0)*rowPitchSrc);
+            auto rowSrc1 = (const uint32_t*)(dataSrc + (y*2+1)*rowPitchSrc);
+            auto rowDst  = (uint32_t*)(dataDst + (y    )*rowPitchDst);
+            // No dependencies between texels, so this loop vectorizes
             for (size_t x = 0; x < width; ++x) {
-                for (size_t comp = 0; comp < 4; ++comp) {
-                    uint32_t c = rowSrc0[x*8+comp+0];
-                    c +=         rowSrc0[x*8+comp+4];
-                    c +=         rowSrc1[x*8+comp+0];
-                    c +=         rowSrc1[x*8+comp+4];
-                    c = c / 4;
-                    assert(c < 256);
-                    rowDst[4*x+comp] = (byte)c;
-                }
+                rowDst[x] = BoxFilter_XXXX8(rowSrc0[x*2+0], rowSrc0[x*2+1], rowSrc1[x*2+0], rowSrc1[x*2+1]);
             }
         }
     }
 }
 
 
-void FillNoise2D_RGBA8(D3D11_SUBRESOURCE_DATA* subresources, size_t width, size_t height, size_t mipLevels,
-                       float seed, float persistence, float noiseScale, float noiseStrength,
-					   float redScale, float greenScale, float blueScale)
+void FillNoise2DRows_RGBA8(D3D11_SUBRESOURCE_DATA* subresource, size_t width, size_t rowBegin, size_t rowEnd,
+                           float seed, float persistence, float noiseScale, float noiseStrength,
+                           float redScale, float greenScale, float blueScale)
 {
     NoiseOctaves<4> textureNoise(persistence);
-    
-    // Level 0
-    for (size_t y = 0; y < height; ++y) {
-        uint32_t* row = (uint32_t*)((BYTE*)subresources[0].pSysMem + y*subresources[0].SysMemPitch);
-        for (size_t x = 0; x < width; ++x) {
+
+    const float seeds[4] = {seed, seed, seed, seed};
+    for (size_t y = rowBegin; y < rowEnd; ++y) {
+        uint32_t* row = (uint32_t*)((BYTE*)subresource->pSysMem + y*subresource->SysMemPitch);
+        const float ny[4] = {(float)y*noiseScale, (float)y*noiseScale, (float)y*noiseScale, (float)y*noiseScale};
+
+        // Four texels at a time; the tail (textures narrower than 4 texels) falls back to the scalar noise
+        size_t x = 0;
+        for (; x + 4 <= width; x += 4) {
+            float nx[4], c[4];
+            for (size_t l = 0; l < 4; ++l)
+                nx[l] = (float)(x + l)*noiseScale;
+            textureNoise.Evaluate4(nx, ny, seeds, c);
+
+            for (size_t l = 0; l < 4; ++l) {
+                auto cl = std::max(0.0f, std::min(1.0f, (c[l] - 0.5f) * noiseStrength + 0.5f));
+                int32_t cr = (int32_t)(cl * redScale);
+                int32_t cg = (int32_t)(cl * greenScale);
+                int32_t cb = (int32_t)(cl * blueScale);
+                assert(cr >= 0 && cr < 256);
+                assert(cg >= 0 && cg < 256);
+                assert(cb >= 0 && cb < 256);
+
+                row[x + l] = (cr) << 16 | (cg) <<  8 | (cb) << 0;
+            }
+        }
+        for (; x < width; ++x) {
             auto c = textureNoise((float)x*noiseScale, (float)y*noiseScale, seed);
             c = std::max(0.0f, std::min(1.0f, (c - 0.5f) * noiseStrength + 0.5f));
 
             int32_t cr = (int32_t)(c * redScale);
-			int32_t cg = (int32_t)(c * greenScale);
-			int32_t cb = (int32_t)(c * blueScale);
-			assert(cr >= 0 && cr < 256);
-			assert(cg >= 0 && cg < 256);
+            int32_t cg = (int32_t)(c * greenScale);
+            int32_t cb = (int32_t)(c * blueScale);
+            assert(cr >= 0 && cr < 256);
+            assert(cg >= 0 && cg < 256);
             assert(cb >= 0 && cb < 256);
 
             row[x] = (cr) << 16 | (cg) <<  8 | (cb) << 0;
         }
     }
+}
+
+
+void FillNoise2D_RGBA8(D3D11_SUBRESOURCE_DATA* subresources, size_t width, size_t height, size_t mipLevels,
+                       float seed, float persistence, float noiseScale, float noiseStrength,
+					   float redScale, float greenScale, float blueScale)
+{
+    // Level 0
+    FillNoise2DRows_RGBA8(subresources, width, 0, height,
+                          seed, persistence, noiseScale, noiseStrength,
+                          redScale, greenScale, blueScale);
 
     if (mipLevels > 1)
         GenerateMips2D_XXXX8(subresources, width, height, mipLevels);
 }
 
 
+#ifdef _WIN32
 void InitializeTexture2D(
     ID3D12Device* device, ID3D12CommandQueue* cmdQueue,
     ID3D12Resource* texture, const D3D12_RESOURCE_DESC* desc,
@@ -294,3 +333,4 @@ HRESULT CreateTexture2DFromDDS_XXXX8(
     delete[] heapData;
     return S_OK;
 }
+#endif
@@ -10,18 +10,28 @@
 
 #pragma once
 
-#include <d3d12.h>
-#include <d3dx12.h>
-#include <d3d11.h>
+#include <cstddef>
+
+#include "portable.h"
 
 void GenerateMips2D_XXXX8(D3D11_SUBRESOURCE_DATA* subresources, size_t widthLevel0, size_t heightLevel0, size_t mipLevels);
 
+// Fills rows [rowBegin, rowEnd) of the top level only, so that a texture can be split between threads
+void FillNoise2DRows_RGBA8(D3D11_SUBRESOURCE_DATA* subresource, size_t width, size_t rowBegin, size_t rowEnd,
+                           float seed, float persistence, float noiseScale, float noiseStrength,
+                           float redScale = 255.0f, float greenScale = 255.0f, float blueScale = 255.0f);
+
 // Will generate mips (into subresources array) is mipLevels > 0
 void FillNoise2D_RGBA8(D3D11_SUBRESOURCE_DATA* subresources, size_t width, size_t height, size_t mipLevels,
                        float seed, float persistence, float noiseScale, float noiseStrength,
 					   float redScale = 255.0f, float greenScale = 255.0f, float blueScale = 255.0f);
 
 
+#ifdef _WIN32
+
+#include <d3d12.h>
+#include <d3dx12.h>
+
 // Helper for uploading initial texture data in D3D12; as with D3D11, one initialData structure per subresource
 // Creates temporary resources internally and syncs with GPU... this is a convenience function for init time!
 // NOTE: Currently textures with mip chain must be pow2!
@@ -44,3 +54,5 @@ HRESULT CreateTexture2DFromDDS_XXXX8(
     const char* fileName,
     DXGI_FORMAT format, // Should match file otherwise expect explosion/wackiness...
     D3D12_RESOURCE_STATES stateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+
+#endif
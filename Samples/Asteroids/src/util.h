@@ -11,12 +11,15 @@
 #pragma once
 
 #include <assert.h>
-#include <d3d12.h>
 
 #include <algorithm>
 #include <vector>
 
+#ifdef _WIN32
+#include <d3d12.h>
+
 #define CBUFFER_ALIGN __declspec(align(D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT))
+#endif
 
 #define WIDE_HELPER_2(x) L##x
 #define WIDE_HELPER_1(x) WIDE_HELPER_2(x)
@@ -32,18 +35,19 @@ inline void SafeRelease(T** p)
     }
 }
 
-inline HRESULT ThrowIfFailed(HRESULT hr)
-{
-    if (FAILED(hr)) throw;
-    return hr;
-}
-
 template <typename T>
 inline T AlignUp(T v, T align)
 {
     return (v + (align-1)) & ~(align-1);
 }
 
+#ifdef _WIN32
+inline HRESULT ThrowIfFailed(HRESULT hr)
+{
+    if (FAILED(hr)) throw;
+    return hr;
+}
+
 struct ResourceBarrier {
     std::vector<D3D12_RESOURCE_BARRIER> mDescs;
 
@@ -77,3 +81,4 @@ struct ResourceBarrier {
         commandList->ResourceBarrier((UINT)mDescs.size(), mDescs.data());
     }
 };
+#endif
@@ -0,0 +1,22 @@
+
+#include "HostSharedTerrainStructs.fxh"
+
+Texture2D< uint >                       g_tex2DFinerMip;
+RWTexture2D< uint /* format=r16ui */ >  g_rwtex2DCoarserMip;
+
+// Averages 2x2 texels of the finer mip level exactly like the CPU path does
+[numthreads(NM_GENERATION_GROUP_SIZE, NM_GENERATION_GROUP_SIZE, 1)]
+void GenerateHeightMipCS(uint3 DTid : SV_DispatchThreadID)
+{
+    uint MipWidth, MipHeight;
+    g_rwtex2DCoarserMip.GetDimensions( MipWidth, MipHeight );
+    if (DTid.x >= MipWidth || DTid.y >= MipHeight)
+        return;
+
+    int2 i2FinerIJ = int2(DTid.xy) * 2;
+    uint uiSum = g_tex2DFinerMip.Load( int3(i2FinerIJ + int2(0,0), 0) ) +
+                 g_tex2DFinerMip.Load( int3(i2FinerIJ + int2(1,0), 0) ) +
+                 g_tex2DFinerMip.Load( int3(i2FinerIJ + int2(0,1), 0) ) +
+                 g_tex2DFinerMip.Load( int3(i2FinerIJ + int2(1,1), 0) );
+    g_rwtex2DCoarserMip[DTid.xy] = uiSum >> 2u;
+}
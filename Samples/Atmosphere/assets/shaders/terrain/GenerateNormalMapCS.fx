@@ -0,0 +1,17 @@
+
+#include "ComputeNormal.fxh"
+
+RWTexture2D< float2 /* format=rg8 */ > g_rwtex2DNormalMap;
+
+[numthreads(NM_GENERATION_GROUP_SIZE, NM_GENERATION_GROUP_SIZE, 1)]
+void GenerateNormalMapCS(uint3 DTid : SV_DispatchThreadID)
+{
+    uint MipWidth, MipHeight;
+    g_rwtex2DNormalMap.GetDimensions( MipWidth, MipHeight );
+    if (DTid.x >= MipWidth || DTid.y >= MipHeight)
+        return;
+
+    float3 Normal = ComputeNormal( int2(DTid.xy), g_NMGenerationAttribs.m_fSampleSpacingInterval*exp2( float(g_NMGenerationAttribs.m_iMIPLevel) ), g_NMGenerationAttribs.m_iMIPLevel );
+    // Only xy components are stored. z component is calculated in the shader
+    g_rwtex2DNormalMap[DTid.xy] = Normal.xy * float2(0.5,0.5) + float2(0.5,0.5);
+}
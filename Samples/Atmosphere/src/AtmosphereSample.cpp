@@ -28,6 +28,7 @@
 #include <cmath>
 #include <algorithm>
 #include <array>
+#include <thread>
 
 #include "AtmosphereSample.hpp"
 #include "MapHelper.hpp"
@@ -37,6 +38,7 @@
 #include "../imGuIZMO.quat/imGuIZMO.h"
 #include "PlatformMisc.hpp"
 #include "ImGuiUtils.hpp"
+#include "CommandLineParser.hpp"
 
 namespace Diligent
 {
@@ -49,12 +51,25 @@ SampleBase* CreateSample()
 AtmosphereSample::AtmosphereSample()
 {}
 
+AtmosphereSample::CommandLineStatus AtmosphereSample::ProcessCommandLine(int argc, const char* const* argv)
+{
+    CommandLineParser ArgsParser{argc, argv};
+    // The height map may be an image or a tiled elevation file (ElevationDataSource::TiledFileExtension)
+    ArgsParser.Parse("height_map", m_strRawDEMDataFile);
+    ArgsParser.Parse("save_tiled_height_map", m_strTiledDEMDataFile);
+
+    return CommandLineStatus::OK;
+}
+
 void AtmosphereSample::ModifyEngineInitInfo(const ModifyEngineInitInfoAttribs& Attribs)
 {
     SampleBase::ModifyEngineInitInfo(Attribs);
 
     Attribs.EngineCI.Features.ComputeShaders = DEVICE_FEATURE_STATE_ENABLED;
     Attribs.EngineCI.Features.DepthClamp     = DEVICE_FEATURE_STATE_OPTIONAL;
+
+    // The first shadow cascade is recorded by the immediate context, the remaining ones by deferred contexts
+    Attribs.EngineCI.NumDeferredContexts = std::min(std::max(std::thread::hardware_concurrency(), 2u) - 1u, Uint32{MaxShadowCascades - 1});
 }
 
 void AtmosphereSample::Initialize(const SampleInitInfo& InitInfo)
@@ -101,7 +116,8 @@ void AtmosphereSample::Initialize(const SampleInitInfo& InitInfo)
     m_f3CustomMieBeta         = m_PPAttribs.f4CustomMieBeta;
     m_f3CustomOzoneAbsoprtion = m_PPAttribs.f4CustomOzoneAbsorption;
 
-    m_strRawDEMDataFile       = "Terrain\\HeightMap.tif";
+    if (m_strRawDEMDataFile.empty())
+        m_strRawDEMDataFile = "Terrain\\HeightMap.tif";
     m_strMtrlMaskFile         = "Terrain\\Mask.png";
     m_strTileTexPaths[0]      = "Terrain\\Tiles\\gravel_DM.dds";
     m_strTileTexPaths[1]      = "Terrain\\Tiles\\grass_DM.dds";
@@ -121,6 +137,9 @@ void AtmosphereSample::Initialize(const SampleInitInfo& InitInfo)
         m_pElevDataSource->SetOffsets(m_TerrainRenderParams.m_iColOffset, m_TerrainRenderParams.m_iRowOffset);
         m_fMinElevation = m_pElevDataSource->GetGlobalMinElevation() * m_TerrainRenderParams.m_TerrainAttribs.m_fElevationScale;
         m_fMaxElevation = m_pElevDataSource->GetGlobalMaxElevation() * m_TerrainRenderParams.m_TerrainAttribs.m_fElevationScale;
+
+        if (!m_strTiledDEMDataFile.empty() && m_pElevDataSource->CreateTiledFile(m_strTiledDEMDataFile.c_str()))
+            LOG_INFO_MESSAGE("Saved tiled height map to ", m_strTiledDEMDataFile);
     }
     catch (const std::exception&)
     {
@@ -161,6 +180,19 @@ void AtmosphereSample::Initialize(const SampleInitInfo& InitInfo)
                              m_pcbLightAttribs,
                              m_pLightSctrPP->GetMediaAttribsCB());
 
+    m_CascadeCameraAttribsCBs.resize(MaxShadowCascades);
+    m_CascadeZOnlySRBs.resize(MaxShadowCascades);
+    for (int iCascade = 0; iCascade < MaxShadowCascades; ++iCascade)
+    {
+        CreateUniformBuffer(m_pDevice, sizeof(CameraAttribs), "Cascade Camera Attribs CB", &m_CascadeCameraAttribsCBs[iCascade]);
+        m_EarthHemisphere.CreateZOnlySRB(m_CascadeCameraAttribsCBs[iCascade], &m_CascadeZOnlySRBs[iCascade]);
+    }
+
+    std::vector<IDeviceContext*> ppDeferredCtx(m_pDeferredContexts.size());
+    for (size_t i = 0; i < m_pDeferredContexts.size(); ++i)
+        ppDeferredCtx[i] = m_pDeferredContexts[i];
+    m_pJobScheduler.reset(new RenderJobScheduler{m_pImmediateContext, ppDeferredCtx.data(), static_cast<Uint32>(ppDeferredCtx.size())});
+
     CreateShadowMap();
 }
 
@@ -190,7 +222,7 @@ void AtmosphereSample::UpdateUI()
                 }
             }
 
-            if (ImGui::SliderInt("Num cascades", &m_TerrainRenderParams.m_iNumShadowCascades, 1, 8))
+            if (ImGui::SliderInt("Num cascades", &m_TerrainRenderParams.m_iNumShadowCascades, 1, MaxShadowCascades))
                 CreateShadowMap();
 
             ImGui::Checkbox("Visualize cascades", &m_ShadowSettings.bVisualizeCascades);
@@ -533,29 +565,44 @@ void AtmosphereSample::RenderShadowMap(IDeviceContext* pContext,
         };
     m_ShadowMapMgr.DistributeCascades(DistrInfo, ShadowAttribs);
 
-    // Render cascades
-    for (int iCascade = 0; iCascade < m_TerrainRenderParams.m_iNumShadowCascades; ++iCascade)
-    {
-        ITextureView* pCascadeDSV = m_ShadowMapMgr.GetCascadeDSV(iCascade);
-
-        m_pImmediateContext->SetRenderTargets(0, nullptr, pCascadeDSV, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-        m_pImmediateContext->ClearDepthStencil(pCascadeDSV, CLEAR_DEPTH_FLAG, 1.f, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-
-        const float4x4 CascadeProjMatr = m_ShadowMapMgr.GetCascadeTransform(iCascade).Proj;
+    const int NumCascades = m_TerrainRenderParams.m_iNumShadowCascades;
+    VERIFY_EXPR(NumCascades <= MaxShadowCascades);
+
+    const float4x4& WorldToLightViewSpaceMatr = m_PackMatrixRowMajor ?
+        ShadowAttribs.mWorldToLightView :
+        ShadowAttribs.mWorldToLightView.Transpose();
+
+    std::array<float4x4, MaxShadowCascades> WorldToLightProjSpaceMatrs;
+    for (int iCascade = 0; iCascade < NumCascades; ++iCascade)
+        WorldToLightProjSpaceMatrs[iCascade] = WorldToLightViewSpaceMatr * m_ShadowMapMgr.GetCascadeTransform(iCascade).Proj;
+
+    // Deferred contexts can't transition resources, so move all cascades to the depth write state up front
+    const StateTransitionDesc Barrier{m_ShadowMapMgr.GetCascadeDSV(0)->GetTexture(), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_DEPTH_WRITE, STATE_TRANSITION_FLAG_UPDATE_STATE};
+    m_pImmediateContext->TransitionResourceStates(1, &Barrier);
+
+    // Render cascades. Every cascade uses its own constant buffer and is culled against its own frustum,
+    // so cascades are independent and are recorded in parallel.
+    RenderJobScheduler::JobInfo Job;
+    Job.NumItems        = static_cast<Uint32>(NumCascades);
+    Job.MinChunkSize    = 1;
+    Job.ChunksPerWorker = 1;
+    Job.RecordChunk     = [&](IDeviceContext* pCtx, Uint32 CtxIndex, Uint32 FirstCascade, Uint32 EndCascade) {
+        for (Uint32 iCascade = FirstCascade; iCascade < EndCascade; ++iCascade)
+        {
+            ITextureView* pCascadeDSV = m_ShadowMapMgr.GetCascadeDSV(iCascade);
 
-        const float4x4& WorldToLightViewSpaceMatr = m_PackMatrixRowMajor ?
-            ShadowAttribs.mWorldToLightView :
-            ShadowAttribs.mWorldToLightView.Transpose();
+            pCtx->SetRenderTargets(0, nullptr, pCascadeDSV, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            pCtx->ClearDepthStencil(pCascadeDSV, CLEAR_DEPTH_FLAG, 1.f, 0, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
-        const float4x4 WorldToLightProjSpaceMatr = WorldToLightViewSpaceMatr * CascadeProjMatr;
+            {
+                MapHelper<CameraAttribs> CamAttribs(pCtx, m_CascadeCameraAttribsCBs[iCascade], MAP_WRITE, MAP_FLAG_DISCARD);
+                WriteShaderMatrix(&CamAttribs->mViewProj, WorldToLightProjSpaceMatrs[iCascade], !m_PackMatrixRowMajor);
+            }
 
-        {
-            MapHelper<CameraAttribs> CamAttribs(m_pImmediateContext, m_pcbCameraAttribs, MAP_WRITE, MAP_FLAG_DISCARD);
-            WriteShaderMatrix(&CamAttribs->mViewProj, WorldToLightProjSpaceMatr, !m_PackMatrixRowMajor);
+            m_EarthHemisphere.RenderZOnly(pCtx, m_CascadeZOnlySRBs[iCascade], WorldToLightProjSpaceMatrs[iCascade]);
         }
-
-        m_EarthHemisphere.Render(m_pImmediateContext, m_TerrainRenderParams, m_f3CameraPos, WorldToLightProjSpaceMatr, nullptr, nullptr, nullptr, true);
-    }
+    };
+    m_pJobScheduler->Execute(Job);
 }
 
 
@@ -33,6 +33,7 @@
 #include "ElevationDataSource.hpp"
 #include "EpipolarLightScattering.hpp"
 #include "ShadowMapManager.hpp"
+#include "RenderJobScheduler.hpp"
 
 namespace Diligent
 {
@@ -43,6 +44,8 @@ public:
     AtmosphereSample();
     ~AtmosphereSample();
 
+    virtual CommandLineStatus ProcessCommandLine(int argc, const char* const* argv) override final;
+
     virtual void ModifyEngineInitInfo(const ModifyEngineInitInfoAttribs& Attribs) override final;
 
     virtual void Initialize(const SampleInitInfo& InitInfo) override final;
@@ -72,7 +75,16 @@ private:
     RefCntAutoPtr<IBuffer> m_pcbCameraAttribs;
     RefCntAutoPtr<IBuffer> m_pcbLightAttribs;
 
+    static constexpr int MaxShadowCascades = 8;
+
     ShadowMapManager m_ShadowMapMgr;
+
+    // Every cascade has its own camera attribs buffer and Z-only SRB, so that
+    // cascades can be recorded by different threads.
+    std::vector<RefCntAutoPtr<IBuffer>>                m_CascadeCameraAttribsCBs;
+    std::vector<RefCntAutoPtr<IShaderResourceBinding>> m_CascadeZOnlySRBs;
+    std::unique_ptr<RenderJobScheduler>                m_pJobScheduler;
+
     struct ShadowSettings
     {
         Uint32 Resolution                 = 1024;
@@ -87,6 +99,7 @@ private:
     EpipolarLightScatteringAttribs m_PPAttribs;
 
     String m_strRawDEMDataFile;
+    String m_strTiledDEMDataFile; // If not empty, the height map is saved to this tiled elevation file
     String m_strMtrlMaskFile;
     String m_strTileTexPaths[EarthHemsiphere::NUM_TILE_TEXTURES];
     String m_strNormalMapTexPaths[EarthHemsiphere::NUM_TILE_TEXTURES];
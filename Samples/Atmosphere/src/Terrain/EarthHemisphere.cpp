@@ -46,6 +46,8 @@
 #include <algorithm>
 #include <cfloat>
 #include <array>
+#include <atomic>
+#include <thread>
 
 #include "EarthHemisphere.hpp"
 
@@ -68,6 +70,8 @@ namespace Diligent
 #include "CallbackWrapper.hpp"
 #include "Utilities/interface/DiligentFXShaderSourceStreamFactory.hpp"
 #include "ShaderSourceFactoryUtils.hpp"
+#include "ThreadPool.hpp"
+#include "PlatformMisc.hpp"
 
 namespace Diligent
 {
@@ -101,11 +105,11 @@ enum QUAD_TRIANGULATION_TYPE
     QUAD_TRIANG_TYPE_01_TO_10
 };
 
-template <typename IndexType, class IndexGenerator>
+template <typename IndexBufferType, class IndexGenerator>
 class TriStrip
 {
 public:
-    TriStrip(std::vector<IndexType>& Indices, IndexGenerator indexGenerator) :
+    TriStrip(IndexBufferType& Indices, IndexGenerator indexGenerator) :
         m_QuadTriangType(QUAD_TRIANG_TYPE_UNDEFINED),
         m_Indices(Indices),
         m_IndexGenerator(indexGenerator)
@@ -186,10 +190,40 @@ public:
 
 private:
     QUAD_TRIANGULATION_TYPE m_QuadTriangType;
-    std::vector<IndexType>& m_Indices;
+    IndexBufferType&        m_Indices;
     IndexGenerator          m_IndexGenerator;
 };
 
+// Appends indices to a preallocated range of a larger index array
+template <typename IndexType>
+class IndexRange
+{
+public:
+    IndexRange(IndexType* pIndices, size_t MaxIndices) :
+        m_pIndices{pIndices},
+        m_MaxIndices{MaxIndices}
+    {}
+
+    void push_back(IndexType Index)
+    {
+        VERIFY(m_NumIndices < m_MaxIndices, "Index range overflow");
+        m_pIndices[m_NumIndices++] = Index;
+    }
+
+    IndexType back() const
+    {
+        VERIFY_EXPR(m_NumIndices > 0);
+        return m_pIndices[m_NumIndices - 1];
+    }
+
+    size_t size() const { return m_NumIndices; }
+
+private:
+    IndexType* const m_pIndices;
+    const size_t     m_MaxIndices;
+    size_t           m_NumIndices = 0;
+};
+
 class StdIndexGenerator
 {
 public:
@@ -201,7 +235,48 @@ private:
     int m_iPitch;
 };
 
-typedef TriStrip<Uint32, StdIndexGenerator> StdTriStrip32;
+typedef TriStrip<IndexRange<Uint32>, StdIndexGenerator> StdTriStrip32;
+
+// Returns the number of indices TriStrip generates for a single strip
+Uint32 GetStripIndexCount(int iNumCols, int iNumRows, QUAD_TRIANGULATION_TYPE QuadTriangType)
+{
+    // The first strip starting with 01 to 10 quad gets an extra vertex to preserve winding order,
+    // every row has two indices per column, and every row but the last one ends with two degenerate indices
+    Uint32 NumIndices = QuadTriangType == QUAD_TRIANG_TYPE_01_TO_10 ? 1 : 0;
+    if (iNumRows >= 2)
+    {
+        NumIndices += static_cast<Uint32>((iNumRows - 1) * iNumCols * 2);
+        NumIndices += static_cast<Uint32>((iNumRows - 2) * 2);
+    }
+    return NumIndices;
+}
+
+// Calls Func(Item) for every item in [0, NumItems) on the thread pool workers and the calling thread.
+// Items are handed out one at a time, so the results do not depend on the number of threads.
+template <typename FuncType>
+void ParallelFor(IThreadPool* pThreadPool, Uint32 NumWorkers, Uint32 NumItems, FuncType Func)
+{
+    std::atomic<Uint32> NextItem{0};
+
+    auto ProcessItems = [&]() {
+        for (Uint32 Item = NextItem.fetch_add(1); Item < NumItems; Item = NextItem.fetch_add(1))
+            Func(Item);
+    };
+
+    NumWorkers = std::min(NumWorkers, NumItems > 0 ? NumItems - 1 : 0);
+    for (Uint32 i = 0; i < NumWorkers; ++i)
+    {
+        EnqueueAsyncWork(pThreadPool,
+                         [&](Uint32 ThreadId) {
+                             ProcessItems();
+                             return ASYNC_TASK_STATUS_COMPLETE;
+                         });
+    }
+
+    ProcessItems();
+
+    pThreadPool->WaitForAllTasks();
+}
 
 
 void ComputeVertexHeight(HemisphereVertex&          Vertex,
@@ -227,16 +302,18 @@ void ComputeVertexHeight(HemisphereVertex&          Vertex,
 class RingMeshBuilder
 {
 public:
-    RingMeshBuilder(IRenderDevice*                       pDevice,
-                    const std::vector<HemisphereVertex>& VB,
+    RingMeshBuilder(const std::vector<HemisphereVertex>& VB,
                     int                                  iGridDimenion,
-                    std::vector<RingSectorMesh>&         RingMeshes) :
-        m_pDevice(pDevice),
+                    std::vector<RingSectorMesh>&         RingMeshes,
+                    std::vector<Uint32>&                 IB) :
         m_RingMeshes(RingMeshes),
+        m_IB(IB),
         m_VB(VB),
         m_iGridDimenion(iGridDimenion)
     {}
 
+    // Reserves the range of the sector in the shared index buffer.
+    // The indices and the bounding box are generated by BuildMeshes().
     void CreateMesh(int                          iBaseIndex,
                     int                          iStartCol,
                     int                          iStartRow,
@@ -244,58 +321,241 @@ public:
                     int                          iNumRows,
                     enum QUAD_TRIANGULATION_TYPE QuadTriangType)
     {
+        m_Sectors.push_back({iBaseIndex, iStartCol, iStartRow, iNumCols, iNumRows, QuadTriangType});
+
         m_RingMeshes.push_back(RingSectorMesh());
         RingSectorMesh& CurrMesh = m_RingMeshes.back();
+        CurrMesh.uiFirstIndex    = m_NumIndices;
+        CurrMesh.uiNumIndices    = GetStripIndexCount(iNumCols, iNumRows, QuadTriangType);
+        m_NumIndices += CurrMesh.uiNumIndices;
+    }
 
-        std::vector<Uint32> IB;
-        StdTriStrip32       TriStrip(IB, StdIndexGenerator(m_iGridDimenion));
-        TriStrip.AddStrip(iBaseIndex, iStartCol, iStartRow, iNumCols, iNumRows, QuadTriangType);
-
-        CurrMesh.uiNumIndices = (Uint32)IB.size();
-
-        // Prepare buffer description
-        BufferDesc IndexBufferDesc;
-        IndexBufferDesc.Name      = "Ring mesh index buffer";
-        IndexBufferDesc.Size      = (Uint32)(IB.size() * sizeof(IB[0]));
-        IndexBufferDesc.BindFlags = BIND_INDEX_BUFFER;
-        IndexBufferDesc.Usage     = USAGE_IMMUTABLE;
-        BufferData IBInitData;
-        IBInitData.pData    = IB.data();
-        IBInitData.DataSize = IndexBufferDesc.Size;
-        // Create the buffer
-        m_pDevice->CreateBuffer(IndexBufferDesc, &IBInitData, &CurrMesh.pIndBuff);
-        VERIFY(CurrMesh.pIndBuff, "Failed to create index buffer");
+    // Generates indices and bounding boxes of all sectors. Must be called
+    // after the vertex positions are final.
+    void BuildMeshes(IThreadPool* pThreadPool, Uint32 NumWorkers)
+    {
+        m_IB.resize(m_NumIndices);
+        ParallelFor(pThreadPool, NumWorkers, static_cast<Uint32>(m_Sectors.size()), [this](Uint32 Sector) {
+            BuildMesh(m_Sectors[Sector], m_RingMeshes[Sector]);
+        });
+    }
+
+    // Organizes the sectors into a quadtree and reorders them so that the sectors of
+    // every subtree occupy a contiguous range. Must be called after BuildMeshes().
+    void BuildSectorTree(std::vector<SectorTreeNode>& Tree)
+    {
+        Tree.clear();
+        if (m_Sectors.empty())
+            return;
+
+        const int iGridMidst   = (m_iGridDimenion - 1) / 2;
+        const int NumRingVerts = m_iGridDimenion * m_iGridDimenion;
+        const int iNumRings    = m_Sectors.back().iBaseIndex / NumRingVerts + 1;
+
+        RingQuadrants Quadrants(iNumRings);
+        for (Uint32 i = 0; i < m_Sectors.size(); ++i)
+        {
+            const SectorDesc& Sector    = m_Sectors[i];
+            const int         iQuadrant = (Sector.iStartCol >= iGridMidst ? 1 : 0) + (Sector.iStartRow >= iGridMidst ? 2 : 0);
+            Quadrants[Sector.iBaseIndex / NumRingVerts][iQuadrant].push_back(i);
+        }
+
+        std::vector<RingSectorMesh> SortedMeshes;
+        SortedMeshes.reserve(m_RingMeshes.size());
+
+        // The root holds the four quadrants of the coarsest ring
+        Tree.resize(1 + 4);
+        Tree[0].uiFirstChild  = 1;
+        Tree[0].uiNumChildren = 4;
+        for (int iQuadrant = 0; iQuadrant < 4; ++iQuadrant)
+            InitQuadrantNode(Tree, Quadrants, SortedMeshes, 1 + iQuadrant, iNumRings - 1, iQuadrant);
+        Tree[0].uiFirstMesh = 0;
+        Tree[0].uiNumMeshes = static_cast<Uint32>(SortedMeshes.size());
+        InitInnerNode(Tree, 0);
+
+        VERIFY_EXPR(SortedMeshes.size() == m_RingMeshes.size());
+        m_RingMeshes.swap(SortedMeshes);
+    }
+
+private:
+    struct SectorDesc
+    {
+        int                     iBaseIndex;
+        int                     iStartCol;
+        int                     iStartRow;
+        int                     iNumCols;
+        int                     iNumRows;
+        QUAD_TRIANGULATION_TYPE QuadTriangType;
+    };
+
+    // Sector indices of every quadrant of every ring
+    using RingQuadrants = std::vector<std::array<std::vector<Uint32>, 4>>;
+
+    void InitQuadrantNode(std::vector<SectorTreeNode>& Tree,
+                          const RingQuadrants&         Quadrants,
+                          std::vector<RingSectorMesh>& SortedMeshes,
+                          Uint32                       uiNode,
+                          int                          iRing,
+                          int                          iQuadrant)
+    {
+        const std::vector<Uint32>& Sectors = Quadrants[iRing][iQuadrant];
+        if (iRing == 0)
+        {
+            // Quadrants of the innermost ring consist of a single sector
+            VERIFY_EXPR(Sectors.size() == 1);
+            InitLeafNode(Tree[uiNode], SortedMeshes, Sectors[0]);
+            return;
+        }
+
+        // Tree may be reallocated, so the node is accessed by index
+        const Uint32 uiFirstChild  = static_cast<Uint32>(Tree.size());
+        const Uint32 uiNumSectors  = static_cast<Uint32>(Sectors.size());
+        Tree[uiNode].uiFirstChild  = uiFirstChild;
+        Tree[uiNode].uiNumChildren = uiNumSectors + 1;
+        Tree[uiNode].uiFirstMesh   = static_cast<Uint32>(SortedMeshes.size());
+        Tree.resize(Tree.size() + uiNumSectors + 1);
+
+        for (Uint32 i = 0; i < uiNumSectors; ++i)
+            InitLeafNode(Tree[uiFirstChild + i], SortedMeshes, Sectors[i]);
+        InitQuadrantNode(Tree, Quadrants, SortedMeshes, uiFirstChild + uiNumSectors, iRing - 1, iQuadrant);
+
+        Tree[uiNode].uiNumMeshes = static_cast<Uint32>(SortedMeshes.size()) - Tree[uiNode].uiFirstMesh;
+        InitInnerNode(Tree, uiNode);
+    }
+
+    void InitLeafNode(SectorTreeNode& Node, std::vector<RingSectorMesh>& SortedMeshes, Uint32 Sector)
+    {
+        Node.BndBox      = m_RingMeshes[Sector].BndBox;
+        Node.uiFirstMesh = static_cast<Uint32>(SortedMeshes.size());
+        Node.uiNumMeshes = 1;
+        SortedMeshes.push_back(m_RingMeshes[Sector]);
+    }
+
+    // Computes the conservative bounding box of the node from its children
+    static void InitInnerNode(std::vector<SectorTreeNode>& Tree, Uint32 uiNode)
+    {
+        SectorTreeNode& Node = Tree[uiNode];
+        Node.BndBox.Max      = float3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        Node.BndBox.Min      = float3(+FLT_MAX, +FLT_MAX, +FLT_MAX);
+        for (Uint32 i = 0; i < Node.uiNumChildren; ++i)
+        {
+            const BoundBox& ChildBB = Tree[Node.uiFirstChild + i].BndBox;
+
+            Node.BndBox.Min = std::min(Node.BndBox.Min, ChildBB.Min);
+            Node.BndBox.Max = std::max(Node.BndBox.Max, ChildBB.Max);
+        }
+    }
+
+    void BuildMesh(const SectorDesc& Sector, RingSectorMesh& Mesh)
+    {
+        IndexRange<Uint32> IB{m_IB.data() + Mesh.uiFirstIndex, Mesh.uiNumIndices};
+        StdTriStrip32      TriStrip(IB, StdIndexGenerator(m_iGridDimenion));
+        TriStrip.AddStrip(Sector.iBaseIndex, Sector.iStartCol, Sector.iStartRow, Sector.iNumCols, Sector.iNumRows, Sector.QuadTriangType);
+        VERIFY(IB.size() == Mesh.uiNumIndices, "Unexpected number of indices");
 
         // Compute bounding box
-        BoundBox& BB{CurrMesh.BndBox};
+        BoundBox& BB{Mesh.BndBox};
         BB.Max = float3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
         BB.Min = float3(+FLT_MAX, +FLT_MAX, +FLT_MAX);
-        for (auto Ind = IB.begin(); Ind != IB.end(); ++Ind)
+        for (Uint32 i = 0; i < Mesh.uiNumIndices; ++i)
         {
-            const float3& CurrVert = m_VB[*Ind].f3WorldPos;
+            const float3& CurrVert = m_VB[m_IB[Mesh.uiFirstIndex + i]].f3WorldPos;
 
             BB.Min = std::min(BB.Min, CurrVert);
             BB.Max = std::max(BB.Max, CurrVert);
         }
     }
 
-private:
-    RefCntAutoPtr<IRenderDevice>         m_pDevice;
     std::vector<RingSectorMesh>&         m_RingMeshes;
+    std::vector<Uint32>&                 m_IB;
     const std::vector<HemisphereVertex>& m_VB;
     const int                            m_iGridDimenion;
+    std::vector<SectorDesc>              m_Sectors;
+    Uint32                               m_NumIndices = 0;
 };
 
 
-void GenerateSphereGeometry(IRenderDevice*                 pDevice,
-                            const float                    fEarthRadius,
+void ComputeRingVertexRow(HemisphereVertex*          pRowVerts,
+                          int                        iRow,
+                          int                        iGridDimension,
+                          float                      fGridScale,
+                          const float                fEarthRadius,
+                          class ElevationDataSource* pDataSource,
+                          float                      fSamplingStep,
+                          float                      fSampleScale)
+{
+    for (int iCol = 0; iCol < iGridDimension; ++iCol)
+    {
+        HemisphereVertex& CurrVert = pRowVerts[iCol];
+        float3&           f3Pos    = CurrVert.f3WorldPos;
+
+        f3Pos.x = static_cast<float>(iCol) / static_cast<float>(iGridDimension - 1);
+        f3Pos.z = static_cast<float>(iRow) / static_cast<float>(iGridDimension - 1);
+        f3Pos.x = f3Pos.x * 2 - 1;
+        f3Pos.z = f3Pos.z * 2 - 1;
+        f3Pos.y = 0;
+
+        float fDirectionScale = 1;
+        if (f3Pos.x != 0 || f3Pos.z != 0)
+        {
+            float fDX       = fabs(f3Pos.x);
+            float fDZ       = fabs(f3Pos.z);
+            float fMaxD     = std::max(fDX, fDZ);
+            float fMinD     = std::min(fDX, fDZ);
+            float fTan      = fMinD / fMaxD;
+            fDirectionScale = 1 / sqrt(1 + fTan * fTan);
+        }
+
+        f3Pos.x *= fDirectionScale * fGridScale;
+        f3Pos.z *= fDirectionScale * fGridScale;
+        f3Pos.y = sqrt(std::max(0.f, 1.f - (f3Pos.x * f3Pos.x + f3Pos.z * f3Pos.z)));
+
+        f3Pos.x *= fEarthRadius;
+        f3Pos.z *= fEarthRadius;
+        f3Pos.y *= fEarthRadius;
+
+        ComputeVertexHeight(CurrVert, pDataSource, fSamplingStep, fSampleScale);
+        f3Pos.y -= fEarthRadius;
+    }
+}
+
+
+// Aligns vertices on the outer boundary of the ring with the next coarser ring
+void AlignRingBoundary(HemisphereVertex* pRingVerts, int iGridDimension)
+{
+    for (int i = 1; i < iGridDimension - 1; i += 2)
+    {
+        // Top & bottom boundaries
+        for (int iRow = 0; iRow < iGridDimension; iRow += iGridDimension - 1)
+        {
+            const float3& V0 = pRingVerts[i - 1 + iRow * iGridDimension].f3WorldPos;
+            float3&       V1 = pRingVerts[i + 0 + iRow * iGridDimension].f3WorldPos;
+            const float3& V2 = pRingVerts[i + 1 + iRow * iGridDimension].f3WorldPos;
+            V1               = (V0 + V2) / 2.f;
+        }
+
+        // Left & right boundaries
+        for (int iCol = 0; iCol < iGridDimension; iCol += iGridDimension - 1)
+        {
+            const float3& V0 = pRingVerts[iCol + (i - 1) * iGridDimension].f3WorldPos;
+            float3&       V1 = pRingVerts[iCol + (i + 0) * iGridDimension].f3WorldPos;
+            const float3& V2 = pRingVerts[iCol + (i + 1) * iGridDimension].f3WorldPos;
+            V1               = (V0 + V2) / 2.f;
+        }
+    }
+}
+
+
+void GenerateSphereGeometry(const float                    fEarthRadius,
                             int                            iGridDimension,
                             const int                      iNumRings,
                             class ElevationDataSource*     pDataSource,
                             float                          fSamplingStep,
                             float                          fSampleScale,
                             std::vector<HemisphereVertex>& VB,
-                            std::vector<RingSectorMesh>&   SphereMeshes)
+                            std::vector<Uint32>&           IB,
+                            std::vector<RingSectorMesh>&   SphereMeshes,
+                            std::vector<SectorTreeNode>&   SectorTree)
 {
     if ((iGridDimension - 1) % 4 != 0)
     {
@@ -307,76 +567,44 @@ void GenerateSphereGeometry(IRenderDevice*                 pDevice,
 
     //const int iLargestGridScale = iGridDimension << (iNumRings-1);
 
-    RingMeshBuilder RingMeshBuilder(pDevice, VB, iGridDimension, SphereMeshes);
-
-    int iStartRing = 0;
-    VB.reserve((iNumRings - iStartRing) * iGridDimension * iGridDimension);
-    for (int iRing = iStartRing; iRing < iNumRings; ++iRing)
-    {
-        int iCurrGridStart = (int)VB.size();
-        VB.resize(VB.size() + static_cast<size_t>(iGridDimension) * static_cast<size_t>(iGridDimension));
-        float fGridScale = 1.f / (float)(1 << (iNumRings - 1 - iRing));
-        // Fill vertex buffer
-        for (int iRow = 0; iRow < iGridDimension; ++iRow)
-            for (int iCol = 0; iCol < iGridDimension; ++iCol)
-            {
-                HemisphereVertex& CurrVert = VB[iCurrGridStart + iCol + iRow * iGridDimension];
-                float3&           f3Pos    = CurrVert.f3WorldPos;
-
-                f3Pos.x = static_cast<float>(iCol) / static_cast<float>(iGridDimension - 1);
-                f3Pos.z = static_cast<float>(iRow) / static_cast<float>(iGridDimension - 1);
-                f3Pos.x = f3Pos.x * 2 - 1;
-                f3Pos.z = f3Pos.z * 2 - 1;
-                f3Pos.y = 0;
-
-                float fDirectionScale = 1;
-                if (f3Pos.x != 0 || f3Pos.z != 0)
-                {
-                    float fDX       = fabs(f3Pos.x);
-                    float fDZ       = fabs(f3Pos.z);
-                    float fMaxD     = std::max(fDX, fDZ);
-                    float fMinD     = std::min(fDX, fDZ);
-                    float fTan      = fMinD / fMaxD;
-                    fDirectionScale = 1 / sqrt(1 + fTan * fTan);
-                }
+    ThreadPoolCreateInfo ThreadPoolCI;
+    ThreadPoolCI.NumThreads = std::max(std::thread::hardware_concurrency(), 2u) - 1u;
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCI);
 
-                f3Pos.x *= fDirectionScale * fGridScale;
-                f3Pos.z *= fDirectionScale * fGridScale;
-                f3Pos.y = sqrt(std::max(0.f, 1.f - (f3Pos.x * f3Pos.x + f3Pos.z * f3Pos.z)));
+    RingMeshBuilder RingMeshBuilder(VB, iGridDimension, SphereMeshes, IB);
 
-                f3Pos.x *= fEarthRadius;
-                f3Pos.z *= fEarthRadius;
-                f3Pos.y *= fEarthRadius;
+    const int    iStartRing    = 0;
+    const int    iNumGridRings = iNumRings - iStartRing;
+    const size_t NumRingVerts  = static_cast<size_t>(iGridDimension) * static_cast<size_t>(iGridDimension);
+    VB.resize(iNumGridRings * NumRingVerts);
 
-                ComputeVertexHeight(CurrVert, pDataSource, fSamplingStep, fSampleScale);
-                f3Pos.y -= fEarthRadius;
-            }
-
-        // Align vertices on the outer boundary
-        if (iRing < iNumRings - 1)
-        {
-            for (int i = 1; i < iGridDimension - 1; i += 2)
-            {
-                // Top & bottom boundaries
-                for (int iRow = 0; iRow < iGridDimension; iRow += iGridDimension - 1)
-                {
-                    const float3& V0 = VB[iCurrGridStart + i - 1 + iRow * iGridDimension].f3WorldPos;
-                    float3&       V1 = VB[iCurrGridStart + i + 0 + iRow * iGridDimension].f3WorldPos;
-                    const float3& V2 = VB[iCurrGridStart + i + 1 + iRow * iGridDimension].f3WorldPos;
-                    V1               = (V0 + V2) / 2.f;
-                }
+    // Fill vertex buffer. Every row of every ring is independent.
+    // The coarse rings span the whole height map, so the rows of a tiled elevation file are processed
+    // in batches of one row per thread, and the tiles over the budget are evicted after every batch.
+    const Uint32 NumRows      = static_cast<Uint32>(iNumGridRings * iGridDimension);
+    const Uint32 RowBatchSize = pDataSource->IsTiledFile() ? ThreadPoolCI.NumThreads + 1 : NumRows;
+    for (Uint32 FirstRow = 0; FirstRow < NumRows; FirstRow += RowBatchSize)
+    {
+        ParallelFor(pThreadPool, ThreadPoolCI.NumThreads, std::min(RowBatchSize, NumRows - FirstRow), [&](Uint32 Item) {
+            Item += FirstRow;
+            const int iRing      = iStartRing + static_cast<int>(Item) / iGridDimension;
+            const int iRow       = static_cast<int>(Item) % iGridDimension;
+            float     fGridScale = 1.f / (float)(1 << (iNumRings - 1 - iRing));
+
+            HemisphereVertex* pRowVerts = &VB[(iRing - iStartRing) * NumRingVerts + static_cast<size_t>(iRow) * iGridDimension];
+            ComputeRingVertexRow(pRowVerts, iRow, iGridDimension, fGridScale, fEarthRadius, pDataSource, fSamplingStep, fSampleScale);
+        });
+        pDataSource->EvictTiles();
+    }
 
-                // Left & right boundaries
-                for (int iCol = 0; iCol < iGridDimension; iCol += iGridDimension - 1)
-                {
-                    const float3& V0 = VB[iCurrGridStart + iCol + (i - 1) * iGridDimension].f3WorldPos;
-                    float3&       V1 = VB[iCurrGridStart + iCol + (i + 0) * iGridDimension].f3WorldPos;
-                    const float3& V2 = VB[iCurrGridStart + iCol + (i + 1) * iGridDimension].f3WorldPos;
-                    V1               = (V0 + V2) / 2.f;
-                }
-            }
-        }
+    // Align vertices on the outer boundary of every ring but the last one
+    ParallelFor(pThreadPool, ThreadPoolCI.NumThreads, static_cast<Uint32>(std::max(iNumGridRings - 1, 0)), [&](Uint32 Ring) {
+        AlignRingBoundary(&VB[Ring * NumRingVerts], iGridDimension);
+    });
 
+    for (int iRing = iStartRing; iRing < iNumRings; ++iRing)
+    {
+        int iCurrGridStart = static_cast<int>((iRing - iStartRing) * NumRingVerts);
 
         // Generate indices for the current ring
         if (iRing == 0)
@@ -411,15 +639,113 @@ void GenerateSphereGeometry(IRenderDevice*                 pDevice,
             // clang-format on
         }
     }
+
+    // Bounding boxes need the aligned vertices
+    RingMeshBuilder.BuildMeshes(pThreadPool, ThreadPoolCI.NumThreads);
+    RingMeshBuilder.BuildSectorTree(SectorTree);
 }
 
 
-void EarthHemsiphere::RenderNormalMap(IRenderDevice*  pDevice,
-                                      IDeviceContext* pContext,
-                                      const Uint16*   pHeightMap,
-                                      size_t          HeightMapStride,
-                                      int             iHeightMapDim,
-                                      ITexture*       ptex2DNormalMap)
+// Replaces the finer height map level with the next coarser one using a 2x2 box filter.
+// Every sample is written after all samples it is computed from have been read.
+void DownsampleHeightMipInPlace(Uint16* pData, size_t Stride, Uint32 Width, Uint32 Height)
+{
+    for (size_t Row = 0; Row < Height; ++Row)
+    {
+        for (size_t Col = 0; Col < Width; ++Col)
+        {
+            int iAverageHeight = 0;
+            for (size_t i = 0; i < 2; ++i)
+            {
+                for (size_t j = 0; j < 2; ++j)
+                {
+                    iAverageHeight += pData[(Col * 2 + i) + (Row * 2 + j) * Stride];
+                }
+            }
+            pData[Col + Row * Stride] = (Uint16)(iAverageHeight >> 2);
+        }
+    }
+}
+
+// Uploads levels [0, NumMipLevels) of the height map of a tiled elevation file one tile at a time,
+// so that the file never needs to be loaded as a whole. Coarse levels use the same box filter as
+// the image path: every tile computes its part of the levels until it shrinks to a single sample,
+// and these samples form the image the remaining levels are computed from.
+void UploadHeightMapTiles(IDeviceContext*            pContext,
+                          const ElevationDataSource* pDataSource,
+                          ITexture*                  ptex2DHeightMap,
+                          Uint32                     NumMipLevels)
+{
+    const TextureDesc& HeightMapDesc = ptex2DHeightMap->GetDesc();
+
+    const Uint32 TileSize      = pDataSource->GetTileSize();
+    const Uint32 TileSizeLog2  = PlatformMisc::GetMSB(TileSize);
+    const Uint32 NumTileLevels = std::min(NumMipLevels, TileSizeLog2 + 1);
+
+    // Level TileSizeLog2 has exactly one sample per tile
+    Uint32 CoarseWidth  = 0;
+    Uint32 CoarseHeight = 0;
+    if (NumMipLevels > NumTileLevels)
+    {
+        const MipLevelProperties CoarseMipProps = GetMipLevelProperties(HeightMapDesc, TileSizeLog2);
+        CoarseWidth                             = CoarseMipProps.LogicalWidth;
+        CoarseHeight                            = CoarseMipProps.LogicalHeight;
+    }
+    std::vector<Uint16> CoarseLevel(size_t{CoarseWidth} * size_t{CoarseHeight});
+
+    std::vector<Uint16> TileData(size_t{TileSize} * size_t{TileSize});
+    for (Uint32 ty = 0; ty < pDataSource->GetNumTilesY(); ++ty)
+    {
+        for (Uint32 tx = 0; tx < pDataSource->GetNumTilesX(); ++tx)
+        {
+            pDataSource->ReadTileSamples(tx, ty, TileData.data());
+
+            for (Uint32 uiMipLevel = 0; uiMipLevel < NumTileLevels; ++uiMipLevel)
+            {
+                const Uint32 MipTileSize = TileSize >> uiMipLevel;
+                if (uiMipLevel > 0)
+                    DownsampleHeightMipInPlace(TileData.data(), TileSize, MipTileSize, MipTileSize);
+
+                // Columns and rows past the last even one do not contribute to coarser levels
+                const MipLevelProperties MipProps = GetMipLevelProperties(HeightMapDesc, uiMipLevel);
+                const Uint32             X0       = tx * MipTileSize;
+                const Uint32             Y0       = ty * MipTileSize;
+                if (X0 >= MipProps.LogicalWidth || Y0 >= MipProps.LogicalHeight)
+                    break;
+
+                TextureSubResData SubresData;
+                SubresData.pData  = TileData.data();
+                SubresData.Stride = TileSize * sizeof(Uint16);
+
+                Box UpdateBox{X0, std::min(X0 + MipTileSize, MipProps.LogicalWidth), Y0, std::min(Y0 + MipTileSize, MipProps.LogicalHeight)};
+                pContext->UpdateTexture(ptex2DHeightMap, uiMipLevel, 0, UpdateBox, SubresData, RESOURCE_STATE_TRANSITION_MODE_NONE, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+                if (uiMipLevel == TileSizeLog2 && NumMipLevels > NumTileLevels)
+                    CoarseLevel[ty * CoarseWidth + tx] = TileData[0];
+            }
+        }
+    }
+
+    for (Uint32 uiMipLevel = NumTileLevels; uiMipLevel < NumMipLevels; ++uiMipLevel)
+    {
+        const MipLevelProperties MipProps = GetMipLevelProperties(HeightMapDesc, uiMipLevel);
+        DownsampleHeightMipInPlace(CoarseLevel.data(), CoarseWidth, MipProps.LogicalWidth, MipProps.LogicalHeight);
+
+        TextureSubResData SubresData;
+        SubresData.pData  = CoarseLevel.data();
+        SubresData.Stride = CoarseWidth * sizeof(Uint16);
+
+        Box UpdateBox{0, MipProps.LogicalWidth, 0, MipProps.LogicalHeight};
+        pContext->UpdateTexture(ptex2DHeightMap, uiMipLevel, 0, UpdateBox, SubresData, RESOURCE_STATE_TRANSITION_MODE_NONE, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    }
+}
+
+
+void EarthHemsiphere::RenderNormalMap(IRenderDevice*             pDevice,
+                                      IDeviceContext*            pContext,
+                                      class ElevationDataSource* pDataSource,
+                                      int                        iHeightMapDim,
+                                      ITexture*                  ptex2DNormalMap)
 {
     TextureDesc HeightMapDesc;
     HeightMapDesc.Name      = "Height map texture";
@@ -431,59 +757,76 @@ void EarthHemsiphere::RenderNormalMap(IRenderDevice*  pDevice,
     HeightMapDesc.BindFlags = BIND_SHADER_RESOURCE;
     HeightMapDesc.MipLevels = ComputeMipLevelsCount(HeightMapDesc.Width, HeightMapDesc.Height);
 
-    // Stack all coarse mip levels on top of each other with the same stride
-    //    __________
-    //   |__|__     |
-    //   |     |    |
-    //   |_____|____|
-    //   |          |
-    //   |          |
-    //   |          |
-    //   |__________|
-    std::vector<Uint16> CoarseMipLevels;
-    CoarseMipLevels.resize(static_cast<size_t>(iHeightMapDim) / 2 * iHeightMapDim);
-
-    std::vector<TextureSubResData> InitData(HeightMapDesc.MipLevels);
-    InitData[0].pData            = pHeightMap;
-    InitData[0].Stride           = (Uint32)HeightMapStride * sizeof(pHeightMap[0]);
-    const Uint16* pFinerMipLevel = pHeightMap;
-    Uint16*       pCurrMipLevel  = &CoarseMipLevels[0];
-    size_t        FinerMipStride = HeightMapStride;
-    size_t        CurrMipStride  = iHeightMapDim / 2;
-    for (Uint32 uiMipLevel = 1; uiMipLevel < HeightMapDesc.MipLevels; ++uiMipLevel)
+    RefCntAutoPtr<ITexture> ptex2DHeightMap;
+    if (pDataSource->IsTiledFile())
     {
-        const MipLevelProperties MipProps = GetMipLevelProperties(HeightMapDesc, uiMipLevel);
-        for (size_t Row = 0; Row < MipProps.LogicalHeight; ++Row)
+        HeightMapDesc.Usage = USAGE_DEFAULT;
+        pDevice->CreateTexture(HeightMapDesc, nullptr, &ptex2DHeightMap);
+        VERIFY(ptex2DHeightMap, "Failed to create height map texture");
+        UploadHeightMapTiles(pContext, pDataSource, ptex2DHeightMap, HeightMapDesc.MipLevels);
+
+        StateTransitionDesc Barrier{ptex2DHeightMap, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE};
+        pContext->TransitionResourceStates(1, &Barrier);
+    }
+    else
+    {
+        const Uint16* pHeightMap;
+        size_t        HeightMapStride;
+        pDataSource->GetDataPtr(pHeightMap, HeightMapStride);
+
+        // Stack all coarse mip levels on top of each other with the same stride
+        //    __________
+        //   |__|__     |
+        //   |     |    |
+        //   |_____|____|
+        //   |          |
+        //   |          |
+        //   |          |
+        //   |__________|
+        std::vector<Uint16> CoarseMipLevels;
+        CoarseMipLevels.resize(static_cast<size_t>(iHeightMapDim) / 2 * iHeightMapDim);
+
+        std::vector<TextureSubResData> InitData(HeightMapDesc.MipLevels);
+        InitData[0].pData            = pHeightMap;
+        InitData[0].Stride           = (Uint32)HeightMapStride * sizeof(pHeightMap[0]);
+        const Uint16* pFinerMipLevel = pHeightMap;
+        Uint16*       pCurrMipLevel  = &CoarseMipLevels[0];
+        size_t        FinerMipStride = HeightMapStride;
+        size_t        CurrMipStride  = iHeightMapDim / 2;
+        for (Uint32 uiMipLevel = 1; uiMipLevel < HeightMapDesc.MipLevels; ++uiMipLevel)
         {
-            for (size_t Col = 0; Col < MipProps.LogicalWidth; ++Col)
+            const MipLevelProperties MipProps = GetMipLevelProperties(HeightMapDesc, uiMipLevel);
+            for (size_t Row = 0; Row < MipProps.LogicalHeight; ++Row)
             {
-                int iAverageHeight = 0;
-                for (size_t i = 0; i < 2; ++i)
+                for (size_t Col = 0; Col < MipProps.LogicalWidth; ++Col)
                 {
-                    for (size_t j = 0; j < 2; ++j)
+                    int iAverageHeight = 0;
+                    for (size_t i = 0; i < 2; ++i)
                     {
-                        iAverageHeight += pFinerMipLevel[(Col * 2 + i) + (Row * 2 + j) * size_t{FinerMipStride}];
+                        for (size_t j = 0; j < 2; ++j)
+                        {
+                            iAverageHeight += pFinerMipLevel[(Col * 2 + i) + (Row * 2 + j) * size_t{FinerMipStride}];
+                        }
                     }
+                    pCurrMipLevel[Col + Row * CurrMipStride] = (Uint16)(iAverageHeight >> 2);
                 }
-                pCurrMipLevel[Col + Row * CurrMipStride] = (Uint16)(iAverageHeight >> 2);
             }
+
+            InitData[uiMipLevel].pData  = pCurrMipLevel;
+            InitData[uiMipLevel].Stride = (Uint32)CurrMipStride * sizeof(*pCurrMipLevel);
+            pFinerMipLevel              = pCurrMipLevel;
+            FinerMipStride              = CurrMipStride;
+            pCurrMipLevel += MipProps.LogicalHeight * CurrMipStride;
+            CurrMipStride = iHeightMapDim / 2; // Same stride for all mips
         }
 
-        InitData[uiMipLevel].pData  = pCurrMipLevel;
-        InitData[uiMipLevel].Stride = (Uint32)CurrMipStride * sizeof(*pCurrMipLevel);
-        pFinerMipLevel              = pCurrMipLevel;
-        FinerMipStride              = CurrMipStride;
-        pCurrMipLevel += MipProps.LogicalHeight * CurrMipStride;
-        CurrMipStride = iHeightMapDim / 2; // Same stride for all mips
+        TextureData HeigtMapInitData;
+        HeigtMapInitData.pSubResources   = InitData.data();
+        HeigtMapInitData.NumSubresources = (Uint32)InitData.size();
+        pDevice->CreateTexture(HeightMapDesc, &HeigtMapInitData, &ptex2DHeightMap);
+        VERIFY(ptex2DHeightMap, "Failed to create height map texture");
     }
 
-    RefCntAutoPtr<ITexture> ptex2DHeightMap;
-    TextureData             HeigtMapInitData;
-    HeigtMapInitData.pSubResources   = InitData.data();
-    HeigtMapInitData.NumSubresources = (Uint32)InitData.size();
-    pDevice->CreateTexture(HeightMapDesc, &HeigtMapInitData, &ptex2DHeightMap);
-    VERIFY(ptex2DHeightMap, "Failed to create height map texture");
-
     m_pResMapping->AddResource("g_tex2DElevationMap", ptex2DHeightMap->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE), true);
 
     RefCntAutoPtr<IBuffer> pcbNMGenerationAttribs;
@@ -530,6 +873,178 @@ void EarthHemsiphere::RenderNormalMap(IRenderDevice*  pDevice,
 }
 
 
+// Returns true if the height map mips and the normal map can be generated by compute shaders
+static bool IsComputeNormalMapSupported(IRenderDevice* pDevice)
+{
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+        return false;
+
+    // clang-format off
+    return (pDevice->GetTextureFormatInfoExt(TEX_FORMAT_R16_UINT  ).BindFlags & BIND_UNORDERED_ACCESS) != 0 &&
+           (pDevice->GetTextureFormatInfoExt(TEX_FORMAT_RG8_UNORM).BindFlags & BIND_UNORDERED_ACCESS) != 0;
+    // clang-format on
+}
+
+void EarthHemsiphere::ComputeNormalMap(IRenderDevice*             pDevice,
+                                       IDeviceContext*            pContext,
+                                       class ElevationDataSource* pDataSource,
+                                       int                        iHeightMapDim,
+                                       ITexture*                  ptex2DNormalMap)
+{
+    TextureDesc HeightMapDesc;
+    HeightMapDesc.Name      = "Height map texture";
+    HeightMapDesc.Type      = RESOURCE_DIM_TEX_2D;
+    HeightMapDesc.Width     = iHeightMapDim;
+    HeightMapDesc.Height    = iHeightMapDim;
+    HeightMapDesc.Format    = TEX_FORMAT_R16_UINT;
+    HeightMapDesc.Usage     = USAGE_DEFAULT;
+    HeightMapDesc.BindFlags = BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS;
+    HeightMapDesc.MipLevels = ComputeMipLevelsCount(HeightMapDesc.Width, HeightMapDesc.Height);
+
+    RefCntAutoPtr<ITexture> ptex2DHeightMap;
+    pDevice->CreateTexture(HeightMapDesc, nullptr, &ptex2DHeightMap);
+    VERIFY(ptex2DHeightMap, "Failed to create height map texture");
+
+    // Only the finest level is uploaded, coarser levels are generated on the GPU
+    if (pDataSource->IsTiledFile())
+    {
+        UploadHeightMapTiles(pContext, pDataSource, ptex2DHeightMap, 1);
+    }
+    else
+    {
+        const Uint16* pHeightMap;
+        size_t        HeightMapStride;
+        pDataSource->GetDataPtr(pHeightMap, HeightMapStride);
+
+        TextureSubResData SubresData;
+        SubresData.pData  = pHeightMap;
+        SubresData.Stride = static_cast<Uint32>(HeightMapStride * sizeof(pHeightMap[0]));
+
+        Box UpdateBox{0, HeightMapDesc.Width, 0, HeightMapDesc.Height};
+        pContext->UpdateTexture(ptex2DHeightMap, 0, 0, UpdateBox, SubresData, RESOURCE_STATE_TRANSITION_MODE_NONE, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    }
+
+    // Every mip level is read through its own SRV and written through its own UAV,
+    // so states are tracked per mip level manually
+    std::vector<RefCntAutoPtr<ITextureView>> HeightMipSRVs(HeightMapDesc.MipLevels);
+    std::vector<RefCntAutoPtr<ITextureView>> HeightMipUAVs(HeightMapDesc.MipLevels);
+    for (Uint32 uiMipLevel = 0; uiMipLevel < HeightMapDesc.MipLevels; ++uiMipLevel)
+    {
+        TextureViewDesc TexViewDesc;
+        TexViewDesc.MostDetailedMip = uiMipLevel;
+        TexViewDesc.NumMipLevels    = 1;
+
+        TexViewDesc.ViewType = TEXTURE_VIEW_SHADER_RESOURCE;
+        ptex2DHeightMap->CreateView(TexViewDesc, &HeightMipSRVs[uiMipLevel]);
+
+        TexViewDesc.ViewType = TEXTURE_VIEW_UNORDERED_ACCESS;
+        ptex2DHeightMap->CreateView(TexViewDesc, &HeightMipUAVs[uiMipLevel]);
+    }
+
+    {
+        RefCntAutoPtr<IPipelineState> pGenerateHeightMipPSO;
+        m_pRSNLoader->LoadPipelineState({"Generate Height Mip", PIPELINE_TYPE_COMPUTE, false, false}, &pGenerateHeightMipPSO);
+
+        RefCntAutoPtr<IShaderResourceBinding> pGenerateHeightMipSRB;
+        pGenerateHeightMipPSO->CreateShaderResourceBinding(&pGenerateHeightMipSRB, true);
+        IShaderResourceVariable* pFinerMipVar   = pGenerateHeightMipSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_tex2DFinerMip");
+        IShaderResourceVariable* pCoarserMipVar = pGenerateHeightMipSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_rwtex2DCoarserMip");
+
+        const StateTransitionDesc InitialBarriers[] = //
+            {
+                {ptex2DHeightMap, RESOURCE_STATE_COPY_DEST, RESOURCE_STATE_SHADER_RESOURCE, 0, 1},
+                {ptex2DHeightMap, RESOURCE_STATE_COPY_DEST, RESOURCE_STATE_UNORDERED_ACCESS, 1, REMAINING_MIP_LEVELS} //
+            };
+        pContext->TransitionResourceStates(_countof(InitialBarriers), InitialBarriers);
+
+        pContext->SetPipelineState(pGenerateHeightMipPSO);
+        for (Uint32 uiMipLevel = 1; uiMipLevel < HeightMapDesc.MipLevels; ++uiMipLevel)
+        {
+            if (uiMipLevel > 1)
+            {
+                // Make the previous level visible to the next dispatch
+                StateTransitionDesc Barrier{ptex2DHeightMap, RESOURCE_STATE_UNORDERED_ACCESS, RESOURCE_STATE_SHADER_RESOURCE, uiMipLevel - 1, 1};
+                pContext->TransitionResourceStates(1, &Barrier);
+            }
+
+            pFinerMipVar->Set(HeightMipSRVs[uiMipLevel - 1]);
+            pCoarserMipVar->Set(HeightMipUAVs[uiMipLevel]);
+            pContext->CommitShaderResources(pGenerateHeightMipSRB, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+            const MipLevelProperties MipProps = GetMipLevelProperties(HeightMapDesc, uiMipLevel);
+
+            DispatchComputeAttribs DispatchAttrs;
+            DispatchAttrs.ThreadGroupCountX = (MipProps.LogicalWidth + NM_GENERATION_GROUP_SIZE - 1) / NM_GENERATION_GROUP_SIZE;
+            DispatchAttrs.ThreadGroupCountY = (MipProps.LogicalHeight + NM_GENERATION_GROUP_SIZE - 1) / NM_GENERATION_GROUP_SIZE;
+            pContext->DispatchCompute(DispatchAttrs);
+        }
+
+        if (HeightMapDesc.MipLevels > 1)
+        {
+            StateTransitionDesc Barrier{ptex2DHeightMap, RESOURCE_STATE_UNORDERED_ACCESS, RESOURCE_STATE_SHADER_RESOURCE, HeightMapDesc.MipLevels - 1, 1};
+            pContext->TransitionResourceStates(1, &Barrier);
+        }
+        // All levels are now in the shader resource state
+        ptex2DHeightMap->SetState(RESOURCE_STATE_SHADER_RESOURCE);
+    }
+
+    m_pResMapping->AddResource("g_tex2DElevationMap", ptex2DHeightMap->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE), true);
+
+    RefCntAutoPtr<IBuffer> pcbNMGenerationAttribs;
+    CreateUniformBuffer(pDevice, sizeof(NMGenerationAttribs), "NM Generation Attribs CB", &pcbNMGenerationAttribs);
+
+    m_pResMapping->AddResource("cbNMGenerationAttribs", pcbNMGenerationAttribs, true);
+
+    RefCntAutoPtr<IPipelineState> pGenerateNormalMapPSO;
+    m_pRSNLoader->LoadPipelineState({"Generate Normal Map", PIPELINE_TYPE_COMPUTE, false, false}, &pGenerateNormalMapPSO);
+
+    pGenerateNormalMapPSO->BindStaticResources(SHADER_TYPE_COMPUTE, m_pResMapping, BIND_SHADER_RESOURCES_VERIFY_ALL_RESOLVED);
+
+    RefCntAutoPtr<IShaderResourceBinding> pGenerateNormalMapSRB;
+    pGenerateNormalMapPSO->CreateShaderResourceBinding(&pGenerateNormalMapSRB, true);
+    IShaderResourceVariable* pNormalMapVar = pGenerateNormalMapSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_rwtex2DNormalMap");
+
+    // Normal map levels are independent of each other, so no barriers are needed between dispatches
+    StateTransitionDesc Barrier{ptex2DNormalMap, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNORDERED_ACCESS, STATE_TRANSITION_FLAG_UPDATE_STATE};
+    pContext->TransitionResourceStates(1, &Barrier);
+
+    pContext->SetPipelineState(pGenerateNormalMapPSO);
+
+    const TextureDesc& NormalMapDesc = ptex2DNormalMap->GetDesc();
+    for (Uint32 uiMipLevel = 0; uiMipLevel < NormalMapDesc.MipLevels; ++uiMipLevel)
+    {
+        TextureViewDesc TexViewDesc;
+        TexViewDesc.ViewType        = TEXTURE_VIEW_UNORDERED_ACCESS;
+        TexViewDesc.MostDetailedMip = uiMipLevel;
+        TexViewDesc.NumMipLevels    = 1;
+        RefCntAutoPtr<ITextureView> ptex2DNormalMapUAV;
+        ptex2DNormalMap->CreateView(TexViewDesc, &ptex2DNormalMapUAV);
+
+        {
+            MapHelper<NMGenerationAttribs> NMGenerationAttribs(pContext, pcbNMGenerationAttribs, MAP_WRITE, MAP_FLAG_DISCARD);
+            NMGenerationAttribs->m_fElevationScale        = m_Params.m_TerrainAttribs.m_fElevationScale;
+            NMGenerationAttribs->m_fSampleSpacingInterval = m_Params.m_TerrainAttribs.m_fElevationSamplingInterval;
+            NMGenerationAttribs->m_iMIPLevel              = static_cast<int>(uiMipLevel);
+        }
+
+        pNormalMapVar->Set(ptex2DNormalMapUAV);
+        pContext->CommitShaderResources(pGenerateNormalMapSRB, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+        const MipLevelProperties MipProps = GetMipLevelProperties(NormalMapDesc, uiMipLevel);
+
+        DispatchComputeAttribs DispatchAttrs;
+        DispatchAttrs.ThreadGroupCountX = (MipProps.LogicalWidth + NM_GENERATION_GROUP_SIZE - 1) / NM_GENERATION_GROUP_SIZE;
+        DispatchAttrs.ThreadGroupCountY = (MipProps.LogicalHeight + NM_GENERATION_GROUP_SIZE - 1) / NM_GENERATION_GROUP_SIZE;
+        pContext->DispatchCompute(DispatchAttrs);
+    }
+
+    Barrier = StateTransitionDesc{ptex2DNormalMap, RESOURCE_STATE_UNORDERED_ACCESS, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE};
+    pContext->TransitionResourceStates(1, &Barrier);
+
+    // Remove elevation map from resource mapping to release the resource
+    m_pResMapping->RemoveResourceByName("g_tex2DElevationMap");
+}
+
 void EarthHemsiphere::Create(class ElevationDataSource* pDataSource,
                              const RenderingParams&     Params,
                              IRenderDevice*             pDevice,
@@ -563,12 +1078,13 @@ void EarthHemsiphere::Create(class ElevationDataSource* pDataSource,
         CreateRenderStateNotationLoader({m_pDevice, pRSNParser, pCompoundFactory}, &m_pRSNLoader);
     }
 
-    const Uint16* pHeightMap;
-    size_t        HeightMapPitch;
-    pDataSource->GetDataPtr(pHeightMap, HeightMapPitch);
     Uint32 iHeightMapDim = pDataSource->GetNumCols();
     VERIFY_EXPR(iHeightMapDim == pDataSource->GetNumRows());
 
+    // Fall back to building the height mips on the CPU and rendering the normal map
+    // with a pixel shader if compute shaders cannot write the required formats
+    const bool UseComputeNormalMap = IsComputeNormalMapSupported(pDevice);
+
     TextureDesc NormalMapDesc;
     NormalMapDesc.Name      = "Normal map texture";
     NormalMapDesc.Type      = RESOURCE_DIM_TEX_2D;
@@ -576,7 +1092,7 @@ void EarthHemsiphere::Create(class ElevationDataSource* pDataSource,
     NormalMapDesc.Height    = iHeightMapDim;
     NormalMapDesc.Format    = TEX_FORMAT_RG8_UNORM;
     NormalMapDesc.Usage     = USAGE_DEFAULT;
-    NormalMapDesc.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET;
+    NormalMapDesc.BindFlags = BIND_SHADER_RESOURCE | (UseComputeNormalMap ? BIND_UNORDERED_ACCESS : BIND_RENDER_TARGET);
     NormalMapDesc.MipLevels = 0;
 
     RefCntAutoPtr<ITexture> ptex2DNormalMap;
@@ -630,7 +1146,10 @@ void EarthHemsiphere::Create(class ElevationDataSource* pDataSource,
 
     m_pDevice->CreateSampler(Sam_ComparisonLinearClamp, &m_pComparisonSampler);
 
-    RenderNormalMap(pDevice, pContext, pHeightMap, HeightMapPitch, iHeightMapDim, ptex2DNormalMap);
+    if (UseComputeNormalMap)
+        ComputeNormalMap(pDevice, pContext, pDataSource, iHeightMapDim, ptex2DNormalMap);
+    else
+        RenderNormalMap(pDevice, pContext, pDataSource, iHeightMapDim, ptex2DNormalMap);
 
     {
         auto ShaderCallback = MakeCallback([&](ShaderCreateInfo& ShaderCI, SHADER_TYPE ShaderType, bool& IsAddToCache) {
@@ -644,11 +1163,12 @@ void EarthHemsiphere::Create(class ElevationDataSource* pDataSource,
         });
         m_pRSNLoader->LoadPipelineState({"Render Hemisphere Z Only", PIPELINE_TYPE_GRAPHICS, false, false, PipelineCallback, PipelineCallback, ShaderCallback, ShaderCallback}, &m_pHemisphereZOnlyPSO);
         m_pHemisphereZOnlyPSO->BindStaticResources(SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL, m_pResMapping, BIND_SHADER_RESOURCES_VERIFY_ALL_RESOLVED);
-        m_pHemisphereZOnlyPSO->CreateShaderResourceBinding(&m_pHemisphereZOnlySRB, true);
+        CreateZOnlySRB(pcbCameraAttribs, &m_pHemisphereZOnlySRB);
     }
 
     std::vector<HemisphereVertex> VB;
-    GenerateSphereGeometry(pDevice, Diligent::AirScatteringAttribs().fEarthRadius, m_Params.m_iRingDimension, m_Params.m_iNumRings, pDataSource, m_Params.m_TerrainAttribs.m_fElevationSamplingInterval, m_Params.m_TerrainAttribs.m_fElevationScale, VB, m_SphereMeshes);
+    std::vector<Uint32>           IB;
+    GenerateSphereGeometry(Diligent::AirScatteringAttribs().fEarthRadius, m_Params.m_iRingDimension, m_Params.m_iNumRings, pDataSource, m_Params.m_TerrainAttribs.m_fElevationSamplingInterval, m_Params.m_TerrainAttribs.m_fElevationScale, VB, IB, m_SphereMeshes, m_SectorTree);
 
     BufferDesc VBDesc;
     VBDesc.Name      = "Hemisphere vertex buffer";
@@ -660,6 +1180,79 @@ void EarthHemsiphere::Create(class ElevationDataSource* pDataSource,
     VBInitData.DataSize = VBDesc.Size;
     pDevice->CreateBuffer(VBDesc, &VBInitData, &m_pVertBuff);
     VERIFY(m_pVertBuff, "Failed to create VB");
+
+    // All ring sectors share one index buffer
+    BufferDesc IBDesc;
+    IBDesc.Name      = "Ring mesh index buffer";
+    IBDesc.Size      = static_cast<Uint64>(IB.size() * sizeof(IB[0]));
+    IBDesc.Usage     = USAGE_IMMUTABLE;
+    IBDesc.BindFlags = BIND_INDEX_BUFFER;
+    BufferData IBInitData;
+    IBInitData.pData    = IB.data();
+    IBInitData.DataSize = IBDesc.Size;
+    pDevice->CreateBuffer(IBDesc, &IBInitData, &m_pIndBuff);
+    VERIFY(m_pIndBuff, "Failed to create IB");
+
+    // Transition the buffers once so that deferred contexts only need to verify their states
+    const StateTransitionDesc Barriers[] = //
+        {
+            {m_pVertBuff, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE},
+            {m_pIndBuff, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_INDEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE} //
+        };
+    pContext->TransitionResourceStates(_countof(Barriers), Barriers);
+}
+
+void EarthHemsiphere::CreateZOnlySRB(IBuffer* pcbCameraAttribs, IShaderResourceBinding** ppZOnlySRB)
+{
+    m_pHemisphereZOnlyPSO->CreateShaderResourceBinding(ppZOnlySRB, true);
+    (*ppZOnlySRB)->GetVariableByName(SHADER_TYPE_VERTEX, "cbCameraAttribs")->Set(pcbCameraAttribs);
+}
+
+void EarthHemsiphere::RenderZOnly(IDeviceContext*         pContext,
+                                  IShaderResourceBinding* pZOnlySRB,
+                                  const float4x4&         ViewProjMatrix) const
+{
+    ViewFrustumExt     ViewFrustum;
+    RENDER_DEVICE_TYPE DevType = m_pDevice->GetDeviceInfo().Type;
+    ExtractViewFrustumPlanesFromMatrix(ViewProjMatrix, ViewFrustum, DevType == RENDER_DEVICE_TYPE_D3D11 || DevType == RENDER_DEVICE_TYPE_D3D12);
+
+    IBuffer* ppBuffers[1] = {m_pVertBuff};
+    pContext->SetVertexBuffers(0, 1, ppBuffers, nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY, SET_VERTEX_BUFFERS_FLAG_RESET);
+    pContext->SetIndexBuffer(m_pIndBuff, 0, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    pContext->SetPipelineState(m_pHemisphereZOnlyPSO);
+    pContext->CommitShaderResources(pZOnlySRB, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    if (!m_SectorTree.empty())
+        DrawSectorSubtree(pContext, ViewFrustum, FRUSTUM_PLANE_FLAG_OPEN_NEAR, 0);
+}
+
+void EarthHemsiphere::DrawSectorSubtree(IDeviceContext*       pContext,
+                                        const ViewFrustumExt& ViewFrustum,
+                                        FRUSTUM_PLANE_FLAGS   PlaneFlags,
+                                        Uint32                uiNode) const
+{
+    const SectorTreeNode& Node       = m_SectorTree[uiNode];
+    const BoxVisibility   Visibility = GetBoxVisibility(ViewFrustum, Node.BndBox, PlaneFlags);
+    if (Visibility == BoxVisibility::Invisible)
+        return;
+
+    if (Visibility == BoxVisibility::Intersecting && Node.uiNumChildren != 0)
+    {
+        for (Uint32 i = 0; i < Node.uiNumChildren; ++i)
+            DrawSectorSubtree(pContext, ViewFrustum, PlaneFlags, Node.uiFirstChild + i);
+        return;
+    }
+
+    // All sectors of a fully visible subtree are drawn without further tests
+    for (Uint32 i = Node.uiFirstMesh; i < Node.uiFirstMesh + Node.uiNumMeshes; ++i)
+    {
+        const RingSectorMesh& Mesh = m_SphereMeshes[i];
+
+        DrawIndexedAttribs DrawAttrs(Mesh.uiNumIndices, VT_UINT32, DRAW_FLAG_VERIFY_ALL);
+        DrawAttrs.FirstIndexLocation = Mesh.uiFirstIndex;
+        pContext->DrawIndexed(DrawAttrs);
+    }
 }
 
 void EarthHemsiphere::Render(IDeviceContext*        pContext,
@@ -683,6 +1276,12 @@ void EarthHemsiphere::Render(IDeviceContext*        pContext,
 
     m_Params = NewParams;
 
+    if (bZOnlyPass)
+    {
+        RenderZOnly(pContext, m_pHemisphereZOnlySRB, CameraViewProjMatrix);
+        return;
+    }
+
 #if 0
     if( GetAsyncKeyState(VK_F9) )
     {
@@ -758,32 +1357,18 @@ void EarthHemsiphere::Render(IDeviceContext*        pContext,
     IBuffer* ppBuffers[1] = {m_pVertBuff};
     pContext->SetVertexBuffers(0, 1, ppBuffers, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
 
-    if (bZOnlyPass)
-    {
-        pContext->SetPipelineState(m_pHemisphereZOnlyPSO);
-        pContext->CommitShaderResources(m_pHemisphereZOnlySRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-    }
-    else
-    {
-        pShadowMapSRV->SetSampler(m_pComparisonSampler);
-        pContext->SetPipelineState(m_pHemispherePSO);
+    pShadowMapSRV->SetSampler(m_pComparisonSampler);
+    pContext->SetPipelineState(m_pHemispherePSO);
 
-        m_pHemisphereSRB->GetVariableByName(SHADER_TYPE_VERTEX, "g_tex2DOccludedNetDensityToAtmTop")->Set(pPrecomputedNetDensitySRV);
-        m_pHemisphereSRB->GetVariableByName(SHADER_TYPE_VERTEX, "g_tex2DAmbientSkylight")->Set(pAmbientSkylightSRV);
-        m_pHemisphereSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_tex2DShadowMap")->Set(pShadowMapSRV);
+    m_pHemisphereSRB->GetVariableByName(SHADER_TYPE_VERTEX, "g_tex2DOccludedNetDensityToAtmTop")->Set(pPrecomputedNetDensitySRV);
+    m_pHemisphereSRB->GetVariableByName(SHADER_TYPE_VERTEX, "g_tex2DAmbientSkylight")->Set(pAmbientSkylightSRV);
+    m_pHemisphereSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_tex2DShadowMap")->Set(pShadowMapSRV);
 
-        pContext->CommitShaderResources(m_pHemisphereSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-    }
+    pContext->CommitShaderResources(m_pHemisphereSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
 
-    for (auto MeshIt = m_SphereMeshes.begin(); MeshIt != m_SphereMeshes.end(); ++MeshIt)
-    {
-        if (GetBoxVisibility(ViewFrustum, MeshIt->BndBox, bZOnlyPass ? FRUSTUM_PLANE_FLAG_OPEN_NEAR : FRUSTUM_PLANE_FLAG_FULL_FRUSTUM) != BoxVisibility::Invisible)
-        {
-            pContext->SetIndexBuffer(MeshIt->pIndBuff, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-            DrawIndexedAttribs DrawAttrs(MeshIt->uiNumIndices, VT_UINT32, DRAW_FLAG_VERIFY_ALL);
-            pContext->DrawIndexed(DrawAttrs);
-        }
-    }
+    pContext->SetIndexBuffer(m_pIndBuff, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    if (!m_SectorTree.empty())
+        DrawSectorSubtree(pContext, ViewFrustum, FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, 0);
 }
 
 } // namespace Diligent
@@ -92,13 +92,25 @@ struct RenderingParams
     TEXTURE_FORMAT ShadowMapFormat              = TEX_FORMAT_D32_FLOAT;
 };
 
+// Range of the shared ring mesh index buffer
 struct RingSectorMesh
 {
-    RefCntAutoPtr<IBuffer> pIndBuff;
-    Uint32                 uiNumIndices;
-    BoundBox               BndBox;
+    Uint32   uiFirstIndex;
+    Uint32   uiNumIndices;
+    BoundBox BndBox;
     RingSectorMesh() :
-        uiNumIndices(0) {}
+        uiFirstIndex(0), uiNumIndices(0) {}
+};
+
+// Node of the quadtree of ring sectors. Every quadrant of a ring consists of three
+// sectors of that ring and the same quadrant of the next finer ring.
+struct SectorTreeNode
+{
+    BoundBox BndBox;            // Union of the bounding boxes of all sectors in the subtree
+    Uint32   uiFirstMesh   = 0; // Sectors of the subtree occupy a contiguous range of meshes
+    Uint32   uiNumMeshes   = 0;
+    Uint32   uiFirstChild  = 0; // Children are stored contiguously
+    Uint32   uiNumChildren = 0; // 0 for leaves that hold a single sector
 };
 
 // This class renders the adaptive model using DX11 API
@@ -125,6 +137,16 @@ public:
                 ITextureView*          pAmbientSkylightSRV,
                 bool                   bZOnlyPass);
 
+    // Renders the terrain depth with the Z-only pipeline. Unlike Render(), this method does not
+    // modify the object, so it may be called from multiple threads simultaneously, each thread
+    // using its own context and SRB. Resource states are verified, not transitioned.
+    void RenderZOnly(IDeviceContext*         pContext,
+                     IShaderResourceBinding* pZOnlySRB,
+                     const float4x4&         ViewProjMatrix) const;
+
+    // Creates the Z-only pass SRB that reads the camera attributes from pcbCameraAttribs
+    void CreateZOnlySRB(IBuffer* pcbCameraAttribs, IShaderResourceBinding** ppZOnlySRB);
+
     // Creates device resources
     void Create(class ElevationDataSource* pDataSource,
                 const RenderingParams&     Params,
@@ -143,12 +165,25 @@ public:
     }; // One base material + 4 masked materials
 
 private:
-    void RenderNormalMap(IRenderDevice*  pd3dDevice,
-                         IDeviceContext* pd3dImmediateContext,
-                         const Uint16*   pHeightMap,
-                         size_t          HeightMapPitch,
-                         int             HeightMapDim,
-                         ITexture*       ptex2DNormalMap);
+    void RenderNormalMap(IRenderDevice*             pd3dDevice,
+                         IDeviceContext*            pd3dImmediateContext,
+                         class ElevationDataSource* pDataSource,
+                         int                        HeightMapDim,
+                         ITexture*                  ptex2DNormalMap);
+
+    // Draws the sectors of the subtree that intersect the frustum
+    void DrawSectorSubtree(IDeviceContext*       pContext,
+                           const ViewFrustumExt& ViewFrustum,
+                           FRUSTUM_PLANE_FLAGS   PlaneFlags,
+                           Uint32                uiNode) const;
+
+    // Uploads only the finest height map level and builds the remaining height
+    // mips and all normal map mips with compute shaders
+    void ComputeNormalMap(IRenderDevice*             pDevice,
+                          IDeviceContext*            pContext,
+                          class ElevationDataSource* pDataSource,
+                          int                        HeightMapDim,
+                          ITexture*                  ptex2DNormalMap);
 
     RenderingParams m_Params;
 
@@ -158,6 +193,7 @@ private:
 
     RefCntAutoPtr<IBuffer>      m_pcbTerrainAttribs;
     RefCntAutoPtr<IBuffer>      m_pVertBuff;
+    RefCntAutoPtr<IBuffer>      m_pIndBuff;
     RefCntAutoPtr<ITextureView> m_ptex2DNormalMapSRV, m_ptex2DMtrlMaskSRV;
 
     RefCntAutoPtr<ITextureView> m_ptex2DTilesSRV[NUM_TILE_TEXTURES];
@@ -172,6 +208,7 @@ private:
     RefCntAutoPtr<ISampler>               m_pComparisonSampler;
 
     std::vector<RingSectorMesh> m_SphereMeshes;
+    std::vector<SectorTreeNode> m_SectorTree;
 
     Uint32 m_ValidShaders;
 };
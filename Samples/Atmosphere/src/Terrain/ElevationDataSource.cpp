@@ -45,6 +45,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 #include "ElevationDataSource.hpp"
 #include "FileWrapper.hpp"
@@ -53,10 +54,52 @@
 #include "BasicFileStream.hpp"
 #include "TextureUtilities.h"
 #include "GraphicsAccessories.hpp"
+#include "Errors.hpp"
+#include "Align.hpp"
+#include "PlatformMisc.hpp"
 
 namespace Diligent
 {
 
+namespace
+{
+
+// Tiled elevation file layout:
+//  - TiledElevationFileHeader
+//  - Min/max pyramid, NumMinMaxEntries pairs of Uint16 starting from the finest level
+//  - Tiles in row-major order, TileSize x TileSize Uint16 samples each. Samples past
+//    the last column or row duplicate the last column or row.
+struct TiledElevationFileHeader
+{
+    Uint32 Magic;
+    Uint32 Version;
+    Uint32 NumCols;
+    Uint32 NumRows;
+    Uint32 TileSize;
+    Uint32 NumMinMaxEntries;
+};
+
+constexpr Uint32 TiledElevationFileMagic   = 0x56454C45; // 'ELEV'
+constexpr Uint32 TiledElevationFileVersion = 1;
+
+bool HasTiledFileExtension(const Char* strFile)
+{
+    const size_t Len    = strlen(strFile);
+    const size_t ExtLen = strlen(ElevationDataSource::TiledFileExtension);
+    return Len >= ExtLen && strcmp(strFile + Len - ExtLen, ElevationDataSource::TiledFileExtension) == 0;
+}
+
+int ComputeNumLevels(int iPatchSize, Uint32 NumCols, Uint32 NumRows)
+{
+    int iNumLevels = 1;
+    while ((iPatchSize << (iNumLevels - 1)) < (int)NumCols - 1 ||
+           (iPatchSize << (iNumLevels - 1)) < (int)NumRows - 1)
+        iNumLevels++;
+    return iNumLevels;
+}
+
+} // namespace
+
 // Creates data source from the specified raw data file
 ElevationDataSource::ElevationDataSource(const Char* strSrcDemFile) :
     m_iNumLevels(0),
@@ -64,7 +107,20 @@ ElevationDataSource::ElevationDataSource(const Char* strSrcDemFile) :
     m_iColOffset(0),
     m_iRowOffset(0)
 {
+    if (HasTiledFileExtension(strSrcDemFile))
+    {
+        OpenTiledFile(strSrcDemFile);
+    }
+    else
+    {
+        LoadHeightMapImage(strSrcDemFile);
+        InitTiles();
+        BuildMinMaxPyramid();
+    }
+}
 
+void ElevationDataSource::LoadHeightMapImage(const Char* strSrcDemFile)
+{
 #if 1
     RefCntAutoPtr<Image> pHeightMap;
     CreateImageFromFile(strSrcDemFile, &pHeightMap);
@@ -81,14 +137,10 @@ ElevationDataSource::ElevationDataSource(const Char* strSrcDemFile) :
         m_iNumRows *= 2;
     }
 
-    m_iNumLevels = 1;
-    while ((m_iPatchSize << (m_iNumLevels - 1)) < (int)m_iNumCols ||
-           (m_iPatchSize << (m_iNumLevels - 1)) < (int)m_iNumRows)
-        m_iNumLevels++;
-
     m_iNumCols++;
     m_iNumRows++;
-    m_iStride = (m_iNumCols + 1) & (-2);
+    m_iNumLevels = ComputeNumLevels(m_iPatchSize, m_iNumCols, m_iNumRows);
+    m_iStride    = (m_iNumCols + 1) & (-2);
 
     // Load the data
     m_TheHeightMap.resize(size_t{m_iStride} * size_t{m_iNumRows});
@@ -103,11 +155,11 @@ ElevationDataSource::ElevationDataSource(const Char* strSrcDemFile) :
     // Duplicate the last row and column
     for (Uint32 iRow = 0; iRow < ImgInfo.Height; iRow++)
         for (Uint32 iCol = ImgInfo.Width; iCol < m_iNumCols; iCol++)
-            GetElevSample(iCol, iRow) = GetElevSample((ImgInfo.Width - 1), iRow);
+            GetHeightMapSample(iCol, iRow) = GetHeightMapSample((ImgInfo.Width - 1), iRow);
 
     for (Uint32 iCol = 0; iCol < m_iNumCols; iCol++)
         for (Uint32 iRow = ImgInfo.Height; iRow < m_iNumRows; iRow++)
-            GetElevSample(iCol, iRow) = GetElevSample(iCol, ImgInfo.Height - 1);
+            GetHeightMapSample(iCol, iRow) = GetHeightMapSample(iCol, ImgInfo.Height - 1);
 
 #else
     m_iStride  = 2048;
@@ -131,24 +183,205 @@ ElevationDataSource::ElevationDataSource(const Char* strSrcDemFile) :
             h = fabs(h) * 32000.f;
             h = std::min(h, (float)std::numeric_limits<Uint16>::max());
 
-            GetElevSample(i, j) = (Uint16)h;
+            GetHeightMapSample(i, j) = (Uint16)h;
         }
     }
 #endif
+}
+
+void ElevationDataSource::OpenTiledFile(const Char* strSrcDemFile)
+{
+    m_pTiledFile = std::make_unique<FileWrapper>(strSrcDemFile);
+    if (!*m_pTiledFile)
+        LOG_ERROR_AND_THROW("Failed to open tiled elevation file ", strSrcDemFile);
+
+    TiledElevationFileHeader Header{};
+    if (!(*m_pTiledFile)->Read(&Header, sizeof(Header)))
+        LOG_ERROR_AND_THROW("Failed to read the header of tiled elevation file ", strSrcDemFile);
 
-    m_GlobalMinElevation = m_TheHeightMap[0];
-    m_GlobalMaxElevation = m_TheHeightMap[0];
-    for (Uint16 Elev : m_TheHeightMap)
+    if (Header.Magic != TiledElevationFileMagic || Header.Version != TiledElevationFileVersion)
+        LOG_ERROR_AND_THROW(strSrcDemFile, " is not a tiled elevation file or its version is not supported");
+    if (Header.TileSize == 0 || !IsPowerOfTwo(Header.TileSize) || Header.NumCols == 0 || Header.NumRows == 0)
+        LOG_ERROR_AND_THROW("Tiled elevation file ", strSrcDemFile, " is corrupted");
+
+    m_iNumCols   = Header.NumCols;
+    m_iNumRows   = Header.NumRows;
+    m_iPatchSize = static_cast<int>(Header.TileSize);
+    m_iNumLevels = ComputeNumLevels(m_iPatchSize, m_iNumCols, m_iNumRows);
+
+    InitTiles();
+    if (Header.NumMinMaxEntries != m_MinMaxPyramid.size())
+        LOG_ERROR_AND_THROW("Tiled elevation file ", strSrcDemFile, " is corrupted: unexpected min/max pyramid size");
+
+    if (!(*m_pTiledFile)->Read(m_MinMaxPyramid.data(), m_MinMaxPyramid.size() * sizeof(MinMax)))
+        LOG_ERROR_AND_THROW("Failed to read the min/max pyramid of tiled elevation file ", strSrcDemFile);
+
+    m_TileDataOffset = sizeof(Header) + m_MinMaxPyramid.size() * sizeof(MinMax);
+    InitGlobalElevationRange();
+}
+
+void ElevationDataSource::InitTiles()
+{
+    VERIFY(IsPowerOfTwo(m_iPatchSize), "Tile size must be a power of two");
+    const Uint32 TileSize = static_cast<Uint32>(m_iPatchSize);
+
+    m_TileSizeLog2 = PlatformMisc::GetMSB(TileSize);
+    m_NumTilesX    = (m_iNumCols + TileSize - 1) >> m_TileSizeLog2;
+    m_NumTilesY    = (m_iNumRows + TileSize - 1) >> m_TileSizeLog2;
+    m_pTiles.reset(new Tile[size_t{m_NumTilesX} * size_t{m_NumTilesY}]);
+
+    if (!m_TheHeightMap.empty())
+    {
+        // Tiles of the height map loaded at once point into it
+        m_TileStride = m_iStride;
+        for (Uint32 ty = 0; ty < m_NumTilesY; ++ty)
+        {
+            for (Uint32 tx = 0; tx < m_NumTilesX; ++tx)
+            {
+                const Uint16* pTileData = &m_TheHeightMap[size_t{ty} * TileSize * m_iStride + size_t{tx} * TileSize];
+                m_pTiles[ty * m_NumTilesX + tx].pData.store(pTileData);
+            }
+        }
+        m_NumResidentTiles = m_NumTilesX * m_NumTilesY;
+    }
+    else
+    {
+        m_TileStride = TileSize;
+    }
+
+    // Allocate the min/max pyramid
+    m_MinMaxLevelOffsets.clear();
+    Uint32 NumEntries = 0;
+    for (Uint32 Level = 0;; ++Level)
     {
-        m_GlobalMinElevation = std::min(m_GlobalMinElevation, Elev);
-        m_GlobalMaxElevation = std::max(m_GlobalMaxElevation, Elev);
+        m_MinMaxLevelOffsets.push_back(NumEntries);
+        const Uint32 LevelWidth  = ((m_NumTilesX - 1) >> Level) + 1;
+        const Uint32 LevelHeight = ((m_NumTilesY - 1) >> Level) + 1;
+        NumEntries += LevelWidth * LevelHeight;
+        if (LevelWidth == 1 && LevelHeight == 1)
+            break;
+    }
+    m_MinMaxPyramid.resize(NumEntries);
+}
+
+void ElevationDataSource::BuildMinMaxPyramid()
+{
+    const Uint32 TileSize = static_cast<Uint32>(m_iPatchSize);
+
+    for (Uint32 ty = 0; ty < m_NumTilesY; ++ty)
+    {
+        for (Uint32 tx = 0; tx < m_NumTilesX; ++tx)
+        {
+            MinMax& TileMinMax = m_MinMaxPyramid[ty * m_NumTilesX + tx];
+            TileMinMax.Min     = 0xFFFF;
+            TileMinMax.Max     = 0;
+            for (Uint32 iRow = ty * TileSize; iRow < std::min((ty + 1) * TileSize, m_iNumRows); ++iRow)
+            {
+                for (Uint32 iCol = tx * TileSize; iCol < std::min((tx + 1) * TileSize, m_iNumCols); ++iCol)
+                {
+                    const Uint16 Elev = GetElevSample(iCol, iRow);
+                    TileMinMax.Min    = std::min(TileMinMax.Min, Elev);
+                    TileMinMax.Max    = std::max(TileMinMax.Max, Elev);
+                }
+            }
+        }
+    }
+
+    for (size_t Level = 1; Level < m_MinMaxLevelOffsets.size(); ++Level)
+    {
+        const Uint32 FinerWidth  = ((m_NumTilesX - 1) >> (Level - 1)) + 1;
+        const Uint32 FinerHeight = ((m_NumTilesY - 1) >> (Level - 1)) + 1;
+        const Uint32 LevelWidth  = ((m_NumTilesX - 1) >> Level) + 1;
+        const Uint32 LevelHeight = ((m_NumTilesY - 1) >> Level) + 1;
+
+        const MinMax* pFiner = &m_MinMaxPyramid[m_MinMaxLevelOffsets[Level - 1]];
+        MinMax*       pLevel = &m_MinMaxPyramid[m_MinMaxLevelOffsets[Level]];
+        for (Uint32 y = 0; y < LevelHeight; ++y)
+        {
+            for (Uint32 x = 0; x < LevelWidth; ++x)
+            {
+                MinMax& Entry = pLevel[y * LevelWidth + x];
+                Entry.Min     = 0xFFFF;
+                Entry.Max     = 0;
+                for (Uint32 fy = y * 2; fy < std::min(y * 2 + 2, FinerHeight); ++fy)
+                {
+                    for (Uint32 fx = x * 2; fx < std::min(x * 2 + 2, FinerWidth); ++fx)
+                    {
+                        Entry.Min = std::min(Entry.Min, pFiner[fy * FinerWidth + fx].Min);
+                        Entry.Max = std::max(Entry.Max, pFiner[fy * FinerWidth + fx].Max);
+                    }
+                }
+            }
+        }
     }
+
+    InitGlobalElevationRange();
+}
+
+void ElevationDataSource::InitGlobalElevationRange()
+{
+    m_GlobalMinElevation = m_MinMaxPyramid.back().Min;
+    m_GlobalMaxElevation = m_MinMaxPyramid.back().Max;
+
+    // The global range has always been computed over the whole height map including
+    // the zero padding column of the even stride. The camera near and far planes
+    // depend on it, so tiled files and images report the same range as before.
+    if ((m_iNumCols & 0x01) != 0)
+        m_GlobalMinElevation = 0;
 }
 
 ElevationDataSource::~ElevationDataSource(void)
 {
 }
 
+bool ElevationDataSource::CreateTiledFile(const Char* strDstFile) const
+{
+    FileWrapper File{strDstFile, EFileAccessMode::Overwrite};
+    if (!File)
+    {
+        LOG_ERROR_MESSAGE("Failed to create tiled elevation file '", strDstFile, "'.");
+        return false;
+    }
+
+    const Uint32 TileSize = static_cast<Uint32>(m_iPatchSize);
+
+    TiledElevationFileHeader Header{};
+    Header.Magic            = TiledElevationFileMagic;
+    Header.Version          = TiledElevationFileVersion;
+    Header.NumCols          = m_iNumCols;
+    Header.NumRows          = m_iNumRows;
+    Header.TileSize         = TileSize;
+    Header.NumMinMaxEntries = static_cast<Uint32>(m_MinMaxPyramid.size());
+
+    bool Res = File->Write(&Header, sizeof(Header));
+    Res      = Res && File->Write(m_MinMaxPyramid.data(), m_MinMaxPyramid.size() * sizeof(MinMax));
+
+    // Write one tile at a time so that the source does not need to be resident as a whole
+    std::vector<Uint16> TileData(size_t{TileSize} * size_t{TileSize});
+    for (Uint32 ty = 0; ty < m_NumTilesY && Res; ++ty)
+    {
+        for (Uint32 tx = 0; tx < m_NumTilesX && Res; ++tx)
+        {
+            for (Uint32 y = 0; y < TileSize; ++y)
+            {
+                const Uint32 iRow = std::min(ty * TileSize + y, m_iNumRows - 1);
+                for (Uint32 x = 0; x < TileSize; ++x)
+                {
+                    const Uint32 iCol          = std::min(tx * TileSize + x, m_iNumCols - 1);
+                    TileData[y * TileSize + x] = GetElevSample(iCol, iRow);
+                }
+            }
+            Res = File->Write(TileData.data(), TileData.size() * sizeof(TileData[0]));
+        }
+    }
+    File.Close();
+
+    if (!Res)
+        LOG_ERROR_MESSAGE("Failed to write tiled elevation file '", strDstFile, "'.");
+
+    return Res;
+}
+
 Uint16 ElevationDataSource::GetGlobalMinElevation() const
 {
     return m_GlobalMinElevation;
@@ -171,14 +404,83 @@ int MirrorCoord(int iCoord, int iDim)
     return iCoord;
 }
 
-inline Uint16& ElevationDataSource::GetElevSample(Int32 i, Int32 j)
+inline Uint16& ElevationDataSource::GetHeightMapSample(Int32 i, Int32 j)
 {
     return m_TheHeightMap[i + j * m_iStride];
 }
 
 inline Uint16 ElevationDataSource::GetElevSample(Int32 i, Int32 j) const
 {
-    return m_TheHeightMap[i + j * m_iStride];
+    const Uint32  TileIdx   = (static_cast<Uint32>(j) >> m_TileSizeLog2) * m_NumTilesX + (static_cast<Uint32>(i) >> m_TileSizeLog2);
+    const Uint32  TileMask  = (1u << m_TileSizeLog2) - 1u;
+    const Uint16* pTileData = m_pTiles[TileIdx].pData.load(std::memory_order_acquire);
+    if (pTileData == nullptr)
+        pTileData = PageInTile(TileIdx);
+    return pTileData[(j & TileMask) * m_TileStride + (i & TileMask)];
+}
+
+bool ElevationDataSource::ReadTile(Uint32 TileIdx, Uint16* pDst) const
+{
+    VERIFY_EXPR(m_pTiledFile);
+    const size_t TileBytes = size_t{1} << (m_TileSizeLog2 * 2 + 1);
+    return (*m_pTiledFile)->SetPos(static_cast<size_t>(m_TileDataOffset + TileIdx * TileBytes), FilePosOrigin::Start) &&
+        (*m_pTiledFile)->Read(pDst, TileBytes);
+}
+
+const Uint16* ElevationDataSource::PageInTile(Uint32 TileIdx) const
+{
+    std::lock_guard<std::mutex> Lock{m_TilesMtx};
+
+    Tile& CurrTile    = m_pTiles[TileIdx];
+    CurrTile.LastUsed = m_ResidencyStamp;
+    // The tile may have been read by another thread while this one was waiting
+    if (const Uint16* pTileData = CurrTile.pData.load(std::memory_order_acquire))
+        return pTileData;
+
+    const size_t              TileSize = size_t{1} << m_TileSizeLog2;
+    std::unique_ptr<Uint16[]> pTileData{new Uint16[TileSize * TileSize]};
+    if (!ReadTile(TileIdx, pTileData.get()))
+    {
+        LOG_ERROR_MESSAGE("Failed to read elevation tile ", TileIdx, ". Using the minimal tile elevation.");
+        std::fill_n(pTileData.get(), TileSize * TileSize, m_MinMaxPyramid[TileIdx].Min);
+    }
+
+    CurrTile.pOwnedData = std::move(pTileData);
+    CurrTile.pData.store(CurrTile.pOwnedData.get(), std::memory_order_release);
+    ++m_NumResidentTiles;
+
+    return CurrTile.pOwnedData.get();
+}
+
+void ElevationDataSource::EvictTiles()
+{
+    if (!m_pTiledFile)
+        return; // All tiles are always resident
+
+    std::lock_guard<std::mutex> Lock{m_TilesMtx};
+    // Tiles read after this call are newer than all resident ones
+    ++m_ResidencyStamp;
+    if (m_NumResidentTiles <= m_MaxResidentTiles)
+        return;
+
+    // No height queries are running, so any tile can be evicted
+    std::vector<Uint32> Candidates;
+    for (Uint32 TileIdx = 0; TileIdx < m_NumTilesX * m_NumTilesY; ++TileIdx)
+    {
+        if (m_pTiles[TileIdx].pOwnedData)
+            Candidates.push_back(TileIdx);
+    }
+    std::sort(Candidates.begin(), Candidates.end(), [this](Uint32 Idx0, Uint32 Idx1) {
+        return m_pTiles[Idx0].LastUsed < m_pTiles[Idx1].LastUsed;
+    });
+
+    for (size_t i = 0; i < Candidates.size() && m_NumResidentTiles > m_MaxResidentTiles; ++i)
+    {
+        Tile& CurrTile = m_pTiles[Candidates[i]];
+        CurrTile.pData.store(nullptr, std::memory_order_release);
+        CurrTile.pOwnedData.reset();
+        --m_NumResidentTiles;
+    }
 }
 
 float ElevationDataSource::GetInterpolatedHeight(float fCol, float fRow, int iStep) const
@@ -235,8 +537,40 @@ float3 ElevationDataSource::ComputeSurfaceNormal(float fCol, float fRow, float f
 
 void ElevationDataSource::GetDataPtr(const Uint16*& pDataPtr, size_t& Pitch)
 {
-    pDataPtr = &m_TheHeightMap[0];
+    VERIFY(!IsTiledFile(), "Tiled elevation files are not loaded as a whole. Use ReadTileSamples() instead.");
+    pDataPtr = !m_TheHeightMap.empty() ? m_TheHeightMap.data() : nullptr;
     Pitch    = m_iStride;
 }
 
+void ElevationDataSource::ReadTileSamples(Uint32 tx, Uint32 ty, Uint16* pDst) const
+{
+    VERIFY_EXPR(tx < m_NumTilesX && ty < m_NumTilesY);
+    const Uint32 TileSize = 1u << m_TileSizeLog2;
+    const Uint32 TileIdx  = ty * m_NumTilesX + tx;
+
+    std::lock_guard<std::mutex> Lock{m_TilesMtx};
+
+    const Uint16* pTileData = m_pTiles[TileIdx].pData.load(std::memory_order_acquire);
+    if (pTileData == nullptr)
+    {
+        // Tiles in the file already contain the duplicated samples
+        if (!ReadTile(TileIdx, pDst))
+        {
+            LOG_ERROR_MESSAGE("Failed to read elevation tile ", TileIdx, ". Using the minimal tile elevation.");
+            std::fill_n(pDst, size_t{TileSize} * size_t{TileSize}, m_MinMaxPyramid[TileIdx].Min);
+        }
+        return;
+    }
+
+    const Uint32 NumTileCols = std::min(TileSize, m_iNumCols - tx * TileSize);
+    const Uint32 NumTileRows = std::min(TileSize, m_iNumRows - ty * TileSize);
+    for (Uint32 y = 0; y < TileSize; ++y)
+    {
+        const Uint16* pSrcRow = pTileData + size_t{std::min(y, NumTileRows - 1)} * m_TileStride;
+        Uint16*       pDstRow = pDst + size_t{y} * TileSize;
+        memcpy(pDstRow, pSrcRow, NumTileCols * sizeof(Uint16));
+        std::fill(pDstRow + NumTileCols, pDstRow + TileSize, pSrcRow[NumTileCols - 1]);
+    }
+}
+
 } // namespace Diligent
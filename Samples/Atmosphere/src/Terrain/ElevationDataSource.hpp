@@ -46,6 +46,9 @@
 #pragma once
 
 #include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
 
 #include "BasicTypes.h"
 #include "BasicMath.hpp"
@@ -53,23 +56,41 @@
 namespace Diligent
 {
 
+class FileWrapper;
+
 // Class implementing elevation data source
+//
+// The height map is split into square tiles, and every tile keeps its elevation range in a min/max
+// pyramid. Tiles of an image source are views into the height map that is loaded at once. Tiles of
+// a tiled elevation file (see CreateTiledFile) are read from the file when they are first accessed,
+// and EvictTiles() releases the least recently read tiles over the budget between batches of height
+// queries, so that the height map does not need to fit in memory.
 class ElevationDataSource
 {
 public:
-    // Creates data source from the specified raw data file
+    // Creates data source from the specified image or tiled elevation file (TiledFileExtension)
     ElevationDataSource(const Char* strSrcDemFile);
     virtual ~ElevationDataSource(void);
 
+    static constexpr const Char* TiledFileExtension = ".elev";
+
+    // Writes the height map to a tiled elevation file that can be paged from disk
+    bool CreateTiledFile(const Char* strDstFile) const;
+
+    // Returns the whole height map of an image source. Tiled files are never
+    // loaded as a whole, their samples are accessed by tiles (see ReadTileSamples).
     void GetDataPtr(const Uint16*& pDataPtr, size_t& Pitch);
 
+    // Copies TileSize x TileSize samples of the tile (tx, ty) to pDst without making the
+    // tile resident. Samples past the last column or row duplicate the last column or row.
+    void ReadTileSamples(Uint32 tx, Uint32 ty, Uint16* pDst) const;
+
     // Returns minimal height of the whole terrain
     Uint16 GetGlobalMinElevation() const;
 
     // Returns maximal height of the whole terrain
     Uint16 GetGlobalMaxElevation() const;
 
-
     void SetOffsets(int iColOffset, int iRowOffset)
     {
         m_iColOffset = iColOffset;
@@ -81,16 +102,38 @@ public:
         iRowOffset = m_iRowOffset;
     }
 
+    // Height queries are thread-safe. Missing tiles are read from the file on demand.
     float GetInterpolatedHeight(float fCol, float fRow, int iStep = 1) const;
 
     float3 ComputeSurfaceNormal(float fCol, float fRow, float fSampleSpacing, float fHeightScale, int iStep = 1) const;
 
+    // Evicts the least recently read tiles until at most MaxResidentTiles tiles remain resident.
+    // Must not be called concurrently with the height queries.
+    void EvictTiles();
+
+    void   SetMaxResidentTiles(Uint32 MaxResidentTiles) { m_MaxResidentTiles = MaxResidentTiles; }
+    Uint32 GetNumResidentTiles() const { return m_NumResidentTiles; }
+    bool   IsTiledFile() const { return m_pTiledFile != nullptr; }
+
+    Uint32 GetTileSize() const { return 1u << m_TileSizeLog2; }
+    Uint32 GetNumTilesX() const { return m_NumTilesX; }
+    Uint32 GetNumTilesY() const { return m_NumTilesY; }
+
     unsigned int GetNumCols() const { return m_iNumCols; }
     unsigned int GetNumRows() const { return m_iNumRows; }
 
 private:
+    void LoadHeightMapImage(const Char* strSrcDemFile);
+    void OpenTiledFile(const Char* strSrcDemFile);
+    void InitTiles();
+    void BuildMinMaxPyramid();
+    void InitGlobalElevationRange();
+
     inline Uint16  GetElevSample(Int32 i, Int32 j) const;
-    inline Uint16& GetElevSample(Int32 i, Int32 j);
+    inline Uint16& GetHeightMapSample(Int32 i, Int32 j);
+
+    const Uint16* PageInTile(Uint32 TileIdx) const;
+    bool          ReadTile(Uint32 TileIdx, Uint16* pDst) const;
 
     Uint16 m_GlobalMinElevation = 0;
     Uint16 m_GlobalMaxElevation = 0;
@@ -100,12 +143,44 @@ private:
     int m_iColOffset = 0;
     int m_iRowOffset = 0;
 
-    // The whole terrain height map
+    // The whole terrain height map. Always empty for tiled files.
     std::vector<Uint16> m_TheHeightMap;
 
     Uint32 m_iNumCols = 0;
     Uint32 m_iNumRows = 0;
     Uint32 m_iStride  = 0;
+
+    struct Tile
+    {
+        std::atomic<const Uint16*> pData{nullptr};
+        std::unique_ptr<Uint16[]>  pOwnedData;
+        Uint64                     LastUsed = 0;
+    };
+
+    struct MinMax
+    {
+        Uint16 Min;
+        Uint16 Max;
+    };
+
+    Uint32 m_TileSizeLog2 = 0;
+    Uint32 m_TileStride   = 0;
+    Uint32 m_NumTilesX    = 0;
+    Uint32 m_NumTilesY    = 0;
+
+    std::unique_ptr<Tile[]> m_pTiles;
+
+    // Level 0 has one entry per tile, every next level reduces 2x2 entries of the previous one
+    std::vector<MinMax> m_MinMaxPyramid;
+    std::vector<Uint32> m_MinMaxLevelOffsets;
+
+    std::unique_ptr<FileWrapper> m_pTiledFile;
+    Uint64                       m_TileDataOffset = 0;
+
+    mutable std::mutex m_TilesMtx;
+    mutable Uint64     m_ResidencyStamp   = 0;
+    mutable Uint32     m_NumResidentTiles = 0;
+    Uint32             m_MaxResidentTiles = 256;
 };
 
 } // namespace Diligent
@@ -0,0 +1,73 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+// Runs several tutorials one after another in the same process and on the same device,
+// which avoids the cost of creating the engine for every golden image test. Usage:
+//
+//   GoldenImageBatch --mode vk --golden_image_mode compare --capture_path <golden images dir> --batch_samples_root <DiligentSamples dir>
+//
+// The golden images are expected in the same layout as the one used by ProcessGoldenImages scripts.
+
+#include "SampleApp.hpp"
+
+namespace Diligent
+{
+
+#define DECLARE_BATCH_SAMPLE(Name) SampleBase* CreateSample_##Name();
+DECLARE_BATCH_SAMPLE(Tutorial01_HelloTriangle)
+DECLARE_BATCH_SAMPLE(Tutorial02_Cube)
+DECLARE_BATCH_SAMPLE(Tutorial03_Texturing)
+DECLARE_BATCH_SAMPLE(Tutorial04_Instancing)
+DECLARE_BATCH_SAMPLE(Tutorial05_TextureArray)
+DECLARE_BATCH_SAMPLE(Tutorial06_Multithreading)
+DECLARE_BATCH_SAMPLE(Tutorial12_RenderTarget)
+DECLARE_BATCH_SAMPLE(Tutorial13_ShadowMap)
+DECLARE_BATCH_SAMPLE(Tutorial17_MSAA)
+#undef DECLARE_BATCH_SAMPLE
+
+SampleBase* CreateSample()
+{
+    // clang-format off
+    std::vector<SampleBatchItem> Samples =
+    {
+        {"Tutorials/Tutorial01_HelloTriangle",  nullptr, CreateSample_Tutorial01_HelloTriangle},
+        {"Tutorials/Tutorial02_Cube",           nullptr, CreateSample_Tutorial02_Cube},
+        {"Tutorials/Tutorial03_Texturing",      nullptr, CreateSample_Tutorial03_Texturing},
+        {"Tutorials/Tutorial04_Instancing",     nullptr, CreateSample_Tutorial04_Instancing},
+        {"Tutorials/Tutorial05_TextureArray",   nullptr, CreateSample_Tutorial05_TextureArray},
+        {"Tutorials/Tutorial06_Multithreading", nullptr, CreateSample_Tutorial06_Multithreading},
+        {"Tutorials/Tutorial12_RenderTarget",   nullptr, CreateSample_Tutorial12_RenderTarget},
+        {"Tutorials/Tutorial13_ShadowMap",      nullptr, CreateSample_Tutorial13_ShadowMap},
+        {"Tutorials/Tutorial17_MSAA",           nullptr, CreateSample_Tutorial17_MSAA},
+    };
+    // clang-format on
+
+    SampleBase* pFirstSample = Samples[0].CreateSample();
+    SampleApp::SetSampleBatch(std::move(Samples));
+    return pFirstSample;
+}
+
+} // namespace Diligent
@@ -172,6 +172,14 @@ rem For some reason, colored font does not work after the line that starts the s
         md "%golden_img_dir%"
     )
 
+    set diff_args=
+    if not "%GOLDEN_IMAGE_DIFF_DIR%" == "" (
+        if not exist "%GOLDEN_IMAGE_DIFF_DIR%/%app_folder%/%app_name%" (
+            md "%GOLDEN_IMAGE_DIFF_DIR%/%app_folder%/%app_name%"
+        )
+        set diff_args=--golden_image_diff_path %GOLDEN_IMAGE_DIFF_DIR%/%app_folder%/%app_name%
+    )
+
     set EXIT_CODE=0
     for %%X in (%test_modes%) do (
         rem ~ removes quotes from %%X
@@ -220,7 +228,7 @@ rem For some reason, colored font does not work after the line that starts the s
             rem   !!!   ERRORLEVEL doesn't get updated inside control blocks like IF statements unless           !!!
             rem   !!!   !ERRORLEVEL! is used instead of %ERRORLEVEL% and delayed expansion is enabled as below:  !!!
             rem   !!!   setlocal ENABLEDELAYEDEXPANSION                                                          !!!
-            set cmd_args=!test_mode! --width %GOLDEN_IMAGE_WIDTH% --height %GOLDEN_IMAGE_HEIGHT% --golden_image_mode %golden_img_mode% --capture_path %golden_img_dir% --capture_name !capture_name! --capture_format png --adapters_dialog 0 --break_on_error 0 --golden_image_tolerance %GOLDEN_IMAGE_TOLERANCE% %extra_args%
+            set cmd_args=!test_mode! --width %GOLDEN_IMAGE_WIDTH% --height %GOLDEN_IMAGE_HEIGHT% --golden_image_mode %golden_img_mode% --capture_path %golden_img_dir% --capture_name !capture_name! --capture_format png --adapters_dialog 0 --break_on_error 0 --golden_image_tolerance %GOLDEN_IMAGE_TOLERANCE% !diff_args! %extra_args%
             echo !app_path! !cmd_args!
             !app_path! !cmd_args!
             rem It is important to save the value of !ERRORLEVEL! so that it is not overridden by further commands
@@ -277,6 +285,7 @@ rem For some reason, colored font does not work after the line that starts the s
     echo.
     echo   GOLDEN_IMAGE_WIDTH   - Golden image width (Default: 512^)
     echo   GOLDEN_IMAGE_HEIGHT  - Golden image height (Default: 512^)
+    echo   GOLDEN_IMAGE_DIFF_DIR - Absolute path to the directory where difference heat maps are saved for failed tests
     echo   ADDITIONAL_TEST_APPS - A list of additional applications to test.
     echo                          Each application should be defined as follows:
     echo                            Folder/Application ^<optional arguments^>
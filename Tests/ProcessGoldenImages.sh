@@ -11,6 +11,7 @@ function print_help
     echo ""
     echo "  GOLDEN_IMAGE_WIDTH  - Golden image width (Default: 512)"
     echo "  GOLDEN_IMAGE_HEIGHT - Golden image height (Default: 512)"
+    echo "  GOLDEN_IMAGE_DIFF_DIR - Absolute path to the directory where difference heat maps are saved for failed tests"
     echo ""
     echo "Command line format:"
     echo ""
@@ -99,6 +100,9 @@ echo "Build dir:   $DILIGENT_BUILD_DIR"
 echo "Img mode:    $golden_img_mode"
 echo "Img dir:     $golden_images_dir"
 echo "Img size:    $GOLDEN_IMAGE_WIDTH x $GOLDEN_IMAGE_HEIGHT"
+if [[ "$GOLDEN_IMAGE_DIFF_DIR" != "" ]]; then
+    echo "Diff dir:    $GOLDEN_IMAGE_DIFF_DIR"
+fi
 echo "Test modes:  $test_modes_str"
 echo ""
 
@@ -182,6 +186,13 @@ function process_golden_img
         mkdir -p "$golden_img_dir"
     fi
 
+    local diff_args=""
+    if [[ "$GOLDEN_IMAGE_DIFF_DIR" != "" ]]; then
+        local diff_img_dir=$GOLDEN_IMAGE_DIFF_DIR/$app_folder/$app_name
+        mkdir -p "$diff_img_dir"
+        diff_args="--golden_image_diff_path $diff_img_dir"
+    fi
+
     for mode in "${test_modes[@]}"; do
         local app_path=$DILIGENT_BUILD_DIR/DiligentSamples/$app_folder/$app_name/$app_name
 
@@ -210,7 +221,7 @@ function process_golden_img
         if [[ "$skip_test" == "0" ]]; then
             local capture_name="$app_name""_""$backend_name"
 
-            local cmd="$app_path $mode --width $GOLDEN_IMAGE_WIDTH --height $GOLDEN_IMAGE_HEIGHT --golden_image_mode $golden_img_mode --capture_path $golden_img_dir --capture_name $capture_name --capture_format png --adapters_dialog 0 --break_on_error 0 --golden_image_tolerance $GOLDEN_IMAGE_TOLERANCE $extra_args"
+            local cmd="$app_path $mode --width $GOLDEN_IMAGE_WIDTH --height $GOLDEN_IMAGE_HEIGHT --golden_image_mode $golden_img_mode --capture_path $golden_img_dir --capture_name $capture_name --capture_format png --adapters_dialog 0 --break_on_error 0 --golden_image_tolerance $GOLDEN_IMAGE_TOLERANCE $diff_args $extra_args"
 
             echo $cmd
             echo ""
@@ -28,6 +28,7 @@
 #include <random>
 #include <string>
 #include <algorithm>
+#include <thread>
 
 #include "Tutorial06_Multithreading.hpp"
 #include "MapHelper.hpp"
@@ -37,6 +38,7 @@
 #include "../../Common/src/TexturedCube.hpp"
 #include "imgui.h"
 #include "ImGuiUtils.hpp"
+#include "CommandLineParser.hpp"
 
 namespace Diligent
 {
@@ -48,7 +50,27 @@ SampleBase* CreateSample()
 
 Tutorial06_Multithreading::~Tutorial06_Multithreading()
 {
-    StopWorkerThreads();
+    m_pJobScheduler.reset();
+}
+
+SampleBase::CommandLineStatus Tutorial06_Multithreading::ProcessCommandLine(int argc, const char* const* argv)
+{
+    CommandLineParser ArgsParser{argc, argv};
+    if (ArgsParser.Parse("grid_size", 'g', m_GridSize))
+    {
+        m_GridSize = clamp(m_GridSize, 1, 32);
+    }
+    if (ArgsParser.Parse("threads", 't', m_NumWorkerThreads))
+    {
+        m_NumWorkerThreads = clamp(m_NumWorkerThreads, 0, 128);
+    }
+    bool Instanced = m_RenderMode == RENDER_MODE_INSTANCED;
+    if (ArgsParser.Parse("instanced", 'i', Instanced))
+    {
+        m_RenderMode = Instanced ? RENDER_MODE_INSTANCED : RENDER_MODE_DRAW_PER_INSTANCE;
+    }
+
+    return CommandLineStatus::OK;
 }
 
 void Tutorial06_Multithreading::ModifyEngineInitInfo(const ModifyEngineInitInfoAttribs& Attribs)
@@ -88,6 +110,26 @@ void Tutorial06_Multithreading::CreatePipelineState(std::vector<StateTransitionD
 
     m_pPSO = TexturedCube::CreatePipelineState(CubePsoCI, m_ConvertPSOutputToGamma);
 
+    // clang-format off
+    // Instanced pipeline reads the instance matrix from the second buffer slot
+    LayoutElement InstanceLayoutElems[] =
+    {
+        // Attribute 2 - first row
+        LayoutElement{2, 1, 4, VT_FLOAT32, False, INPUT_ELEMENT_FREQUENCY_PER_INSTANCE},
+        // Attribute 3 - second row
+        LayoutElement{3, 1, 4, VT_FLOAT32, False, INPUT_ELEMENT_FREQUENCY_PER_INSTANCE},
+        // Attribute 4 - third row
+        LayoutElement{4, 1, 4, VT_FLOAT32, False, INPUT_ELEMENT_FREQUENCY_PER_INSTANCE},
+        // Attribute 5 - fourth row
+        LayoutElement{5, 1, 4, VT_FLOAT32, False, INPUT_ELEMENT_FREQUENCY_PER_INSTANCE}
+    };
+    // clang-format on
+    CubePsoCI.VSFilePath             = "cube_inst.vsh";
+    CubePsoCI.ExtraLayoutElements    = InstanceLayoutElems;
+    CubePsoCI.NumExtraLayoutElements = _countof(InstanceLayoutElems);
+
+    m_pInstancedPSO = TexturedCube::CreatePipelineState(CubePsoCI, m_ConvertPSOutputToGamma);
+
     // Create dynamic uniform buffer that will store our transformation matrix
     // Dynamic buffers can be frequently updated by the CPU
     CreateUniformBuffer(m_pDevice, sizeof(float4x4) * 2, "VS constants CB", &m_VSConstants);
@@ -101,6 +143,18 @@ void Tutorial06_Multithreading::CreatePipelineState(std::vector<StateTransitionD
     // never change and are bound directly to the pipeline state object.
     m_pPSO->GetStaticVariableByName(SHADER_TYPE_VERTEX, "Constants")->Set(m_VSConstants);
     m_pPSO->GetStaticVariableByName(SHADER_TYPE_VERTEX, "InstanceData")->Set(m_InstanceConstants);
+    m_pInstancedPSO->GetStaticVariableByName(SHADER_TYPE_VERTEX, "Constants")->Set(m_VSConstants);
+
+    // Dynamic instance buffer is mapped with MAP_FLAG_DISCARD in every context, so
+    // every thread writes its own copy of the data.
+    BufferDesc InstBuffDesc;
+    InstBuffDesc.Name           = "Instance data buffer";
+    InstBuffDesc.Usage          = USAGE_DYNAMIC;
+    InstBuffDesc.BindFlags      = BIND_VERTEX_BUFFER;
+    InstBuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+    InstBuffDesc.Size           = sizeof(float4x4) * MaxInstancesPerMap;
+    m_pDevice->CreateBuffer(InstBuffDesc, nullptr, &m_InstanceBuffer);
+    Barriers.emplace_back(m_InstanceBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE);
 }
 
 void Tutorial06_Multithreading::LoadTextures(std::vector<StateTransitionDesc>& Barriers)
@@ -127,6 +181,9 @@ void Tutorial06_Multithreading::LoadTextures(std::vector<StateTransitionDesc>& B
         // http://diligentgraphics.com/2016/03/23/resource-binding-model-in-diligent-engine-2-0/
         m_pPSO->CreateShaderResourceBinding(&m_SRB[tex], true);
         m_SRB[tex]->GetVariableByName(SHADER_TYPE_PIXEL, "g_Texture")->Set(m_TextureSRV[tex]);
+
+        m_pInstancedPSO->CreateShaderResourceBinding(&m_InstancedSRB[tex], true);
+        m_InstancedSRB[tex]->GetVariableByName(SHADER_TYPE_PIXEL, "g_Texture")->Set(m_TextureSRV[tex]);
     }
 }
 
@@ -139,12 +196,12 @@ void Tutorial06_Multithreading::UpdateUI()
         {
             PopulateInstanceData();
         }
+        ImGui::Combo("Render Mode", &m_RenderMode, "Draw per cube\0Instanced\0\0");
         {
             ImGui::ScopedDisabler Disable(m_MaxThreads == 0);
             if (ImGui::SliderInt("Worker Threads", &m_NumWorkerThreads, 0, m_MaxThreads))
             {
-                StopWorkerThreads();
-                StartWorkerThreads(m_NumWorkerThreads);
+                CreateJobScheduler(static_cast<Uint32>(m_NumWorkerThreads));
             }
         }
     }
@@ -157,7 +214,7 @@ void Tutorial06_Multithreading::Initialize(const SampleInitInfo& InitInfo)
     SampleBase::Initialize(InitInfo);
 
     m_MaxThreads       = static_cast<int>(m_pDeferredContexts.size());
-    m_NumWorkerThreads = std::min(4, m_MaxThreads);
+    m_NumWorkerThreads = std::min(m_NumWorkerThreads, m_MaxThreads);
 
     std::vector<StateTransitionDesc> Barriers;
 
@@ -176,7 +233,7 @@ void Tutorial06_Multithreading::Initialize(const SampleInitInfo& InitInfo)
 
     PopulateInstanceData();
 
-    StartWorkerThreads(m_NumWorkerThreads);
+    CreateJobScheduler(static_cast<Uint32>(m_NumWorkerThreads));
 }
 
 void Tutorial06_Multithreading::PopulateInstanceData()
@@ -224,79 +281,17 @@ void Tutorial06_Multithreading::PopulateInstanceData()
     }
 }
 
-void Tutorial06_Multithreading::StartWorkerThreads(size_t NumThreads)
+void Tutorial06_Multithreading::CreateJobScheduler(Uint32 NumThreads)
 {
-    m_WorkerThreads.resize(NumThreads);
-    for (Uint32 t = 0; t < m_WorkerThreads.size(); ++t)
-    {
-        m_WorkerThreads[t] = std::thread(WorkerThreadFunc, this, t);
-    }
-    m_CmdLists.resize(NumThreads);
-}
-
-void Tutorial06_Multithreading::StopWorkerThreads()
-{
-    m_RenderSubsetSignal.Trigger(true, -1);
+    m_pJobScheduler.reset();
 
-    for (std::thread& thread : m_WorkerThreads)
-    {
-        thread.join();
-    }
-    m_RenderSubsetSignal.Reset();
-    m_WorkerThreads.clear();
-    m_CmdLists.clear();
-}
-
-void Tutorial06_Multithreading::WorkerThreadFunc(Tutorial06_Multithreading* pThis, Uint32 ThreadNum)
-{
-    // Every thread should use its own deferred context
-    IDeviceContext* pDeferredCtx     = pThis->m_pDeferredContexts[ThreadNum];
-    const int       NumWorkerThreads = static_cast<int>(pThis->m_WorkerThreads.size());
-    for (;;)
-    {
-        // Wait for the signal
-        int SignaledValue = pThis->m_RenderSubsetSignal.Wait(true, NumWorkerThreads);
-        if (SignaledValue < 0)
-            return;
-
-        pDeferredCtx->Begin(0);
-
-        // Render current subset using the deferred context
-        pThis->RenderSubset(pDeferredCtx, 1 + ThreadNum);
-
-        // Finish command list
-        RefCntAutoPtr<ICommandList> pCmdList;
-        pDeferredCtx->FinishCommandList(&pCmdList);
-        pThis->m_CmdLists[ThreadNum] = pCmdList;
-
-        {
-            // Atomically increment the number of completed threads
-            const int NumThreadsCompleted = pThis->m_NumThreadsCompleted.fetch_add(1) + 1;
-            if (NumThreadsCompleted == NumWorkerThreads)
-                pThis->m_ExecuteCommandListsSignal.Trigger();
-        }
-
-        pThis->m_GotoNextFrameSignal.Wait(true, NumWorkerThreads);
-
-        // Call FinishFrame() to release dynamic resources allocated by deferred contexts
-        // IMPORTANT: we must wait until the command lists are submitted for execution
-        //            because FinishFrame() invalidates all dynamic resources.
-        // IMPORTANT: In Metal backend FinishFrame must be called from the same
-        //            thread that issued rendering commands.
-        pDeferredCtx->FinishFrame();
-
-        pThis->m_NumThreadsReady.fetch_add(1);
-        // We must wait until all threads reach this point, because
-        // m_GotoNextFrameSignal must be unsignaled before we proceed to
-        // RenderSubsetSignal to avoid one thread going through the loop twice in
-        // a row.
-        while (pThis->m_NumThreadsReady.load() < NumWorkerThreads)
-            std::this_thread::yield();
-        VERIFY_EXPR(!pThis->m_GotoNextFrameSignal.IsTriggered());
-    }
+    std::vector<IDeviceContext*> ppDeferredCtx(NumThreads);
+    for (Uint32 t = 0; t < NumThreads; ++t)
+        ppDeferredCtx[t] = m_pDeferredContexts[t];
+    m_pJobScheduler.reset(new RenderJobScheduler{m_pImmediateContext, ppDeferredCtx.data(), NumThreads});
 }
 
-void Tutorial06_Multithreading::RenderSubset(IDeviceContext* pCtx, Uint32 Subset)
+void Tutorial06_Multithreading::RenderInstances(IDeviceContext* pCtx, Uint32 StartInst, Uint32 EndInst)
 {
     // Deferred contexts start in default state. We must bind everything to the context.
     // Render targets are set and transitioned to correct states by the main thread, here we only verify the states.
@@ -313,10 +308,20 @@ void Tutorial06_Multithreading::RenderSubset(IDeviceContext* pCtx, Uint32 Subset
         CBConstants[1] = m_RotationMatrix;
     }
 
+    // Bind index buffer. This must be done for every context
+    pCtx->SetIndexBuffer(m_CubeIndexBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    if (m_RenderMode == RENDER_MODE_INSTANCED)
+        DrawInstanced(pCtx, StartInst, EndInst);
+    else
+        DrawPerInstance(pCtx, StartInst, EndInst);
+}
+
+void Tutorial06_Multithreading::DrawPerInstance(IDeviceContext* pCtx, Uint32 StartInst, Uint32 EndInst)
+{
     // Bind vertex and index buffers. This must be done for every context
     IBuffer* pBuffs[] = {m_CubeVertexBuffer};
     pCtx->SetVertexBuffers(0, _countof(pBuffs), pBuffs, nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY, SET_VERTEX_BUFFERS_FLAG_RESET);
-    pCtx->SetIndexBuffer(m_CubeIndexBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
     DrawIndexedAttribs DrawAttrs;     // This is an indexed draw call
     DrawAttrs.IndexType  = VT_UINT32; // Index type
@@ -325,11 +330,6 @@ void Tutorial06_Multithreading::RenderSubset(IDeviceContext* pCtx, Uint32 Subset
 
     // Set the pipeline state
     pCtx->SetPipelineState(m_pPSO);
-    Uint32 NumSubsets   = Uint32{1} + static_cast<Uint32>(m_WorkerThreads.size());
-    Uint32 NumInstances = static_cast<Uint32>(m_Instances.size());
-    Uint32 SusbsetSize  = NumInstances / NumSubsets;
-    Uint32 StartInst    = SusbsetSize * Subset;
-    Uint32 EndInst      = (Subset < NumSubsets - 1) ? SusbsetSize * (Subset + 1) : NumInstances;
     for (size_t inst = StartInst; inst < EndInst; ++inst)
     {
         const InstanceData& CurrInstData = m_Instances[inst];
@@ -355,6 +355,60 @@ void Tutorial06_Multithreading::RenderSubset(IDeviceContext* pCtx, Uint32 Subset
     }
 }
 
+void Tutorial06_Multithreading::DrawInstanced(IDeviceContext* pCtx, Uint32 StartInst, Uint32 EndInst)
+{
+    DrawIndexedAttribs DrawAttrs;
+    DrawAttrs.IndexType  = VT_UINT32;
+    DrawAttrs.NumIndices = 36;
+    DrawAttrs.Flags      = DRAW_FLAG_VERIFY_ALL;
+
+    pCtx->SetPipelineState(m_pInstancedPSO);
+    for (Uint32 BatchStart = StartInst; BatchStart < EndInst; BatchStart += MaxInstancesPerMap)
+    {
+        const Uint32 BatchEnd = std::min(BatchStart + MaxInstancesPerMap, EndInst);
+
+        // Group the instances by texture using counting sort
+        Uint32 GroupStart[NumTextures + 1] = {};
+        for (Uint32 inst = BatchStart; inst < BatchEnd; ++inst)
+            ++GroupStart[m_Instances[inst].TextureInd + 1];
+        for (int tex = 0; tex < NumTextures; ++tex)
+            GroupStart[tex + 1] += GroupStart[tex];
+
+        {
+            MapHelper<float4x4> InstData(pCtx, m_InstanceBuffer, MAP_WRITE, MAP_FLAG_DISCARD);
+            if (InstData == nullptr)
+            {
+                LOG_ERROR_MESSAGE("Failed to map instance data buffer");
+                break;
+            }
+
+            Uint32 GroupOffset[NumTextures];
+            std::copy(GroupStart, GroupStart + NumTextures, GroupOffset);
+            for (Uint32 inst = BatchStart; inst < BatchEnd; ++inst)
+            {
+                const InstanceData& CurrInstData                = m_Instances[inst];
+                InstData[GroupOffset[CurrInstData.TextureInd]++] = CurrInstData.Matrix;
+            }
+        }
+
+        for (int tex = 0; tex < NumTextures; ++tex)
+        {
+            const Uint32 NumInstances = GroupStart[tex + 1] - GroupStart[tex];
+            if (NumInstances == 0)
+                continue;
+
+            // Use buffer offset rather than the first instance location that is not supported on all devices
+            IBuffer*     pBuffs[]  = {m_CubeVertexBuffer, m_InstanceBuffer};
+            const Uint64 Offsets[] = {0, Uint64{GroupStart[tex]} * sizeof(float4x4)};
+            pCtx->SetVertexBuffers(0, _countof(pBuffs), pBuffs, Offsets, RESOURCE_STATE_TRANSITION_MODE_VERIFY, SET_VERTEX_BUFFERS_FLAG_RESET);
+            pCtx->CommitShaderResources(m_InstancedSRB[tex], RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+            DrawAttrs.NumInstances = NumInstances;
+            pCtx->DrawIndexed(DrawAttrs);
+        }
+    }
+}
+
 // Render a frame
 void Tutorial06_Multithreading::Render()
 {
@@ -370,35 +424,14 @@ void Tutorial06_Multithreading::Render()
     m_pImmediateContext->ClearRenderTarget(pRTV, ClearColor.Data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
     m_pImmediateContext->ClearDepthStencil(pDSV, CLEAR_DEPTH_FLAG, 1.f, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
 
-    if (!m_WorkerThreads.empty())
-    {
-        m_NumThreadsCompleted.store(0);
-        m_RenderSubsetSignal.Trigger(true);
-    }
-
-    RenderSubset(m_pImmediateContext, 0);
-
-    if (!m_WorkerThreads.empty())
-    {
-        m_ExecuteCommandListsSignal.Wait(true, 1);
-
-        m_CmdListPtrs.resize(m_CmdLists.size());
-        for (Uint32 i = 0; i < m_CmdLists.size(); ++i)
-            m_CmdListPtrs[i] = m_CmdLists[i];
-
-        m_pImmediateContext->ExecuteCommandLists(static_cast<Uint32>(m_CmdListPtrs.size()), m_CmdListPtrs.data());
-
-        for (auto& cmdList : m_CmdLists)
-        {
-            // Release command lists now to release all outstanding references.
-            // In d3d11 mode, command lists hold references to the swap chain's back buffer
-            // that cause swap chain resize to fail.
-            cmdList.Release();
-        }
-
-        m_NumThreadsReady.store(0);
-        m_GotoNextFrameSignal.Trigger(true);
-    }
+    // Every instance is a separate draw call; chunks of at least 64 keep the number of command lists low
+    RenderJobScheduler::JobInfo Job;
+    Job.NumItems     = static_cast<Uint32>(m_Instances.size());
+    Job.MinChunkSize = 64;
+    Job.RecordChunk  = [this](IDeviceContext* pCtx, Uint32 CtxIndex, Uint32 StartInst, Uint32 EndInst) {
+        RenderInstances(pCtx, StartInst, EndInst);
+    };
+    m_pJobScheduler->Execute(Job);
 }
 
 void Tutorial06_Multithreading::Update(double CurrTime, double ElapsedTime, bool DoUpdateUI)
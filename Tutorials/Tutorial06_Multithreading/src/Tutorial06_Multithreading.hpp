@@ -27,13 +27,11 @@
 
 #pragma once
 
-#include <atomic>
+#include <memory>
 #include <vector>
-#include <thread>
-#include <mutex>
 #include "SampleBase.hpp"
 #include "BasicMath.hpp"
-#include "ThreadSignal.hpp"
+#include "RenderJobScheduler.hpp"
 
 namespace Diligent
 {
@@ -42,7 +40,8 @@ class Tutorial06_Multithreading final : public SampleBase
 {
 public:
     ~Tutorial06_Multithreading() override;
-    virtual void ModifyEngineInitInfo(const ModifyEngineInitInfoAttribs& Attribs) override final;
+    virtual CommandLineStatus ProcessCommandLine(int argc, const char* const* argv) override final;
+    virtual void              ModifyEngineInitInfo(const ModifyEngineInitInfoAttribs& Attribs) override final;
     virtual void Initialize(const SampleInitInfo& InitInfo) override final;
 
     virtual void Render() override final;
@@ -58,32 +57,42 @@ private:
     void LoadTextures(std::vector<StateTransitionDesc>& Barriers);
     void PopulateInstanceData();
 
-    void StartWorkerThreads(size_t NumThreads);
-    void StopWorkerThreads();
+    void CreateJobScheduler(Uint32 NumThreads);
 
-    void RenderSubset(IDeviceContext* pCtx, Uint32 Subset);
+    void RenderInstances(IDeviceContext* pCtx, Uint32 StartInst, Uint32 EndInst);
+    void DrawPerInstance(IDeviceContext* pCtx, Uint32 StartInst, Uint32 EndInst);
+    void DrawInstanced(IDeviceContext* pCtx, Uint32 StartInst, Uint32 EndInst);
 
-    static void WorkerThreadFunc(Tutorial06_Multithreading* pThis, Uint32 ThreadNum);
+    std::unique_ptr<RenderJobScheduler> m_pJobScheduler;
 
-    Threading::Signal        m_RenderSubsetSignal;
-    Threading::Signal        m_ExecuteCommandListsSignal;
-    Threading::Signal        m_GotoNextFrameSignal;
-    std::atomic_int          m_NumThreadsCompleted;
-    std::atomic_int          m_NumThreadsReady;
-    std::vector<std::thread> m_WorkerThreads;
+    enum RENDER_MODE : int
+    {
+        // One draw call and one constant buffer update per cube
+        RENDER_MODE_DRAW_PER_INSTANCE = 0,
+
+        // Instance matrices are written to a dynamic vertex buffer, and cubes
+        // with the same texture are drawn with one instanced draw call
+        RENDER_MODE_INSTANCED,
 
-    std::vector<RefCntAutoPtr<ICommandList>> m_CmdLists;
-    std::vector<ICommandList*>               m_CmdListPtrs;
+        RENDER_MODE_COUNT
+    };
+    int m_RenderMode = RENDER_MODE_DRAW_PER_INSTANCE;
 
     RefCntAutoPtr<IPipelineState> m_pPSO;
+    RefCntAutoPtr<IPipelineState> m_pInstancedPSO;
     RefCntAutoPtr<IBuffer>        m_CubeVertexBuffer;
     RefCntAutoPtr<IBuffer>        m_CubeIndexBuffer;
     RefCntAutoPtr<IBuffer>        m_InstanceConstants;
+    RefCntAutoPtr<IBuffer>        m_InstanceBuffer;
     RefCntAutoPtr<IBuffer>        m_VSConstants;
 
     static constexpr int NumTextures = 4;
 
+    // The maximum number of instances written to the instance buffer with one map
+    static constexpr Uint32 MaxInstancesPerMap = 1024;
+
     RefCntAutoPtr<IShaderResourceBinding> m_SRB[NumTextures];
+    RefCntAutoPtr<IShaderResourceBinding> m_InstancedSRB[NumTextures];
     RefCntAutoPtr<ITextureView>           m_TextureSRV[NumTextures];
 
     float4x4 m_ViewProjMatrix;
@@ -31,6 +31,7 @@
 #include <algorithm>
 #include <limits>
 #include <cstdlib>
+#include <thread>
 
 #include "Tutorial09_Quads.hpp"
 #include "MapHelper.hpp"
@@ -51,7 +52,7 @@ SampleBase* CreateSample()
 
 Tutorial09_Quads::~Tutorial09_Quads()
 {
-    StopWorkerThreads();
+    m_pJobScheduler.reset();
 }
 
 Tutorial09_Quads::CommandLineStatus Tutorial09_Quads::ProcessCommandLine(int argc, const char* const* argv)
@@ -69,6 +70,7 @@ Tutorial09_Quads::CommandLineStatus Tutorial09_Quads::ProcessCommandLine(int arg
     {
         m_NumWorkerThreads = clamp(m_NumWorkerThreads, 0, 128);
     }
+    ArgsParser.Parse("indirect", 'i', m_bUseIndirect);
 
     return CommandLineStatus::OK;
 }
@@ -352,15 +354,20 @@ void Tutorial09_Quads::UpdateUI()
         {
             m_BatchSize = clamp(m_BatchSize, 1, MaxBatchSize);
             CreateInstanceBuffer();
+            InitializeIndirectDraws();
         }
         {
             ImGui::ScopedDisabler Disable(m_MaxThreads == 0);
             if (ImGui::SliderInt("Worker Threads", &m_NumWorkerThreads, 0, m_MaxThreads))
             {
-                StopWorkerThreads();
-                StartWorkerThreads(m_NumWorkerThreads);
+                CreateJobScheduler(static_cast<Uint32>(m_NumWorkerThreads));
             }
         }
+        if (m_IndirectSupported)
+        {
+            ImGui::Checkbox("Multi-draw indirect", &m_bUseIndirect);
+        }
+        ImGui::Text("Draw calls: %u", m_NumDrawCalls);
     }
     ImGui::End();
 }
@@ -373,6 +380,15 @@ void Tutorial09_Quads::Initialize(const SampleInitInfo& InitInfo)
     m_MaxThreads       = static_cast<int>(m_pDeferredContexts.size());
     m_NumWorkerThreads = std::min(m_NumWorkerThreads, m_MaxThreads);
 
+    // Indirect draws rely on the first instance location, which is not available in OpenGL and WebGPU
+    const RenderDeviceInfo& DeviceInfo = m_pDevice->GetDeviceInfo();
+    m_IndirectSupported                = DeviceInfo.Features.IndirectRendering &&
+        (DeviceInfo.Type == RENDER_DEVICE_TYPE_D3D11 ||
+         DeviceInfo.Type == RENDER_DEVICE_TYPE_D3D12 ||
+         DeviceInfo.Type == RENDER_DEVICE_TYPE_VULKAN ||
+         DeviceInfo.Type == RENDER_DEVICE_TYPE_METAL);
+    m_bUseIndirect = m_bUseIndirect && m_IndirectSupported;
+
     std::vector<StateTransitionDesc> Barriers;
     CreatePipelineStates(Barriers);
     LoadTextures(Barriers);
@@ -383,12 +399,13 @@ void Tutorial09_Quads::Initialize(const SampleInitInfo& InitInfo)
     if (m_BatchSize > 1)
         CreateInstanceBuffer();
 
-    StartWorkerThreads(m_NumWorkerThreads);
+    CreateJobScheduler(static_cast<Uint32>(m_NumWorkerThreads));
 }
 
 void Tutorial09_Quads::InitializeQuads()
 {
     m_Quads.resize(m_NumQuads);
+    m_QuadMotion.Resize(m_NumQuads);
 
     std::mt19937 gen; // Standard mersenne_twister_engine. Use default seed
                       // to generate consistent distribution.
@@ -405,122 +422,90 @@ void Tutorial09_Quads::InitializeQuads()
     {
         QuadData& CurrInst = m_Quads[quad];
         CurrInst.Size      = scale_distr(gen);
-        CurrInst.Angle     = angle_distr(gen);
-        CurrInst.Pos.x     = pos_distr(gen);
-        CurrInst.Pos.y     = pos_distr(gen);
-        CurrInst.MoveDir.x = move_dir_distr(gen);
-        CurrInst.MoveDir.y = move_dir_distr(gen);
-        CurrInst.RotSpeed  = rot_distr(gen);
+
+        // Braced initializers are evaluated left to right, which keeps the random sequence unchanged
+        const float  Angle    = angle_distr(gen);
+        const float2 Pos      = {pos_distr(gen), pos_distr(gen)};
+        const float2 MoveDir  = {move_dir_distr(gen), move_dir_distr(gen)};
+        const float  RotSpeed = rot_distr(gen);
+        m_QuadMotion.SetSprite(quad, Pos, MoveDir, Angle, RotSpeed);
+
         // Texture array index
         CurrInst.TextureInd = tex_distr(gen);
         CurrInst.StateInd   = state_distr(gen);
     }
+
+    InitializeIndirectDraws();
 }
 
-void Tutorial09_Quads::UpdateQuads(float elapsedTime)
+void Tutorial09_Quads::InitializeIndirectDraws()
 {
-    std::mt19937 gen; // Standard mersenne_twister_engine. Use default seed
-                      // to generate consistent distribution.
+    if (!m_IndirectSupported)
+        return;
 
-    std::uniform_real_distribution<float> rot_distr(-PI_F * 0.5f, +PI_F * 0.5f);
-    for (int quad = 0; quad < m_NumQuads; ++quad)
-    {
-        QuadData& CurrInst = m_Quads[quad];
-        CurrInst.Angle += CurrInst.RotSpeed * elapsedTime;
-        if (std::abs(CurrInst.Pos.x + CurrInst.MoveDir.x * elapsedTime) > 0.95)
-        {
-            CurrInst.MoveDir.x *= -1.f;
-            CurrInst.RotSpeed = rot_distr(gen);
-        }
-        CurrInst.Pos.x += CurrInst.MoveDir.x * elapsedTime;
-        if (std::abs(CurrInst.Pos.y + CurrInst.MoveDir.y * elapsedTime) > 0.95)
-        {
-            CurrInst.MoveDir.y *= -1.f;
-            CurrInst.RotSpeed = rot_distr(gen);
-        }
-        CurrInst.Pos.y += CurrInst.MoveDir.y * elapsedTime;
-    }
-}
+    const Uint32 NumQuads   = static_cast<Uint32>(m_Quads.size());
+    const Uint32 NumBatches = (NumQuads + m_BatchSize - 1) / m_BatchSize;
 
-void Tutorial09_Quads::StartWorkerThreads(size_t NumThreads)
-{
-    m_WorkerThreads.resize(NumThreads);
-    for (Uint32 t = 0; t < m_WorkerThreads.size(); ++t)
-    {
-        m_WorkerThreads[t] = std::thread(WorkerThreadFunc, this, t);
-    }
-    m_CmdLists.resize(NumThreads);
+    // Counting sort of the batches by blend state, so that every state is drawn with one indirect call
+    Uint32 StateCounts[NumStates] = {};
+    for (Uint32 batch = 0; batch < NumBatches; ++batch)
+        ++StateCounts[m_Quads[batch * m_BatchSize].StateInd];
+
+    m_StateFirstArg[0] = 0;
+    for (int state = 0; state < NumStates; ++state)
+        m_StateFirstArg[state + 1] = m_StateFirstArg[state] + StateCounts[state];
+
+    Uint32 NextSlot[NumStates];
+    std::copy(m_StateFirstArg, m_StateFirstArg + NumStates, NextSlot);
+    m_BatchArgSlot.resize(NumBatches);
+    for (Uint32 batch = 0; batch < NumBatches; ++batch)
+        m_BatchArgSlot[batch] = NextSlot[m_Quads[batch * m_BatchSize].StateInd]++;
+
+    m_IndirectInstances.resize(NumQuads);
+    m_IndirectArgs.resize(NumBatches);
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name      = "Indirect instance buffer";
+    BuffDesc.Usage     = USAGE_DEFAULT;
+    BuffDesc.BindFlags = BIND_VERTEX_BUFFER;
+    BuffDesc.Size      = sizeof(InstanceData) * NumQuads;
+    m_IndirectInstanceBuffer.Release();
+    m_pDevice->CreateBuffer(BuffDesc, nullptr, &m_IndirectInstanceBuffer);
+
+    BuffDesc.Name      = "Indirect draw args buffer";
+    BuffDesc.BindFlags = BIND_INDIRECT_DRAW_ARGS;
+    BuffDesc.Size      = sizeof(DrawArgs) * NumBatches;
+    m_IndirectArgsBuffer.Release();
+    m_pDevice->CreateBuffer(BuffDesc, nullptr, &m_IndirectArgsBuffer);
 }
 
-void Tutorial09_Quads::StopWorkerThreads()
+void Tutorial09_Quads::UpdateQuads(float elapsedTime)
 {
-    m_RenderSubsetSignal.Trigger(true, -1);
-
-    for (std::thread& thread : m_WorkerThreads)
-    {
-        thread.join();
-    }
-    m_RenderSubsetSignal.Reset();
-    m_WorkerThreads.clear();
-    m_CmdLists.clear();
+    SpriteMotionSoA::UpdateAttribs Attribs;
+    Attribs.ElapsedTime = elapsedTime;
+    Attribs.Seed        = m_FrameIndex++;
+
+    RenderJobScheduler::TaskInfo Task;
+    Task.NumItems     = m_QuadMotion.GetNumSprites();
+    Task.MinChunkSize = 1024;
+    Task.Process      = [&](Uint32 FirstItem, Uint32 EndItem) {
+        m_QuadMotion.Update(FirstItem, EndItem, Attribs);
+    };
+    m_pJobScheduler->ParallelFor(Task);
 }
 
-void Tutorial09_Quads::WorkerThreadFunc(Tutorial09_Quads* pThis, Uint32 ThreadNum)
+void Tutorial09_Quads::CreateJobScheduler(Uint32 NumThreads)
 {
-    // Every thread should use its own deferred context
-    IDeviceContext* pDeferredCtx = pThis->m_pDeferredContexts[ThreadNum];
-
-    const int NumWorkerThreads = static_cast<int>(pThis->m_WorkerThreads.size());
-    VERIFY_EXPR(NumWorkerThreads > 0);
-    for (;;)
-    {
-        // Wait for the signal
-        int SignaledValue = pThis->m_RenderSubsetSignal.Wait(true, NumWorkerThreads);
-        if (SignaledValue < 0)
-            return;
+    m_pJobScheduler.reset();
 
-        pDeferredCtx->Begin(0);
-
-        // Render current subset using the deferred context
-        if (pThis->m_BatchSize > 1)
-            pThis->RenderSubset<true>(pDeferredCtx, 1 + ThreadNum);
-        else
-            pThis->RenderSubset<false>(pDeferredCtx, 1 + ThreadNum);
-
-        // Finish command list
-        RefCntAutoPtr<ICommandList> pCmdList;
-        pDeferredCtx->FinishCommandList(&pCmdList);
-        pThis->m_CmdLists[ThreadNum] = pCmdList;
-
-        {
-            // Atomically increment the number of completed threads
-            const int NumThreadsCompleted = pThis->m_NumThreadsCompleted.fetch_add(1) + 1;
-            if (NumThreadsCompleted == NumWorkerThreads)
-                pThis->m_ExecuteCommandListsSignal.Trigger();
-        }
-
-        pThis->m_GotoNextFrameSignal.Wait(true, NumWorkerThreads);
-
-        // Call FinishFrame() to release dynamic resources allocated by deferred contexts
-        // IMPORTANT: we must wait until the command lists are submitted for execution
-        //            because FinishFrame() invalidates all dynamic resources.
-        // IMPORTANT: In Metal backend FinishFrame must be called from the same
-        //            thread that issued rendering commands.
-        pDeferredCtx->FinishFrame();
-
-        pThis->m_NumThreadsReady.fetch_add(1);
-        // We must wait until all threads reach this point, because
-        // m_GotoNextFrameSignal must be unsignaled before we proceed to
-        // RenderSubsetSignal to avoid one thread go through the loop twice in
-        // a row
-        while (pThis->m_NumThreadsReady.load() < NumWorkerThreads)
-            std::this_thread::yield();
-        VERIFY_EXPR(!pThis->m_GotoNextFrameSignal.IsTriggered());
-    }
+    std::vector<IDeviceContext*> ppDeferredCtx(NumThreads);
+    for (Uint32 t = 0; t < NumThreads; ++t)
+        ppDeferredCtx[t] = m_pDeferredContexts[t];
+    m_pJobScheduler.reset(new RenderJobScheduler{m_pImmediateContext, ppDeferredCtx.data(), NumThreads});
 }
 
 template <bool UseBatch>
-void Tutorial09_Quads::RenderSubset(IDeviceContext* pCtx, Uint32 Subset)
+void Tutorial09_Quads::RenderBatches(IDeviceContext* pCtx, Uint32 CtxIndex, Uint32 StartBatch, Uint32 EndBatch)
 {
     // Deferred contexts start in default state. We must bind everything to the context
     // Render targets are set and transitioned to correct states by the main thread, here we only verify states
@@ -536,12 +521,6 @@ void Tutorial09_Quads::RenderSubset(IDeviceContext* pCtx, Uint32 Subset)
     DrawAttrs.Flags       = DRAW_FLAG_VERIFY_ALL;
     DrawAttrs.NumVertices = 4;
 
-    Uint32       NumSubsets   = Uint32{1} + static_cast<Uint32>(m_WorkerThreads.size());
-    const Uint32 TotalQuads   = static_cast<Uint32>(m_Quads.size());
-    const Uint32 TotalBatches = (TotalQuads + m_BatchSize - 1) / m_BatchSize;
-    const Uint32 SusbsetSize  = TotalBatches / NumSubsets;
-    const Uint32 StartBatch   = SusbsetSize * Subset;
-    const Uint32 EndBatch     = (Subset < NumSubsets - 1) ? SusbsetSize * (Subset + 1) : TotalBatches;
     for (Uint32 batch = StartBatch; batch < EndBatch; ++batch)
     {
         const Uint32 StartInst = batch * m_BatchSize;
@@ -577,8 +556,8 @@ void Tutorial09_Quads::RenderSubset(IDeviceContext* pCtx, Uint32 Subset)
                     0.f,               CurrInstData.Size
                 };
                 // clang-format on
-                float    sinAngle = sinf(CurrInstData.Angle);
-                float    cosAngle = cosf(CurrInstData.Angle);
+                float    sinAngle = sinf(m_QuadMotion.GetAngle(inst));
+                float    cosAngle = cosf(m_QuadMotion.GetAngle(inst));
                 float2x2 RotMatr(cosAngle, -sinAngle,
                                  sinAngle, cosAngle);
                 float2x2 Matr = ScaleMatr * RotMatr;
@@ -589,7 +568,7 @@ void Tutorial09_Quads::RenderSubset(IDeviceContext* pCtx, Uint32 Subset)
                 {
                     InstanceData& CurrQuad        = BatchData[inst - StartInst];
                     CurrQuad.QuadRotationAndScale = QuadRotationAndScale;
-                    CurrQuad.QuadCenter           = CurrInstData.Pos;
+                    CurrQuad.QuadCenter           = m_QuadMotion.GetPos(inst);
                     CurrQuad.TexArrInd            = static_cast<float>(CurrInstData.TextureInd);
                 }
                 else
@@ -604,8 +583,8 @@ void Tutorial09_Quads::RenderSubset(IDeviceContext* pCtx, Uint32 Subset)
                     MapHelper<QuadAttribs> InstData(pCtx, m_QuadAttribsCB, MAP_WRITE, MAP_FLAG_DISCARD);
 
                     InstData->g_QuadRotationAndScale = QuadRotationAndScale;
-                    InstData->g_QuadCenter.x         = CurrInstData.Pos.x;
-                    InstData->g_QuadCenter.y         = CurrInstData.Pos.y;
+                    InstData->g_QuadCenter.x         = m_QuadMotion.GetPos(inst).x;
+                    InstData->g_QuadCenter.y         = m_QuadMotion.GetPos(inst).y;
                 }
             }
         }
@@ -618,6 +597,95 @@ void Tutorial09_Quads::RenderSubset(IDeviceContext* pCtx, Uint32 Subset)
     }
 }
 
+void Tutorial09_Quads::WriteIndirectBatches(Uint32 StartBatch, Uint32 EndBatch)
+{
+    for (Uint32 batch = StartBatch; batch < EndBatch; ++batch)
+    {
+        const Uint32 StartInst = batch * m_BatchSize;
+        const Uint32 EndInst   = std::min(StartInst + static_cast<Uint32>(m_BatchSize), static_cast<Uint32>(m_NumQuads));
+
+        for (Uint32 inst = StartInst; inst < EndInst; ++inst)
+        {
+            const float Size     = m_Quads[inst].Size;
+            const float sinAngle = sinf(m_QuadMotion.GetAngle(inst));
+            const float cosAngle = cosf(m_QuadMotion.GetAngle(inst));
+
+            // Same as ScaleMatr * RotMatr in RenderBatches()
+            InstanceData& CurrQuad        = m_IndirectInstances[inst];
+            CurrQuad.QuadRotationAndScale = float4{Size * cosAngle, Size * sinAngle, -Size * sinAngle, Size * cosAngle};
+            CurrQuad.QuadCenter           = m_QuadMotion.GetPos(inst);
+            CurrQuad.TexArrInd            = static_cast<float>(m_Quads[inst].TextureInd);
+        }
+
+        DrawArgs& Args     = m_IndirectArgs[m_BatchArgSlot[batch]];
+        Args.NumVertices   = 4;
+        Args.NumInstances  = EndInst - StartInst;
+        Args.StartVertex   = 0;
+        Args.FirstInstance = StartInst;
+    }
+}
+
+void Tutorial09_Quads::RenderIndirect()
+{
+    // Worker threads write instance data and draw arguments for disjoint ranges of batches
+    RenderJobScheduler::TaskInfo Task;
+    Task.NumItems     = static_cast<Uint32>(m_BatchArgSlot.size());
+    Task.MinChunkSize = 64;
+    Task.Process      = [this](Uint32 StartBatch, Uint32 EndBatch) {
+        WriteIndirectBatches(StartBatch, EndBatch);
+    };
+    m_pJobScheduler->ParallelFor(Task);
+
+    IDeviceContext* pCtx = m_pImmediateContext;
+    pCtx->UpdateBuffer(m_IndirectInstanceBuffer, 0, sizeof(InstanceData) * m_IndirectInstances.size(), m_IndirectInstances.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pCtx->UpdateBuffer(m_IndirectArgsBuffer, 0, sizeof(DrawArgs) * m_IndirectArgs.size(), m_IndirectArgs.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    ITextureView* pRTV = m_pSwapChain->GetCurrentBackBufferRTV();
+    pCtx->SetRenderTargets(1, &pRTV, m_pSwapChain->GetDepthBufferDSV(), RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    IBuffer* pBuffs[] = {m_IndirectInstanceBuffer};
+    pCtx->SetVertexBuffers(0, _countof(pBuffs), pBuffs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+    const bool NativeMDI = m_pDevice->GetDeviceInfo().Features.NativeMultiDrawIndirect;
+
+    DrawIndirectAttribs IndirectAttrs;
+    IndirectAttrs.pAttribsBuffer                   = m_IndirectArgsBuffer;
+    IndirectAttrs.DrawArgsStride                   = sizeof(DrawArgs);
+    IndirectAttrs.Flags                            = DRAW_FLAG_VERIFY_ALL;
+    IndirectAttrs.AttribsBufferStateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+
+    m_NumDrawCalls = 0;
+    for (int state = 0; state < NumStates; ++state)
+    {
+        const Uint32 FirstArg = m_StateFirstArg[state];
+        const Uint32 NumArgs  = m_StateFirstArg[state + 1] - FirstArg;
+        if (NumArgs == 0)
+            continue;
+
+        pCtx->SetPipelineState(m_pPSO[1][state]);
+        pCtx->CommitShaderResources(m_BatchSRB, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+        if (NativeMDI)
+        {
+            IndirectAttrs.DrawArgsOffset = Uint64{FirstArg} * sizeof(DrawArgs);
+            IndirectAttrs.DrawCount      = NumArgs;
+            pCtx->DrawIndirect(IndirectAttrs);
+            ++m_NumDrawCalls;
+        }
+        else
+        {
+            // Emulate multi-draw with a loop of single indirect draws
+            IndirectAttrs.DrawCount = 1;
+            for (Uint32 arg = FirstArg; arg < FirstArg + NumArgs; ++arg)
+            {
+                IndirectAttrs.DrawArgsOffset = Uint64{arg} * sizeof(DrawArgs);
+                pCtx->DrawIndirect(IndirectAttrs);
+                ++m_NumDrawCalls;
+            }
+        }
+    }
+}
+
 // Render a frame
 void Tutorial09_Quads::Render()
 {
@@ -633,38 +701,30 @@ void Tutorial09_Quads::Render()
     m_pImmediateContext->ClearRenderTarget(pRTV, ClearColor.Data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
     m_pImmediateContext->ClearDepthStencil(pDSV, CLEAR_DEPTH_FLAG, 1.f, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
 
-    if (!m_WorkerThreads.empty())
+    if (m_bUseIndirect)
     {
-        m_NumThreadsCompleted.store(0);
-        m_RenderSubsetSignal.Trigger(true);
+        RenderIndirect();
+        return;
     }
 
+    // Items are batches of m_BatchSize quads, one draw call per batch
+    RenderJobScheduler::JobInfo Job;
+    Job.NumItems     = (static_cast<Uint32>(m_Quads.size()) + m_BatchSize - 1) / m_BatchSize;
+    Job.MinChunkSize = 16;
     if (m_BatchSize > 1)
-        RenderSubset<true>(m_pImmediateContext, 0);
+    {
+        Job.RecordChunk = [this](IDeviceContext* pCtx, Uint32 CtxIndex, Uint32 StartBatch, Uint32 EndBatch) {
+            RenderBatches<true>(pCtx, CtxIndex, StartBatch, EndBatch);
+        };
+    }
     else
-        RenderSubset<false>(m_pImmediateContext, 0);
-
-    if (!m_WorkerThreads.empty())
     {
-        m_ExecuteCommandListsSignal.Wait(true, 1);
-
-        m_CmdListPtrs.resize(m_CmdLists.size());
-        for (Uint32 i = 0; i < m_CmdLists.size(); ++i)
-            m_CmdListPtrs[i] = m_CmdLists[i];
-
-        m_pImmediateContext->ExecuteCommandLists(static_cast<Uint32>(m_CmdListPtrs.size()), m_CmdListPtrs.data());
-
-        for (auto& cmdList : m_CmdLists)
-        {
-            // Release command lists now to release all outstanding references
-            // In d3d11 mode, command lists hold references to the swap chain's back buffer
-            // that cause swap chain resize to fail
-            cmdList.Release();
-        }
-
-        m_NumThreadsReady.store(0);
-        m_GotoNextFrameSignal.Trigger(true);
+        Job.RecordChunk = [this](IDeviceContext* pCtx, Uint32 CtxIndex, Uint32 StartBatch, Uint32 EndBatch) {
+            RenderBatches<false>(pCtx, CtxIndex, StartBatch, EndBatch);
+        };
     }
+    m_pJobScheduler->Execute(Job);
+    m_NumDrawCalls = Job.NumItems;
 }
 
 void Tutorial09_Quads::CreateInstanceBuffer()
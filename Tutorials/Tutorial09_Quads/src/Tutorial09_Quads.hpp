@@ -27,13 +27,12 @@
 
 #pragma once
 
-#include <atomic>
+#include <memory>
 #include <vector>
-#include <thread>
-#include <mutex>
 #include "SampleBase.hpp"
 #include "BasicMath.hpp"
-#include "ThreadSignal.hpp"
+#include "RenderJobScheduler.hpp"
+#include "SpriteMotionSoA.hpp"
 
 namespace Diligent
 {
@@ -64,23 +63,15 @@ private:
     void InitializeQuads();
     void CreateInstanceBuffer();
     void UpdateQuads(float elapsedTime);
-    void StartWorkerThreads(size_t NumThreads);
-    void StopWorkerThreads();
+    void CreateJobScheduler(Uint32 NumThreads);
     template <bool UseBatch>
-    void RenderSubset(IDeviceContext* pCtx, Uint32 Subset);
+    void RenderBatches(IDeviceContext* pCtx, Uint32 CtxIndex, Uint32 StartBatch, Uint32 EndBatch);
 
-    static void WorkerThreadFunc(Tutorial09_Quads* pThis, Uint32 ThreadNum);
+    void InitializeIndirectDraws();
+    void WriteIndirectBatches(Uint32 StartBatch, Uint32 EndBatch);
+    void RenderIndirect();
 
-    Threading::Signal m_RenderSubsetSignal;
-    Threading::Signal m_ExecuteCommandListsSignal;
-    Threading::Signal m_GotoNextFrameSignal;
-
-    std::atomic_int m_NumThreadsCompleted;
-    std::atomic_int m_NumThreadsReady;
-
-    std::vector<std::thread>                 m_WorkerThreads;
-    std::vector<RefCntAutoPtr<ICommandList>> m_CmdLists;
-    std::vector<ICommandList*>               m_CmdListPtrs;
+    std::unique_ptr<RenderJobScheduler> m_pJobScheduler;
 
     static constexpr int          NumStates = 5;
     RefCntAutoPtr<IPipelineState> m_pPSO[2][NumStates];
@@ -102,24 +93,47 @@ private:
     int m_MaxThreads       = 8;
     int m_NumWorkerThreads = 4;
 
+    // Cold per-instance data that is only read by rendering
     struct QuadData
     {
-        float2 Pos;
-        float2 MoveDir;
-        float  Size       = 0;
-        float  Angle      = 0;
-        float  RotSpeed   = 0;
-        int    TextureInd = 0;
-        int    StateInd   = 0;
+        float Size       = 0;
+        int   TextureInd = 0;
+        int   StateInd   = 0;
     };
     std::vector<QuadData> m_Quads;
 
+    // Hot simulation data is stored as structure of arrays and updated with SIMD
+    SpriteMotionSoA m_QuadMotion;
+    Uint32          m_FrameIndex = 0;
+
     struct InstanceData
     {
         float4 QuadRotationAndScale;
         float2 QuadCenter;
         float  TexArrInd;
     };
+
+    // Multi-draw-indirect mode: worker threads write the instance data of all quads and one set of
+    // draw arguments per batch, and the immediate context issues one indirect draw per blend state.
+    bool m_IndirectSupported = false;
+    bool m_bUseIndirect      = false;
+
+    struct DrawArgs
+    {
+        Uint32 NumVertices   = 0;
+        Uint32 NumInstances  = 0;
+        Uint32 StartVertex   = 0;
+        Uint32 FirstInstance = 0;
+    };
+    RefCntAutoPtr<IBuffer>    m_IndirectInstanceBuffer;
+    RefCntAutoPtr<IBuffer>    m_IndirectArgsBuffer;
+    std::vector<InstanceData> m_IndirectInstances;
+    std::vector<DrawArgs>     m_IndirectArgs;
+    // Draw arguments are sorted by blend state; m_StateFirstArg[s] is the first argument of state s
+    std::vector<Uint32> m_BatchArgSlot;
+    Uint32              m_StateFirstArg[NumStates + 1] = {};
+
+    Uint32 m_NumDrawCalls = 0;
 };
 
 } // namespace Diligent
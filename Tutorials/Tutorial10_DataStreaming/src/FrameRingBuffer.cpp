@@ -0,0 +1,207 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "FrameRingBuffer.hpp"
+
+#include <algorithm>
+
+#include "Align.hpp"
+#include "Errors.hpp"
+
+namespace Diligent
+{
+
+bool FrameRingBuffer::IsSupported(IRenderDevice* pDevice)
+{
+    // Fence waits from worker threads and persistent mapping of unified buffers
+    // are only available in next-gen backends
+    const RENDER_DEVICE_TYPE DeviceType = pDevice->GetDeviceInfo().Type;
+    if (DeviceType != RENDER_DEVICE_TYPE_D3D12 &&
+        DeviceType != RENDER_DEVICE_TYPE_VULKAN &&
+        DeviceType != RENDER_DEVICE_TYPE_METAL)
+        return false;
+
+    const AdapterMemoryInfo& MemInfo = pDevice->GetAdapterInfo().Memory;
+    return MemInfo.UnifiedMemory > 0 && (MemInfo.UnifiedMemoryCPUAccess & CPU_ACCESS_WRITE) != 0;
+}
+
+FrameRingBuffer::FrameRingBuffer(const CreateInfo& CI) :
+    m_pContext{CI.pContext},
+    m_Size{AlignUp(Uint64{CI.Size}, Uint64{BlockAlignment})},
+    m_BlockSize{AlignUp(Uint64{std::max(CI.BlockSize, BlockAlignment)}, Uint64{BlockAlignment})}
+{
+    BufferDesc BuffDesc;
+    BuffDesc.Name           = CI.Name;
+    BuffDesc.Usage          = USAGE_UNIFIED;
+    BuffDesc.BindFlags      = CI.BindFlags;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+    BuffDesc.Size           = m_Size;
+    CI.pDevice->CreateBuffer(BuffDesc, nullptr, &m_pBuffer);
+    if (!m_pBuffer)
+    {
+        LOG_ERROR_MESSAGE("Failed to create ring buffer '", CI.Name, "'.");
+        return;
+    }
+
+    FenceDesc FenceCI;
+    FenceCI.Name = "Ring buffer frame fence";
+    FenceCI.Type = FENCE_TYPE_CPU_WAIT_ONLY;
+    CI.pDevice->CreateFence(FenceCI, &m_pFence);
+
+    // Unified buffers stay mapped for their entire lifetime. The GPU never reads the memory
+    // that is being written because the ring does not overwrite frames in flight.
+    PVoid pData = nullptr;
+    m_pContext->MapBuffer(m_pBuffer, MAP_WRITE, MAP_FLAG_NO_OVERWRITE, pData);
+    m_pData = static_cast<Uint8*>(pData);
+    VERIFY_EXPR(m_pData != nullptr);
+}
+
+FrameRingBuffer::~FrameRingBuffer()
+{
+    if (m_pData != nullptr)
+        m_pContext->UnmapBuffer(m_pBuffer, MAP_WRITE);
+}
+
+Uint32 FrameRingBuffer::Allocate(ThreadBlock& Block, Uint32 Size, Uint32 Alignment)
+{
+    VERIFY(IsPowerOfTwo(Alignment) && Alignment <= BlockAlignment, "Alignment must be a power of two not greater than ", BlockAlignment);
+
+    // Blocks that were obtained in previous frames belong to frames that are already in flight
+    const Uint64 FrameId = m_FrameId.load(std::memory_order_acquire);
+    if (Block.FrameId != FrameId)
+    {
+        Block         = {};
+        Block.FrameId = FrameId;
+    }
+
+    Uint64 Offset = AlignUp(Block.Offset, Uint64{Alignment});
+    if (Offset + Size > Block.End)
+    {
+        // Allocations that are larger than the block size get a block of their own
+        if (!AllocateBlock(std::max(Uint64{Size}, m_BlockSize), Block))
+            return InvalidOffset;
+        Offset = Block.Offset;
+    }
+    Block.Offset = Offset + Size;
+
+    m_BytesStreamed.fetch_add(Size, std::memory_order_relaxed);
+    return static_cast<Uint32>(Offset % m_Size);
+}
+
+bool FrameRingBuffer::AllocateBlock(Uint64 Size, ThreadBlock& Block)
+{
+    Size = AlignUp(Size, Uint64{BlockAlignment});
+    if (Size > m_Size)
+    {
+        LOG_ERROR_MESSAGE("Requested block size (", Size, ") exceeds the ring buffer size (", m_Size, ").");
+        return false;
+    }
+
+    Uint64 Head = m_Head.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        // Blocks never straddle the end of the ring: skip the remainder and start the next lap
+        Uint64       Start      = Head;
+        const Uint64 RingOffset = Start % m_Size;
+        const bool   Wrap       = RingOffset + Size > m_Size;
+        if (Wrap)
+            Start += m_Size - RingOffset;
+        const Uint64 End = Start + Size;
+
+        if (End > m_Tail.load(std::memory_order_acquire) + m_Size)
+        {
+            // The GPU may still be reading the memory at the tail
+            if (!WaitForTail(End - m_Size))
+                return false;
+            Head = m_Head.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        if (m_Head.compare_exchange_weak(Head, End, std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+            if (Wrap)
+                m_NumWraps.fetch_add(1, std::memory_order_relaxed);
+            Block.Offset = Start;
+            Block.End    = End;
+            return true;
+        }
+    }
+}
+
+bool FrameRingBuffer::WaitForTail(Uint64 RequiredTail)
+{
+    m_NumStalls.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> Lock{m_FramesMtx};
+    while (m_Tail.load(std::memory_order_relaxed) < RequiredTail)
+    {
+        if (m_InFlightFrames.empty())
+        {
+            // All memory is used by the current frame
+            LOG_ERROR_MESSAGE("Ring buffer '", m_pBuffer->GetDesc().Name, "' is too small to hold the data of a single frame.");
+            return false;
+        }
+
+        const FrameInfo& Frame = m_InFlightFrames.front();
+        m_pFence->Wait(Frame.FenceValue);
+        m_Tail.store(Frame.Head, std::memory_order_release);
+        m_InFlightFrames.pop_front();
+    }
+    return true;
+}
+
+void FrameRingBuffer::FinishFrame(IDeviceContext* pContext)
+{
+    const Uint64 FenceValue = m_NextFenceValue++;
+    pContext->EnqueueSignal(m_pFence, FenceValue);
+
+    {
+        std::lock_guard<std::mutex> Lock{m_FramesMtx};
+        m_InFlightFrames.push_back({FenceValue, m_Head.load(std::memory_order_relaxed)});
+
+        // Release the memory of all frames that the GPU has finished
+        const Uint64 CompletedValue = m_pFence->GetCompletedValue();
+        while (!m_InFlightFrames.empty() && m_InFlightFrames.front().FenceValue <= CompletedValue)
+        {
+            m_Tail.store(m_InFlightFrames.front().Head, std::memory_order_release);
+            m_InFlightFrames.pop_front();
+        }
+    }
+
+    m_FrameId.fetch_add(1, std::memory_order_release);
+}
+
+FrameRingBuffer::Statistics FrameRingBuffer::GetStatistics() const
+{
+    Statistics Stats;
+    Stats.BytesStreamed = m_BytesStreamed.load(std::memory_order_relaxed);
+    Stats.NumWraps      = m_NumWraps.load(std::memory_order_relaxed);
+    Stats.NumStalls     = m_NumStalls.load(std::memory_order_relaxed);
+    Stats.BytesInFlight = m_Head.load(std::memory_order_relaxed) - m_Tail.load(std::memory_order_relaxed);
+    return Stats;
+}
+
+} // namespace Diligent
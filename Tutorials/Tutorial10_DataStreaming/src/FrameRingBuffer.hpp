@@ -0,0 +1,149 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+#include "RenderDevice.h"
+#include "DeviceContext.h"
+#include "Buffer.h"
+#include "Fence.h"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Ring buffer that is shared by all threads recording commands for the current frame.
+///
+/// \remarks    The buffer is persistently mapped, so the threads write directly to the memory
+///             the GPU reads from. Every thread grabs a block of the ring with a single atomic
+///             operation and then sub-allocates from it without any synchronization.
+///             Memory is reclaimed a whole frame at a time: FinishFrame() signals a fence and
+///             remembers the head of the ring, and once the fence is completed, the tail is moved
+///             to that position. If the ring is full, the allocating thread waits for the oldest
+///             frame in flight.
+class FrameRingBuffer
+{
+public:
+    static constexpr Uint32 InvalidOffset = ~0u;
+
+    /// Every block starts at an offset that is a multiple of this value.
+    static constexpr Uint32 BlockAlignment = 256;
+
+    struct CreateInfo
+    {
+        IRenderDevice*  pDevice   = nullptr;
+        IDeviceContext* pContext  = nullptr;
+        const Char*     Name      = nullptr;
+        BIND_FLAGS      BindFlags = BIND_NONE;
+        Uint32          Size      = 0;
+        Uint32          BlockSize = 64 << 10;
+    };
+
+    /// Per-thread allocation state. Every thread must use its own block.
+    struct ThreadBlock
+    {
+        Uint64 FrameId = ~Uint64{0};
+        Uint64 Offset  = 0;
+        Uint64 End     = 0;
+    };
+
+    struct Statistics
+    {
+        /// Total number of bytes allocated from the ring.
+        Uint64 BytesStreamed = 0;
+
+        /// The number of times the head wrapped around the end of the ring.
+        Uint32 NumWraps = 0;
+
+        /// The number of times a thread had to wait for the GPU to release memory.
+        Uint32 NumStalls = 0;
+
+        /// The number of bytes that may still be used by the GPU.
+        Uint64 BytesInFlight = 0;
+    };
+
+    /// Returns true if the device supports persistently mapped buffers that can be read by the GPU.
+    static bool IsSupported(IRenderDevice* pDevice);
+
+    explicit FrameRingBuffer(const CreateInfo& CI);
+    ~FrameRingBuffer();
+
+    // clang-format off
+    FrameRingBuffer(const FrameRingBuffer&)            = delete;
+    FrameRingBuffer& operator=(const FrameRingBuffer&) = delete;
+    // clang-format on
+
+    /// Allocates Size bytes from the block owned by the calling thread and returns
+    /// the offset of the allocation in the buffer, or InvalidOffset if the allocation failed.
+    Uint32 Allocate(ThreadBlock& Block, Uint32 Size, Uint32 Alignment);
+
+    /// Finishes the current frame. Must be called by the thread that owns the immediate context
+    /// after all commands that use the memory allocated in this frame have been submitted.
+    /// All thread blocks are invalidated.
+    void FinishFrame(IDeviceContext* pContext);
+
+    IBuffer* GetBuffer() const { return m_pBuffer; }
+    void*    GetCPUAddress(Uint32 Offset) const { return m_pData + Offset; }
+
+    Statistics GetStatistics() const;
+
+private:
+    bool AllocateBlock(Uint64 Size, ThreadBlock& Block);
+    bool WaitForTail(Uint64 RequiredTail);
+
+    RefCntAutoPtr<IDeviceContext> m_pContext;
+    RefCntAutoPtr<IBuffer>        m_pBuffer;
+    RefCntAutoPtr<IFence>         m_pFence;
+
+    Uint8*       m_pData = nullptr;
+    const Uint64 m_Size;
+    const Uint64 m_BlockSize;
+
+    // Head and tail are monotonic positions; the offset in the buffer is the position modulo the size
+    std::atomic<Uint64> m_Head{0};
+    std::atomic<Uint64> m_Tail{0};
+    std::atomic<Uint64> m_FrameId{0};
+
+    struct FrameInfo
+    {
+        Uint64 FenceValue = 0;
+        Uint64 Head       = 0;
+    };
+    // Frames that may still be used by the GPU, protected by m_FramesMtx
+    std::deque<FrameInfo> m_InFlightFrames;
+    std::mutex            m_FramesMtx;
+    Uint64                m_NextFenceValue = 1;
+
+    std::atomic<Uint64> m_BytesStreamed{0};
+    std::atomic<Uint32> m_NumWraps{0};
+    std::atomic<Uint32> m_NumStalls{0};
+};
+
+} // namespace Diligent
@@ -31,6 +31,7 @@
 #include <algorithm>
 #include <limits>
 #include <cstdlib>
+#include <thread>
 
 #include "Tutorial10_DataStreaming.hpp"
 #include "MapHelper.hpp"
@@ -131,7 +132,7 @@ SampleBase* CreateSample()
 
 Tutorial10_DataStreaming::~Tutorial10_DataStreaming()
 {
-    StopWorkerThreads();
+    m_pJobScheduler.reset();
 }
 
 Tutorial10_DataStreaming::CommandLineStatus Tutorial10_DataStreaming::ProcessCommandLine(int argc, const char* const* argv)
@@ -149,6 +150,12 @@ Tutorial10_DataStreaming::CommandLineStatus Tutorial10_DataStreaming::ProcessCom
     {
         m_NumWorkerThreads = clamp(m_NumWorkerThreads, 0, 128);
     }
+    ArgsParser.Parse("indirect", 'i', m_bUseIndirect);
+    bool UseAtlas = false;
+    if (ArgsParser.Parse("atlas", 'a', UseAtlas))
+    {
+        m_GeometryMode = UseAtlas ? GEOMETRY_MODE_ATLAS : GEOMETRY_MODE_STREAMING;
+    }
 
     return CommandLineStatus::OK;
 }
@@ -441,20 +448,45 @@ void Tutorial10_DataStreaming::UpdateUI()
         {
             m_BatchSize = clamp(m_BatchSize, 1, MaxBatchSize);
             CreateInstanceBuffer();
+            InitializeIndirectDraws();
         }
         {
             ImGui::ScopedDisabler Disable(m_MaxThreads == 0);
             if (ImGui::SliderInt("Worker Threads", &m_NumWorkerThreads, 0, m_MaxThreads))
             {
-                StopWorkerThreads();
-                StartWorkerThreads(m_NumWorkerThreads);
+                CreateJobScheduler(static_cast<Uint32>(m_NumWorkerThreads));
             }
         }
-        if (m_pDevice->GetDeviceInfo().Type == RENDER_DEVICE_TYPE_D3D12 ||
-            m_pDevice->GetDeviceInfo().Type == RENDER_DEVICE_TYPE_VULKAN)
+        if (m_IndirectSupported)
+        {
+            ImGui::Checkbox("Multi-draw indirect", &m_bUseIndirect);
+        }
+        {
+            // Indirect draws always use the atlas
+            ImGui::ScopedDisabler Disable(m_bUseIndirect);
+            ImGui::Combo("Geometry", &m_GeometryMode, "Streaming\0Atlas\0\0");
+        }
+        if (m_RingVB && m_RingIB)
+        {
+            ImGui::Checkbox("Ring buffer", &m_bUseRingBuffer);
+        }
+        if (!m_bUseRingBuffer &&
+            (m_pDevice->GetDeviceInfo().Type == RENDER_DEVICE_TYPE_D3D12 ||
+             m_pDevice->GetDeviceInfo().Type == RENDER_DEVICE_TYPE_VULKAN))
         {
             ImGui::Checkbox("Persistent map", &m_bAllowPersistentMap);
         }
+        if (m_bUseRingBuffer)
+        {
+            const FrameRingBuffer::Statistics VBStats = m_RingVB->GetStatistics();
+            const FrameRingBuffer::Statistics IBStats = m_RingIB->GetStatistics();
+            ImGui::Text("Streamed: %.1f MB", static_cast<double>(VBStats.BytesStreamed + IBStats.BytesStreamed) / (1 << 20));
+            ImGui::Text("In flight: %.1f KB", static_cast<double>(VBStats.BytesInFlight + IBStats.BytesInFlight) / (1 << 10));
+            ImGui::Text("Wraps: %u, Stalls: %u", VBStats.NumWraps + IBStats.NumWraps, VBStats.NumStalls + IBStats.NumStalls);
+        }
+        ImGui::Text("Geometry: %.1f KB/frame", static_cast<double>(m_LastFrameGeometryBytes) / (1 << 10));
+        ImGui::Text("Instances: %.1f KB/frame", static_cast<double>(m_LastFrameInstanceBytes) / (1 << 10));
+        ImGui::Text("Draw calls: %u", m_NumDrawCalls);
     }
     ImGui::End();
 }
@@ -467,6 +499,15 @@ void Tutorial10_DataStreaming::Initialize(const SampleInitInfo& InitInfo)
     m_MaxThreads       = static_cast<int>(m_pDeferredContexts.size());
     m_NumWorkerThreads = std::min(m_NumWorkerThreads, m_MaxThreads);
 
+    // Indirect draws rely on the first instance location, which is not available in OpenGL and WebGPU
+    const RenderDeviceInfo& DeviceInfo = m_pDevice->GetDeviceInfo();
+    m_IndirectSupported                = DeviceInfo.Features.IndirectRendering &&
+        (DeviceInfo.Type == RENDER_DEVICE_TYPE_D3D11 ||
+         DeviceInfo.Type == RENDER_DEVICE_TYPE_D3D12 ||
+         DeviceInfo.Type == RENDER_DEVICE_TYPE_VULKAN ||
+         DeviceInfo.Type == RENDER_DEVICE_TYPE_METAL);
+    m_bUseIndirect = m_bUseIndirect && m_IndirectSupported;
+
     std::vector<StateTransitionDesc> Barriers;
     CreatePipelineStates(Barriers);
     LoadTextures(Barriers);
@@ -478,7 +519,32 @@ void Tutorial10_DataStreaming::Initialize(const SampleInitInfo& InitInfo)
     Barriers.emplace_back(m_StreamingVB->GetBuffer(), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE);
     Barriers.emplace_back(m_StreamingIB->GetBuffer(), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_INDEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE);
 
+    if (FrameRingBuffer::IsSupported(m_pDevice))
+    {
+        // The rings must hold the data of at least one frame with the maximum number of polygons.
+        // Make them twice as large so that the CPU does not wait for the GPU.
+        FrameRingBuffer::CreateInfo RingCI;
+        RingCI.pDevice  = m_pDevice;
+        RingCI.pContext = m_pImmediateContext;
+
+        RingCI.Name      = "Ring vertex buffer";
+        RingCI.BindFlags = BIND_VERTEX_BUFFER;
+        RingCI.Size      = MaxPolygons * MaxPolygonVerts * Uint32{sizeof(float2)} * 2;
+        m_RingVB         = std::make_unique<FrameRingBuffer>(RingCI);
+
+        RingCI.Name      = "Ring index buffer";
+        RingCI.BindFlags = BIND_INDEX_BUFFER;
+        RingCI.Size      = MaxPolygons * (MaxPolygonVerts - 2) * 3 * Uint32{sizeof(Uint32)} * 2;
+        m_RingIB         = std::make_unique<FrameRingBuffer>(RingCI);
+
+        // Unified buffers are created in a state that allows reading vertex and index data, so no transitions are needed
+        m_RingVBBlocks.resize(1u + InitInfo.NumDeferredCtx);
+        m_RingIBBlocks.resize(1u + InitInfo.NumDeferredCtx);
+        m_bUseRingBuffer = true;
+    }
+
     InitializePolygonGeometry();
+    CreateGeometryAtlas(Barriers);
     InitializePolygons();
 
     m_pImmediateContext->TransitionResourceStates(static_cast<Uint32>(Barriers.size()), Barriers.data());
@@ -486,7 +552,7 @@ void Tutorial10_DataStreaming::Initialize(const SampleInitInfo& InitInfo)
     if (m_BatchSize > 1)
         CreateInstanceBuffer();
 
-    StartWorkerThreads(m_NumWorkerThreads);
+    CreateJobScheduler(static_cast<Uint32>(m_NumWorkerThreads));
 }
 
 void Tutorial10_DataStreaming::InitializePolygonGeometry()
@@ -513,9 +579,47 @@ void Tutorial10_DataStreaming::InitializePolygonGeometry()
     }
 }
 
+void Tutorial10_DataStreaming::CreateGeometryAtlas(std::vector<StateTransitionDesc>& Barriers)
+{
+    // Pack all polygon shapes into one vertex buffer and one index buffer.
+    // Indices are offset by the first vertex of the shape, so draws only need the first index
+    // location and work on devices that do not support base vertex.
+    std::vector<float2> AtlasVerts;
+    std::vector<Uint32> AtlasInds;
+    m_AtlasFirstIndex.assign(m_PolygonGeo.size(), 0);
+    for (Uint32 NumVerts = MinPolygonVerts; NumVerts <= MaxPolygonVerts; ++NumVerts)
+    {
+        const PolygonGeometry& PolygonGeo = m_PolygonGeo[NumVerts];
+        const Uint32           BaseVertex = static_cast<Uint32>(AtlasVerts.size());
+
+        m_AtlasFirstIndex[NumVerts] = static_cast<Uint32>(AtlasInds.size());
+        AtlasVerts.insert(AtlasVerts.end(), PolygonGeo.Verts.begin(), PolygonGeo.Verts.end());
+        for (Uint32 Ind : PolygonGeo.Inds)
+            AtlasInds.push_back(BaseVertex + Ind);
+    }
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name      = "Polygon atlas vertex buffer";
+    BuffDesc.Usage     = USAGE_IMMUTABLE;
+    BuffDesc.BindFlags = BIND_VERTEX_BUFFER;
+    BuffDesc.Size      = AtlasVerts.size() * sizeof(float2);
+    BufferData VBData{AtlasVerts.data(), BuffDesc.Size};
+    m_pDevice->CreateBuffer(BuffDesc, &VBData, &m_AtlasVB);
+
+    BuffDesc.Name      = "Polygon atlas index buffer";
+    BuffDesc.BindFlags = BIND_INDEX_BUFFER;
+    BuffDesc.Size      = AtlasInds.size() * sizeof(Uint32);
+    BufferData IBData{AtlasInds.data(), BuffDesc.Size};
+    m_pDevice->CreateBuffer(BuffDesc, &IBData, &m_AtlasIB);
+
+    Barriers.emplace_back(m_AtlasVB, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE);
+    Barriers.emplace_back(m_AtlasIB, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_INDEX_BUFFER, STATE_TRANSITION_FLAG_UPDATE_STATE);
+}
+
 void Tutorial10_DataStreaming::InitializePolygons()
 {
     m_Polygons.resize(m_NumPolygons);
+    m_PolygonMotion.Resize(m_NumPolygons);
 
     std::mt19937 gen; // Standard mersenne_twister_engine. Use default seed
                       // to generate consistent distribution.
@@ -534,21 +638,79 @@ void Tutorial10_DataStreaming::InitializePolygons()
         PolygonData& CurrInst = m_Polygons[Polygon];
 
         CurrInst.Size      = scale_distr(gen);
-        CurrInst.Angle     = angle_distr(gen);
-        CurrInst.Pos.x     = pos_distr(gen);
-        CurrInst.Pos.y     = pos_distr(gen);
-        CurrInst.MoveDir.x = move_dir_distr(gen);
-        CurrInst.MoveDir.y = move_dir_distr(gen);
-        CurrInst.RotSpeed  = rot_distr(gen);
+
+        // Braced initializers are evaluated left to right, which keeps the random sequence unchanged
+        const float  Angle    = angle_distr(gen);
+        const float2 Pos      = {pos_distr(gen), pos_distr(gen)};
+        const float2 MoveDir  = {move_dir_distr(gen), move_dir_distr(gen)};
+        const float  RotSpeed = rot_distr(gen);
+        m_PolygonMotion.SetSprite(Polygon, Pos, MoveDir, Angle, RotSpeed);
+
         // Texture array index
         CurrInst.TextureInd = tex_distr(gen);
         CurrInst.StateInd   = state_distr(gen);
         CurrInst.NumVerts   = num_verts_distr(gen);
     }
+
+    InitializeIndirectDraws();
+}
+
+void Tutorial10_DataStreaming::InitializeIndirectDraws()
+{
+    if (!m_IndirectSupported)
+        return;
+
+    const Uint32 NumPolygons = static_cast<Uint32>(m_Polygons.size());
+    const Uint32 NumBatches  = (NumPolygons + m_BatchSize - 1) / m_BatchSize;
+
+    // Counting sort of the batches by blend state, so that every state is drawn with one indirect call
+    Uint32 StateCounts[NumStates] = {};
+    for (Uint32 batch = 0; batch < NumBatches; ++batch)
+        ++StateCounts[m_Polygons[batch * m_BatchSize].StateInd];
+
+    m_StateFirstArg[0] = 0;
+    for (int state = 0; state < NumStates; ++state)
+        m_StateFirstArg[state + 1] = m_StateFirstArg[state] + StateCounts[state];
+
+    Uint32 NextSlot[NumStates];
+    std::copy(m_StateFirstArg, m_StateFirstArg + NumStates, NextSlot);
+    m_BatchArgSlot.resize(NumBatches);
+    for (Uint32 batch = 0; batch < NumBatches; ++batch)
+        m_BatchArgSlot[batch] = NextSlot[m_Polygons[batch * m_BatchSize].StateInd]++;
+
+    m_IndirectInstances.resize(NumPolygons);
+    m_IndirectArgs.resize(NumBatches);
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name      = "Indirect instance buffer";
+    BuffDesc.Usage     = USAGE_DEFAULT;
+    BuffDesc.BindFlags = BIND_VERTEX_BUFFER;
+    BuffDesc.Size      = sizeof(InstanceData) * NumPolygons;
+    m_IndirectInstanceBuffer.Release();
+    m_pDevice->CreateBuffer(BuffDesc, nullptr, &m_IndirectInstanceBuffer);
+
+    BuffDesc.Name      = "Indirect draw args buffer";
+    BuffDesc.BindFlags = BIND_INDIRECT_DRAW_ARGS;
+    BuffDesc.Size      = sizeof(DrawIndexedArgs) * NumBatches;
+    m_IndirectArgsBuffer.Release();
+    m_pDevice->CreateBuffer(BuffDesc, nullptr, &m_IndirectArgsBuffer);
 }
 
 std::pair<Diligent::Uint32, Diligent::Uint32> Tutorial10_DataStreaming::WritePolygon(const PolygonGeometry& PolygonGeo, IDeviceContext* pCtx, size_t CtxNum)
 {
+    if (m_bUseRingBuffer)
+    {
+        // Every context sub-allocates from its own block, so no locks are taken here
+        const Uint32 VBOffset = m_RingVB->Allocate(m_RingVBBlocks[CtxNum], static_cast<Uint32>(PolygonGeo.Verts.size() * sizeof(float2)), sizeof(float2));
+        const Uint32 IBOffset = m_RingIB->Allocate(m_RingIBBlocks[CtxNum], static_cast<Uint32>(PolygonGeo.Inds.size() * sizeof(Uint32)), sizeof(Uint32));
+        if (VBOffset == FrameRingBuffer::InvalidOffset || IBOffset == FrameRingBuffer::InvalidOffset)
+            return {FrameRingBuffer::InvalidOffset, FrameRingBuffer::InvalidOffset};
+
+        memcpy(m_RingVB->GetCPUAddress(VBOffset), PolygonGeo.Verts.data(), PolygonGeo.Verts.size() * sizeof(float2));
+        memcpy(m_RingIB->GetCPUAddress(IBOffset), PolygonGeo.Inds.data(), PolygonGeo.Inds.size() * sizeof(Uint32));
+        return {VBOffset, IBOffset};
+    }
+
     // Request memory for vertices and indices
     Uint32  VBOffset   = m_StreamingVB->Allocate(pCtx, static_cast<Uint32>(PolygonGeo.Verts.size()) * sizeof(float2), CtxNum);
     Uint32  IBOffset   = m_StreamingIB->Allocate(pCtx, static_cast<Uint32>(PolygonGeo.Inds.size()) * sizeof(Uint32), CtxNum);
@@ -565,107 +727,31 @@ std::pair<Diligent::Uint32, Diligent::Uint32> Tutorial10_DataStreaming::WritePol
 
 void Tutorial10_DataStreaming::UpdatePolygons(float elapsedTime)
 {
-    std::mt19937 gen; // Standard mersenne_twister_engine. Use default seed
-                      // to generate consistent distribution.
-
-    std::uniform_real_distribution<float> rot_distr(-PI_F * 0.5f, +PI_F * 0.5f);
-    for (int Polygon = 0; Polygon < m_NumPolygons; ++Polygon)
-    {
-        PolygonData& CurrInst = m_Polygons[Polygon];
-        CurrInst.Angle += CurrInst.RotSpeed * elapsedTime;
-        if (std::abs(CurrInst.Pos.x + CurrInst.MoveDir.x * elapsedTime) > 0.95)
-        {
-            CurrInst.MoveDir.x *= -1.f;
-            CurrInst.RotSpeed = rot_distr(gen);
-        }
-        CurrInst.Pos.x += CurrInst.MoveDir.x * elapsedTime;
-        if (std::abs(CurrInst.Pos.y + CurrInst.MoveDir.y * elapsedTime) > 0.95)
-        {
-            CurrInst.MoveDir.y *= -1.f;
-            CurrInst.RotSpeed = rot_distr(gen);
-        }
-        CurrInst.Pos.y += CurrInst.MoveDir.y * elapsedTime;
-    }
-}
-
-void Tutorial10_DataStreaming::StartWorkerThreads(size_t NumThreads)
-{
-    m_WorkerThreads.resize(NumThreads);
-    for (Uint32 t = 0; t < m_WorkerThreads.size(); ++t)
-    {
-        m_WorkerThreads[t] = std::thread(WorkerThreadFunc, this, t);
-    }
-    m_CmdLists.resize(NumThreads);
-}
-
-void Tutorial10_DataStreaming::StopWorkerThreads()
-{
-    m_RenderSubsetSignal.Trigger(true, -1);
-
-    for (std::thread& thread : m_WorkerThreads)
-    {
-        thread.join();
-    }
-    m_RenderSubsetSignal.Reset();
-    m_WorkerThreads.clear();
-    m_CmdLists.clear();
+    SpriteMotionSoA::UpdateAttribs Attribs;
+    Attribs.ElapsedTime = elapsedTime;
+    Attribs.Seed        = m_FrameIndex++;
+
+    RenderJobScheduler::TaskInfo Task;
+    Task.NumItems     = m_PolygonMotion.GetNumSprites();
+    Task.MinChunkSize = 1024;
+    Task.Process      = [&](Uint32 FirstItem, Uint32 EndItem) {
+        m_PolygonMotion.Update(FirstItem, EndItem, Attribs);
+    };
+    m_pJobScheduler->ParallelFor(Task);
 }
 
-void Tutorial10_DataStreaming::WorkerThreadFunc(Tutorial10_DataStreaming* pThis, Uint32 ThreadNum)
+void Tutorial10_DataStreaming::CreateJobScheduler(Uint32 NumThreads)
 {
-    // Every thread should use its own deferred context
-    IDeviceContext* pDeferredCtx     = pThis->m_pDeferredContexts[ThreadNum];
-    const int       NumWorkerThreads = static_cast<int>(pThis->m_WorkerThreads.size());
-    VERIFY_EXPR(NumWorkerThreads > 0);
-    for (;;)
-    {
-        // Wait for the signal
-        int SignaledValue = pThis->m_RenderSubsetSignal.Wait(true, NumWorkerThreads);
-        if (SignaledValue < 0)
-            return;
-
-        pDeferredCtx->Begin(0);
-
-        // Render current subset using the deferred context
-        if (pThis->m_BatchSize > 1)
-            pThis->RenderSubset<true>(pDeferredCtx, 1 + ThreadNum);
-        else
-            pThis->RenderSubset<false>(pDeferredCtx, 1 + ThreadNum);
+    m_pJobScheduler.reset();
 
-        // Finish command list
-        RefCntAutoPtr<ICommandList> pCmdList;
-        pDeferredCtx->FinishCommandList(&pCmdList);
-        pThis->m_CmdLists[ThreadNum] = pCmdList;
-
-        {
-            // Atomically increment the number of completed threads
-            const int NumThreadsCompleted = pThis->m_NumThreadsCompleted.fetch_add(1) + 1;
-            if (NumThreadsCompleted == NumWorkerThreads)
-                pThis->m_ExecuteCommandListsSignal.Trigger();
-        }
-
-        pThis->m_GotoNextFrameSignal.Wait(true, NumWorkerThreads);
-
-        // Call FinishFrame() to release dynamic resources allocated by deferred contexts
-        // IMPORTANT: we must wait until the command lists are submitted for execution
-        //            because FinishFrame() invalidates all dynamic resources.
-        // IMPORTANT: In Metal backend FinishFrame must be called from the same
-        //            thread that issued rendering commands.
-        pDeferredCtx->FinishFrame();
-
-        pThis->m_NumThreadsReady.fetch_add(1);
-        // We must wait until all threads reach this point, because
-        // m_GotoNextFrameSignal must be unsignaled before we proceed to
-        // RenderSubsetSignal to avoid one thread go through the loop twice in
-        // a row
-        while (pThis->m_NumThreadsReady.load() < NumWorkerThreads)
-            std::this_thread::yield();
-        VERIFY_EXPR(!pThis->m_GotoNextFrameSignal.IsTriggered());
-    }
+    std::vector<IDeviceContext*> ppDeferredCtx(NumThreads);
+    for (Uint32 t = 0; t < NumThreads; ++t)
+        ppDeferredCtx[t] = m_pDeferredContexts[t];
+    m_pJobScheduler.reset(new RenderJobScheduler{m_pImmediateContext, ppDeferredCtx.data(), NumThreads});
 }
 
 template <bool UseBatch>
-void Tutorial10_DataStreaming::RenderSubset(IDeviceContext* pCtx, Uint32 Subset)
+void Tutorial10_DataStreaming::RenderBatches(IDeviceContext* pCtx, Uint32 CtxIndex, Uint32 StartBatch, Uint32 EndBatch)
 {
     // Deferred contexts start in default state. We must bind everything to the context
     // Render targets are set and transitioned to correct states by the main thread, here we only verify states
@@ -676,12 +762,12 @@ void Tutorial10_DataStreaming::RenderSubset(IDeviceContext* pCtx, Uint32 Subset)
     DrawAttrs.IndexType = VT_UINT32;
     DrawAttrs.Flags     = DRAW_FLAG_VERIFY_ALL;
 
-    Uint32       NumSubsets    = Uint32{1} + static_cast<Uint32>(m_WorkerThreads.size());
-    const Uint32 TotalPolygons = static_cast<Uint32>(m_Polygons.size());
-    const Uint32 TotalBatches  = (TotalPolygons + m_BatchSize - 1) / m_BatchSize;
-    const Uint32 SusbsetSize   = TotalBatches / NumSubsets;
-    const Uint32 StartBatch    = SusbsetSize * Subset;
-    const Uint32 EndBatch      = (Subset < NumSubsets - 1) ? SusbsetSize * (Subset + 1) : TotalBatches;
+    const bool UseAtlas = m_GeometryMode == GEOMETRY_MODE_ATLAS;
+
+    // Accumulate locally to avoid contention on the atomic counters
+    Uint64 GeometryBytes = 0;
+    Uint64 InstanceBytes = 0;
+
     for (Uint32 batch = StartBatch; batch < EndBatch; ++batch)
     {
         const Uint32 StartInst = batch * m_BatchSize;
@@ -691,13 +777,32 @@ void Tutorial10_DataStreaming::RenderSubset(IDeviceContext* pCtx, Uint32 Subset)
         int StateInd = m_Polygons[StartInst].StateInd;
         pCtx->SetPipelineState(m_pPSO[UseBatch ? 1 : 0][StateInd]);
 
-        const PolygonGeometry& PolygonGeo = m_PolygonGeo[m_Polygons[StartInst].NumVerts];
-        auto                   Offsets    = WritePolygon(PolygonGeo, pCtx, Subset);
-        const Uint64           offsets[]  = {Offsets.first, 0};
-        IBuffer*               pBuffs[]   = {m_StreamingVB->GetBuffer(), m_BatchDataBuffer};
-        pCtx->SetVertexBuffers(0, UseBatch ? 2 : 1, pBuffs, offsets, RESOURCE_STATE_TRANSITION_MODE_VERIFY, SET_VERTEX_BUFFERS_FLAG_RESET);
+        const int              NumVerts   = m_Polygons[StartInst].NumVerts;
+        const PolygonGeometry& PolygonGeo = m_PolygonGeo[NumVerts];
+        if (UseAtlas)
+        {
+            // The geometry is already in GPU memory; only select the shape in the atlas
+            const Uint64 offsets[] = {0, 0};
+            IBuffer*     pBuffs[]  = {m_AtlasVB, m_BatchDataBuffer};
+            pCtx->SetVertexBuffers(0, UseBatch ? 2 : 1, pBuffs, offsets, RESOURCE_STATE_TRANSITION_MODE_VERIFY, SET_VERTEX_BUFFERS_FLAG_RESET);
+            pCtx->SetIndexBuffer(m_AtlasIB, 0, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            DrawAttrs.FirstIndexLocation = m_AtlasFirstIndex[NumVerts];
+        }
+        else
+        {
+            auto Offsets = WritePolygon(PolygonGeo, pCtx, CtxIndex);
+            if (Offsets.first == FrameRingBuffer::InvalidOffset)
+                continue;
 
-        pCtx->SetIndexBuffer(m_StreamingIB->GetBuffer(), Offsets.second, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            const Uint64 offsets[] = {Offsets.first, 0};
+            IBuffer*     pBuffs[]  = {m_bUseRingBuffer ? m_RingVB->GetBuffer() : m_StreamingVB->GetBuffer(), m_BatchDataBuffer};
+            pCtx->SetVertexBuffers(0, UseBatch ? 2 : 1, pBuffs, offsets, RESOURCE_STATE_TRANSITION_MODE_VERIFY, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+            pCtx->SetIndexBuffer(m_bUseRingBuffer ? m_RingIB->GetBuffer() : m_StreamingIB->GetBuffer(), Offsets.second, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+            DrawAttrs.FirstIndexLocation = 0;
+
+            GeometryBytes += PolygonGeo.Verts.size() * sizeof(float2) + PolygonGeo.Inds.size() * sizeof(Uint32);
+        }
 
         MapHelper<InstanceData> BatchData;
         if (UseBatch)
@@ -725,8 +830,8 @@ void Tutorial10_DataStreaming::RenderSubset(IDeviceContext* pCtx, Uint32 Subset)
                     0.f,               CurrInstData.Size
                 };
                 // clang-format on
-                float    sinAngle = sinf(CurrInstData.Angle);
-                float    cosAngle = cosf(CurrInstData.Angle);
+                float    sinAngle = sinf(m_PolygonMotion.GetAngle(inst));
+                float    cosAngle = cosf(m_PolygonMotion.GetAngle(inst));
                 float2x2 RotMatr(cosAngle, -sinAngle,
                                  sinAngle, cosAngle);
                 float2x2 Matr = ScaleMatr * RotMatr;
@@ -737,7 +842,7 @@ void Tutorial10_DataStreaming::RenderSubset(IDeviceContext* pCtx, Uint32 Subset)
                 {
                     InstanceData& CurrPolygon           = BatchData[inst - StartInst];
                     CurrPolygon.PolygonRotationAndScale = PolygonRotationAndScale;
-                    CurrPolygon.PolygonCenter           = CurrInstData.Pos;
+                    CurrPolygon.PolygonCenter           = m_PolygonMotion.GetPos(inst);
                     CurrPolygon.TexArrInd               = static_cast<float>(CurrInstData.TextureInd);
                 }
                 else
@@ -752,22 +857,134 @@ void Tutorial10_DataStreaming::RenderSubset(IDeviceContext* pCtx, Uint32 Subset)
                     MapHelper<PolygonAttribs> InstData(pCtx, m_PolygonAttribsCB, MAP_WRITE, MAP_FLAG_DISCARD);
 
                     InstData->g_PolygonRotationAndScale = PolygonRotationAndScale;
-                    InstData->g_PolygonCenter.x         = CurrInstData.Pos.x;
-                    InstData->g_PolygonCenter.y         = CurrInstData.Pos.y;
+                    InstData->g_PolygonCenter.x         = m_PolygonMotion.GetPos(inst).x;
+                    InstData->g_PolygonCenter.y         = m_PolygonMotion.GetPos(inst).y;
                 }
             }
         }
 
         if (UseBatch)
+        {
             BatchData.Unmap();
+            InstanceBytes += sizeof(InstanceData) * (EndInst - StartInst);
+        }
+        else
+        {
+            InstanceBytes += sizeof(float4) * 2 * (EndInst - StartInst);
+        }
 
         DrawAttrs.NumIndices   = static_cast<Uint32>(PolygonGeo.Inds.size());
         DrawAttrs.NumInstances = EndInst - StartInst;
         pCtx->DrawIndexed(DrawAttrs);
     }
 
-    m_StreamingVB->Flush(Subset);
-    m_StreamingIB->Flush(Subset);
+    if (!m_bUseRingBuffer)
+    {
+        m_StreamingVB->Flush(CtxIndex);
+        m_StreamingIB->Flush(CtxIndex);
+    }
+
+    m_GeometryBytes.fetch_add(GeometryBytes, std::memory_order_relaxed);
+    m_InstanceBytes.fetch_add(InstanceBytes, std::memory_order_relaxed);
+}
+
+void Tutorial10_DataStreaming::WriteIndirectBatches(Uint32 StartBatch, Uint32 EndBatch)
+{
+    for (Uint32 batch = StartBatch; batch < EndBatch; ++batch)
+    {
+        const Uint32 StartInst = batch * m_BatchSize;
+        const Uint32 EndInst   = std::min(StartInst + static_cast<Uint32>(m_BatchSize), static_cast<Uint32>(m_NumPolygons));
+
+        for (Uint32 inst = StartInst; inst < EndInst; ++inst)
+        {
+            const float Size     = m_Polygons[inst].Size;
+            const float sinAngle = sinf(m_PolygonMotion.GetAngle(inst));
+            const float cosAngle = cosf(m_PolygonMotion.GetAngle(inst));
+
+            // Same as ScaleMatr * RotMatr in RenderBatches()
+            InstanceData& CurrPolygon           = m_IndirectInstances[inst];
+            CurrPolygon.PolygonRotationAndScale = float4{Size * cosAngle, Size * sinAngle, -Size * sinAngle, Size * cosAngle};
+            CurrPolygon.PolygonCenter           = m_PolygonMotion.GetPos(inst);
+            CurrPolygon.TexArrInd               = static_cast<float>(m_Polygons[inst].TextureInd);
+        }
+
+        // All polygons in a batch have the same shape
+        const int NumVerts = m_Polygons[StartInst].NumVerts;
+
+        DrawIndexedArgs& Args = m_IndirectArgs[m_BatchArgSlot[batch]];
+        Args.NumIndices       = static_cast<Uint32>(m_PolygonGeo[NumVerts].Inds.size());
+        Args.NumInstances     = EndInst - StartInst;
+        Args.FirstIndex       = m_AtlasFirstIndex[NumVerts];
+        Args.BaseVertex       = 0;
+        Args.FirstInstance    = StartInst;
+    }
+}
+
+void Tutorial10_DataStreaming::RenderIndirect()
+{
+    // Worker threads write instance data and draw arguments for disjoint ranges of batches
+    RenderJobScheduler::TaskInfo Task;
+    Task.NumItems     = static_cast<Uint32>(m_BatchArgSlot.size());
+    Task.MinChunkSize = 64;
+    Task.Process      = [this](Uint32 StartBatch, Uint32 EndBatch) {
+        WriteIndirectBatches(StartBatch, EndBatch);
+    };
+    m_pJobScheduler->ParallelFor(Task);
+
+    IDeviceContext* pCtx = m_pImmediateContext;
+    pCtx->UpdateBuffer(m_IndirectInstanceBuffer, 0, sizeof(InstanceData) * m_IndirectInstances.size(), m_IndirectInstances.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pCtx->UpdateBuffer(m_IndirectArgsBuffer, 0, sizeof(DrawIndexedArgs) * m_IndirectArgs.size(), m_IndirectArgs.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    m_LastFrameGeometryBytes = 0;
+    m_LastFrameInstanceBytes = sizeof(InstanceData) * m_IndirectInstances.size() + sizeof(DrawIndexedArgs) * m_IndirectArgs.size();
+
+    ITextureView* pRTV = m_pSwapChain->GetCurrentBackBufferRTV();
+    pCtx->SetRenderTargets(1, &pRTV, m_pSwapChain->GetDepthBufferDSV(), RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    const Uint64 Offsets[] = {0, 0};
+    IBuffer*     pBuffs[]  = {m_AtlasVB, m_IndirectInstanceBuffer};
+    pCtx->SetVertexBuffers(0, _countof(pBuffs), pBuffs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+    pCtx->SetIndexBuffer(m_AtlasIB, 0, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+    const bool NativeMDI = m_pDevice->GetDeviceInfo().Features.NativeMultiDrawIndirect;
+
+    DrawIndexedIndirectAttribs IndirectAttrs;
+    IndirectAttrs.pAttribsBuffer                   = m_IndirectArgsBuffer;
+    IndirectAttrs.IndexType                        = VT_UINT32;
+    IndirectAttrs.DrawArgsStride                   = sizeof(DrawIndexedArgs);
+    IndirectAttrs.Flags                            = DRAW_FLAG_VERIFY_ALL;
+    IndirectAttrs.AttribsBufferStateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+
+    m_NumDrawCalls = 0;
+    for (int state = 0; state < NumStates; ++state)
+    {
+        const Uint32 FirstArg = m_StateFirstArg[state];
+        const Uint32 NumArgs  = m_StateFirstArg[state + 1] - FirstArg;
+        if (NumArgs == 0)
+            continue;
+
+        pCtx->SetPipelineState(m_pPSO[1][state]);
+        pCtx->CommitShaderResources(m_BatchSRB, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+
+        if (NativeMDI)
+        {
+            IndirectAttrs.DrawArgsOffset = Uint64{FirstArg} * sizeof(DrawIndexedArgs);
+            IndirectAttrs.DrawCount      = NumArgs;
+            pCtx->DrawIndexedIndirect(IndirectAttrs);
+            ++m_NumDrawCalls;
+        }
+        else
+        {
+            // Emulate multi-draw with a loop of single indirect draws
+            IndirectAttrs.DrawCount = 1;
+            for (Uint32 arg = FirstArg; arg < FirstArg + NumArgs; ++arg)
+            {
+                IndirectAttrs.DrawArgsOffset = Uint64{arg} * sizeof(DrawIndexedArgs);
+                pCtx->DrawIndexedIndirect(IndirectAttrs);
+                ++m_NumDrawCalls;
+            }
+        }
+    }
 }
 
 // Render a frame
@@ -785,40 +1002,42 @@ void Tutorial10_DataStreaming::Render()
     m_pImmediateContext->ClearRenderTarget(pRTV, ClearColor.Data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
     m_pImmediateContext->ClearDepthStencil(pDSV, CLEAR_DEPTH_FLAG, 1.f, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
 
+    if (m_bUseIndirect)
+    {
+        RenderIndirect();
+        return;
+    }
+
     m_StreamingIB->AllowPersistentMapping(m_bAllowPersistentMap);
     m_StreamingVB->AllowPersistentMapping(m_bAllowPersistentMap);
 
-    if (!m_WorkerThreads.empty())
+    // Items are batches of m_BatchSize polygons, one draw call per batch
+    RenderJobScheduler::JobInfo Job;
+    Job.NumItems     = (static_cast<Uint32>(m_Polygons.size()) + m_BatchSize - 1) / m_BatchSize;
+    Job.MinChunkSize = 16;
+    if (m_BatchSize > 1)
     {
-        m_NumThreadsCompleted.store(0);
-        m_RenderSubsetSignal.Trigger(true);
+        Job.RecordChunk = [this](IDeviceContext* pCtx, Uint32 CtxIndex, Uint32 StartBatch, Uint32 EndBatch) {
+            RenderBatches<true>(pCtx, CtxIndex, StartBatch, EndBatch);
+        };
     }
-
-    if (m_BatchSize > 1)
-        RenderSubset<true>(m_pImmediateContext, 0);
     else
-        RenderSubset<false>(m_pImmediateContext, 0);
-
-    if (!m_WorkerThreads.empty())
     {
-        m_ExecuteCommandListsSignal.Wait(true, 1);
-
-        m_CmdListPtrs.resize(m_CmdLists.size());
-        for (Uint32 i = 0; i < m_CmdLists.size(); ++i)
-            m_CmdListPtrs[i] = m_CmdLists[i];
-
-        m_pImmediateContext->ExecuteCommandLists(static_cast<Uint32>(m_CmdListPtrs.size()), m_CmdListPtrs.data());
+        Job.RecordChunk = [this](IDeviceContext* pCtx, Uint32 CtxIndex, Uint32 StartBatch, Uint32 EndBatch) {
+            RenderBatches<false>(pCtx, CtxIndex, StartBatch, EndBatch);
+        };
+    }
+    m_pJobScheduler->Execute(Job);
+    m_NumDrawCalls = Job.NumItems;
 
-        for (auto& cmdList : m_CmdLists)
-        {
-            // Release command lists now to release all outstanding references
-            // In d3d11 mode, command lists hold references to the swap chain's back buffer
-            // that cause swap chain resize to fail
-            cmdList.Release();
-        }
+    m_LastFrameGeometryBytes = m_GeometryBytes.exchange(0);
+    m_LastFrameInstanceBytes = m_InstanceBytes.exchange(0);
 
-        m_NumThreadsReady.store(0);
-        m_GotoNextFrameSignal.Trigger(true);
+    if (m_bUseRingBuffer)
+    {
+        // All command lists that reference this frame's data have been submitted
+        m_RingVB->FinishFrame(m_pImmediateContext);
+        m_RingIB->FinishFrame(m_pImmediateContext);
     }
 }
 
@@ -30,11 +30,11 @@
 #include <atomic>
 #include <memory>
 #include <vector>
-#include <thread>
-#include <mutex>
 #include "SampleBase.hpp"
 #include "BasicMath.hpp"
-#include "ThreadSignal.hpp"
+#include "RenderJobScheduler.hpp"
+#include "SpriteMotionSoA.hpp"
+#include "FrameRingBuffer.hpp"
 
 namespace Diligent
 {
@@ -64,27 +64,19 @@ private:
 
     void InitializePolygons();
     void InitializePolygonGeometry();
+    void CreateGeometryAtlas(std::vector<StateTransitionDesc>& Barriers);
     void CreateInstanceBuffer();
     void UpdatePolygons(float elapsedTime);
-    void StartWorkerThreads(size_t NumThreads);
-    void StopWorkerThreads();
+    void CreateJobScheduler(Uint32 NumThreads);
 
     template <bool UseBatch>
-    void RenderSubset(IDeviceContext* pCtx, Uint32 Subset);
+    void RenderBatches(IDeviceContext* pCtx, Uint32 CtxIndex, Uint32 StartBatch, Uint32 EndBatch);
 
-    static void WorkerThreadFunc(Tutorial10_DataStreaming* pThis, Uint32 ThreadNum);
+    void InitializeIndirectDraws();
+    void WriteIndirectBatches(Uint32 StartBatch, Uint32 EndBatch);
+    void RenderIndirect();
 
-    Threading::Signal m_RenderSubsetSignal;
-    Threading::Signal m_ExecuteCommandListsSignal;
-    Threading::Signal m_GotoNextFrameSignal;
-
-    std::atomic_int m_NumThreadsCompleted;
-    std::atomic_int m_NumThreadsReady;
-
-    std::vector<std::thread> m_WorkerThreads;
-
-    std::vector<RefCntAutoPtr<ICommandList>> m_CmdLists;
-    std::vector<ICommandList*>               m_CmdListPtrs;
+    std::unique_ptr<RenderJobScheduler> m_pJobScheduler;
 
     static constexpr const int    NumStates = 5;
     RefCntAutoPtr<IPipelineState> m_pPSO[2][NumStates];
@@ -95,6 +87,38 @@ private:
     std::unique_ptr<class StreamingBuffer> m_StreamingVB;
     std::unique_ptr<class StreamingBuffer> m_StreamingIB;
 
+    // Ring buffers shared by all contexts. Only available on backends with unified memory.
+    std::unique_ptr<FrameRingBuffer>          m_RingVB;
+    std::unique_ptr<FrameRingBuffer>          m_RingIB;
+    std::vector<FrameRingBuffer::ThreadBlock> m_RingVBBlocks;
+    std::vector<FrameRingBuffer::ThreadBlock> m_RingIBBlocks;
+    bool                                      m_bUseRingBuffer = false;
+
+    enum GEOMETRY_MODE : int
+    {
+        // Vertices and indices of every polygon are written to the streaming buffers every frame
+        GEOMETRY_MODE_STREAMING = 0,
+
+        // All polygon shapes are stored in immutable atlas buffers, and only the
+        // per-instance data is streamed
+        GEOMETRY_MODE_ATLAS,
+
+        GEOMETRY_MODE_COUNT
+    };
+    int m_GeometryMode = GEOMETRY_MODE_STREAMING;
+
+    RefCntAutoPtr<IBuffer> m_AtlasVB;
+    RefCntAutoPtr<IBuffer> m_AtlasIB;
+
+    // Location of every polygon shape in the atlas index buffer, indexed by the number of vertices
+    std::vector<Uint32> m_AtlasFirstIndex;
+
+    // Bytes written by the CPU in the current and the last frame
+    std::atomic<Uint64> m_GeometryBytes{0};
+    std::atomic<Uint64> m_InstanceBytes{0};
+    Uint64              m_LastFrameGeometryBytes = 0;
+    Uint64              m_LastFrameInstanceBytes = 0;
+
     static constexpr int                  NumTextures = 4;
     RefCntAutoPtr<IShaderResourceBinding> m_SRB[NumTextures];
     RefCntAutoPtr<IShaderResourceBinding> m_BatchSRB;
@@ -110,19 +134,20 @@ private:
     int m_MaxThreads       = 8;
     int m_NumWorkerThreads = 4;
 
+    // Cold per-instance data that is only read by rendering
     struct PolygonData
     {
-        float2 Pos;
-        float2 MoveDir;
-        float  Size       = 0;
-        float  Angle      = 0;
-        float  RotSpeed   = 0;
-        int    TextureInd = 0;
-        int    StateInd   = 0;
-        int    NumVerts   = 0;
+        float Size       = 0;
+        int   TextureInd = 0;
+        int   StateInd   = 0;
+        int   NumVerts   = 0;
     };
     std::vector<PolygonData> m_Polygons;
 
+    // Hot simulation data is stored as structure of arrays and updated with SIMD
+    SpriteMotionSoA m_PolygonMotion;
+    Uint32          m_FrameIndex = 0;
+
     struct InstanceData
     {
         float4 PolygonRotationAndScale;
@@ -130,6 +155,30 @@ private:
         float  TexArrInd;
     };
 
+    // Multi-draw-indirect mode: worker threads write the instance data of all polygons and one set of
+    // draw arguments per batch, and the immediate context issues one indirect draw per blend state.
+    // Polygon geometry is taken from the atlas.
+    bool m_IndirectSupported = false;
+    bool m_bUseIndirect      = false;
+
+    struct DrawIndexedArgs
+    {
+        Uint32 NumIndices    = 0;
+        Uint32 NumInstances  = 0;
+        Uint32 FirstIndex    = 0;
+        Int32  BaseVertex    = 0;
+        Uint32 FirstInstance = 0;
+    };
+    RefCntAutoPtr<IBuffer>       m_IndirectInstanceBuffer;
+    RefCntAutoPtr<IBuffer>       m_IndirectArgsBuffer;
+    std::vector<InstanceData>    m_IndirectInstances;
+    std::vector<DrawIndexedArgs> m_IndirectArgs;
+    // Draw arguments are sorted by blend state; m_StateFirstArg[s] is the first argument of state s
+    std::vector<Uint32> m_BatchArgSlot;
+    Uint32              m_StateFirstArg[NumStates + 1] = {};
+
+    Uint32 m_NumDrawCalls = 0;
+
     static constexpr const Uint32 MinPolygonVerts = 3;
     static constexpr const Uint32 MaxPolygonVerts = 10;
     struct PolygonGeometry
@@ -25,10 +25,13 @@
  */
 
 #include <random>
+#include <algorithm>
 
 #include "Buildings.hpp"
+#include "TextureMipGen.hpp"
 #include "MapHelper.hpp"
 #include "PlatformMisc.hpp"
+#include "RenderJobScheduler.hpp"
 
 namespace Diligent
 {
@@ -508,6 +511,9 @@ void CreateBuilding(std::mt19937&           RndDev,
     }
 }
 
+// Grid cells in one tile of the city generation
+static constexpr int CityTileSize = 4;
+
 } // namespace
 
 void Buildings::CreateResources(IDeviceContext* pContext)
@@ -531,52 +537,101 @@ void Buildings::CreateResources(IDeviceContext* pContext)
         }
     }
 
-    std::vector<Building> CityGrid;
-    for (int y = 0; y < GridSize; ++y)
+    // The city is generated in parallel by tiles of the grid. Every tile has its own random generator
+    // seeded with the tile index, so the result does not depend on the number of threads.
+    struct CityTile
     {
-        for (int x = 0; x < GridSize; ++x)
-        {
-            Building& b       = TempCityGrid[x + y * GridSize];
-            float     MinDist = std::numeric_limits<float>::max();
+        std::vector<Vertex>    Vertices;
+        std::vector<IndexType> Indices; // relative to the first vertex of the tile
+
+        size_t FirstVertex = 0;
+        size_t FirstIndex  = 0;
+    };
+    const int             NumTilesX = (GridSize + CityTileSize - 1) / CityTileSize;
+    std::vector<CityTile> Tiles(static_cast<size_t>(NumTilesX) * static_cast<size_t>(NumTilesX));
 
-            for (int dy = -1; dy <= 1; ++dy)
+    const float Scale = m_DistributionScale;
+    const auto  CreateTile = [&](size_t TileInd) //
+    {
+        const int TileX = static_cast<int>(TileInd % NumTilesX) * CityTileSize;
+        const int TileY = static_cast<int>(TileInd / NumTilesX) * CityTileSize;
+
+        std::mt19937 RndDev{static_cast<std::mt19937::result_type>(TileInd)};
+
+        CityTile& Tile = Tiles[TileInd];
+        for (int y = TileY; y < std::min(TileY + CityTileSize, GridSize); ++y)
+        {
+            for (int x = TileX; x < std::min(TileX + CityTileSize, GridSize); ++x)
             {
-                for (int dx = -1; dx <= 1; ++dx)
+                Building b       = TempCityGrid[x + y * GridSize];
+                float    MinDist = std::numeric_limits<float>::max();
+
+                for (int dy = -1; dy <= 1; ++dy)
                 {
-                    const int2 iCenter = {x + dx, y + dy};
-                    if (iCenter.x >= 0 && iCenter.y >= 0 && iCenter.x < GridSize && iCenter.y < GridSize)
+                    for (int dx = -1; dx <= 1; ++dx)
                     {
-                        const Building& Other = TempCityGrid[iCenter.x + iCenter.y * GridSize];
-                        if (&b != &Other)
+                        const int2 iCenter = {x + dx, y + dy};
+                        if ((dx != 0 || dy != 0) && iCenter.x >= 0 && iCenter.y >= 0 && iCenter.x < GridSize && iCenter.y < GridSize)
                         {
+                            const Building& Other = TempCityGrid[iCenter.x + iCenter.y * GridSize];
+
                             float dist = length(b.Center - Other.Center);
                             MinDist    = std::min(MinDist, dist);
                         }
                     }
                 }
-            }
 
-            if (MinDist > 0.94f)
-            {
-                b.Radius = std::min(MinDist, 1.f) * 0.25f;
-                CityGrid.push_back(b);
+                if (MinDist > 0.94f)
+                {
+                    b.Radius = std::min(MinDist, 1.f) * 0.25f;
+                    // The cell index selects the textures, so they do not depend on the other tiles either
+                    CreateBuilding(RndDev, b.Center * Scale, b.Radius * Scale, b.Height, static_cast<Uint32>(x + y * GridSize), NumUniqueSlices, Tile.Vertices, Tile.Indices);
+                }
             }
         }
-    }
+    };
 
-    VERIFY_EXPR(CityGrid.size() > 0);
+    // The texture generation threads wait for work until the atlas is initialized below,
+    // so the city is generated by as many threads as they use.
+    RenderJobScheduler JobScheduler{pContext, nullptr, static_cast<Uint32>(m_GenTexThreads.size())};
 
-    // Use default seed to produce consistent distributions
-    std::mt19937 RndDev;
+    RenderJobScheduler::TaskInfo Task;
+    Task.NumItems = static_cast<Uint32>(Tiles.size());
+    Task.Process  = [&](Uint32 FirstTile, Uint32 EndTile) {
+        for (Uint32 TileInd = FirstTile; TileInd < EndTile; ++TileInd)
+            CreateTile(TileInd);
+    };
+    JobScheduler.ParallelFor(Task);
 
-    std::vector<Vertex>    Vertices;
-    std::vector<IndexType> Indices;
-    const float            Scale = m_DistributionScale;
-    for (Uint32 i = 0; i < CityGrid.size(); ++i)
+    // Merge the tiles in order
+    size_t NumVertices = 0;
+    size_t NumIndices  = 0;
+    for (CityTile& Tile : Tiles)
     {
-        Building& b = CityGrid[i];
-        CreateBuilding(RndDev, b.Center * Scale, b.Radius * Scale, b.Height, i, NumUniqueSlices, Vertices, Indices);
+        Tile.FirstVertex = NumVertices;
+        Tile.FirstIndex  = NumIndices;
+        NumVertices += Tile.Vertices.size();
+        NumIndices += Tile.Indices.size();
     }
+    VERIFY_EXPR(NumIndices > 0);
+
+    std::vector<Vertex>    Vertices(NumVertices);
+    std::vector<IndexType> Indices(NumIndices);
+    const auto MergeTile = [&](size_t TileInd) //
+    {
+        const CityTile& Tile       = Tiles[TileInd];
+        const IndexType BaseVertex = static_cast<IndexType>(Tile.FirstVertex);
+
+        std::copy(Tile.Vertices.begin(), Tile.Vertices.end(), Vertices.begin() + Tile.FirstVertex);
+        for (size_t i = 0; i < Tile.Indices.size(); ++i)
+            Indices[Tile.FirstIndex + i] = Tile.Indices[i] + BaseVertex;
+    };
+    Task.Process = [&](Uint32 FirstTile, Uint32 EndTile) {
+        for (Uint32 TileInd = FirstTile; TileInd < EndTile; ++TileInd)
+            MergeTile(TileInd);
+    };
+    JobScheduler.ParallelFor(Task);
+    Tiles.clear();
 
     // Create vertex & index buffers for opaque geometry
     {
@@ -633,23 +688,26 @@ void Buildings::CreateResources(IDeviceContext* pContext)
         // Resource is used in multiple contexts, so disable automatic resource transitions.
         m_OpaqueTexAtlas->SetState(RESOURCE_STATE_UNKNOWN);
 
-#if USE_STAGING_TEXTURE
-        TexDesc.Name           = "Buildings staging texture atlas";
-        TexDesc.BindFlags      = BIND_NONE;
-        TexDesc.Usage          = USAGE_STAGING;
-        TexDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
-        m_Device->CreateTexture(TexDesc, nullptr, &m_OpaqueTexAtlasStaging);
-
-        VERIFY_EXPR((m_OpaqueTexAtlasStaging->GetState() & RESOURCE_STATE_COPY_SOURCE) != 0);
-        m_OpaqueTexAtlasStaging->SetState(RESOURCE_STATE_UNKNOWN);
-#endif
+        {
+            UploadScheduler::CreateInfo SchedulerCI;
+            SchedulerCI.pDevice              = m_Device;
+            SchedulerCI.Name                 = "Buildings texture atlas staging chunk";
+            SchedulerCI.Width                = TexDesc.Width;
+            SchedulerCI.Height               = TexDesc.Height;
+            SchedulerCI.MipLevels            = TexDesc.MipLevels;
+            SchedulerCI.Format               = TexDesc.Format;
+            SchedulerCI.NumChunks            = 16; // about 20 Mb of staging memory for 512x512 slices
+            SchedulerCI.ImmediateContextMask = m_ImmediateContextMask;
+            m_UploadScheduler                = std::make_unique<UploadScheduler>(SchedulerCI);
+        }
 
         Uint32 SliceSize = 0;
         for (Uint32 Mip = 0; Mip < TexDesc.MipLevels; ++Mip)
             SliceSize += std::max(1u, TexDesc.Width >> Mip) * std::max(1u, TexDesc.Height >> Mip);
 
-        m_OpaqueTexAtlasPixels.resize(size_t{SliceSize} * size_t{TexDesc.ArraySize});
-        m_GenTexTask.Pixels.resize(SliceSize);
+        m_OpaqueTexAtlasSlices.resize(TexDesc.ArraySize);
+        for (std::vector<Uint32>& SlicePixels : m_OpaqueTexAtlasSlices)
+            SlicePixels.resize(SliceSize);
         m_OpaqueTexAtlasSliceSize = SliceSize * 4;
 
         // Initialize content
@@ -658,14 +716,19 @@ void Buildings::CreateResources(IDeviceContext* pContext)
         UpdateAtlas(pContext, ~0u, Unused);
         pContext->Flush();
 
-        // Begin texture generation in async thread
+        // Begin texture generation in worker threads
         {
-            m_GenTexTask.ArraySlice = 0;
-            m_GenTexTask.Time       = CurrentTime;
-
-            const TaskStatus OldStatus = m_GenTexTask.Status.exchange(TaskStatus::NewTask, std::memory_order_release);
-            VERIFY_EXPR(OldStatus == TaskStatus::Initial);
+            std::lock_guard<std::mutex> Lock{m_GenTexMtx};
+            for (Uint32 SlotInd = 0; SlotInd < m_GenTexSlots.size(); ++SlotInd)
+            {
+                GenTexSlot& Slot = m_GenTexSlots[SlotInd];
+                Slot.Pixels.resize(SliceSize);
+                QueueOpaqueSlice(Slot);
+                m_PendingGenTexSlots.push_back(SlotInd);
+            }
+            VERIFY(m_PendingGenTexSlots.size() == m_GenTexSlots.size(), "Every slot must be handed to the workers, otherwise no slice is ever regenerated");
         }
+        m_GenTexCondVar.notify_all();
     }
 
     m_DrawOpaqueSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_OpaqueTexAtlas")->Set(m_OpaqueTexAtlas->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
@@ -676,13 +739,6 @@ void Buildings::Initialize(IRenderDevice* pDevice, IBuffer* pDrawConstants, Uint
     m_Device               = pDevice;
     m_DrawConstants        = pDrawConstants;
     m_ImmediateContextMask = ImmediateContextMask;
-
-#if USE_STAGING_TEXTURE
-    FenceDesc FenceCI;
-    FenceCI.Name = "Upload complete fence";
-    FenceCI.Type = FENCE_TYPE_CPU_WAIT_ONLY;
-    m_Device->CreateFence(FenceCI, &m_UploadCompleteFence);
-#endif
 }
 
 void Buildings::CreatePSO(const ScenePSOCreateAttribs& Attr)
@@ -971,30 +1027,6 @@ static void GenWindowsAndTopNeonLineTexture(Uint32* Pixels, const Uint32 W, cons
     }
 }
 
-static void GenMipmap(const Uint32* SrcPixels, const Uint32 SrcW, const Uint32 SrcH, Uint32* DstPixels, const Uint32 DstW, const Uint32 DstH)
-{
-    VERIFY_EXPR(SrcW >= 2 && SrcH >= 2);
-
-    for (Uint32 y = 0; y < DstH; ++y)
-    {
-        for (Uint32 x = 0; x < DstW; ++x)
-        {
-            float4 c0  = RGBA8Unorm_To_F4Color(SrcPixels[(x * 2 + 0) + (y * 2 + 0) * SrcW]);
-            float4 c1  = RGBA8Unorm_To_F4Color(SrcPixels[(x * 2 + 1) + (y * 2 + 0) * SrcW]);
-            float4 c2  = RGBA8Unorm_To_F4Color(SrcPixels[(x * 2 + 0) + (y * 2 + 1) * SrcW]);
-            float4 c3  = RGBA8Unorm_To_F4Color(SrcPixels[(x * 2 + 1) + (y * 2 + 1) * SrcW]);
-            float4 col = (c0 + c1 + c2 + c3) * 0.25f;
-
-            // disable self-emission
-            Uint32 NumEmissionPix = (c0.a > 0.f) + (c1.a > 0.f) + (c2.a > 0.f) + (c3.a > 0.f);
-            if (NumEmissionPix <= 2)
-                col.a = 0.f;
-
-            DstPixels[x + y * DstW] = F4Color_To_RGBA8Unorm(col);
-        }
-    }
-}
-
 static void GenTexture(Uint32* Pixels, Uint32 Width, Uint32 Height, Uint32 Slice, Uint32 CurrTime)
 {
     const Uint32 Hash  = ((Slice * 0xacd) << (CurrTime & 2)) ^ (CurrTime * 0x4c44);
@@ -1027,28 +1059,30 @@ void Buildings::UpdateAtlas(IDeviceContext* pContext, Uint32 RequiredTransferRat
 
     const TextureDesc& TexDesc = m_OpaqueTexAtlas->GetDesc();
 
-    // Try to read a new texture
-    for (Uint32 i = 0; i < 100; ++i)
+    // Take the slices generated by the worker threads. The new pixels replace the old ones without a copy,
+    // and the memory of the old slice is given to the workers to generate the next slice.
+    bool HasNewTasks = false;
     {
-        TaskStatus Expected = TaskStatus::TexReady;
-        if (m_GenTexTask.Status.compare_exchange_weak(Expected, TaskStatus::CopyTex, std::memory_order_acquire, std::memory_order_relaxed))
+        std::lock_guard<std::mutex> Lock{m_GenTexMtx};
+        for (Uint32 SlotInd : m_ReadyGenTexSlots)
         {
-            Uint32 Offset = (m_OpaqueTexAtlasSliceSize / 4) * m_GenTexTask.ArraySlice;
-            memcpy(&m_OpaqueTexAtlasPixels[Offset], m_GenTexTask.Pixels.data(), m_OpaqueTexAtlasSliceSize);
+            GenTexSlot& Slot = m_GenTexSlots[SlotInd];
+            std::swap(Slot.Pixels, m_OpaqueTexAtlasSlices[Slot.ArraySlice]);
+            if (std::find(m_FreshOpaqueTexAtlasSlices.begin(), m_FreshOpaqueTexAtlasSlices.end(), Slot.ArraySlice) == m_FreshOpaqueTexAtlasSlices.end())
+                m_FreshOpaqueTexAtlasSlices.push_back(Slot.ArraySlice);
 
-            // Update task parameters
-            m_GenTexTask.ArraySlice = (m_GenTexTask.ArraySlice + 1) % TexDesc.ArraySize;
-            m_GenTexTask.Time       = CurrentTime;
-
-            const TaskStatus OldStatus = m_GenTexTask.Status.exchange(TaskStatus::NewTask, std::memory_order_release);
-            VERIFY_EXPR(OldStatus == TaskStatus::CopyTex);
-            break;
+            QueueOpaqueSlice(Slot);
+            m_PendingGenTexSlots.push_back(SlotInd);
         }
+        HasNewTasks = !m_ReadyGenTexSlots.empty();
+        m_NumRegeneratedSlices += static_cast<Uint32>(m_ReadyGenTexSlots.size());
+        m_ReadyGenTexSlots.clear();
     }
+    if (HasNewTasks)
+        m_GenTexCondVar.notify_all();
 
-#if USE_STAGING_TEXTURE
-    m_UploadCompleteFence->Wait(m_UploadCompleteFenceValue);
-#endif
+    // Release staging chunks completed by the GPU, never waiting for it
+    m_UploadScheduler->BeginFrame(Uint64{RequiredTransferRateMb} << 20);
 
     pContext->BeginDebugGroup("Update textures");
 
@@ -1061,49 +1095,27 @@ void Buildings::UpdateAtlas(IDeviceContext* pContext, Uint32 RequiredTransferRat
         pContext->TransitionResourceState(Barrier);
     }
 
-    Uint32       CopiedCpuToGpu = 0;
-    const Uint32 FirstSlice     = m_m_OpaqueTexAtlasOffset;
+    const auto UploadSlice = [&](Uint32 Slice) //
+    {
+        m_UploadScheduler->UploadSlice(pContext, m_OpaqueTexAtlas, Slice, m_OpaqueTexAtlasSlices[Slice].data());
+        return !m_UploadScheduler->HasBudget();
+    };
+
+    // Newly generated slices are uploaded first.
+    size_t NumFreshUploaded = 0;
+    bool   RateReached      = !m_UploadScheduler->HasBudget(); // the previous frames may have overdrawn the budget
+    while (NumFreshUploaded < m_FreshOpaqueTexAtlasSlices.size() && !RateReached)
+        RateReached = UploadSlice(m_FreshOpaqueTexAtlasSlices[NumFreshUploaded++]);
+    m_FreshOpaqueTexAtlasSlices.erase(m_FreshOpaqueTexAtlasSlices.begin(), m_FreshOpaqueTexAtlasSlices.begin() + NumFreshUploaded);
 
     // Each frame we copy pixels from CPU side to GPU side.
-    for (Uint32 SliceInd = 0; SliceInd < TexDesc.ArraySize; ++SliceInd)
+    const Uint32 FirstSlice = m_m_OpaqueTexAtlasOffset;
+    for (Uint32 SliceInd = 0; SliceInd < TexDesc.ArraySize && !RateReached; ++SliceInd)
     {
-        Uint32 Slice  = (FirstSlice + SliceInd) % TexDesc.ArraySize;
-        Uint32 Offset = (m_OpaqueTexAtlasSliceSize / 4) * Slice;
-        for (Uint32 Mipmap = 0; Mipmap < TexDesc.MipLevels; ++Mipmap)
-        {
-            const Uint32 W = std::max(1u, TexDesc.Width >> Mipmap);
-            const Uint32 H = std::max(1u, TexDesc.Height >> Mipmap);
-
-#if USE_STAGING_TEXTURE
-            MappedTextureSubresource SubRes;
-            pContext->MapTextureSubresource(m_OpaqueTexAtlasStaging, Mipmap, Slice, MAP_WRITE, MAP_FLAG_DO_NOT_WAIT | MAP_FLAG_DISCARD | MAP_FLAG_NO_OVERWRITE, nullptr, SubRes);
-            memcpy(SubRes.pData, &m_OpaqueTexAtlasPixels[Offset], W * H * 4);
-            pContext->UnmapTextureSubresource(m_OpaqueTexAtlasStaging, Mipmap, Slice);
-
-            CopyTextureAttribs Attribs;
-            Attribs.pSrcTexture = m_OpaqueTexAtlasStaging;
-            Attribs.SrcMipLevel = Mipmap;
-            Attribs.SrcSlice    = Slice;
-            Attribs.pDstTexture = m_OpaqueTexAtlas;
-            Attribs.DstMipLevel = Mipmap;
-            Attribs.DstSlice    = Slice;
-            pContext->CopyTexture(Attribs);
-#else
-            TextureSubResData SubRes;
-            SubRes.Stride = Uint64{W} * 4u;
-            SubRes.pData = &m_OpaqueTexAtlasPixels[Offset];
-            Box Region{0u, W, 0u, H};
-            pContext->UpdateTexture(m_OpaqueTexAtlas, Mipmap, Slice, Region, SubRes, RESOURCE_STATE_TRANSITION_MODE_NONE, RESOURCE_STATE_TRANSITION_MODE_NONE);
-#endif
-            CopiedCpuToGpu += W * H * 4;
-            Offset += W * H;
-        }
+        Uint32 Slice = (FirstSlice + SliceInd) % TexDesc.ArraySize;
+        RateReached  = UploadSlice(Slice);
 
         m_m_OpaqueTexAtlasOffset = Slice;
-
-        ActualTransferRateMb = (CopiedCpuToGpu >> 20) + (CopiedCpuToGpu >> 21); // round bytes to Mb
-        if (ActualTransferRateMb >= RequiredTransferRateMb)
-            break;
     }
 
     // Resources must be manually transitioned to required states.
@@ -1117,88 +1129,98 @@ void Buildings::UpdateAtlas(IDeviceContext* pContext, Uint32 RequiredTransferRat
 
     pContext->EndDebugGroup();
 
-#if USE_STAGING_TEXTURE
-    pContext->EnqueueSignal(m_UploadCompleteFence, ++m_UploadCompleteFenceValue);
-#endif
+    m_UploadScheduler->EndFrame(pContext);
+
+    const Uint64 CopiedCpuToGpu = m_UploadScheduler->GetStatistics().FrameBytes;
+    ActualTransferRateMb        = static_cast<Uint32>((CopiedCpuToGpu >> 20) + (CopiedCpuToGpu >> 21)); // round bytes to Mb
 }
 
 Buildings::Buildings()
 {
-    m_GenTexThreadLooping.store(true);
-    m_GenTexThread = std::thread{&Buildings::ThreadProc, this};
+    // Leave one core for the render thread
+    const Uint32 NumCores   = std::max(std::thread::hardware_concurrency(), 2u);
+    const Uint32 NumThreads = std::min(NumCores - 1, 4u);
+
+    // Two slots per thread let the workers continue while the render thread holds the ready slices
+    m_GenTexSlots.resize(size_t{NumThreads} * 2);
+
+    for (Uint32 i = 0; i < NumThreads; ++i)
+        m_GenTexThreads.emplace_back(&Buildings::GenTexThreadProc, this);
 }
 
 Buildings::~Buildings()
 {
-    m_GenTexThreadLooping.store(false);
-    m_GenTexThread.join();
+    {
+        std::lock_guard<std::mutex> Lock{m_GenTexMtx};
+        m_GenTexThreadsLooping = false;
+    }
+    m_GenTexCondVar.notify_all();
+
+    for (std::thread& Thread : m_GenTexThreads)
+        Thread.join();
+}
+
+void Buildings::QueueOpaqueSlice(GenTexSlot& Slot)
+{
+    Slot.ArraySlice   = m_NextGenTexSlice;
+    Slot.Time         = CurrentTime;
+    m_NextGenTexSlice = (m_NextGenTexSlice + 1) % m_OpaqueTexAtlas->GetDesc().ArraySize;
 }
 
-void Buildings::ThreadProc()
+void Buildings::GenTexThreadProc()
 {
-    while (m_GenTexThreadLooping.load())
+    for (;;)
     {
-        for (Uint32 i = 0; i < 100; ++i)
+        Uint32 SlotInd = 0;
         {
-            // Check the task status.
-            // If task status is 'NewTask' then change status to GenTex,
-            // invalidate CPU cache to make changes from another thread visible to current thread.
-            TaskStatus Expected = TaskStatus::NewTask;
-            if (m_GenTexTask.Status.compare_exchange_weak(Expected, TaskStatus::GenTex, std::memory_order_acquire, std::memory_order_relaxed))
-            {
-                const TextureDesc& TexDesc   = m_OpaqueTexAtlas->GetDesc();
-                const Uint32       Slice     = m_GenTexTask.ArraySlice;
-                Uint32             SrcOffset = 0;
-                GenTexture(&m_GenTexTask.Pixels[SrcOffset], TexDesc.Width, TexDesc.Height, Slice, m_GenTexTask.Time);
+            std::unique_lock<std::mutex> Lock{m_GenTexMtx};
+            m_GenTexCondVar.wait(Lock, [this]() { return !m_GenTexThreadsLooping || !m_PendingGenTexSlots.empty(); });
+            if (!m_GenTexThreadsLooping)
+                break;
 
-                for (Uint32 Mipmap = 1; Mipmap < TexDesc.MipLevels; ++Mipmap)
-                {
-                    const Uint32* SrcPixels = &m_GenTexTask.Pixels[SrcOffset];
-                    const Uint32  SrcW      = std::max(1u, TexDesc.Width >> (Mipmap - 1));
-                    const Uint32  SrcH      = std::max(1u, TexDesc.Height >> (Mipmap - 1));
-                    const Uint32  DstOffset = SrcOffset + SrcW * SrcH;
-                    Uint32*       DstPixels = &m_GenTexTask.Pixels[DstOffset];
-                    const Uint32  DstW      = std::max(1u, TexDesc.Width >> Mipmap);
-                    const Uint32  DstH      = std::max(1u, TexDesc.Height >> Mipmap);
-
-                    GenMipmap(SrcPixels, SrcW, SrcH, DstPixels, DstW, DstH);
-                    SrcOffset = DstOffset;
-                }
+            SlotInd = m_PendingGenTexSlots.front();
+            m_PendingGenTexSlots.pop_front();
+        }
 
-                // Change status to 'TexReady' and flush CPU cache to make local changes visible for other threads.
-                const TaskStatus OldStatus = m_GenTexTask.Status.exchange(TaskStatus::TexReady, std::memory_order_release);
-                VERIFY_EXPR(OldStatus == TaskStatus::GenTex);
+        // The slot is owned by this thread until it is returned to the ready list
+        GenTexSlot& Slot = m_GenTexSlots[SlotInd];
+        GenerateOpaqueSlice(Slot.Pixels.data(), Slot.ArraySlice, Slot.Time);
 
-                break;
-            }
+        {
+            std::lock_guard<std::mutex> Lock{m_GenTexMtx};
+            m_ReadyGenTexSlots.push_back(SlotInd);
         }
-        std::this_thread::sleep_for(std::chrono::microseconds{1});
     }
 }
 
-void Buildings::GenerateOpaqueTexture()
+void Buildings::GenerateOpaqueSlice(Uint32* Pixels, Uint32 Slice, Uint32 Time) const
 {
     const TextureDesc& TexDesc = m_OpaqueTexAtlas->GetDesc();
 
-    for (Uint32 Slice = 0; Slice < TexDesc.ArraySize; ++Slice)
-    {
-        Uint32 SrcOffset = (m_OpaqueTexAtlasSliceSize / 4) * Slice;
-        GenTexture(&m_OpaqueTexAtlasPixels[SrcOffset], TexDesc.Width, TexDesc.Height, Slice, 0u);
+    Uint32 SrcOffset = 0;
+    GenTexture(&Pixels[SrcOffset], TexDesc.Width, TexDesc.Height, Slice, Time);
 
-        for (Uint32 Mipmap = 1; Mipmap < TexDesc.MipLevels; ++Mipmap)
-        {
-            const Uint32* SrcPixels = &m_OpaqueTexAtlasPixels[SrcOffset];
-            const Uint32  SrcW      = std::max(1u, TexDesc.Width >> (Mipmap - 1));
-            const Uint32  SrcH      = std::max(1u, TexDesc.Height >> (Mipmap - 1));
-            const Uint32  DstOffset = SrcOffset + SrcW * SrcH;
-            Uint32*       DstPixels = &m_OpaqueTexAtlasPixels[DstOffset];
-            const Uint32  DstW      = std::max(1u, TexDesc.Width >> Mipmap);
-            const Uint32  DstH      = std::max(1u, TexDesc.Height >> Mipmap);
-
-            GenMipmap(SrcPixels, SrcW, SrcH, DstPixels, DstW, DstH);
-            SrcOffset = DstOffset;
-        }
+    for (Uint32 Mipmap = 1; Mipmap < TexDesc.MipLevels; ++Mipmap)
+    {
+        const Uint32* SrcPixels = &Pixels[SrcOffset];
+        const Uint32  SrcW      = std::max(1u, TexDesc.Width >> (Mipmap - 1));
+        const Uint32  SrcH      = std::max(1u, TexDesc.Height >> (Mipmap - 1));
+        const Uint32  DstOffset = SrcOffset + SrcW * SrcH;
+        Uint32*       DstPixels = &Pixels[DstOffset];
+        const Uint32  DstW      = std::max(1u, TexDesc.Width >> Mipmap);
+        const Uint32  DstH      = std::max(1u, TexDesc.Height >> Mipmap);
+
+        GenerateMipRGBA8(SrcPixels, SrcW, SrcH, DstPixels, DstW, DstH);
+        SrcOffset = DstOffset;
     }
 }
 
+void Buildings::GenerateOpaqueTexture()
+{
+    const TextureDesc& TexDesc = m_OpaqueTexAtlas->GetDesc();
+
+    for (Uint32 Slice = 0; Slice < TexDesc.ArraySize; ++Slice)
+        GenerateOpaqueSlice(m_OpaqueTexAtlasSlices[Slice].data(), Slice, 0u);
+}
+
 } // namespace Diligent
@@ -27,13 +27,14 @@
 #pragma once
 
 #include <thread>
-#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <vector>
 
 #include "Terrain.hpp"
-
-// Single staging texture allocates less memory, but spends more time
-// than when UpdateTexture() is used with implicit staging buffer.
-#define USE_STAGING_TEXTURE 0
+#include "UploadScheduler.hpp"
 
 namespace Diligent
 {
@@ -60,9 +61,18 @@ public:
         return TexDesc.Width * TexDesc.Height * TexDesc.ArraySize * 4;
     }
 
+    const UploadScheduler::Statistics& GetUploadStatistics() const { return m_UploadScheduler->GetStatistics(); }
+
+    // The number of slices generated by the worker threads since the atlas was initialized
+    Uint32 GetNumRegeneratedSlices() const { return m_NumRegeneratedSlices; }
+
 private:
+    struct GenTexSlot;
+
     void GenerateOpaqueTexture();
-    void ThreadProc();
+    void GenerateOpaqueSlice(Uint32* Pixels, Uint32 Slice, Uint32 Time) const;
+    void QueueOpaqueSlice(GenTexSlot& Slot);
+    void GenTexThreadProc();
 
     RefCntAutoPtr<IRenderDevice> m_Device;
     Uint64                       m_ImmediateContextMask = 0;
@@ -82,33 +92,38 @@ private:
     Uint32      m_m_OpaqueTexAtlasOffset = 0;
 
 
-    std::vector<Uint32> m_OpaqueTexAtlasPixels;
-    Uint32              m_OpaqueTexAtlasSliceSize = 0; // in bytes
+    // CPU-side copy of every atlas slice including all mip levels. Slices are stored separately,
+    // so a newly generated slice replaces the old one by swapping the memory instead of copying it.
+    std::vector<std::vector<Uint32>> m_OpaqueTexAtlasSlices;
+    Uint32                           m_OpaqueTexAtlasSliceSize = 0; // in bytes
 
-    enum class TaskStatus : Uint32
-    {
-        NewTask  = 0,
-        GenTex   = 1,
-        TexReady = 2,
-        CopyTex  = 3,
-        Initial  = ~0u,
-    };
-    struct GenTexTask
+    // Generated slices that have not been uploaded yet
+    std::vector<Uint32> m_FreshOpaqueTexAtlasSlices;
+    Uint32              m_NumRegeneratedSlices = 0;
+
+    // Texture generation pool: worker threads generate slices into the slots,
+    // UpdateAtlas() takes the ready slots and queues new slices.
+    // Slices are not generated into staging memory: every slice is re-uploaded from
+    // m_OpaqueTexAtlasSlices round-robin, so the CPU copy has to outlive the staging chunk,
+    // and staging chunks can only be mapped by the thread that owns the immediate context.
+    struct GenTexSlot
     {
-        std::atomic<TaskStatus> Status{TaskStatus::Initial}; // protects access to other fields
-        std::vector<Uint32>     Pixels;
-        Uint32                  ArraySlice = 0;
-        Uint32                  Time       = 0;
+        std::vector<Uint32> Pixels;
+        Uint32              ArraySlice = 0;
+        Uint32              Time       = 0;
     };
-    GenTexTask        m_GenTexTask;
-    std::thread       m_GenTexThread;
-    std::atomic<bool> m_GenTexThreadLooping{false};
-
-#if USE_STAGING_TEXTURE
-    RefCntAutoPtr<ITexture> m_OpaqueTexAtlasStaging;
-    RefCntAutoPtr<IFence>   m_UploadCompleteFence;
-    Uint64                  m_UploadCompleteFenceValue = 0;
-#endif
+    std::vector<GenTexSlot>  m_GenTexSlots;
+    std::vector<std::thread> m_GenTexThreads;
+    Uint32                   m_NextGenTexSlice = 0;
+
+    std::mutex              m_GenTexMtx;
+    std::condition_variable m_GenTexCondVar;
+    // Protected by m_GenTexMtx
+    std::deque<Uint32>  m_PendingGenTexSlots;
+    std::vector<Uint32> m_ReadyGenTexSlots;
+    bool                m_GenTexThreadsLooping = true;
+
+    std::unique_ptr<UploadScheduler> m_UploadScheduler;
 
 public:
     Uint32 CurrentTime = 0;
@@ -0,0 +1,138 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+// Micro-benchmark that compares the reference float mip generation (GenerateMipRGBA8Reference)
+// with the vectorized integer version (GenerateMipRGBA8) used by the buildings texture generator.
+//
+// Usage: Tutorial23MipGenBenchmark [--iterations N] [size ...]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "TextureMipGen.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+using Clock = std::chrono::high_resolution_clock;
+
+using MipGenFuncType = void (*)(const Uint32*, Uint32, Uint32, Uint32*, Uint32, Uint32);
+
+// Generates the full mip chain of a square texture stored as consecutive mip levels
+// the same way the buildings atlas slices are, and returns the average time per chain.
+double MeasureMipChain(MipGenFuncType MipGenFunc, std::vector<Uint32>& Pixels, Uint32 Size, Uint32 NumIterations)
+{
+    const auto StartTime = Clock::now();
+    for (Uint32 i = 0; i < NumIterations; ++i)
+    {
+        Uint32 SrcOffset = 0;
+        for (Uint32 SrcSize = Size; SrcSize >= 2; SrcSize /= 2)
+        {
+            const Uint32 DstOffset = SrcOffset + SrcSize * SrcSize;
+            MipGenFunc(&Pixels[SrcOffset], SrcSize, SrcSize, &Pixels[DstOffset], SrcSize / 2, SrcSize / 2);
+            SrcOffset = DstOffset;
+        }
+    }
+    return std::chrono::duration<double>(Clock::now() - StartTime).count() / NumIterations;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Uint32              NumIterations = 100;
+    std::vector<Uint32> Sizes;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+            NumIterations = static_cast<Uint32>(std::max(atoi(argv[++i]), 1));
+        else if (atoi(argv[i]) >= 2 && (atoi(argv[i]) & (atoi(argv[i]) - 1)) == 0)
+            Sizes.push_back(static_cast<Uint32>(atoi(argv[i])));
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--iterations N] [size ...] (sizes must be powers of two)" << std::endl;
+            return 1;
+        }
+    }
+    if (Sizes.empty())
+        Sizes = {256, 512, 1024};
+
+    int ExitCode = 0;
+    std::cout << std::fixed << std::setprecision(3);
+    for (Uint32 Size : Sizes)
+    {
+        size_t ChainSize = 0;
+        for (Uint32 MipSize = Size; MipSize >= 1; MipSize /= 2)
+            ChainSize += size_t{MipSize} * MipSize;
+
+        // Random colors where about half of the texels are emissive
+        std::mt19937        Rnd{static_cast<std::mt19937::result_type>(Size)};
+        std::vector<Uint32> Reference(ChainSize);
+        for (size_t i = 0; i < size_t{Size} * Size; ++i)
+            Reference[i] = (Rnd() & 1) ? Rnd() : (Rnd() & 0x00FFFFFFu);
+        std::vector<Uint32> Vectorized = Reference;
+
+        const double ReferenceTime  = MeasureMipChain(GenerateMipRGBA8Reference, Reference, Size, NumIterations);
+        const double VectorizedTime = MeasureMipChain(GenerateMipRGBA8, Vectorized, Size, NumIterations);
+
+        int    MaxError            = 0;
+        size_t NumEmissionMismatch = 0;
+        for (size_t i = size_t{Size} * Size; i < ChainSize; ++i)
+        {
+            for (Uint32 Shift = 0; Shift < 32; Shift += 8)
+            {
+                const int Error = std::abs(static_cast<int>((Reference[i] >> Shift) & 0xFF) - static_cast<int>((Vectorized[i] >> Shift) & 0xFF));
+                MaxError        = std::max(MaxError, Error);
+            }
+            if (((Reference[i] >> 24) == 0) != ((Vectorized[i] >> 24) == 0))
+                ++NumEmissionMismatch;
+        }
+
+        std::cout << std::setw(5) << Size << "x" << Size << ", " << NumIterations << " iterations: "
+                  << "reference " << ReferenceTime * 1000.0 << " ms, "
+                  << "vectorized " << VectorizedTime * 1000.0 << " ms, "
+                  << "speedup " << std::setprecision(2) << ReferenceTime / VectorizedTime << "x, "
+                  << "max error " << MaxError << ", "
+                  << "emission mismatches " << NumEmissionMismatch << std::setprecision(3) << std::endl;
+
+        // GenerateMipRGBA8 is documented to be within one unit of the reference
+        if (MaxError > 1)
+        {
+            std::cerr << "Error: the vectorized result differs from the reference by more than one unit" << std::endl;
+            ExitCode = 1;
+        }
+    }
+
+    return ExitCode;
+}
@@ -0,0 +1,191 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "TextureMipGen.hpp"
+
+#include "BasicMath.hpp"
+#include "DebugUtilities.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define MIP_GEN_SSE2 1
+#    include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#    define MIP_GEN_NEON 1
+#    include <arm_neon.h>
+#endif
+
+namespace Diligent
+{
+
+void GenerateMipRGBA8Reference(const Uint32* SrcPixels, const Uint32 SrcW, const Uint32 SrcH, Uint32* DstPixels, const Uint32 DstW, const Uint32 DstH)
+{
+    VERIFY_EXPR(SrcW >= 2 && SrcH >= 2);
+
+    for (Uint32 y = 0; y < DstH; ++y)
+    {
+        for (Uint32 x = 0; x < DstW; ++x)
+        {
+            float4 c0  = RGBA8Unorm_To_F4Color(SrcPixels[(x * 2 + 0) + (y * 2 + 0) * SrcW]);
+            float4 c1  = RGBA8Unorm_To_F4Color(SrcPixels[(x * 2 + 1) + (y * 2 + 0) * SrcW]);
+            float4 c2  = RGBA8Unorm_To_F4Color(SrcPixels[(x * 2 + 0) + (y * 2 + 1) * SrcW]);
+            float4 c3  = RGBA8Unorm_To_F4Color(SrcPixels[(x * 2 + 1) + (y * 2 + 1) * SrcW]);
+            float4 col = (c0 + c1 + c2 + c3) * 0.25f;
+
+            // disable self-emission
+            Uint32 NumEmissionPix = (c0.a > 0.f) + (c1.a > 0.f) + (c2.a > 0.f) + (c3.a > 0.f);
+            if (NumEmissionPix <= 2)
+                col.a = 0.f;
+
+            DstPixels[x + y * DstW] = F4Color_To_RGBA8Unorm(col);
+        }
+    }
+}
+
+namespace
+{
+
+Uint32 Average2x2(const Uint32 c0, const Uint32 c1, const Uint32 c2, const Uint32 c3)
+{
+    Uint32 Res = 0;
+    for (Uint32 Shift = 0; Shift < 32; Shift += 8)
+    {
+        const Uint32 Sum = ((c0 >> Shift) & 0xFFu) + ((c1 >> Shift) & 0xFFu) + ((c2 >> Shift) & 0xFFu) + ((c3 >> Shift) & 0xFFu);
+        Res |= ((Sum + 2u) >> 2u) << Shift;
+    }
+
+    // disable self-emission
+    const Uint32 NumEmissionPix = ((c0 >> 24u) != 0) + ((c1 >> 24u) != 0) + ((c2 >> 24u) != 0) + ((c3 >> 24u) != 0);
+    if (NumEmissionPix <= 2)
+        Res &= 0x00FFFFFFu;
+
+    return Res;
+}
+
+#if MIP_GEN_SSE2
+
+// Averages 4x2 source texels from each of the two rows into 4 destination texels.
+inline __m128i Average4x2x2(const Uint32* Row0, const Uint32* Row1)
+{
+    const __m128i Zero      = _mm_setzero_si128();
+    const __m128i AlphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+
+    const __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Row0));     // texels 0..3 of row 0
+    const __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Row0 + 4)); // texels 4..7 of row 0
+    const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Row1));
+    const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Row1 + 4));
+
+    // Vertical sums of the channels in 16 bits, two texels per register
+    const __m128i v01 = _mm_add_epi16(_mm_unpacklo_epi8(a0, Zero), _mm_unpacklo_epi8(b0, Zero));
+    const __m128i v23 = _mm_add_epi16(_mm_unpackhi_epi8(a0, Zero), _mm_unpackhi_epi8(b0, Zero));
+    const __m128i v45 = _mm_add_epi16(_mm_unpacklo_epi8(a1, Zero), _mm_unpacklo_epi8(b1, Zero));
+    const __m128i v67 = _mm_add_epi16(_mm_unpackhi_epi8(a1, Zero), _mm_unpackhi_epi8(b1, Zero));
+
+    // Horizontal sums of the even and odd texels
+    const __m128i Round = _mm_set1_epi16(2);
+    __m128i       d01   = _mm_add_epi16(_mm_unpacklo_epi64(v01, v23), _mm_unpackhi_epi64(v01, v23));
+    __m128i       d23   = _mm_add_epi16(_mm_unpacklo_epi64(v45, v67), _mm_unpackhi_epi64(v45, v67));
+    d01                 = _mm_srli_epi16(_mm_add_epi16(d01, Round), 2);
+    d23                 = _mm_srli_epi16(_mm_add_epi16(d23, Round), 2);
+    const __m128i Color = _mm_packus_epi16(d01, d23);
+
+    // Count emissive texels: every lane is 1 if the texel alpha is not zero
+    const __m128i One = _mm_set1_epi32(1);
+    const __m128i e0  = _mm_add_epi32(_mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(a0, AlphaMask), Zero), One),
+                                      _mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(b0, AlphaMask), Zero), One));
+    const __m128i e1  = _mm_add_epi32(_mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(a1, AlphaMask), Zero), One),
+                                      _mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(b1, AlphaMask), Zero), One));
+
+    const __m128  e0f          = _mm_castsi128_ps(e0);
+    const __m128  e1f          = _mm_castsi128_ps(e1);
+    const __m128i EvenEmission = _mm_castps_si128(_mm_shuffle_ps(e0f, e1f, _MM_SHUFFLE(2, 0, 2, 0)));
+    const __m128i OddEmission  = _mm_castps_si128(_mm_shuffle_ps(e0f, e1f, _MM_SHUFFLE(3, 1, 3, 1)));
+    const __m128i NumEmission  = _mm_add_epi32(EvenEmission, OddEmission);
+
+    const __m128i KeepAlpha = _mm_or_si128(_mm_cmpgt_epi32(NumEmission, _mm_set1_epi32(2)), _mm_set1_epi32(0x00FFFFFF));
+    return _mm_and_si128(Color, KeepAlpha);
+}
+
+#elif MIP_GEN_NEON
+
+// Averages 4x2 source texels from each of the two rows into 4 destination texels.
+inline uint32x4_t Average4x2x2(const Uint32* Row0, const Uint32* Row1)
+{
+    const uint8x16_t a0 = vld1q_u8(reinterpret_cast<const uint8_t*>(Row0)); // texels 0..3 of row 0
+    const uint8x16_t a1 = vld1q_u8(reinterpret_cast<const uint8_t*>(Row0 + 4));
+    const uint8x16_t b0 = vld1q_u8(reinterpret_cast<const uint8_t*>(Row1));
+    const uint8x16_t b1 = vld1q_u8(reinterpret_cast<const uint8_t*>(Row1 + 4));
+
+    // Vertical sums of the channels in 16 bits, two texels per register
+    const uint16x8_t v01 = vaddl_u8(vget_low_u8(a0), vget_low_u8(b0));
+    const uint16x8_t v23 = vaddl_u8(vget_high_u8(a0), vget_high_u8(b0));
+    const uint16x8_t v45 = vaddl_u8(vget_low_u8(a1), vget_low_u8(b1));
+    const uint16x8_t v67 = vaddl_u8(vget_high_u8(a1), vget_high_u8(b1));
+
+    // Horizontal sums of the texel pairs, rounded and divided by four
+    const uint16x8_t d01   = vcombine_u16(vadd_u16(vget_low_u16(v01), vget_high_u16(v01)), vadd_u16(vget_low_u16(v23), vget_high_u16(v23)));
+    const uint16x8_t d23   = vcombine_u16(vadd_u16(vget_low_u16(v45), vget_high_u16(v45)), vadd_u16(vget_low_u16(v67), vget_high_u16(v67)));
+    const uint32x4_t Color = vreinterpretq_u32_u8(vcombine_u8(vmovn_u16(vrshrq_n_u16(d01, 2)), vmovn_u16(vrshrq_n_u16(d23, 2))));
+
+    // Count emissive texels: every lane is 1 if the texel alpha is not zero
+    const uint32x4_t AlphaMask   = vdupq_n_u32(0xFF000000u);
+    const uint32x4_t e0          = vaddq_u32(vshrq_n_u32(vtstq_u32(vreinterpretq_u32_u8(a0), AlphaMask), 31),
+                                             vshrq_n_u32(vtstq_u32(vreinterpretq_u32_u8(b0), AlphaMask), 31));
+    const uint32x4_t e1          = vaddq_u32(vshrq_n_u32(vtstq_u32(vreinterpretq_u32_u8(a1), AlphaMask), 31),
+                                             vshrq_n_u32(vtstq_u32(vreinterpretq_u32_u8(b1), AlphaMask), 31));
+    const uint32x4_t NumEmission = vcombine_u32(vpadd_u32(vget_low_u32(e0), vget_high_u32(e0)), vpadd_u32(vget_low_u32(e1), vget_high_u32(e1)));
+
+    const uint32x4_t KeepAlpha = vorrq_u32(vcgtq_u32(NumEmission, vdupq_n_u32(2)), vdupq_n_u32(0x00FFFFFFu));
+    return vandq_u32(Color, KeepAlpha);
+}
+
+#endif
+
+} // namespace
+
+void GenerateMipRGBA8(const Uint32* SrcPixels, const Uint32 SrcW, const Uint32 SrcH, Uint32* DstPixels, const Uint32 DstW, const Uint32 DstH)
+{
+    VERIFY_EXPR(SrcW >= 2 && SrcH >= 2);
+
+    for (Uint32 y = 0; y < DstH; ++y)
+    {
+        const Uint32* Row0 = &SrcPixels[(y * 2 + 0) * SrcW];
+        const Uint32* Row1 = &SrcPixels[(y * 2 + 1) * SrcW];
+        Uint32*       Dst  = &DstPixels[y * DstW];
+
+        Uint32 x = 0;
+#if MIP_GEN_SSE2
+        for (; x + 4 <= DstW; x += 4)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&Dst[x]), Average4x2x2(&Row0[x * 2], &Row1[x * 2]));
+#elif MIP_GEN_NEON
+        for (; x + 4 <= DstW; x += 4)
+            vst1q_u32(&Dst[x], Average4x2x2(&Row0[x * 2], &Row1[x * 2]));
+#endif
+        for (; x < DstW; ++x)
+            Dst[x] = Average2x2(Row0[x * 2], Row0[x * 2 + 1], Row1[x * 2], Row1[x * 2 + 1]);
+    }
+}
+
+} // namespace Diligent
@@ -0,0 +1,47 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+// Both functions generate the next mip level of an RGBA8 texture by averaging 2x2 blocks of texels.
+// Alpha channel stores self-emission: a destination texel keeps its alpha only if at least
+// three of the four source texels are emissive, so that thin neon lines do not glow at a distance.
+// Source dimensions must be at least 2.
+
+// Reference implementation that converts every texel to float and back.
+void GenerateMipRGBA8Reference(const Uint32* SrcPixels, Uint32 SrcW, Uint32 SrcH, Uint32* DstPixels, Uint32 DstW, Uint32 DstH);
+
+// Integer implementation that processes 4 destination (16 source) texels per iteration with SSE2 or NEON.
+// Channels are rounded to the nearest integer and differ from the reference by at most one unit.
+// Tutorial23MipGenBenchmark reports the largest difference and fails if the bound is exceeded.
+void GenerateMipRGBA8(const Uint32* SrcPixels, Uint32 SrcW, Uint32 SrcH, Uint32* DstPixels, Uint32 DstW, Uint32 DstH);
+
+} // namespace Diligent
@@ -333,10 +333,9 @@ void Tutorial23_CommandQueues::Initialize(const SampleInitInfo& InitInfo)
     m_Buildings.CreateResources(m_pImmediateContext);
     m_Terrain.CreateResources(m_pImmediateContext);
 
-    if (m_pDevice->GetDeviceInfo().Features.TimestampQueries)
-    {
-        m_Profiler.Initialize(m_pDevice);
-    }
+    // GPU scopes are only recorded if the device supports timestamp queries
+    m_Profiler.Initialize(m_pDevice, FrameProfiler::CreateInfo{});
+    m_Profiler.SetThreadName("Render thread");
 
     // Signal first value to graphics fence.
     // Compute and transfer contexts will wait for this fence.
@@ -450,17 +449,17 @@ void Tutorial23_CommandQueues::ComputePass()
     const float DebugColor[] = {0.f, 1.f, 0.f, 1.f};
     ComputeCtx->BeginDebugGroup("Compute pass", DebugColor);
 
-    m_Profiler.Begin(ComputeCtx, Profiler::COMPUTE);
-
-    if (m_UseAsyncCompute)
     {
-        // Wait until graphics pass finishes working with terrain height and normal maps
-        ComputeCtx->DeviceWaitForFence(m_GraphicsCtxFence, m_GraphicsCtxFenceValue);
-    }
+        FrameProfiler::Scope ProfilerScope{m_Profiler, ComputeCtx, "Compute pass"};
 
-    m_Terrain.Update(ComputeCtx);
+        if (m_UseAsyncCompute)
+        {
+            // Wait until graphics pass finishes working with terrain height and normal maps
+            ComputeCtx->DeviceWaitForFence(m_GraphicsCtxFence, m_GraphicsCtxFenceValue);
+        }
 
-    m_Profiler.End(ComputeCtx, Profiler::COMPUTE);
+        m_Terrain.Update(ComputeCtx);
+    }
 
     ComputeCtx->EndDebugGroup(); // Compute pass
 
@@ -486,6 +485,7 @@ void Tutorial23_CommandQueues::UploadPass()
 {
     const Uint32 TransferRate = GetCpuToGpuTransferRateMb();
 
+    m_CpuToGpuTransferRateMb = 0;
     if (m_TransferCtx == nullptr || TransferRate == 0)
         return;
 
@@ -494,19 +494,17 @@ void Tutorial23_CommandQueues::UploadPass()
     const float DebugColor[] = {0.f, 0.f, 1.f, 1.f};
     TransferCtx->BeginDebugGroup("Transfer pass", DebugColor);
 
-    m_Profiler.Begin(TransferCtx, Profiler::TRANSFER);
-
-    if (m_UseAsyncTransfer)
     {
-        // Wait until graphics pass finishes with m_BuildingsTexAtlas.
-        TransferCtx->DeviceWaitForFence(m_GraphicsCtxFence, m_GraphicsCtxFenceValue);
-    }
+        FrameProfiler::Scope ProfilerScope{m_Profiler, TransferCtx, "Upload pass"};
 
-    Uint32 CpuToGpuTransferRateMb = 0;
-    m_Buildings.UpdateAtlas(TransferCtx, TransferRate, CpuToGpuTransferRateMb);
-    m_Profiler.SetCpuToGpuTransferRate(CpuToGpuTransferRateMb);
+        if (m_UseAsyncTransfer)
+        {
+            // Wait until graphics pass finishes with m_BuildingsTexAtlas.
+            TransferCtx->DeviceWaitForFence(m_GraphicsCtxFence, m_GraphicsCtxFenceValue);
+        }
 
-    m_Profiler.End(TransferCtx, Profiler::TRANSFER);
+        m_Buildings.UpdateAtlas(TransferCtx, TransferRate, m_CpuToGpuTransferRateMb);
+    }
 
     TransferCtx->EndDebugGroup(); // Transfer pass
 
@@ -536,7 +534,7 @@ void Tutorial23_CommandQueues::GraphicsPass1()
         const float DebugColor[] = {1.f, 0.f, 0.f, 1.f};
         m_pImmediateContext->BeginDebugGroup("Graphics pass 1", DebugColor);
 
-        m_Profiler.Begin(m_pImmediateContext, Profiler::GRAPHICS_1);
+        FrameProfiler::Scope ProfilerScope{m_Profiler, m_pImmediateContext, "Graphics pass 1"};
 
         ITextureView* pRTV = m_GBuffer.Color->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
         ITextureView* pDSV = m_GBuffer.Depth->GetDefaultView(TEXTURE_VIEW_DEPTH_STENCIL);
@@ -553,8 +551,6 @@ void Tutorial23_CommandQueues::GraphicsPass1()
 
         m_pImmediateContext->SetRenderTargets(0, nullptr, nullptr, RESOURCE_STATE_TRANSITION_MODE_NONE);
 
-        m_Profiler.End(m_pImmediateContext, Profiler::GRAPHICS_1);
-
         m_pImmediateContext->EndDebugGroup(); // Graphics pass 1
     }
 
@@ -578,27 +574,28 @@ void Tutorial23_CommandQueues::GraphicsPass2()
     const float DebugColor[] = {1.f, 0.5f, 0.f, 1.f};
     m_pImmediateContext->BeginDebugGroup("Graphics pass 2", DebugColor);
 
-    m_Profiler.Begin(m_pImmediateContext, Profiler::GRAPHICS_2);
+    {
+        FrameProfiler::Scope ProfilerScope{m_Profiler, m_pImmediateContext, "Graphics pass 2"};
 
-    if (m_Glow)
-        DownSample();
+        if (m_Glow)
+            DownSample();
 
-    // Final pass
-    {
-        ITextureView* pRTV = m_pSwapChain->GetCurrentBackBufferRTV();
-        m_pImmediateContext->SetRenderTargets(1, &pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        // Final pass
+        {
+            ITextureView* pRTV = m_pSwapChain->GetCurrentBackBufferRTV();
+            m_pImmediateContext->SetRenderTargets(1, &pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
 
-        PostProcess();
+            PostProcess();
+        }
     }
 
-    m_Profiler.End(m_pImmediateContext, Profiler::GRAPHICS_2);
-
     m_pImmediateContext->EndDebugGroup(); // Graphics pass 2
 }
 
 void Tutorial23_CommandQueues::Render()
 {
-    m_Profiler.Begin(nullptr, Profiler::FRAME);
+    // The frame scope is only measured on the CPU: its GPU time is the span of all passes
+    FrameProfiler::Scope ProfilerScope{m_Profiler, nullptr, "Frame"};
 
     ComputePass();
     UploadPass();
@@ -610,14 +607,12 @@ void Tutorial23_CommandQueues::Render()
         m_ComputeCtx->FinishFrame();
     if (m_TransferCtx)
         m_TransferCtx->FinishFrame();
-
-    m_Profiler.End(nullptr, Profiler::FRAME);
 }
 
 void Tutorial23_CommandQueues::Update(double CurrTime, double ElapsedTime, bool DoUpdateUI)
 {
-    // Update profiler before updating the UI
-    m_Profiler.Update(ElapsedTime);
+    // Close the previous frame before updating the UI
+    m_Profiler.EndFrame();
     SampleBase::Update(CurrTime, ElapsedTime, DoUpdateUI);
 
     const float dt = static_cast<float>(ElapsedTime);
@@ -726,6 +721,14 @@ void Tutorial23_CommandQueues::UpdateUI()
             const String TransferRateStr = std::to_string(GetCpuToGpuTransferRateMb());
             ImGui::TextDisabled("Transfer rate per frame (Mb)");
             ImGui::SliderInt("##TransferRate", &m_TransferRateMbExp2, 0, TexSizePOT, TransferRateStr.c_str());
+            ImGui::TextDisabled("Uploaded: %u Mb", m_CpuToGpuTransferRateMb);
+
+            const UploadScheduler::Statistics& UploadStats = m_Buildings.GetUploadStatistics();
+            ImGui::TextDisabled("Throughput: %.1f Mb/s", UploadStats.ThroughputMbPerSecond);
+            ImGui::TextDisabled("Latency: %.1f ms avg, %.1f ms max", UploadStats.AvgLatency * 1000.0, UploadStats.MaxLatency * 1000.0);
+            ImGui::TextDisabled("Staging chunks in flight: %u", UploadStats.NumChunksInFlight);
+            ImGui::TextDisabled("Stalls: %u", UploadStats.NumStalls);
+            ImGui::TextDisabled("Regenerated slices: %u", m_Buildings.GetNumRegeneratedSlices());
 
             ImGui::Checkbox("Use async transfer", &m_UseAsyncTransfer);
             ImGui::Separator();
@@ -32,7 +32,7 @@
 
 #include "Terrain.hpp"
 #include "Buildings.hpp"
-#include "Profiler.hpp"
+#include "FrameProfiler.hpp"
 
 namespace Diligent
 {
@@ -112,19 +112,20 @@ private:
     TEXTURE_FORMAT m_ColorTargetFormat = TEX_FORMAT_RGBA8_UNORM;
     TEXTURE_FORMAT m_DepthTargetFormat = TEX_FORMAT_UNKNOWN;
 
-    int          m_TransferRateMbExp2 = 2; // two to the power of
-    bool         m_UseAsyncCompute    = false;
-    bool         m_UseAsyncTransfer   = false;
-    bool         m_Glow               = true;
-    float3       m_LightDir           = normalize(float3{-0.49f, -0.60f, 0.64f});
-    const float  m_AmbientLight       = 0.1f;
-    const float3 m_FogColor           = {0.73f, 0.65f, 0.59f};
-    const float3 m_SkyColor           = {0.7f, 0.5f, 0.2f};
-    int          m_SurfaceScaleExp2   = 0; // two to the power of
+    int          m_TransferRateMbExp2     = 2; // two to the power of
+    Uint32       m_CpuToGpuTransferRateMb = 0;
+    bool         m_UseAsyncCompute        = false;
+    bool         m_UseAsyncTransfer       = false;
+    bool         m_Glow                   = true;
+    float3       m_LightDir               = normalize(float3{-0.49f, -0.60f, 0.64f});
+    const float  m_AmbientLight           = 0.1f;
+    const float3 m_FogColor               = {0.73f, 0.65f, 0.59f};
+    const float3 m_SkyColor               = {0.7f, 0.5f, 0.2f};
+    int          m_SurfaceScaleExp2       = 0; // two to the power of
 
     std::vector<ImmediateContextCreateInfo> m_ContextCI;
 
-    Profiler m_Profiler;
+    FrameProfiler m_Profiler;
 };
 
 } // namespace Diligent
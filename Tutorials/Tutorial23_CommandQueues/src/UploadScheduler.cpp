@@ -0,0 +1,220 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "UploadScheduler.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+// Statistics are averaged over this interval, in seconds
+static constexpr double StatisticsInterval = 0.5;
+
+UploadScheduler::UploadScheduler(const CreateInfo& CI) :
+    m_MipLevels{CI.MipLevels}
+{
+    VERIFY_EXPR(CI.pDevice != nullptr && CI.NumChunks > 0);
+
+    const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(CI.Format);
+    VERIFY(FmtAttribs.ComponentType != COMPONENT_TYPE_COMPRESSED, "Compressed formats are not supported");
+    m_TexelSize = Uint32{FmtAttribs.ComponentSize} * Uint32{FmtAttribs.NumComponents};
+
+    for (Uint32 Mip = 0; Mip < CI.MipLevels; ++Mip)
+        m_SliceSize += Uint64{std::max(1u, CI.Width >> Mip)} * Uint64{std::max(1u, CI.Height >> Mip)} * m_TexelSize;
+
+    TextureDesc TexDesc;
+    TexDesc.Name                 = CI.Name;
+    TexDesc.Type                 = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width                = CI.Width;
+    TexDesc.Height               = CI.Height;
+    TexDesc.MipLevels            = CI.MipLevels;
+    TexDesc.Format               = CI.Format;
+    TexDesc.BindFlags            = BIND_NONE;
+    TexDesc.Usage                = USAGE_STAGING;
+    TexDesc.CPUAccessFlags       = CPU_ACCESS_WRITE;
+    TexDesc.ImmediateContextMask = CI.ImmediateContextMask;
+
+    m_Chunks.resize(CI.NumChunks);
+    for (Uint32 i = 0; i < CI.NumChunks; ++i)
+    {
+        CI.pDevice->CreateTexture(TexDesc, nullptr, &m_Chunks[i].pStaging);
+        VERIFY_EXPR(m_Chunks[i].pStaging);
+
+        // Chunks are used in multiple contexts, so disable automatic resource transitions.
+        VERIFY_EXPR((m_Chunks[i].pStaging->GetState() & RESOURCE_STATE_COPY_SOURCE) != 0);
+        m_Chunks[i].pStaging->SetState(RESOURCE_STATE_UNKNOWN);
+
+        m_FreeChunks.push_back(i);
+    }
+
+    FenceDesc FenceCI;
+    FenceCI.Name = "Upload complete fence";
+    FenceCI.Type = FENCE_TYPE_CPU_WAIT_ONLY;
+    CI.pDevice->CreateFence(FenceCI, &m_pFence);
+}
+
+void UploadScheduler::RetireChunks()
+{
+    const Uint64            CompletedValue = m_pFence->GetCompletedValue();
+    const Clock::time_point CurrTime       = Clock::now();
+    while (!m_InFlightChunks.empty())
+    {
+        Chunk& OldestChunk = m_Chunks[m_InFlightChunks.front()];
+        if (OldestChunk.FenceValue > CompletedValue)
+            break;
+
+        OldestChunk.Info.Latency = std::chrono::duration<double>(CurrTime - OldestChunk.RecordTime).count();
+        m_CompletedUploads.push_back(OldestChunk.Info);
+
+        m_IntervalBytes += OldestChunk.Info.Size;
+        m_IntervalLatencySum += OldestChunk.Info.Latency;
+        m_IntervalMaxLatency = std::max(m_IntervalMaxLatency, OldestChunk.Info.Latency);
+        ++m_IntervalCount;
+
+        m_FreeChunks.push_back(m_InFlightChunks.front());
+        m_InFlightChunks.pop_front();
+    }
+}
+
+void UploadScheduler::BeginFrame(Uint64 FrameBudget)
+{
+    m_CompletedUploads.clear();
+    RetireChunks();
+
+    const Clock::time_point CurrTime = Clock::now();
+    const double            Elapsed  = std::chrono::duration<double>(CurrTime - m_IntervalStart).count();
+    if (Elapsed >= StatisticsInterval)
+    {
+        m_Stats.ThroughputMbPerSecond = static_cast<double>(m_IntervalBytes) / (1 << 20) / Elapsed;
+        m_Stats.AvgLatency            = m_IntervalCount > 0 ? m_IntervalLatencySum / m_IntervalCount : 0.0;
+        m_Stats.MaxLatency            = m_IntervalMaxLatency;
+
+        m_IntervalStart      = CurrTime;
+        m_IntervalBytes      = 0;
+        m_IntervalCount      = 0;
+        m_IntervalLatencySum = 0;
+        m_IntervalMaxLatency = 0;
+    }
+
+    // Keep the overdraft of the previous frame, but do not accumulate more than one frame of unused budget
+    const Int64 Budget = static_cast<Int64>(std::min(FrameBudget, Uint64{1} << 61));
+    m_Allowance        = std::min(m_Allowance, Budget) + Budget;
+
+    m_Stats.FrameBytes        = 0;
+    m_Stats.NumChunksInFlight = static_cast<Uint32>(m_InFlightChunks.size());
+}
+
+Uint32 UploadScheduler::AcquireChunk(IDeviceContext* pContext)
+{
+    if (m_FreeChunks.empty())
+        RetireChunks();
+
+    if (m_FreeChunks.empty())
+    {
+        // All chunks are in flight: wait for the oldest one
+        const Chunk& OldestChunk = m_Chunks[m_InFlightChunks.front()];
+        if (m_HasUnsignaledChunks && OldestChunk.FenceValue == m_NextFenceValue)
+        {
+            // The oldest chunk was recorded in this frame, so its copy commands must be submitted first
+            pContext->EnqueueSignal(m_pFence, m_NextFenceValue++);
+            pContext->Flush();
+            m_HasUnsignaledChunks = false;
+        }
+        m_pFence->Wait(OldestChunk.FenceValue);
+        ++m_Stats.NumStalls;
+
+        RetireChunks();
+        VERIFY_EXPR(!m_FreeChunks.empty());
+    }
+
+    const Uint32 ChunkInd = m_FreeChunks.front();
+    m_FreeChunks.pop_front();
+    return ChunkInd;
+}
+
+void UploadScheduler::UploadSlice(IDeviceContext* pContext, ITexture* pDstTexture, Uint32 DstSlice, const void* pSrcData)
+{
+    const Uint32 ChunkInd  = AcquireChunk(pContext);
+    Chunk&       CurrChunk = m_Chunks[ChunkInd];
+
+    const TextureDesc& ChunkDesc = CurrChunk.pStaging->GetDesc();
+    const Uint8*       pSrc      = static_cast<const Uint8*>(pSrcData);
+    for (Uint32 Mip = 0; Mip < m_MipLevels; ++Mip)
+    {
+        const Uint32 W       = std::max(1u, ChunkDesc.Width >> Mip);
+        const Uint32 H       = std::max(1u, ChunkDesc.Height >> Mip);
+        const size_t RowSize = size_t{W} * m_TexelSize;
+
+        // The chunk is not used by the GPU, so there is no need to wait.
+        MappedTextureSubresource MappedData;
+        pContext->MapTextureSubresource(CurrChunk.pStaging, Mip, 0, MAP_WRITE, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+        if (MappedData.pData == nullptr)
+        {
+            LOG_ERROR_MESSAGE("Failed to map staging texture '", ChunkDesc.Name, "'");
+            break;
+        }
+        for (Uint32 Row = 0; Row < H; ++Row)
+            memcpy(static_cast<Uint8*>(MappedData.pData) + Row * MappedData.Stride, pSrc + Row * RowSize, RowSize);
+        pContext->UnmapTextureSubresource(CurrChunk.pStaging, Mip, 0);
+        pSrc += RowSize * H;
+
+        CopyTextureAttribs Attribs;
+        Attribs.pSrcTexture = CurrChunk.pStaging;
+        Attribs.SrcMipLevel = Mip;
+        Attribs.SrcSlice    = 0;
+        Attribs.pDstTexture = pDstTexture;
+        Attribs.DstMipLevel = Mip;
+        Attribs.DstSlice    = DstSlice;
+        pContext->CopyTexture(Attribs);
+    }
+
+    CurrChunk.FenceValue   = m_NextFenceValue;
+    CurrChunk.RecordTime   = Clock::now();
+    CurrChunk.Info.Slice   = DstSlice;
+    CurrChunk.Info.Size    = m_SliceSize;
+    CurrChunk.Info.Latency = 0;
+    m_InFlightChunks.push_back(ChunkInd);
+    m_HasUnsignaledChunks = true;
+
+    m_Allowance -= static_cast<Int64>(m_SliceSize);
+    m_Stats.FrameBytes += m_SliceSize;
+    m_Stats.NumChunksInFlight = static_cast<Uint32>(m_InFlightChunks.size());
+}
+
+void UploadScheduler::EndFrame(IDeviceContext* pContext)
+{
+    if (m_HasUnsignaledChunks)
+    {
+        pContext->EnqueueSignal(m_pFence, m_NextFenceValue++);
+        m_HasUnsignaledChunks = false;
+    }
+}
+
+} // namespace Diligent
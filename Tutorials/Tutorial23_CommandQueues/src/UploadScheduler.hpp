@@ -0,0 +1,166 @@
+/*
+ *  Copyright 2026 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <vector>
+
+#include "RenderDevice.h"
+#include "DeviceContext.h"
+#include "Texture.h"
+#include "Fence.h"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Uploads texture array slices from the CPU through a ring of staging textures.
+///
+/// \remarks    Every upload writes the slice into its own staging chunk and copies it to the destination
+///             texture in the context that records the upload. All uploads of a frame are followed by a single
+///             fence signal in EndFrame(), and the chunks are reused once the fence reaches that value.
+///             The CPU only waits for the fence when all chunks are in flight.
+///             The amount of data uploaded per frame is limited by a budget. Unused budget (up to one frame)
+///             and overdraft are carried over to the next frame, so the average rate matches the budget.
+///             All uploads must be executed by the GPU in the order they are recorded, so the queue
+///             may only be changed after the GPU has become idle.
+class UploadScheduler
+{
+public:
+    struct CreateInfo
+    {
+        IRenderDevice* pDevice = nullptr;
+        const Char*    Name    = nullptr;
+
+        /// Dimensions and format of the uploaded slices. The format must not be compressed.
+        Uint32         Width     = 0;
+        Uint32         Height    = 0;
+        Uint32         MipLevels = 1;
+        TEXTURE_FORMAT Format    = TEX_FORMAT_RGBA8_UNORM;
+
+        /// The number of staging chunks, each holding one slice with all its mip levels.
+        Uint32 NumChunks = 16;
+
+        Uint64 ImmediateContextMask = 1;
+    };
+
+    struct UploadInfo
+    {
+        Uint32 Slice = 0;
+        Uint64 Size  = 0;
+
+        /// Time in seconds from recording the upload to the moment the CPU found it completed.
+        double Latency = 0;
+    };
+
+    struct Statistics
+    {
+        /// Data rate of the uploads completed in the last measurement interval.
+        double ThroughputMbPerSecond = 0;
+
+        /// Latency of the uploads completed in the last measurement interval, in seconds.
+        double AvgLatency = 0;
+        double MaxLatency = 0;
+
+        /// The number of bytes recorded in the current frame.
+        Uint64 FrameBytes = 0;
+
+        /// The number of staging chunks that may still be used by the GPU.
+        Uint32 NumChunksInFlight = 0;
+
+        /// The number of times the CPU had to wait for the GPU because all chunks were in flight.
+        Uint32 NumStalls = 0;
+    };
+
+    explicit UploadScheduler(const CreateInfo& CI);
+
+    // clang-format off
+    UploadScheduler           (const UploadScheduler&) = delete;
+    UploadScheduler& operator=(const UploadScheduler&) = delete;
+    // clang-format on
+
+    /// Releases the chunks that the GPU has finished with and adds the frame budget (in bytes) to the allowance.
+    void BeginFrame(Uint64 FrameBudget);
+
+    /// Returns true if the allowance of the current frame has not been spent yet.
+    bool HasBudget() const { return m_Allowance > 0; }
+
+    /// Records the upload of one slice. Mip levels of the source data are tightly packed one after another.
+    /// The destination texture must be in COPY_DEST state.
+    void UploadSlice(IDeviceContext* pContext, ITexture* pDstTexture, Uint32 DstSlice, const void* pSrcData);
+
+    /// Signals the fence after the uploads of the frame. Must be called in the context that recorded them.
+    void EndFrame(IDeviceContext* pContext);
+
+    const Statistics& GetStatistics() const { return m_Stats; }
+
+    /// Uploads found completed by the last BeginFrame() call.
+    const std::vector<UploadInfo>& GetCompletedUploads() const { return m_CompletedUploads; }
+
+    Uint64 GetSliceSize() const { return m_SliceSize; }
+
+private:
+    using Clock = std::chrono::high_resolution_clock;
+
+    Uint32 AcquireChunk(IDeviceContext* pContext);
+    void   RetireChunks();
+
+    struct Chunk
+    {
+        RefCntAutoPtr<ITexture> pStaging;
+        Uint64                  FenceValue = 0;
+        UploadInfo              Info;
+        Clock::time_point       RecordTime;
+    };
+    std::vector<Chunk> m_Chunks;
+    std::deque<Uint32> m_FreeChunks;
+    std::deque<Uint32> m_InFlightChunks; // in the order of recording
+
+    RefCntAutoPtr<IFence> m_pFence;
+    // The value that will be signaled after the uploads recorded since the last signal
+    Uint64 m_NextFenceValue      = 1;
+    bool   m_HasUnsignaledChunks = false;
+
+    Uint32 m_TexelSize = 0;
+    Uint64 m_SliceSize = 0;
+    Uint32 m_MipLevels = 0;
+
+    Int64 m_Allowance = 0;
+
+    Statistics              m_Stats;
+    std::vector<UploadInfo> m_CompletedUploads;
+
+    // Completed uploads in the current measurement interval
+    Clock::time_point m_IntervalStart      = Clock::now();
+    Uint64            m_IntervalBytes      = 0;
+    Uint32            m_IntervalCount      = 0;
+    double            m_IntervalLatencySum = 0;
+    double            m_IntervalMaxLatency = 0;
+};
+
+} // namespace Diligent